@@ -720,6 +720,8 @@ public:
             nodeMetrics.set("maxAllocBytes", static_cast<double>(lastPerfMetrics_.nodes[i].maxAllocBytes));
             nodeMetrics.set("maxAllocWidth", lastPerfMetrics_.nodes[i].maxAllocWidth);
             nodeMetrics.set("maxAllocHeight", lastPerfMetrics_.nodes[i].maxAllocHeight);
+            nodeMetrics.set("savedBytes", static_cast<double>(lastPerfMetrics_.nodes[i].savedBytes));
+            nodeMetrics.set("savedPixels", static_cast<double>(lastPerfMetrics_.nodes[i].savedPixels));
 #else
             nodeMetrics.set("time_us", 0);
             nodeMetrics.set("count", 0);
@@ -734,6 +736,8 @@ public:
             nodeMetrics.set("maxAllocBytes", 0.0);
             nodeMetrics.set("maxAllocWidth", 0);
             nodeMetrics.set("maxAllocHeight", 0);
+            nodeMetrics.set("savedBytes", 0.0);
+            nodeMetrics.set("savedPixels", 0.0);
 #endif
             nodes.call<void>("push", nodeMetrics);
         }
@@ -24,14 +24,28 @@ export const NODE_TYPES = {
     affine:      { index: 4, name: 'Affine',      nameJa: 'アフィン',     category: 'structure', showEfficiency: true },
     composite:   { index: 5, name: 'Composite',   nameJa: '合成',         category: 'structure', showEfficiency: false },
     matte:       { index: 13, name: 'Matte',      nameJa: 'マット合成',   category: 'structure', showEfficiency: false },
+    perspective: { index: 14, name: 'Perspective', nameJa: '射影変換',    category: 'structure', showEfficiency: true },
+    warp:        { index: 15, name: 'Warp',        nameJa: 'ワープ',       category: 'structure', showEfficiency: true },
+    mask:        { index: 17, name: 'Mask',        nameJa: 'マスク',       category: 'structure', showEfficiency: false },
     // フィルタ系
     brightness:  { index: 6, name: 'Brightness',  nameJa: '明るさ',       category: 'filter',    showEfficiency: true },
     grayscale:   { index: 7, name: 'Grayscale',   nameJa: 'グレースケール', category: 'filter',  showEfficiency: true },
     alpha:       { index: 9, name: 'Alpha',       nameJa: '透明度',       category: 'filter',    showEfficiency: true },
     horizontalBlur: { index: 10, name: 'HBlur',   nameJa: '水平ぼかし',   category: 'filter',    showEfficiency: true },
     verticalBlur:   { index: 11, name: 'VBlur',   nameJa: '垂直ぼかし',   category: 'filter',    showEfficiency: true },
+    dropShadow:     { index: 20, name: 'DropShadow', nameJa: 'ドロップシャドウ', category: 'filter', showEfficiency: false },
+    gaussianBlur:   { index: 21, name: 'GaussBlur', nameJa: 'ガウスぼかし', category: 'filter', showEfficiency: true },
+    fastBlur:       { index: 22, name: 'FastBlur', nameJa: '縮小ぼかし', category: 'filter', showEfficiency: true },
+    blur:           { index: 23, name: 'Blur', nameJa: 'ぼかし', category: 'filter', showEfficiency: true },
+    convolution:    { index: 24, name: 'Convolution', nameJa: '畳み込み', category: 'filter', showEfficiency: true },
+    morphology:     { index: 25, name: 'Morphology', nameJa: 'モルフォロジー', category: 'filter', showEfficiency: true },
+    median:         { index: 26, name: 'Median', nameJa: 'メディアン', category: 'filter', showEfficiency: true },
+    colorCurve:     { index: 27, name: 'ColorCurve', nameJa: 'トーンカーブ', category: 'filter', showEfficiency: true },
     // 特殊ソース系
     ninepatch:   { index: 12, name: 'NinePatch',  nameJa: '9パッチ',      category: 'source',    showEfficiency: false },
+    spriteBatch: { index: 16, name: 'SpriteBatch', nameJa: 'スプライト',  category: 'source',    showEfficiency: false },
+    cache:       { index: 18, name: 'Cache',       nameJa: 'キャッシュ',   category: 'source',    showEfficiency: false },
+    shared:      { index: 19, name: 'Shared',      nameJa: '共有出力',     category: 'system',    showEfficiency: false },
 };
 
 // ========================================
@@ -1371,6 +1371,15 @@ static void matteComposite2D(uint8_t* outBuf, int width, int height, int outStri
     }
 }
 
+// Output checksum (FNV-1a) for comparing SIMD and scalar results
+static uint32_t outputChecksum(const uint8_t* buf, size_t bytes) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < bytes; ++i) {
+        h = (h ^ buf[i]) * 16777619u;
+    }
+    return h;
+}
+
 static void runMatteCompositeBenchmark(MaskPattern pattern) {
     const char* patternName = maskPatternNames[static_cast<int>(pattern)];
 
@@ -1379,21 +1388,30 @@ static void runMatteCompositeBenchmark(MaskPattern pattern) {
     initBackgroundBuffer();
     initMask2DWithPattern(pattern, BENCH_WIDTH, BENCH_HEIGHT);
 
-    // Benchmark
-    uint32_t us = runBenchmark([&]() {
+    const size_t outBytes = static_cast<size_t>(BENCH_WIDTH) * BENCH_HEIGHT * 4;
+    auto composite = [&]() {
         matteComposite2D(bufOutput, BENCH_WIDTH, BENCH_HEIGHT, BENCH_WIDTH * 4,
                          bufRGBA8, BENCH_WIDTH * 4,
                          bufRGBA8_2, BENCH_WIDTH * 4,
                          bufMask, BENCH_WIDTH);
-    });
+    };
+
+    // Benchmark (scalar reference, then default SIMD dispatch)
+    MatteNode::benchSetForceScalar(true);
+    uint32_t scalarUs = runBenchmark(composite);
+    uint32_t scalarSum = outputChecksum(bufOutput, outBytes);
+    MatteNode::benchSetForceScalar(false);
+    uint32_t us = runBenchmark(composite);
+    uint32_t simdSum = outputChecksum(bufOutput, outBytes);
 
     // Calculate throughput
     int pixelsPerIteration = BENCH_WIDTH * BENCH_HEIGHT;
     float nsPerPx = static_cast<float>(us) * 1000.0f / static_cast<float>(pixelsPerIteration);
     float mpps = static_cast<float>(pixelsPerIteration) / static_cast<float>(us);
 
-    benchPrintf("  %-12s %6u us  %5.1f ns/px  %5.2f Mpix/s\n",
-                patternName, us, static_cast<double>(nsPerPx), static_cast<double>(mpps));
+    benchPrintf("  %-12s %6u us  %5.1f ns/px  %5.2f Mpix/s  (scalar %6u us) %s\n",
+                patternName, us, static_cast<double>(nsPerPx), static_cast<double>(mpps),
+                scalarUs, simdSum == scalarSum ? "match" : "MISMATCH");
 }
 
 static void runMatteCompositeBenchmarks(const char* patternArg) {
@@ -1486,11 +1504,24 @@ static void runMattePipelineBenchmark(MaskPattern pattern) {
 
     renderer.setVirtualScreen(MATTE_RENDER_WIDTH, MATTE_RENDER_HEIGHT);
 
+    // Scalar reference (checksum + timing)
+    const size_t outBytes = static_cast<size_t>(MATTE_RENDER_WIDTH) * MATTE_RENDER_HEIGHT * 4;
+    MatteNode::benchSetForceScalar(true);
+    renderer.exec();
+    uint32_t scalarSum = outputChecksum(bufOutput, outBytes);
+    uint32_t start = benchMicros();
+    for (int i = 0; i < MATTE_ITERATIONS; i++) {
+        renderer.exec();
+    }
+    uint32_t scalarUs = (benchMicros() - start) / MATTE_ITERATIONS;
+    MatteNode::benchSetForceScalar(false);
+
     // Warm up
     renderer.exec();
+    uint32_t simdSum = outputChecksum(bufOutput, outBytes);
 
     // Benchmark with reduced iterations for scaled output
-    uint32_t start = benchMicros();
+    start = benchMicros();
     for (int i = 0; i < MATTE_ITERATIONS; i++) {
         renderer.exec();
     }
@@ -1501,8 +1532,9 @@ static void runMattePipelineBenchmark(MaskPattern pattern) {
     float nsPerPx = static_cast<float>(us) * 1000.0f / static_cast<float>(pixelsPerIteration);
     float mpps = static_cast<float>(pixelsPerIteration) / static_cast<float>(us);  // Mpix/sec
 
-    benchPrintf("  %-12s %6u us  %5.1f ns/px  %5.2f Mpix/s\n",
-                patternName, us, static_cast<double>(nsPerPx), static_cast<double>(mpps));
+    benchPrintf("  %-12s %6u us  %5.1f ns/px  %5.2f Mpix/s  (scalar %6u us) %s\n",
+                patternName, us, static_cast<double>(nsPerPx), static_cast<double>(mpps),
+                scalarUs, simdSum == scalarSum ? "match" : "MISMATCH");
 }
 
 static void runMattePipelineBenchmarks(const char* patternArg) {
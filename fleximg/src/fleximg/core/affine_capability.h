@@ -33,7 +33,7 @@ public:
     // 行列アクセサ
     // ========================================
 
-    void setMatrix(const AffineMatrix& m) { localMatrix_ = m; }
+    void setMatrix(const AffineMatrix& m) { localMatrix_ = m; ++matrixGeneration_; }
     const AffineMatrix& matrix() const { return localMatrix_; }
 
     // ========================================
@@ -46,18 +46,21 @@ public:
         float s = std::sin(radians);
         localMatrix_.a = c;  localMatrix_.b = -s;
         localMatrix_.c = s;  localMatrix_.d = c;
+        ++matrixGeneration_;
     }
 
     // スケールを設定（a,b,c,d のみ変更、tx,ty は維持）
     void setScale(float sx, float sy) {
         localMatrix_.a = sx; localMatrix_.b = 0;
         localMatrix_.c = 0;  localMatrix_.d = sy;
+        ++matrixGeneration_;
     }
 
     // 平行移動を設定（tx,ty のみ変更、a,b,c,d は維持）
     void setTranslation(float tx, float ty) {
         localMatrix_.tx = tx;
         localMatrix_.ty = ty;
+        ++matrixGeneration_;
     }
 
     // 回転+スケールを設定（a,b,c,d のみ変更、tx,ty は維持）
@@ -66,6 +69,7 @@ public:
         float s = std::sin(radians);
         localMatrix_.a = c * sx;  localMatrix_.b = -s * sy;
         localMatrix_.c = s * sx;  localMatrix_.d = c * sy;
+        ++matrixGeneration_;
     }
 
     // ========================================
@@ -79,8 +83,12 @@ public:
                localMatrix_.tx != 0.0f || localMatrix_.ty != 0.0f;
     }
 
+    // 行列の変更世代（セッター呼び出しごとに加算、キャッシュ無効化用）
+    uint32_t matrixGeneration() const { return matrixGeneration_; }
+
 protected:
     AffineMatrix localMatrix_;  // ローカル変換行列（デフォルトは単位行列）
+    uint32_t matrixGeneration_ = 0;  // 行列の変更世代
 };
 
 } // namespace FLEXIMG_NAMESPACE
@@ -49,6 +49,23 @@
   #define FLEXIMG_DEPRECATED(msg)
 #endif
 
+// ========================================================================
+// SIMD detection
+// ========================================================================
+//
+// FLEXIMG_HAS_SSE2: x86 SSE2 命令セットが利用可能（x86-64 では常に有効）
+// FLEXIMG_HAS_AVX2: x86 AVX2 命令セットが利用可能（-mavx2 等で有効化した場合のみ）
+// FLEXIMG_NO_SIMD を定義するとスカラー実装のみを使用
+//
+
+#if defined(__SSE2__) && !defined(FLEXIMG_NO_SIMD)
+  #define FLEXIMG_HAS_SSE2 1
+#endif
+
+#if defined(__AVX2__) && defined(FLEXIMG_HAS_SSE2)
+  #define FLEXIMG_HAS_AVX2 1
+#endif
+
 // Version information
 #define FLEXIMG_VERSION_MAJOR 2
 #define FLEXIMG_VERSION_MINOR 0
@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <cassert>
+#include <cstring>
 #include "common.h"
 #include "port.h"
 #include "perf_metrics.h"
@@ -11,6 +12,9 @@
 #include "../image/image_buffer.h"
 
 namespace FLEXIMG_NAMESPACE {
+
+class FilterNodeBase;
+
 namespace core {
 
 // ========================================================================
@@ -312,6 +316,17 @@ public:
         context_ = nullptr;
     }
 
+    // ========================================
+    // 変更世代（キャッシュ無効化用）
+    // ========================================
+
+    // 出力に影響するパラメータの変更世代
+    // パラメータセッターが markModified() で進める。CacheNode 等が上流の
+    // 変化を検出するために参照する。ソース画素を直接書き換えた場合や
+    // sprite() 等の参照経由で変更した場合は、利用側で markModified() を呼ぶ
+    virtual uint32_t generation() const { return generation_; }
+    void markModified() { ++generation_; }
+
     // ノード名（デバッグ用）
     virtual const char* name() const { return "Node"; }
 
@@ -322,6 +337,13 @@ public:
     // 派生クラスでオーバーライドしてNodeType::Xxxを返す
     virtual int nodeTypeForMetrics() const { return 0; }
 
+    // ========================================
+    // ノード種別の判定（RTTIなしで使用可能）
+    // ========================================
+
+    // FilterNodeBase なら自身を返す（連続したフィルタノードの融合で上流を判定する）
+    virtual const FilterNodeBase* asFilterNode() const { return nullptr; }
+
     // ========================================
     // 範囲判定（最適化用）
     // ========================================
@@ -338,6 +360,21 @@ public:
         return DataRange{0, 0};  // 上流なしはデータなし
     }
 
+    // このノードがrequestに対して提供できるデータ範囲をセグメントリストで取得
+    // segments: 出力先（maxCount要素以上）、startX順・互いに素な区間を格納
+    // 戻り値: セグメント数（0=データなし）
+    // デフォルト: getDataRange() の単一区間
+    // 派生クラス: 離れた複数の領域を持つノード（CompositeNode等）と
+    //             範囲を変更しないパススルーノードがオーバーライド
+    virtual int_fast16_t getDataSegments(const RenderRequest& request,
+                                         DataRange* segments, int_fast16_t maxCount) const {
+        if (maxCount <= 0) return 0;
+        DataRange range = getDataRange(request);
+        if (!range.hasData()) return 0;
+        segments[0] = range;
+        return 1;
+    }
+
     // このノードの出力データ範囲の上限（AABB由来）を取得
     // 全スキャンラインに共通する最大範囲を返す（バッファサイズ見積もり用）
     // Prepare段階で計算済みのAABBを使用するため、計算コストはほぼゼロ
@@ -393,7 +430,8 @@ public:
     // ========================================
 
     // RenderResponseのバッファを整理（validSegments処理 + フォーマット変換）
-    // format: 変換先フォーマット（デフォルト: RGBA8_Straight）
+    // validSegments: セグメント外（未初期化）をゼロ埋めし、セグメント情報を解除
+    // format: 変換先フォーマット（デフォルト: RGBA8_Straight、nullptrで変換なし）
     void consolidateIfNeeded(RenderResponse& input,
                              PixelFormatID format = PixelFormatIDs::RGBA8_Straight);
 
@@ -424,6 +462,9 @@ protected:
     // allocator, entryPool 等のパイプラインリソースを統合管理
     RenderContext* context_ = nullptr;
 
+    // パラメータ変更世代（markModified() で加算）
+    uint32_t generation_ = 0;
+
     // ========================================
     // Template Method フック（派生クラスでオーバーライド）
     // ========================================
@@ -631,6 +672,27 @@ void Node::consolidateIfNeeded(RenderResponse& input, PixelFormatID format) {
         return;
     }
 
+    // 有効セグメント外の未初期化領域をゼロ埋め（通常のバッファとして扱えるようにする）
+    if (input.hasSegments()) {
+        ImageBuffer& buf = input.buffer();
+        auto* row = static_cast<uint8_t*>(buf.view().pixelAt(0, 0));
+        const size_t bpp = buf.bytesPerPixel();
+        int_fast16_t x = 0;
+        for (int_fast16_t i = 0; i < input.segmentCount(); ++i) {
+            const DataRange& seg = input.segments()[i];
+            if (seg.startX > x) {
+                std::memset(row + static_cast<size_t>(x) * bpp, 0,
+                            static_cast<size_t>(seg.startX - x) * bpp);
+            }
+            x = seg.endX;
+        }
+        if (x < buf.width()) {
+            std::memset(row + static_cast<size_t>(x) * bpp, 0,
+                        static_cast<size_t>(buf.width() - x) * bpp);
+        }
+        input.setSegments(nullptr, 0);
+    }
+
     // フォーマット変換が必要な場合
     // convertFormat()経由でメトリクス記録を維持
     if (format != nullptr) {
@@ -57,13 +57,32 @@ namespace NodeType {
     constexpr int NinePatch = 12;  // 9patch画像
     // 合成系
     constexpr int Matte = 13;      // マット合成（3入力）
-
-    constexpr int Count = 14;
+    // 変換系
+    constexpr int Perspective = 14; // 射影変換
+    constexpr int Warp = 15;        // メッシュワープ
+    // 特殊ソース系
+    constexpr int SpriteBatch = 16; // スプライト一括描画
+    // 合成系
+    constexpr int Mask = 17;        // マスク適用（画像 + マスク）
+    // キャッシュ系
+    constexpr int Cache = 18;       // サブツリー描画結果キャッシュ
+    constexpr int Shared = 19;      // 共有出力（DAG、スキャンラインメモ化）
+    // フィルタ系
+    constexpr int DropShadow = 20;  // ドロップシャドウ（アルファぼかし + 下敷き合成）
+    constexpr int GaussianBlur = 21;  // ガウシアンブラー（再帰フィルタ）
+    constexpr int FastBlur = 22;      // 縮小ぼかし（縮小 → ボックスブラー → 拡大）
+    constexpr int Blur = 23;          // 2次元ボックスブラー（水平・垂直の融合）
+    constexpr int Convolution = 24;   // 汎用畳み込み（最大7×7の整数カーネル）
+    constexpr int Morphology = 25;    // モルフォロジー（収縮・膨張・オープン・クローズ）
+    constexpr int Median = 26;        // メディアンフィルタ（定数時間ヒストグラム法）
+    constexpr int ColorCurve = 27;    // トーンカーブ（チャンネル別LUT）
+
+    constexpr int Count = 28;
 }
 
 // コンパイル時チェック: 最後のノードタイプ + 1 == Count
 // ノード追加時に Count の更新を忘れるとここでエラーになる
-static_assert(NodeType::Matte + 1 == NodeType::Count,
+static_assert(NodeType::ColorCurve + 1 == NodeType::Count,
               "NodeType::Count must equal last node type + 1. "
               "Also update demo/web/cpp-sync-types.js NODE_TYPES.");
 static_assert(NodeType::VerticalBlur == 11,
@@ -87,6 +106,8 @@ struct NodeMetrics {
     uint32_t maxAllocBytes = 0;   // 一回の最大確保バイト数
     int16_t maxAllocWidth = 0;     // その時の幅
     int16_t maxAllocHeight = 0;    // その時の高さ
+    uint32_t savedBytes = 0;         // 縮小処理により節約した作業メモリ（推定）
+    uint32_t savedPixels = 0;        // 縮小処理により省略した処理ピクセル数（推定）
 
     void reset() {
         *this = NodeMetrics{};
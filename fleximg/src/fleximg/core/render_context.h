@@ -127,13 +127,38 @@ public:
         return fallback;
     }
 
+    /// @brief 共有元Responseを参照するRenderResponseを取得（借用）
+    /// @param source 共有元Response（参照カウントを加算）
+    /// @return RenderResponse参照（返却時に共有元の参照カウントも減算される）
+    /// @note 共有元のバッファは全ての参照が返却されるまで保持される
+    RenderResponse& acquireSharedResponse(RenderResponse& source) {
+        RenderResponse& resp = acquireResponse();
+        retainResponse(source);
+        resp.shareSource = &source;
+        return resp;
+    }
+
+    /// @brief RenderResponseの参照カウントを加算
+    /// @note 参照カウントが残っている間、releaseResponse()はカウント減算のみ行う
+    void retainResponse(RenderResponse& resp) {
+        size_t idx = static_cast<size_t>(&resp - responsePool_);
+        if (idx < MAX_RESPONSES) {
+            ++resp.refCount;
+        }
+    }
+
     /// @brief RenderResponseを返却
     /// @param resp 返却するResponse参照
     /// @note ImageBufferEntryPoolと同様の範囲チェック付き
+    /// @note 参照カウントが残っている場合は減算のみ（バッファは保持）
     void releaseResponse(RenderResponse& resp) {
         // 範囲チェック（プール内のアドレスか確認）
         size_t idx = static_cast<size_t>(&resp - responsePool_);
         if (idx < MAX_RESPONSES) {
+            if (resp.refCount > 0) {
+                --resp.refCount;
+                return;
+            }
 #ifdef FLEXIMG_DEBUG
             if (!resp.inUse) {
                 printf("WARN: releaseResponse called on non-inUse response idx=%d\n",
@@ -144,8 +169,14 @@ public:
 #endif
             }
 #endif
+            RenderResponse* source = resp.shareSource;
+            resp.shareSource = nullptr;
             resp.clear();            // エントリをプールに返却
             resp.inUse = false;      // スロットを再利用可能に
+            // 共有元の参照を返却
+            if (source) {
+                releaseResponse(*source);
+            }
         }
     }
 
@@ -172,11 +203,19 @@ public:
                 responsePool_[i].clear();
                 responsePool_[i].inUse = false;
             }
+            responsePool_[i].refCount = 0;
+            responsePool_[i].shareSource = nullptr;
         }
         nextHint_ = 0;
         segmentOffset_ = 0;
+        ++scanlineEpoch_;
     }
 
+    /// @brief スキャンライン世代（resetScanlineResources()ごとに加算）
+    /// @note 複数スキャンラインにまたがってResponse参照を保持するノードが、
+    ///       参照の有効性（一括解放されていないか）を判定するために使用
+    uint32_t scanlineEpoch() const { return scanlineEpoch_; }
+
     // ========================================
     // エラー管理
     // ========================================
@@ -205,6 +244,8 @@ private:
     static constexpr int SEGMENT_POOL_SIZE = 256;
     DataRange segmentStorage_[SEGMENT_POOL_SIZE];
     int_fast16_t segmentOffset_ = 0;
+
+    uint32_t scanlineEpoch_ = 0;  // スキャンライン世代
 };
 
 } // namespace core
@@ -183,6 +183,101 @@ struct AffineMatrix {
     }
 };
 
+// ========================================================================
+// PerspectiveMatrix - 射影変換行列（ホモグラフィ）
+// ========================================================================
+//
+// 3x3 の射影変換行列。最下行 (g, h, i) が (0, 0, 1) のときアフィン変換と一致する。
+// 擬似3D表現（カードフリップ、床面）用に PerspectiveNode から SourceNode へ伝播する。
+//
+//   | a  b  tx |   | x |
+//   | c  d  ty | * | y |  →  (x'/w', y'/w')
+//   | g  h  i  |   | 1 |
+//
+
+struct PerspectiveMatrix {
+    float a = 1, b = 0, tx = 0;
+    float c = 0, d = 1, ty = 0;
+    float g = 0, h = 0, i = 1;
+
+    PerspectiveMatrix() = default;
+    PerspectiveMatrix(float a_, float b_, float tx_,
+                      float c_, float d_, float ty_,
+                      float g_, float h_, float i_)
+        : a(a_), b(b_), tx(tx_), c(c_), d(d_), ty(ty_), g(g_), h(h_), i(i_) {}
+
+    // アフィン行列から変換（最下行は (0, 0, 1)）
+    explicit PerspectiveMatrix(const AffineMatrix& m)
+        : a(m.a), b(m.b), tx(m.tx), c(m.c), d(m.d), ty(m.ty) {}
+
+    // 単位行列
+    static PerspectiveMatrix identity() { return PerspectiveMatrix(); }
+
+    // 単位正方形 (0,0)-(1,1) を四角形 (x0,y0)→(x1,y1)→(x2,y2)→(x3,y3) に写す行列
+    // 頂点順: 左上、右上、右下、左下（Heckbert方式）
+    static PerspectiveMatrix squareToQuad(float x0, float y0, float x1, float y1,
+                                          float x2, float y2, float x3, float y3);
+
+    // 行列の乗算（合成）: this * other
+    PerspectiveMatrix operator*(const PerspectiveMatrix& o) const {
+        return PerspectiveMatrix(
+            a * o.a + b * o.c + tx * o.g,
+            a * o.b + b * o.d + tx * o.h,
+            a * o.tx + b * o.ty + tx * o.i,
+            c * o.a + d * o.c + ty * o.g,
+            c * o.b + d * o.d + ty * o.h,
+            c * o.tx + d * o.ty + ty * o.i,
+            g * o.a + h * o.c + i * o.g,
+            g * o.b + h * o.d + i * o.h,
+            g * o.tx + h * o.ty + i * o.i
+        );
+    }
+
+    PerspectiveMatrix operator*(const AffineMatrix& o) const {
+        return *this * PerspectiveMatrix(o);
+    }
+
+    // 逆行列（余因子展開）
+    // 特異行列の場合は false を返し、out は変更しない
+    bool inverse(PerspectiveMatrix& out) const {
+        const float c00 = d * i - ty * h;
+        const float c01 = ty * g - c * i;
+        const float c02 = c * h - d * g;
+        const float det = a * c00 + b * c01 + tx * c02;
+        if (std::abs(det) < 1e-10f) return false;
+        const float invDet = 1.0f / det;
+        out = PerspectiveMatrix(
+            c00 * invDet, (tx * h - b * i) * invDet, (b * ty - tx * d) * invDet,
+            c01 * invDet, (a * i - tx * g) * invDet, (tx * c - a * ty) * invDet,
+            c02 * invDet, (b * g - a * h) * invDet, (a * d - b * c) * invDet
+        );
+        return true;
+    }
+};
+
+inline PerspectiveMatrix PerspectiveMatrix::squareToQuad(
+    float x0, float y0, float x1, float y1,
+    float x2, float y2, float x3, float y3)
+{
+    const float sx = x0 - x1 + x2 - x3;
+    const float sy = y0 - y1 + y2 - y3;
+    if (std::abs(sx) < 1e-10f && std::abs(sy) < 1e-10f) {
+        // 平行四辺形: アフィン変換で表現可能
+        return PerspectiveMatrix(x1 - x0, x3 - x0, x0,
+                                 y1 - y0, y3 - y0, y0,
+                                 0, 0, 1);
+    }
+    const float dx1 = x1 - x2, dx2 = x3 - x2;
+    const float dy1 = y1 - y2, dy2 = y3 - y2;
+    const float det = dx1 * dy2 - dx2 * dy1;
+    if (std::abs(det) < 1e-10f) return PerspectiveMatrix();
+    const float g = (sx * dy2 - dx2 * sy) / det;
+    const float h = (dx1 * sy - sx * dy1) / det;
+    return PerspectiveMatrix(x1 - x0 + g * x1, x3 - x0 + h * x3, x0,
+                             y1 - y0 + g * y1, y3 - y0 + h * y3, y0,
+                             g, h, 1);
+}
+
 // ========================================================================
 // 行列変換関数
 // ========================================================================
@@ -294,6 +389,7 @@ using core::fixed_to_float;
 using core::mul_fixed;
 using core::div_fixed;
 using core::AffineMatrix;
+using core::PerspectiveMatrix;
 using core::toFixed;
 using core::inverseFixed;
 using core::AffinePrecomputed;
@@ -0,0 +1,244 @@
+#ifndef FLEXIMG_WARP_MESH_H
+#define FLEXIMG_WARP_MESH_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include "common.h"
+#include "types.h"
+#include "../operations/transform.h"
+
+namespace FLEXIMG_NAMESPACE {
+namespace core {
+
+// ========================================================================
+// WarpMesh - ワープ用の制御点格子
+// ========================================================================
+//
+// 出力側の矩形領域を cols x rows の等間隔セルに分割し、各格子点に
+// 「その位置でサンプリングする上流側の座標」を持たせます。
+// セル内部は4つの制御点の双線形補間で写像します。
+//
+// 双線形補間はセル内の水平線上で x の1次式になるため、
+// セルを跨がないスパン内では線形DDAで正確に補間できます。
+//
+// 制御点の初期値は格子点自身の座標（恒等写像）です。
+// 格子の外側は写像が定義されず、出力は透明（データなし）になります。
+//
+
+class WarpMesh {
+public:
+    WarpMesh() = default;
+
+    // 格子を設定し、制御点を恒等写像で初期化
+    // (x, y): 格子左上の座標、cellWidth/cellHeight: セルサイズ（正の値）
+    void setGrid(int_fast16_t cols, int_fast16_t rows,
+                 float x, float y, float cellWidth, float cellHeight) {
+        if (cols <= 0 || rows <= 0 || !(cellWidth > 0.0f) || !(cellHeight > 0.0f)) {
+            cols_ = rows_ = 0;
+            points_.clear();
+            return;
+        }
+        cols_ = static_cast<int16_t>(cols);
+        rows_ = static_cast<int16_t>(rows);
+        x_ = x;
+        y_ = y;
+        cellW_ = cellWidth;
+        cellH_ = cellHeight;
+        points_.assign(static_cast<size_t>((cols + 1) * (rows + 1) * 2), 0.0f);
+        for (int_fast16_t r = 0; r <= rows; ++r) {
+            for (int_fast16_t c = 0; c <= cols; ++c) {
+                setPoint(c, r, gridX(c), gridY(r));
+            }
+        }
+    }
+
+    // 制御点を設定（上流側でサンプリングする座標）
+    void setPoint(int_fast16_t col, int_fast16_t row, float srcX, float srcY) {
+        if (col < 0 || col > cols_ || row < 0 || row > rows_) return;
+        float* p = &points_[pointIndex(col, row)];
+        p[0] = srcX;
+        p[1] = srcY;
+    }
+
+    // 制御点を格子点からの変位で設定
+    void setDisplacement(int_fast16_t col, int_fast16_t row, float dx, float dy) {
+        setPoint(col, row, gridX(col) + dx, gridY(row) + dy);
+    }
+
+    float pointX(int_fast16_t col, int_fast16_t row) const { return points_[pointIndex(col, row)]; }
+    float pointY(int_fast16_t col, int_fast16_t row) const { return points_[pointIndex(col, row) + 1]; }
+
+    // 格子点の座標
+    float gridX(int_fast16_t col) const { return x_ + cellW_ * static_cast<float>(col); }
+    float gridY(int_fast16_t row) const { return y_ + cellH_ * static_cast<float>(row); }
+
+    int_fast16_t cols() const { return cols_; }
+    int_fast16_t rows() const { return rows_; }
+    float cellWidth() const { return cellW_; }
+    float cellHeight() const { return cellH_; }
+    bool isValid() const { return cols_ > 0 && rows_ > 0; }
+
+    // 格子の外接矩形（right/bottom は含まない）
+    float left() const { return x_; }
+    float top() const { return y_; }
+    float right() const { return gridX(cols_); }
+    float bottom() const { return gridY(rows_); }
+
+    // 格子内の点 (x, y) を制御点の双線形補間で写像
+    // 戻り値: false=格子外
+    bool map(float x, float y, float& outX, float& outY) const {
+        if (!isValid()) return false;
+        const float fx = (x - x_) / cellW_;
+        const float fy = (y - y_) / cellH_;
+        if (!(fx >= 0.0f && fy >= 0.0f
+              && fx <= static_cast<float>(cols_) && fy <= static_cast<float>(rows_))) {
+            return false;
+        }
+        // 右端・下端はそれぞれ最後のセルに含める
+        const auto col = std::min<int_fast16_t>(static_cast<int_fast16_t>(fx), cols_ - 1);
+        const auto row = std::min<int_fast16_t>(static_cast<int_fast16_t>(fy), rows_ - 1);
+        const float tx = fx - static_cast<float>(col);
+        const float ty = fy - static_cast<float>(row);
+
+        const float* p00 = &points_[pointIndex(col, row)];
+        const float* p10 = p00 + 2;
+        const float* p01 = &points_[pointIndex(col, row + 1)];
+        const float* p11 = p01 + 2;
+        const float topX = p00[0] + (p10[0] - p00[0]) * tx;
+        const float topY = p00[1] + (p10[1] - p00[1]) * tx;
+        const float botX = p01[0] + (p11[0] - p01[0]) * tx;
+        const float botY = p01[1] + (p11[1] - p01[1]) * tx;
+        outX = topX + (botX - topX) * ty;
+        outY = topY + (botY - topY) * ty;
+        return true;
+    }
+
+private:
+    std::vector<float> points_;  // 制御点 (x, y) を行優先で格納
+    float x_ = 0, y_ = 0;
+    float cellW_ = 1, cellH_ = 1;
+    int16_t cols_ = 0;
+    int16_t rows_ = 0;
+
+    size_t pointIndex(int_fast16_t col, int_fast16_t row) const {
+        return static_cast<size_t>((row * (cols_ + 1) + col) * 2);
+    }
+};
+
+// ========================================================================
+// WarpField - パイプライン上に配置されたワープの写像
+// ========================================================================
+//
+// WarpNodeがPrepare時に構築し、PrepareRequest::warp 経由でSourceNodeへ伝播します。
+// ワールド座標（出力ピクセル中心）→ WarpNode出力座標 → メッシュ写像 の順に
+// 変換し、WarpNode上流側の座標系での位置を返します。
+//
+// - view: ワールド座標 → WarpNode出力座標（下流側の射影/アフィンの逆行列）
+// - outer: 下流側にさらにWarpNodeがある場合、その写像を先に適用する
+//
+
+struct WarpField {
+    const WarpMesh* mesh = nullptr;
+    PerspectiveMatrix view;        // ワールド座標 → メッシュ座標
+    PerspectiveMatrix forward;     // メッシュ座標 → ワールド座標（AABB算出用）
+    const WarpField* outer = nullptr;
+    bool valid = false;            // view が有効か（下流行列が特異でないか）
+
+    // ワールド座標の点を上流側座標へ写像
+    // 戻り値: false=写像が定義されない（格子外、視点の背後など）
+    bool map(float x, float y, float& outX, float& outY) const {
+        if (!valid || !mesh) return false;
+        if (outer && !outer->map(x, y, x, y)) return false;
+        const float w = view.g * x + view.h * y + view.i;
+        if (w <= 1e-6f) return false;
+        const float invW = 1.0f / w;
+        return mesh->map((view.a * x + view.b * y + view.tx) * invW,
+                         (view.c * x + view.d * y + view.ty) * invW, outX, outY);
+    }
+
+    // スキャンライン上でメッシュが定義される出力ピクセル範囲
+    // x0: dx=0 のピクセル中心X、y: ピクセル中心Y、width: リクエスト幅
+    // 多段接続時は下流側ワープの範囲を上限とする（保守的な範囲）
+    bool scanlineRange(float x0, float y, int32_t width,
+                       int32_t& dxStart, int32_t& dxEnd) const {
+        if (!valid || !mesh || !mesh->isValid()) return false;
+        if (outer) return outer->scanlineRange(x0, y, width, dxStart, dxEnd);
+
+        // メッシュ座標 (u/w, v/w) は dx の1次式の比なので、
+        // 「w > 0 かつ left <= u/w < right かつ top <= v/w < bottom」は
+        // w を掛けた1次不等式5本に帰着する
+        const PerspectiveMatrix& m = view;
+        const float uq = m.a * x0 + m.b * y + m.tx;
+        const float vq = m.c * x0 + m.d * y + m.ty;
+        const float wq = m.g * x0 + m.h * y + m.i;
+        const float left = mesh->left(), right = mesh->right();
+        const float top = mesh->top(), bottom = mesh->bottom();
+
+        float lo = 0.0f;
+        float hi = static_cast<float>(width - 1);
+        using transform::clipLinearRange;
+        clipLinearRange(m.g, wq, true, lo, hi);                                    // w > 0
+        clipLinearRange(m.a - left * m.g, uq - left * wq, false, lo, hi);          // u >= left * w
+        clipLinearRange(right * m.g - m.a, right * wq - uq, true, lo, hi);         // u < right * w
+        clipLinearRange(m.c - top * m.g, vq - top * wq, false, lo, hi);            // v >= top * w
+        clipLinearRange(bottom * m.g - m.c, bottom * wq - vq, true, lo, hi);       // v < bottom * w
+        if (lo > hi) return false;
+        dxStart = static_cast<int32_t>(lo);
+        dxEnd = static_cast<int32_t>(hi);
+        return true;
+    }
+
+    // ワールド座標X=px のピクセル中心から右方向に、同一セル内に収まるピクセル数
+    // セル内の水平線上では写像が x の1次式になるため、この長さで区切れば
+    // スパン両端の評価値による線形補間が正確になる
+    // 軸平行でない（回転・射影・多段ワープ）場合はセル境界を求めず maxLen を返す
+    int32_t cellRun(float px, int32_t maxLen) const {
+        if (outer || !mesh || view.b != 0.0f || view.c != 0.0f
+            || view.g != 0.0f || view.h != 0.0f || view.a == 0.0f || view.i == 0.0f) {
+            return maxLen;
+        }
+        const float cellW = mesh->cellWidth();
+        const float mx = (view.a * px + view.tx) / view.i;
+        const float cell = (mx - mesh->left()) / cellW;
+        // 進行方向で次に跨ぐ格子線（メッシュ座標）とそのワールド座標
+        const bool increasing = (view.a > 0.0f) == (view.i > 0.0f);
+        const float line = mesh->left() + cellW * (increasing ? std::floor(cell) + 1.0f
+                                                              : std::floor(cell));
+        const float xb = (line * view.i - view.tx) / view.a;
+        const float run = increasing ? std::ceil(xb - px) : std::floor(xb - px) + 1.0f;
+        if (!(run < static_cast<float>(maxLen))) return maxLen;
+        return std::max<int32_t>(1, static_cast<int32_t>(run));
+    }
+
+    // メッシュ外接矩形のワールド座標でのAABB
+    // 戻り値: false=有界でない（頂点が視点の背後にある等）
+    bool bounds(float& minX, float& minY, float& maxX, float& maxY) const {
+        if (!valid || !mesh || !mesh->isValid()) return false;
+        if (outer) return outer->bounds(minX, minY, maxX, maxY);
+        const float cornersX[4] = {mesh->left(), mesh->right(), mesh->right(), mesh->left()};
+        const float cornersY[4] = {mesh->top(), mesh->top(), mesh->bottom(), mesh->bottom()};
+        minX = minY = INFINITY;
+        maxX = maxY = -INFINITY;
+        for (int_fast8_t k = 0; k < 4; ++k) {
+            const float x = cornersX[k], y = cornersY[k];
+            const float w = forward.g * x + forward.h * y + forward.i;
+            if (w <= 1e-6f) return false;
+            const float px = (forward.a * x + forward.b * y + forward.tx) / w;
+            const float py = (forward.c * x + forward.d * y + forward.ty) / w;
+            minX = std::min(minX, px); maxX = std::max(maxX, px);
+            minY = std::min(minY, py); maxY = std::max(maxY, py);
+        }
+        return true;
+    }
+};
+
+} // namespace core
+
+using core::WarpMesh;
+using core::WarpField;
+
+} // namespace FLEXIMG_NAMESPACE
+
+#endif // FLEXIMG_WARP_MESH_H
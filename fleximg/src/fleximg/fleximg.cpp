@@ -28,6 +28,7 @@
 // =============================================================================
 // Operations
 // =============================================================================
+#include "operations/blend_modes.h"
 #include "operations/filters.h"
 
 // =============================================================================
@@ -35,12 +36,26 @@
 // =============================================================================
 #include "nodes/vertical_blur_node.h"
 #include "nodes/matte_node.h"
+#include "nodes/mask_node.h"
+#include "nodes/cache_node.h"
+#include "nodes/shared_node.h"
+#include "nodes/drop_shadow_node.h"
+#include "nodes/gaussian_blur_node.h"
+#include "nodes/fast_blur_node.h"
+#include "nodes/blur_node.h"
+#include "nodes/convolution_node.h"
+#include "nodes/morphology_node.h"
+#include "nodes/median_node.h"
+#include "nodes/color_curve_node.h"
 #include "nodes/source_node.h"
 #include "nodes/ninepatch_source_node.h"
+#include "nodes/sprite_batch_node.h"
 #include "nodes/composite_node.h"
 #include "nodes/horizontal_blur_node.h"
 #include "nodes/renderer_node.h"
 #include "nodes/sink_node.h"
 #include "nodes/filter_node_base.h"
 #include "nodes/affine_node.h"
+#include "nodes/perspective_node.h"
+#include "nodes/warp_node.h"
 #include "nodes/distributor_node.h"
@@ -22,6 +22,64 @@ struct DataRange {
     int16_t width() const { return (startX < endX) ? (endX - startX) : 0; }
 };
 
+// ========================================================================
+// セグメントリスト（複数のDataRange）
+// ========================================================================
+//
+// Node::getDataSegments() が返す、startX順・互いに素なDataRangeの列。
+// 離れた位置にある複数の領域（画面両端のスプライト等）を
+// 1つの和集合区間にまとめずに扱うために使用。
+//
+
+// getDataSegments の最大セグメント数
+constexpr int_fast16_t MAX_DATA_SEGMENTS = 8;
+
+// セグメント配列を正規化（startX順に整列し、重なり・近接区間を結合）
+// - 空区間は除去
+// - 隙間が minGap 以下の隣接区間は結合
+// - 結合後も maxCount を超える場合は、隙間の小さい箇所から順に結合
+// 戻り値: 正規化後のセグメント数
+inline int_fast16_t normalizeDataSegments(DataRange* segments, int_fast16_t count,
+                                          int_fast16_t maxCount, int_fast16_t minGap) {
+    int_fast16_t n = 0;
+    for (int_fast16_t i = 0; i < count; ++i) {
+        if (segments[i].hasData()) segments[n++] = segments[i];
+    }
+    // 挿入ソート（要素数は小さい）
+    for (int_fast16_t i = 1; i < n; ++i) {
+        const DataRange key = segments[i];
+        int_fast16_t j = i - 1;
+        while (j >= 0 && segments[j].startX > key.startX) {
+            segments[j + 1] = segments[j];
+            --j;
+        }
+        segments[j + 1] = key;
+    }
+    int_fast16_t m = 0;
+    for (int_fast16_t i = 0; i < n; ++i) {
+        if (m > 0 && segments[i].startX - segments[m - 1].endX <= minGap) {
+            if (segments[i].endX > segments[m - 1].endX) segments[m - 1].endX = segments[i].endX;
+        } else {
+            segments[m++] = segments[i];
+        }
+    }
+    while (m > maxCount && m > 1) {
+        int_fast16_t best = 0;
+        for (int_fast16_t i = 1; i + 1 < m; ++i) {
+            if (segments[i + 1].startX - segments[i].endX
+                < segments[best + 1].startX - segments[best].endX) {
+                best = i;
+            }
+        }
+        segments[best].endX = segments[best + 1].endX;
+        for (int_fast16_t i = best + 1; i + 1 < m; ++i) {
+            segments[i] = segments[i + 1];
+        }
+        --m;
+    }
+    return m;
+}
+
 } // namespace FLEXIMG_NAMESPACE
 
 #endif // FLEXIMG_DATA_RANGE_H
@@ -365,8 +365,10 @@ public:
 
     /// @brief ソースバッファのデータを自身にunder合成
     /// @param src ソースバッファ（ワールド座標origin設定済み）
+    /// @param clipStartX, clipEndX 合成するX範囲（startX()と同じ座標系、省略時は全体）
     /// @return 成功時true
-    bool blendFrom(const ImageBuffer& src);
+    bool blendFrom(const ImageBuffer& src,
+                   int_fast16_t clipStartX = INT16_MIN, int_fast16_t clipEndX = INT16_MAX);
 
 private:
     ViewPort view_;           // コンポジション: 画像データへのビュー
@@ -450,7 +452,8 @@ private:
 // ImageBuffer::blendFrom() 実装
 // ========================================================================
 
-inline bool ImageBuffer::blendFrom(const ImageBuffer& src) {
+inline bool ImageBuffer::blendFrom(const ImageBuffer& src,
+                                   int_fast16_t clipStartX, int_fast16_t clipEndX) {
     if (!isValid() || !src.isValid() || !view_.data) return false;
 
     const auto& srcView = src.viewRef();
@@ -458,8 +461,9 @@ inline bool ImageBuffer::blendFrom(const ImageBuffer& src) {
     const int_fast16_t srcStartX = src.startX();
 
     // クリッピング: srcのうちdstバッファ範囲内にある部分
-    const int_fast16_t clippedStart = std::max(srcStartX, dstStartX);
-    const int_fast16_t clippedEnd = std::min(src.endX(), endX());
+    const int_fast16_t clippedStart = std::max({srcStartX, dstStartX, clipStartX});
+    const int_fast16_t clippedEnd = std::min({static_cast<int_fast16_t>(src.endX()),
+                                              static_cast<int_fast16_t>(endX()), clipEndX});
     int_fast16_t remaining = static_cast<int_fast16_t>(clippedEnd - clippedStart);
     if (remaining <= 0) return true;  // 範囲外、何もしない
 
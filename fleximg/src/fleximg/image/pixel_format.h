@@ -401,6 +401,13 @@ inline const char* getFormatName(PixelFormatID formatID) {
     return formatID ? formatID->name : "unknown";
 }
 
+// 1バイト1チャンネルの非インデックスフォーマットか（Alpha8 / Grayscale8）
+// フィルタノードの単一チャンネル処理パスの選択に使用
+inline bool isSingleChannel8(PixelFormatID formatID) {
+    return formatID && formatID->bitsPerPixel == 8 && formatID->channelCount == 1
+        && !formatID->isIndexed;
+}
+
 // ========================================================================
 // FormatConverter: 変換パスの事前解決
 // ========================================================================
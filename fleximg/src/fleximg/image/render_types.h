@@ -14,8 +14,9 @@
 // 前方宣言（循環参照回避）
 namespace FLEXIMG_NAMESPACE {
 class ImageBufferEntryPool;
-namespace core { class RenderContext; }
+namespace core { class RenderContext; struct WarpField; }
 using core::RenderContext;
+using core::WarpField;
 }
 
 #include "image_buffer_entry_pool.h"
@@ -101,6 +102,19 @@ struct PrepareRequest {
     AffineMatrix affineMatrix;
     bool hasAffine = false;
 
+    // プル型射影変換（PerspectiveNode→Source で実行）
+    // 合成順序: perspectiveMatrix * affineMatrix * (Sourceのローカル行列)
+    // PerspectiveNodeは下流側のaffineMatrixを自身に取り込んでからリセットするため、
+    // 上流側のAffineNodeは従来通りaffineMatrixへ累積すればよい
+    PerspectiveMatrix perspectiveMatrix;
+    bool hasPerspective = false;
+
+    // プル型ワープ（WarpNode→Source で実行、非所有）
+    // ワールド座標をWarpNode上流側の座標へ写像する。WarpNodeは下流側の
+    // 射影/アフィンを自身のWarpFieldに取り込んでからリセットするため、
+    // 上流側の行列は「ワープ後の座標 → Sourceのローカル座標」として累積される
+    const WarpField* warp = nullptr;
+
     // プッシュ型アフィン（下流→Sink で実行）
     AffineMatrix pushAffineMatrix;
     bool hasPushAffine = false;
@@ -319,6 +333,8 @@ inline void calcInverseAffineAABB(
 struct RenderResponse {
     Point origin;              // バッファ左上のワールド座標（固定小数点 Q16.16）
     bool inUse = false;        // プール管理用：使用中フラグ
+    uint8_t refCount = 0;      // プール管理用：追加参照数（RenderContext::retainResponse）
+    RenderResponse* shareSource = nullptr;  // プール管理用：共有元Response（参照中のみ）
 
     // デフォルトコンストラクタ
     RenderResponse() = default;
@@ -352,6 +368,24 @@ struct RenderResponse {
     /// @brief バッファ数を取得（常に 0 or 1）
     int bufferCount() const { return entry_ ? 1 : 0; }
 
+    // ========================================
+    // 有効セグメント（疎なバッファ）
+    // ========================================
+    //
+    // 設定時、バッファのうちセグメント内（バッファ左端基準のX範囲）のみが有効で、
+    // セグメント外のピクセルは未初期化。セグメント配列はRenderContextの
+    // セグメントプール（スキャンラインスコープ）から借用する。
+    // 対応していない消費側は Node::consolidateIfNeeded() でゼロ埋めして使用する。
+    //
+
+    bool hasSegments() const { return segmentCount_ > 0; }
+    const DataRange* segments() const { return segments_; }
+    int_fast16_t segmentCount() const { return segmentCount_; }
+    void setSegments(const DataRange* segs, int_fast16_t count) {
+        segments_ = segs;
+        segmentCount_ = segs ? count : 0;
+    }
+
     // ========================================
     // バッファアクセス
     // ========================================
@@ -446,12 +480,16 @@ private:
     ImageBufferEntryPool::Entry* entry_ = nullptr;
     ImageBufferEntryPool* pool_ = nullptr;
     core::memory::IAllocator* allocator_ = nullptr;
+    const DataRange* segments_ = nullptr;
+    int_fast16_t segmentCount_ = 0;
 
     void releaseEntry() {
         if (entry_ && pool_) {
             pool_->release(entry_);
         }
         entry_ = nullptr;
+        segments_ = nullptr;
+        segmentCount_ = 0;
     }
 };
 
@@ -41,6 +41,14 @@ public:
     // ========================================
 
     const char* name() const override { return "AffineNode"; }
+    uint32_t generation() const override { return Node::generation() + matrixGeneration(); }
+
+    // getDataSegments: 上流パススルー（範囲は上流のSourceNodeが変換込みで算出）
+    int_fast16_t getDataSegments(const RenderRequest& request,
+                                 DataRange* segments, int_fast16_t maxCount) const override {
+        Node* upstream = upstreamNode(0);
+        return upstream ? upstream->getDataSegments(request, segments, maxCount) : 0;
+    }
 
 protected:
     // ========================================
@@ -26,7 +26,7 @@ public:
     // パラメータ設定
     // ========================================
 
-    void setScale(float scale) { params_.value1 = scale; }
+    void setScale(float scale) { params_.value1 = scale; markModified(); }
     float scale() const { return params_.value1; }
 
     // ========================================
@@ -0,0 +1,726 @@
+#ifndef FLEXIMG_BLUR_NODE_H
+#define FLEXIMG_BLUR_NODE_H
+
+#include "../core/node.h"
+#include "../core/perf_metrics.h"
+#include "../core/render_context.h"
+#include "../image/image_buffer.h"
+#include "vertical_blur_node.h"
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace FLEXIMG_NAMESPACE {
+
+// ========================================================================
+// BlurNode - 2次元ボックスブラーノード（水平・垂直の融合）
+// ========================================================================
+//
+// HorizontalBlurNode >> VerticalBlurNode の組と同じ結果を1ノードで計算します。
+// - 入力: 1ポート
+// - 出力: 1ポート（RGBA8_Straight、上流が Alpha8 / Grayscale8 なら同じフォーマット）
+// - radiusX / radiusY: 水平・垂直のブラー半径（0-127、個別に設定可能）
+// - passes: ボックスブラー適用回数（1-3、水平・垂直共通）
+//
+// 処理方式（スキャンライン）:
+// - 垂直方向は VerticalBlurNode と同じ行リング + 列合計のパイプライン
+// - 上流の行は水平ブラーを適用しながら垂直ステージ0の行リングへ直接書き込む
+//   （中間パスは再利用する行バッファ、行ごとの ImageBuffer / RenderResponse の
+//    受け渡しとフォーマット変換・コピーが発生しない）
+// - 水平の各パスの量子化・範囲外の扱い・DataRange は HorizontalBlurNode と同一
+//   （除算は列合計の出力と同じ resolveRow で1行まとめて行う。結果は一致）
+//
+// 特殊ケース:
+// - radiusX = radiusY = 0: パススルー
+// - radiusY = 0: HorizontalBlurNode と同じ出力（行リングなし）
+// - radiusX = 0: VerticalBlurNode と同じ出力
+//
+// 制約:
+// - pull型のみ対応
+//
+// 使用例:
+//   BlurNode blur;
+//   blur.setRadius(8, 4);  // 水平8、垂直4
+//   blur.setPasses(3);     // ガウシアン近似
+//   src >> blur >> sink;
+//
+
+class BlurNode : public Node {
+public:
+    BlurNode() {
+        initPorts(1, 1);
+    }
+
+    // ========================================
+    // パラメータ設定
+    // ========================================
+
+    // パラメータ上限（HorizontalBlurNode / VerticalBlurNode と同じ）
+    static constexpr int kMaxRadius = 127;
+    static constexpr int kMaxPasses = 3;
+
+    // 水平・垂直に同じ半径を設定
+    void setRadius(int_fast16_t radius) {
+        setRadius(radius, radius);
+    }
+
+    void setRadius(int_fast16_t radiusX, int_fast16_t radiusY) {
+        radiusX_ = clampRadius(radiusX);
+        radiusY_ = clampRadius(radiusY);
+        markModified();
+    }
+
+    void setRadiusX(int_fast16_t radius) {
+        radiusX_ = clampRadius(radius);
+        markModified();
+    }
+
+    void setRadiusY(int_fast16_t radius) {
+        radiusY_ = clampRadius(radius);
+        markModified();
+    }
+
+    void setPasses(int_fast16_t passes) {
+        passes_ = static_cast<int16_t>((passes < 1) ? 1 : (passes > kMaxPasses) ? kMaxPasses : passes);
+        markModified();
+    }
+
+    int16_t radiusX() const { return radiusX_; }
+    int16_t radiusY() const { return radiusY_; }
+    int16_t passes() const { return passes_; }
+    int_fast16_t kernelSizeX() const { return radiusX_ * 2 + 1; }
+    int_fast16_t kernelSizeY() const { return radiusY_ * 2 + 1; }
+
+    // ========================================
+    // Node インターフェース
+    // ========================================
+
+    const char* name() const override { return "BlurNode"; }
+
+    // getDataRange: 水平は上流範囲の拡張、垂直は上下 radiusY*passes 行の和集合
+    DataRange getDataRange(const RenderRequest& request) const override;
+
+    void finalize() override;
+
+protected:
+    int nodeTypeForMetrics() const override { return NodeType::Blur; }
+
+    PrepareResponse onPullPrepare(const PrepareRequest& request) override;
+    RenderResponse& onPullProcess(const RenderRequest& request) override;
+
+private:
+    int16_t radiusX_ = 5;
+    int16_t radiusY_ = 5;
+    int16_t passes_ = 1;  // 1-3の範囲、デフォルト1
+
+    static int16_t clampRadius(int_fast16_t radius) {
+        return static_cast<int16_t>((radius < 0) ? 0 : (radius > kMaxRadius) ? kMaxRadius : radius);
+    }
+
+    int_fast16_t marginX() const { return radiusX_ * passes_; }
+    int_fast16_t marginY() const { return radiusY_ * passes_; }
+
+    // 垂直パイプラインステージ（VerticalBlurNode::BlurStage と同じ構成）
+    struct BlurStage {
+        ImageBuffer rows;                    // 行リング（radiusY*2+1 行 × キャッシュ幅）
+        std::vector<DataRange> rowDataRange; // 各キャッシュ行の格納範囲（範囲外は0として扱う）
+        std::vector<uint32_t> colSum;        // 列合計（RGBA8: [R×A, G×A, B×A, A]、1ch: 値の合計）
+        int32_t currentY = 0;
+        bool cacheReady = false;
+
+        uint8_t* row(int_fast16_t slot) {
+            return static_cast<uint8_t*>(rows.view().pixelAt(0, static_cast<int>(slot)));
+        }
+        const uint8_t* row(int_fast16_t slot) const {
+            return static_cast<const uint8_t*>(rows.view().pixelAt(0, static_cast<int>(slot)));
+        }
+
+        DataRange storedExtent() const {
+            DataRange extent{INT16_MAX, 0};
+            for (const DataRange& r : rowDataRange) {
+                if (!r.hasData()) continue;
+                extent.startX = std::min(extent.startX, r.startX);
+                extent.endX = std::max(extent.endX, r.endX);
+            }
+            return extent.hasData() ? extent : DataRange{};
+        }
+    };
+
+    std::vector<BlurStage> stages_;
+    PixelFormatID channelFormat_ = nullptr;  // 単一チャンネルパスのフォーマット（nullptr = RGBA8）
+    int16_t cacheWidth_ = 0;
+    int_fixed cacheOriginX_ = 0;
+    std::vector<uint8_t> passLines_[2];      // 水平の中間パス用の行バッファ（再利用）
+    std::vector<uint32_t> lineSums_;         // 水平ウィンドウ合計（RGBA8パス、再利用）
+
+    // getDataRange/pullProcess 間のキャッシュ
+    struct DataRangeCache {
+        Point origin = {INT32_MIN, INT32_MIN};
+        int16_t startX = 0;
+        int16_t endX = 0;
+    };
+    mutable DataRangeCache rangeCache_;
+
+    // getDataRange のスライディングウィンドウ（VerticalBlurNode と同じ単調デック方式）
+    struct RowQueue {
+        std::vector<int32_t> rows;
+        size_t head = 0;
+        size_t count = 0;
+
+        void reset(size_t capacity) { rows.assign(capacity, 0); head = 0; count = 0; }
+        bool empty() const { return count == 0; }
+        int32_t front() const { return rows[head]; }
+        int32_t back() const { return rows[(head + count - 1) % rows.size()]; }
+        void popFront() { head = (head + 1) % rows.size(); --count; }
+        void popBack() { --count; }
+        void pushBack(int32_t row) { rows[(head + count) % rows.size()] = row; ++count; }
+    };
+    struct RangeWindow {
+        std::vector<DataRange> history;
+        RowQueue minStart;
+        RowQueue maxEnd;
+        Point origin = {INT32_MIN, INT32_MIN};
+        int16_t width = 0;
+        bool valid = false;
+
+        size_t slot(int32_t row) const {
+            const auto n = static_cast<int32_t>(history.size());
+            const int32_t m = row % n;
+            return static_cast<size_t>(m < 0 ? m + n : m);
+        }
+    };
+    mutable RangeWindow rangeWindow_;
+
+    PixelFormatID workFormat() const { return channelFormat_ ? channelFormat_ : PixelFormatIDs::RGBA8_Straight; }
+    size_t bytesPerPixel() const { return channelFormat_ ? 1 : 4; }
+
+    // 水平ブラー後の1行のデータ範囲（HorizontalBlurNode::getDataRange と同じ）
+    DataRange horizontalRange(const RenderRequest& request) const;
+    // 水平ブラー後の1行を dst に書き込む（dst はリクエスト座標 dstStartX に対応）
+    // 戻り値: 書き込んだ範囲（リクエスト座標、[dstStartX, dstEndX) 内）
+    DataRange blurRowInto(const RenderRequest& request, uint8_t* dst,
+                          int_fast16_t dstStartX, int_fast16_t dstEndX);
+    void pushRangeRow(const RenderRequest& request, int_fast16_t dy) const;
+
+    void initializeStages(int_fast16_t width);
+    void updateStageCache(int_fast16_t stageIndex, int_fast16_t newY);
+    void fetchSourceRow(BlurStage& stage, int_fast16_t srcY, int_fast16_t cacheIndex);
+    void storeStageOutputRow(const BlurStage& prevStage, BlurStage& stage, int_fast16_t cacheIndex);
+    void updateStageColSum(BlurStage& stage, int_fast16_t cacheIndex, bool add);
+    void computeStageOutputRow(const BlurStage& stage, uint8_t* dst,
+                               int_fast16_t startX, int_fast16_t endX) const;
+};
+
+} // namespace FLEXIMG_NAMESPACE
+
+// =============================================================================
+// 実装部
+// =============================================================================
+#ifdef FLEXIMG_IMPLEMENTATION
+
+namespace FLEXIMG_NAMESPACE {
+
+namespace blur_detail {
+
+// 水平ボックスブラー1パス（HorizontalBlurNode::applyHorizontalBlur と同じ計算）
+// 出力 x のカーネル中心は入力 x - radius。出力 [outStart, outEnd) を dst に書き込む
+// ウィンドウ合計 [ΣC×A, ΣC×A, ΣC×A, ΣA] を sums に並べ、列合計と同じ resolveRow で
+// まとめて除算する（RGB = ΣC×A / ΣA、A = ΣA / kernelSize の切り捨てと完全に一致）
+static inline void blurLine(const uint8_t* src, int_fast32_t srcWidth, int_fast32_t radius,
+                            int_fast32_t outStart, int_fast32_t outEnd, uint8_t* dst,
+                            std::vector<uint32_t>& sums) {
+    const auto count = static_cast<size_t>(outEnd - outStart);
+    if (sums.size() < count * 4) sums.resize(count * 4);
+    uint32_t sumR = 0, sumG = 0, sumB = 0, sumA = 0;
+    auto add = [&](int_fast32_t x) {
+        if (x < 0 || x >= srcWidth) return;
+        const uint8_t* p = src + x * 4;
+        const uint32_t a = p[3];
+        sumR += p[0] * a; sumG += p[1] * a; sumB += p[2] * a; sumA += a;
+    };
+    auto sub = [&](int_fast32_t x) {
+        if (x < 0 || x >= srcWidth) return;
+        const uint8_t* p = src + x * 4;
+        const uint32_t a = p[3];
+        sumR -= p[0] * a; sumG -= p[1] * a; sumB -= p[2] * a; sumA -= a;
+    };
+    // 初期ウィンドウ（出力 outStart → 入力 [outStart - 2r, outStart]）
+    for (int_fast32_t x = outStart - radius * 2; x <= outStart; x++) add(x);
+    uint32_t* s = sums.data();
+    for (int_fast32_t x = outStart; x < outEnd; x++, s += 4) {
+        if (x > outStart) {
+            sub(x - radius * 2 - 1);
+            add(x);
+        }
+        s[0] = sumR; s[1] = sumG; s[2] = sumB; s[3] = sumA;
+    }
+    vertical_blur_detail::resolveRow(dst, sums.data(), count, static_cast<uint32_t>(radius * 2 + 1));
+}
+
+// 1チャンネル版（HorizontalBlurNode::applyHorizontalBlur1ch と同じ計算）
+static inline void blurLine1ch(const uint8_t* src, int_fast32_t srcWidth, int_fast32_t radius,
+                               int_fast32_t outStart, int_fast32_t outEnd, uint8_t* dst) {
+    const auto ks = static_cast<uint32_t>(radius * 2 + 1);
+    uint32_t sum = 0;
+    for (int_fast32_t x = outStart - radius * 2; x <= outStart; x++) {
+        if (x >= 0 && x < srcWidth) sum += src[x];
+    }
+    for (int_fast32_t x = outStart; x < outEnd; x++) {
+        if (x > outStart) {
+            const int_fast32_t oldX = x - radius * 2 - 1;
+            if (oldX >= 0 && oldX < srcWidth) sum -= src[oldX];
+            if (x < srcWidth) sum += src[x];
+        }
+        *dst++ = static_cast<uint8_t>(sum / ks);
+    }
+}
+
+} // namespace blur_detail
+
+// ============================================================================
+// BlurNode - データ範囲
+// ============================================================================
+
+DataRange BlurNode::horizontalRange(const RenderRequest& request) const {
+    Node* upstream = upstreamNode(0);
+    if (!upstream) return DataRange();
+    if (radiusX_ == 0) return upstream->getDataRange(request);
+
+    const int_fast16_t margin = marginX();
+    RenderRequest inputReq;
+    inputReq.width = static_cast<int16_t>(request.width + margin * 2);
+    inputReq.height = 1;
+    inputReq.origin.x = request.origin.x - to_fixed(static_cast<int>(margin));
+    inputReq.origin.y = request.origin.y;
+    const DataRange upstreamRange = upstream->getDataRange(inputReq);
+    if (!upstreamRange.hasData()) return DataRange();
+
+    // inputReq 座標 → request 座標（-margin）、ブラーによる両側拡張（±margin）
+    const auto startX = static_cast<int16_t>(std::max<int_fast16_t>(0, upstreamRange.startX - margin * 2));
+    const auto endX = static_cast<int16_t>(std::min<int_fast16_t>(request.width, upstreamRange.endX));
+    return (startX < endX) ? DataRange{startX, endX} : DataRange();
+}
+
+DataRange BlurNode::getDataRange(const RenderRequest& request) const {
+    Node* upstream = upstreamNode(0);
+    if (!upstream) return DataRange();
+    if (radiusY_ == 0) return horizontalRange(request);
+
+    if (rangeCache_.origin.x == request.origin.x &&
+        rangeCache_.origin.y == request.origin.y) {
+        if (rangeCache_.startX >= rangeCache_.endX) return DataRange{0, 0};
+        return DataRange{rangeCache_.startX, rangeCache_.endX};
+    }
+
+    // 出力行Yは水平ブラー後の行 Y-expansion〜Y+expansion の和集合
+    const int_fast16_t expansion = marginY();
+    RangeWindow& window = rangeWindow_;
+    const bool sameColumn = window.valid && window.origin.x == request.origin.x
+                         && window.width == request.width;
+
+    if (sameColumn && request.origin.y == window.origin.y + to_fixed(1)) {
+        window.origin.y = request.origin.y;
+        pushRangeRow(request, expansion);
+        const int32_t firstRow = from_fixed_floor(request.origin.y) - static_cast<int32_t>(expansion);
+        while (!window.minStart.empty() && window.minStart.front() < firstRow) window.minStart.popFront();
+        while (!window.maxEnd.empty() && window.maxEnd.front() < firstRow) window.maxEnd.popFront();
+    } else if (!sameColumn || request.origin.y != window.origin.y) {
+        const auto windowRows = static_cast<size_t>(expansion * 2 + 1);
+        window.history.assign(windowRows, DataRange{0, 0});
+        window.minStart.reset(windowRows);
+        window.maxEnd.reset(windowRows);
+        window.origin = request.origin;
+        window.width = request.width;
+        window.valid = true;
+        for (auto dy = static_cast<int_fast16_t>(-expansion); dy <= expansion; ++dy) {
+            pushRangeRow(request, dy);
+        }
+    }
+
+    int16_t startX = INT16_MAX;
+    int16_t endX = INT16_MIN;
+    if (!window.minStart.empty()) {
+        startX = window.history[window.slot(window.minStart.front())].startX;
+        endX = window.history[window.slot(window.maxEnd.front())].endX;
+    }
+    rangeCache_.origin = request.origin;
+    rangeCache_.startX = startX;
+    rangeCache_.endX = endX;
+
+    if (startX >= endX) return DataRange{0, 0};
+    return DataRange{startX, endX};
+}
+
+void BlurNode::pushRangeRow(const RenderRequest& request, int_fast16_t dy) const {
+    RangeWindow& window = rangeWindow_;
+    RenderRequest rowRequest = request;
+    rowRequest.origin.y = request.origin.y + to_fixed(static_cast<int>(dy));
+    const DataRange rowRange = horizontalRange(rowRequest);
+
+    const int32_t row = from_fixed_floor(rowRequest.origin.y);
+    window.history[window.slot(row)] = rowRange;
+    if (!rowRange.hasData()) return;
+
+    while (!window.minStart.empty()
+           && window.history[window.slot(window.minStart.back())].startX >= rowRange.startX) {
+        window.minStart.popBack();
+    }
+    window.minStart.pushBack(row);
+    while (!window.maxEnd.empty()
+           && window.history[window.slot(window.maxEnd.back())].endX <= rowRange.endX) {
+        window.maxEnd.popBack();
+    }
+    window.maxEnd.pushBack(row);
+}
+
+// ============================================================================
+// BlurNode - 水平ブラー（行リングへの直接書き込み）
+// ============================================================================
+
+DataRange BlurNode::blurRowInto(const RenderRequest& request, uint8_t* dst,
+                                int_fast16_t dstStartX, int_fast16_t dstEndX) {
+    Node* upstream = upstreamNode(0);
+    if (!upstream) return DataRange{};
+    const size_t bpp = bytesPerPixel();
+
+    if (radiusX_ == 0) {
+        // 水平ブラーなし: 上流の行をそのままコピー（VerticalBlurNode と同じ）
+        if (!upstream->getDataRange(request).hasData()) return DataRange{};
+        RenderResponse& result = upstream->pullProcess(request);
+        DataRange stored{};
+        if (result.isValid()) {
+            consolidateIfNeeded(result, workFormat());
+            const ViewPort src = result.view();
+            const auto srcOffsetX = static_cast<int_fast16_t>(from_fixed(result.origin.x - request.origin.x));
+            const int_fast16_t begin = std::max<int_fast16_t>(dstStartX, srcOffsetX);
+            const int_fast16_t end = std::min<int_fast16_t>(dstEndX, static_cast<int_fast16_t>(srcOffsetX + src.width));
+            if (begin < end) {
+                std::memcpy(dst + static_cast<size_t>(begin - dstStartX) * bpp,
+                            src.pixelAt(static_cast<int>(begin - srcOffsetX), 0),
+                            static_cast<size_t>(end - begin) * bpp);
+                stored = DataRange{static_cast<int16_t>(begin), static_cast<int16_t>(end)};
+            }
+        }
+        if (context_) {
+            context_->releaseResponse(result);
+        }
+        return stored;
+    }
+
+    // 出力範囲（HorizontalBlurNode::onPullProcess と同じ計算）
+    const int_fast16_t margin = marginX();
+    RenderRequest inputReq;
+    inputReq.width = static_cast<int16_t>(request.width + margin * 2);
+    inputReq.height = 1;
+    inputReq.origin.x = request.origin.x - to_fixed(static_cast<int>(margin));
+    inputReq.origin.y = request.origin.y;
+    const DataRange upstreamRange = upstream->getDataRange(inputReq);
+    if (!upstreamRange.hasData()) return DataRange{};
+    const int_fast16_t rangeStart = std::max<int_fast16_t>(
+        dstStartX, std::max<int_fast16_t>(0, upstreamRange.startX - margin * 2));
+    const int_fast16_t rangeEnd = std::min<int_fast16_t>(
+        dstEndX, std::min<int_fast16_t>(request.width, upstreamRange.endX));
+    if (rangeStart >= rangeEnd) return DataRange{};
+
+    RenderResponse& input = upstream->pullProcess(inputReq);
+    if (!input.isValid()) {
+        if (context_) {
+            context_->releaseResponse(input);
+        }
+        return DataRange{};
+    }
+    consolidateIfNeeded(input, workFormat());
+
+    FLEXIMG_METRICS_SCOPE(NodeType::Blur);
+
+    const ViewPort srcView = input.view();
+    const auto* src = static_cast<const uint8_t*>(srcView.pixelAt(0, 0));
+    auto srcWidth = static_cast<int_fast32_t>(srcView.width);
+    const int_fast32_t radius = radiusX_;
+
+    // 中間パス（各パスで両側に radius 拡張、8bit に量子化）
+    for (int_fast16_t pass = 0; pass + 1 < passes_; pass++) {
+        const int_fast32_t outWidth = srcWidth + radius * 2;
+        std::vector<uint8_t>& line = passLines_[pass & 1];
+        if (line.size() < static_cast<size_t>(outWidth) * bpp) {
+            line.resize(static_cast<size_t>(outWidth) * bpp);
+        }
+        if (channelFormat_) {
+            blur_detail::blurLine1ch(src, srcWidth, radius, 0, outWidth, line.data());
+        } else {
+            blur_detail::blurLine(src, srcWidth, radius, 0, outWidth, line.data(), lineSums_);
+        }
+        src = line.data();
+        srcWidth = outWidth;
+    }
+
+    // 最終パス: 出力範囲のみ dst へ直接書き込む
+    // ブラー後バッファの x=0 はワールド座標 input.origin.x - margin
+    const auto cropOffset = static_cast<int_fast32_t>(from_fixed(input.origin.x - to_fixed(static_cast<int>(margin)) - request.origin.x));
+    const int_fast32_t blurredWidth = srcWidth + radius * 2;
+    const int_fast32_t writeStart = std::max<int_fast32_t>(rangeStart, cropOffset);
+    const int_fast32_t writeEnd = std::min<int_fast32_t>(rangeEnd, cropOffset + blurredWidth);
+    uint8_t* rowStart = dst + static_cast<size_t>(rangeStart - dstStartX) * bpp;
+    if (writeStart >= writeEnd) {
+        std::memset(rowStart, 0, static_cast<size_t>(rangeEnd - rangeStart) * bpp);
+    } else {
+        // 範囲内でブラー後バッファの外側は0
+        std::memset(rowStart, 0, static_cast<size_t>(writeStart - rangeStart) * bpp);
+        uint8_t* out = dst + static_cast<size_t>(writeStart - dstStartX) * bpp;
+        if (channelFormat_) {
+            blur_detail::blurLine1ch(src, srcWidth, radius, writeStart - cropOffset, writeEnd - cropOffset, out);
+        } else {
+            blur_detail::blurLine(src, srcWidth, radius, writeStart - cropOffset, writeEnd - cropOffset, out, lineSums_);
+        }
+        std::memset(dst + static_cast<size_t>(writeEnd - dstStartX) * bpp, 0,
+                    static_cast<size_t>(rangeEnd - writeEnd) * bpp);
+    }
+
+    if (context_) {
+        context_->releaseResponse(input);
+    }
+    return DataRange{static_cast<int16_t>(rangeStart), static_cast<int16_t>(rangeEnd)};
+}
+
+// ============================================================================
+// BlurNode - Template Method フック実装
+// ============================================================================
+
+PrepareResponse BlurNode::onPullPrepare(const PrepareRequest& request) {
+    Node* upstream = upstreamNode(0);
+    if (!upstream) {
+        PrepareResponse result;
+        result.status = PrepareStatus::Prepared;
+        return result;
+    }
+
+    PrepareResponse result = upstream->pullPrepare(request);
+    if (!result.ok()) {
+        return result;
+    }
+    rangeWindow_.valid = false;
+    rangeCache_.origin = {INT32_MIN, INT32_MIN};
+    if (radiusX_ == 0 && radiusY_ == 0) {
+        return result;
+    }
+
+    // 1バイト1チャンネルの上流は単一チャンネルパスで処理（出力も同じフォーマット）
+    channelFormat_ = isSingleChannel8(result.preferredFormat) ? result.preferredFormat : nullptr;
+
+    // 水平: X方向に radiusX * passes 分拡張
+    const int_fast16_t expansionX = marginX();
+    result.width = static_cast<int16_t>(result.width + expansionX * 2);
+    result.origin.x = result.origin.x - to_fixed(static_cast<int>(expansionX));
+
+    if (radiusY_ == 0) {
+        return result;
+    }
+
+    // 垂直: 拡張後のAABBに基づいて行リングを確保し、Y方向に radiusY * passes 分拡張
+    cacheOriginX_ = result.origin.x;
+    initializeStages(result.width);
+
+#ifdef FLEXIMG_DEBUG_PERF_METRICS
+    size_t cacheBytes = static_cast<size_t>(passes_) * (static_cast<size_t>(kernelSizeY()) * static_cast<size_t>(cacheWidth_) * bytesPerPixel() + static_cast<size_t>(cacheWidth_) * bytesPerPixel() * sizeof(uint32_t));
+    PerfMetrics::instance().nodes[NodeType::Blur].recordAlloc(
+        cacheBytes, cacheWidth_, kernelSizeY() * passes_);
+#endif
+
+    const int_fast16_t expansionY = marginY();
+    result.height = static_cast<int16_t>(result.height + expansionY * 2);
+    result.origin.y = result.origin.y - to_fixed(static_cast<int>(expansionY));
+    return result;
+}
+
+void BlurNode::finalize() {
+    stages_.clear();
+    channelFormat_ = nullptr;
+    for (auto& line : passLines_) {
+        line = std::vector<uint8_t>();
+    }
+    lineSums_ = std::vector<uint32_t>();
+    rangeCache_ = DataRangeCache();
+    rangeWindow_ = RangeWindow();
+}
+
+RenderResponse& BlurNode::onPullProcess(const RenderRequest& request) {
+    Node* upstream = upstreamNode(0);
+    if (!upstream) return makeEmptyResponse(request.origin);
+
+    if (radiusX_ == 0 && radiusY_ == 0) {
+        return upstream->pullProcess(request);
+    }
+
+    if (radiusY_ == 0) {
+        // 水平のみ: HorizontalBlurNode と同じ範囲の出力
+        const DataRange range = horizontalRange(request);
+        if (!range.hasData()) return makeEmptyResponse(request.origin);
+        ImageBuffer output(range.endX - range.startX, 1, workFormat(), InitPolicy::Uninitialized);
+        const DataRange stored = blurRowInto(request, static_cast<uint8_t*>(output.view().data),
+                                             range.startX, range.endX);
+        if (!stored.hasData()) return makeEmptyResponse(request.origin);
+#ifdef FLEXIMG_DEBUG_PERF_METRICS
+        auto& metrics = PerfMetrics::instance().nodes[NodeType::Blur];
+        metrics.requestedPixels += static_cast<uint64_t>(request.width) * 1;
+        metrics.usedPixels += static_cast<uint64_t>(request.width + marginX() * 2) * 1;
+        metrics.recordAlloc(output.totalBytes(), output.width(), output.height());
+#endif
+        return makeResponse(std::move(output),
+                            Point{request.origin.x + to_fixed(range.startX), request.origin.y});
+    }
+
+    // 最終ステージを更新（前段ステージ・水平ブラーは再帰的に更新される）
+    updateStageCache(passes_ - 1, static_cast<int_fast16_t>(from_fixed(request.origin.y)));
+
+    DataRange range;
+    if (rangeCache_.origin.x == request.origin.x &&
+        rangeCache_.origin.y == request.origin.y) {
+        range = DataRange{rangeCache_.startX, rangeCache_.endX};
+    } else {
+        range = getDataRange(request);
+    }
+    if (!range.hasData()) {
+        return makeEmptyResponse(request.origin);
+    }
+
+    FLEXIMG_METRICS_SCOPE(NodeType::Blur);
+
+    // 行リングとリクエストの交差領域（VerticalBlurNode と同じ丸め）
+    const int_fixed cacheLeft = cacheOriginX_;
+    const int_fixed cacheRight = cacheLeft + to_fixed(cacheWidth_);
+    const int_fixed interLeft = std::max(cacheLeft, request.origin.x);
+    const int_fixed interRight = std::min(cacheRight, request.origin.x + to_fixed(request.width));
+    if (interLeft >= interRight) {
+        return makeEmptyResponse(request.origin);
+    }
+    const auto srcStartX = static_cast<int_fast16_t>(from_fixed_floor(interLeft - cacheLeft));
+    const auto srcEndX = static_cast<int_fast16_t>(from_fixed_ceil(interRight - cacheLeft));
+    const auto outputWidth = static_cast<int16_t>(srcEndX - srcStartX);
+
+    ImageBuffer output(outputWidth, 1, workFormat(), InitPolicy::Uninitialized);
+
+#ifdef FLEXIMG_DEBUG_PERF_METRICS
+    auto& metrics = PerfMetrics::instance().nodes[NodeType::Blur];
+    metrics.requestedPixels += static_cast<uint64_t>(request.width) * 1;
+    metrics.usedPixels += static_cast<uint64_t>(outputWidth) * 1;
+    metrics.recordAlloc(output.totalBytes(), output.width(), output.height());
+#endif
+
+    computeStageOutputRow(stages_[static_cast<size_t>(passes_ - 1)],
+                          static_cast<uint8_t*>(output.view().data), srcStartX, srcEndX);
+    return makeResponse(std::move(output), Point{interLeft, request.origin.y});
+}
+
+// ============================================================================
+// BlurNode - 垂直パイプライン
+// ============================================================================
+
+void BlurNode::initializeStages(int_fast16_t width) {
+    cacheWidth_ = static_cast<int16_t>(width);
+    const auto cacheRows = static_cast<size_t>(kernelSizeY());
+    stages_.resize(static_cast<size_t>(passes_));
+    for (auto& stage : stages_) {
+        stage.rows = ImageBuffer(width, static_cast<int_fast16_t>(cacheRows), workFormat(),
+                                 InitPolicy::Uninitialized, allocator());
+        stage.rowDataRange.assign(cacheRows, DataRange{0, 0});
+        stage.colSum.assign(static_cast<size_t>(width) * (channelFormat_ ? 1 : 4), 0);
+        stage.currentY = 0;
+        stage.cacheReady = false;
+    }
+}
+
+void BlurNode::updateStageCache(int_fast16_t stageIndex, int_fast16_t newY) {
+    BlurStage& stage = stages_[static_cast<size_t>(stageIndex)];
+    const int_fast16_t ks = kernelSizeY();
+
+    // 初回はキャッシュ全体を充填するよう newY - kernelSize から開始
+    if (!stage.cacheReady) {
+        stage.currentY = static_cast<int32_t>(newY - ks);
+        stage.cacheReady = true;
+    }
+
+    const int_fast16_t step = (stage.currentY < newY) ? 1 : -1;
+    while (stage.currentY != newY) {
+        const auto newSrcY = static_cast<int_fast16_t>(stage.currentY + step * (radiusY_ + 1));
+        auto slot = static_cast<int_fast16_t>(newSrcY % ks);
+        if (slot < 0) slot += ks;
+
+        updateStageColSum(stage, slot, false);
+        if (stageIndex == 0) {
+            fetchSourceRow(stage, newSrcY, slot);
+        } else {
+            updateStageCache(stageIndex - 1, newSrcY);
+            storeStageOutputRow(stages_[static_cast<size_t>(stageIndex - 1)], stage, slot);
+        }
+        updateStageColSum(stage, slot, true);
+
+        stage.currentY += static_cast<int32_t>(step);
+    }
+}
+
+void BlurNode::fetchSourceRow(BlurStage& stage, int_fast16_t srcY, int_fast16_t cacheIndex) {
+    RenderRequest rowReq;
+    rowReq.width = cacheWidth_;
+    rowReq.height = 1;
+    rowReq.origin.x = cacheOriginX_;
+    rowReq.origin.y = to_fixed(static_cast<int>(srcY));
+    stage.rowDataRange[static_cast<size_t>(cacheIndex)] =
+        blurRowInto(rowReq, stage.row(cacheIndex), 0, cacheWidth_);
+}
+
+void BlurNode::storeStageOutputRow(const BlurStage& prevStage, BlurStage& stage, int_fast16_t cacheIndex) {
+    const DataRange extent = prevStage.storedExtent();
+    stage.rowDataRange[static_cast<size_t>(cacheIndex)] = extent;
+    if (extent.hasData()) {
+        computeStageOutputRow(prevStage, stage.row(cacheIndex) + static_cast<size_t>(extent.startX) * bytesPerPixel(),
+                              extent.startX, extent.endX);
+    }
+}
+
+void BlurNode::updateStageColSum(BlurStage& stage, int_fast16_t cacheIndex, bool add) {
+    const DataRange range = stage.rowDataRange[static_cast<size_t>(cacheIndex)];
+    if (!range.hasData()) return;
+    const auto begin = static_cast<size_t>(range.startX);
+    const auto count = static_cast<size_t>(range.endX - range.startX);
+    if (channelFormat_) {
+        const uint8_t* row = stage.row(cacheIndex) + begin;
+        uint32_t* sums = stage.colSum.data() + begin;
+        if (add) {
+            for (size_t x = 0; x < count; x++) sums[x] += row[x];
+        } else {
+            for (size_t x = 0; x < count; x++) sums[x] -= row[x];
+        }
+        return;
+    }
+    const uint8_t* row = stage.row(cacheIndex) + begin * 4;
+    uint32_t* sums = stage.colSum.data() + begin * 4;
+    if (add) {
+        vertical_blur_detail::accumulateRow<true>(sums, row, count);
+    } else {
+        vertical_blur_detail::accumulateRow<false>(sums, row, count);
+    }
+}
+
+void BlurNode::computeStageOutputRow(const BlurStage& stage, uint8_t* dst,
+                                     int_fast16_t startX, int_fast16_t endX) const {
+    const auto ks = static_cast<uint32_t>(kernelSizeY());
+    const auto begin = static_cast<size_t>(startX);
+    const auto count = static_cast<size_t>(endX - startX);
+    if (channelFormat_) {
+        const uint64_t recip = vertical_blur_detail::kernelReciprocal(ks);
+        const uint32_t* sums = stage.colSum.data() + begin;
+        for (size_t i = 0; i < count; i++) {
+            dst[i] = static_cast<uint8_t>((sums[i] * recip) >> 32);
+        }
+        return;
+    }
+    vertical_blur_detail::resolveRow(dst, stage.colSum.data() + begin * 4, count, ks);
+}
+
+} // namespace FLEXIMG_NAMESPACE
+
+#endif // FLEXIMG_IMPLEMENTATION
+
+#endif // FLEXIMG_BLUR_NODE_H
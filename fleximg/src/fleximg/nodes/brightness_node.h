@@ -24,7 +24,7 @@ public:
     // パラメータ設定
     // ========================================
 
-    void setAmount(float amount) { params_.value1 = amount; }
+    void setAmount(float amount) { params_.value1 = amount; markModified(); }
     float amount() const { return params_.value1; }
 
     // ========================================
@@ -0,0 +1,455 @@
+#ifndef FLEXIMG_CACHE_NODE_H
+#define FLEXIMG_CACHE_NODE_H
+
+#include "../core/node.h"
+#include "../core/perf_metrics.h"
+#include "../core/render_context.h"
+#include "../image/viewport.h"
+#include "../image/image_buffer.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace FLEXIMG_NAMESPACE {
+
+// ========================================================================
+// CacheNode - サブツリー描画結果キャッシュノード
+// ========================================================================
+//
+// 上流サブツリーを所有ビットマップに一度だけ描画し、以降のフレームでは
+// SourceNode と同様にビットマップのサブビュー（ゼロコピー）を返します。
+// 静的な UI レイヤー（9パッチパネル、ぼかし背景、テキスト等）の再描画を省略します。
+// - 入力: 1ポート
+// - 出力: 1ポート（RGBA8_Straight）
+//
+// 描画タイミング:
+// - pullPrepare 時にキャッシュが無効なら、上流を準備して
+//   「上流AABB ∩ スクリーン」の範囲をスキャンライン単位で描画する
+// - キャッシュが有効なら上流の準備自体を省略し、保存済みの PrepareResponse を返す
+//
+// 無効化条件（次回 pullPrepare 時に再描画）:
+// - 上流サブツリーの変更世代（Node::generation()）の変化
+//   （パラメータセッターで自動的に進む。ソース画素の直接書き換え等は
+//    利用側で markModified() を呼ぶこと）
+// - 上流の接続構成の変化
+// - スクリーン（origin / サイズ）または下流から伝播したアフィン行列の変化
+// - invalidate() の明示呼び出し
+//
+// パススルー（キャッシュしない）:
+// - 射影変換・ワープが伝播されている場合
+// - ビットマップがメモリ予算に収まらない場合
+//
+// メモリ予算:
+// - setGlobalBudget() で全 CacheNode 共通の上限（バイト）を設定（0=無制限）
+// - 上限を超える場合、使用中でない（パイプライン外の）他の CacheNode を
+//   最終使用が古い順に解放する（LRU）
+// - レジストリはスレッドセーフではない（描画スレッドからのみ操作すること）
+//
+// 使用例:
+//   CacheNode cache;
+//   panel >> blur >> cache >> composite;
+//   renderer.exec();  // 初回: 上流を描画してキャッシュ
+//   renderer.exec();  // 2回目以降: キャッシュから供給
+//
+
+class CacheNode : public Node {
+public:
+    CacheNode() {
+        initPorts(1, 1);  // 入力1、出力1
+        registerCache();
+    }
+
+    ~CacheNode() override {
+        invalidate();
+        unregisterCache();
+    }
+
+    // レジストリに登録されるためコピー・ムーブ不可
+    CacheNode(const CacheNode&) = delete;
+    CacheNode& operator=(const CacheNode&) = delete;
+
+    // ========================================
+    // キャッシュ操作
+    // ========================================
+
+    // キャッシュを破棄（次回 pullPrepare 時に再描画）
+    void invalidate();
+
+    // キャッシュが有効か
+    bool isCached() const { return valid_; }
+
+    // キャッシュビットマップのバイト数
+    uint32_t cachedBytes() const { return valid_ ? bitmap_.totalBytes() : 0; }
+
+    // 上流サブツリーを描画した回数（キャッシュミス回数）
+    uint32_t renderCount() const { return renderCount_; }
+
+    // ========================================
+    // メモリ予算（全 CacheNode 共通）
+    // ========================================
+
+    // 予算を設定（0=無制限）。超過分は次回のキャッシュ作成時に LRU で解放
+    static void setGlobalBudget(size_t bytes);
+    static size_t globalBudget();
+
+    // 全 CacheNode のキャッシュ使用量（バイト）
+    static size_t globalUsage();
+
+    // ========================================
+    // Node インターフェース
+    // ========================================
+
+    const char* name() const override { return "CacheNode"; }
+    int nodeTypeForMetrics() const override { return NodeType::Cache; }
+
+    // getDataRange: キャッシュ時は行ごとの不透明範囲を返す
+    DataRange getDataRange(const RenderRequest& request) const override;
+
+protected:
+    PrepareResponse onPullPrepare(const PrepareRequest& request) override;
+    RenderResponse& onPullProcess(const RenderRequest& request) override;
+    void onPullFinalize() override;
+
+private:
+    // キャッシュ本体（所有モード、DefaultAllocator で確保）
+    ImageBuffer bitmap_;
+    std::vector<DataRange> rowRanges_;  // 行ごとの有効範囲（ビットマップ座標）
+    int_fixed bitmapOriginX_ = 0;       // ビットマップ左上のワールド座標
+    int_fixed bitmapOriginY_ = 0;
+    PrepareResponse cachedPrepare_;     // キャッシュ時に返す PrepareResponse
+    bool valid_ = false;
+    bool passThrough_ = false;          // 今回のフレームはキャッシュを使わない
+
+    // キャッシュキー
+    uint64_t keySignature_ = 0;         // 上流サブツリーの世代・構成のハッシュ
+    Point keyOrigin_;
+    int16_t keyWidth_ = 0;
+    int16_t keyHeight_ = 0;
+    AffineMatrix keyMatrix_;
+    bool keyHasAffine_ = false;
+
+    uint32_t renderCount_ = 0;
+    uint32_t lastUse_ = 0;              // LRU 用の最終使用ティック
+
+    // レジストリ（侵入型双方向リスト）
+    CacheNode* prevCache_ = nullptr;
+    CacheNode* nextCache_ = nullptr;
+
+    void registerCache();
+    void unregisterCache();
+
+    // LRU: 自身以外の使用中でないキャッシュを解放し、bytes を確保できるか
+    static bool reserveBudget(size_t bytes, const CacheNode* requester);
+
+    // 上流サブツリーの世代・構成ハッシュ
+    static uint64_t subtreeSignature(const Node* node);
+
+    bool keyMatches(const PrepareRequest& request, uint64_t signature) const;
+
+    // 上流を描画してキャッシュを作成（予算超過時は false）
+    bool renderUpstream(Node* upstream, const PrepareRequest& request,
+                        const PrepareResponse& upstreamResult);
+};
+
+} // namespace FLEXIMG_NAMESPACE
+
+// =============================================================================
+// 実装部
+// =============================================================================
+#ifdef FLEXIMG_IMPLEMENTATION
+
+#include <algorithm>
+#include <cstring>
+
+namespace FLEXIMG_NAMESPACE {
+
+// ============================================================================
+// CacheNode - レジストリ・メモリ予算
+// ============================================================================
+
+namespace cache_detail {
+
+static CacheNode* s_head = nullptr;
+static size_t s_budget = 0;     // 0=無制限
+static size_t s_usage = 0;
+static uint32_t s_tick = 0;
+
+// サブツリー走査の深さ上限（循環接続に対する保護）
+constexpr int kMaxSignatureDepth = 64;
+
+inline uint64_t fnv1a(uint64_t h, uint64_t v) {
+    for (int i = 0; i < 8; ++i) {
+        h ^= (v >> (i * 8)) & 0xFF;
+        h *= 0x100000001B3ull;
+    }
+    return h;
+}
+
+inline uint64_t signatureRecursive(const Node* node, int depth) {
+    uint64_t h = 0xCBF29CE484222325ull;
+    if (!node) return fnv1a(h, 0);
+    h = fnv1a(h, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(node)));
+    h = fnv1a(h, node->generation());
+    if (depth >= kMaxSignatureDepth) return h;
+    const int count = node->inputPortCount();
+    for (int i = 0; i < count; ++i) {
+        h = fnv1a(h, signatureRecursive(node->upstreamNode(i), depth + 1));
+    }
+    return h;
+}
+
+inline bool sameMatrix(const AffineMatrix& x, const AffineMatrix& y) {
+    return x.a == y.a && x.b == y.b && x.c == y.c && x.d == y.d &&
+           x.tx == y.tx && x.ty == y.ty;
+}
+
+} // namespace cache_detail
+
+void CacheNode::registerCache() {
+    nextCache_ = cache_detail::s_head;
+    if (nextCache_) nextCache_->prevCache_ = this;
+    cache_detail::s_head = this;
+}
+
+void CacheNode::unregisterCache() {
+    if (prevCache_) prevCache_->nextCache_ = nextCache_;
+    else cache_detail::s_head = nextCache_;
+    if (nextCache_) nextCache_->prevCache_ = prevCache_;
+    prevCache_ = nextCache_ = nullptr;
+}
+
+void CacheNode::setGlobalBudget(size_t bytes) { cache_detail::s_budget = bytes; }
+size_t CacheNode::globalBudget() { return cache_detail::s_budget; }
+size_t CacheNode::globalUsage() { return cache_detail::s_usage; }
+
+void CacheNode::invalidate() {
+    if (valid_) {
+        cache_detail::s_usage -= bitmap_.totalBytes();
+    }
+    valid_ = false;
+    bitmap_ = ImageBuffer();
+    rowRanges_.clear();
+}
+
+bool CacheNode::reserveBudget(size_t bytes, const CacheNode* requester) {
+    const size_t budget = cache_detail::s_budget;
+    if (budget == 0) return true;
+    if (bytes > budget) return false;
+    while (cache_detail::s_usage + bytes > budget) {
+        // 使用中でない（Idle）キャッシュのうち最終使用が最も古いものを解放
+        CacheNode* victim = nullptr;
+        for (CacheNode* n = cache_detail::s_head; n; n = n->nextCache_) {
+            if (n == requester || !n->valid_) continue;
+            if (n->prepareResponse_.status != PrepareStatus::Idle) continue;
+            if (!victim || static_cast<int32_t>(n->lastUse_ - victim->lastUse_) < 0) {
+                victim = n;
+            }
+        }
+        if (!victim) return false;
+        victim->invalidate();
+    }
+    return true;
+}
+
+uint64_t CacheNode::subtreeSignature(const Node* node) {
+    return cache_detail::signatureRecursive(node, 0);
+}
+
+bool CacheNode::keyMatches(const PrepareRequest& request, uint64_t signature) const {
+    if (!valid_ || signature != keySignature_) return false;
+    if (request.origin.x != keyOrigin_.x || request.origin.y != keyOrigin_.y) return false;
+    if (request.width != keyWidth_ || request.height != keyHeight_) return false;
+    if (request.hasAffine != keyHasAffine_) return false;
+    return !request.hasAffine || cache_detail::sameMatrix(request.affineMatrix, keyMatrix_);
+}
+
+// ============================================================================
+// CacheNode - Template Method フック実装
+// ============================================================================
+
+PrepareResponse CacheNode::onPullPrepare(const PrepareRequest& request) {
+    Node* upstream = upstreamNode(0);
+    if (!upstream) {
+        invalidate();
+        passThrough_ = true;
+        PrepareResponse result;
+        result.status = PrepareStatus::Prepared;
+        return result;
+    }
+
+    // 射影変換・ワープはキャッシュキーに含められないためパススルー
+    passThrough_ = request.hasPerspective || request.warp != nullptr;
+    uint64_t signature = 0;
+    if (!passThrough_) {
+        signature = subtreeSignature(upstream);
+        if (keyMatches(request, signature)) {
+            // キャッシュヒット: 上流の準備を省略
+            lastUse_ = ++cache_detail::s_tick;
+            return cachedPrepare_;
+        }
+        invalidate();
+    }
+
+    PrepareResponse result = upstream->pullPrepare(request);
+    if (!result.ok() || passThrough_) {
+        return result;
+    }
+
+    if (!renderUpstream(upstream, request, result)) {
+        passThrough_ = true;
+        return result;
+    }
+
+    keySignature_ = signature;
+    keyOrigin_ = request.origin;
+    keyWidth_ = request.width;
+    keyHeight_ = request.height;
+    keyMatrix_ = request.affineMatrix;
+    keyHasAffine_ = request.hasAffine;
+    lastUse_ = ++cache_detail::s_tick;
+    return cachedPrepare_;
+}
+
+void CacheNode::onPullFinalize() {
+    finalize();
+    // キャッシュヒット時の上流は Idle のため何もしない
+    Node* upstream = upstreamNode(0);
+    if (upstream) {
+        upstream->pullFinalize();
+    }
+}
+
+bool CacheNode::renderUpstream(Node* upstream, const PrepareRequest& request,
+                               const PrepareResponse& upstreamResult) {
+    // 描画範囲: 上流AABB ∩ スクリーン（スクリーンのピクセルグリッドに整列）
+    int left = 0, top = 0, right = 0, bottom = 0;
+    if (upstreamResult.width > 0 && upstreamResult.height > 0) {
+        const int_fixed relX = upstreamResult.origin.x - request.origin.x;
+        const int_fixed relY = upstreamResult.origin.y - request.origin.y;
+        left = std::max(0, from_fixed_floor(relX));
+        top = std::max(0, from_fixed_floor(relY));
+        right = std::min<int>(request.width, from_fixed_ceil(relX + to_fixed(upstreamResult.width)));
+        bottom = std::min<int>(request.height, from_fixed_ceil(relY + to_fixed(upstreamResult.height)));
+    }
+    const int width = std::max(0, right - left);
+    const int height = std::max(0, bottom - top);
+
+    const size_t bytes = static_cast<size_t>(width) * static_cast<size_t>(height) * 4;
+    if (!reserveBudget(bytes, this)) {
+        return false;
+    }
+
+    bitmapOriginX_ = request.origin.x + to_fixed(left);
+    bitmapOriginY_ = request.origin.y + to_fixed(top);
+    rowRanges_.assign(static_cast<size_t>(height), DataRange{0, 0});
+    if (width > 0 && height > 0) {
+        // パイプライン用アロケータはフレーム単位のため使用しない
+        bitmap_ = ImageBuffer(static_cast<int_fast16_t>(width), static_cast<int_fast16_t>(height),
+                              PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero, nullptr);
+#ifdef FLEXIMG_DEBUG_PERF_METRICS
+        PerfMetrics::instance().nodes[NodeType::Cache].recordAlloc(
+            bitmap_.totalBytes(), bitmap_.width(), bitmap_.height());
+#endif
+    }
+
+    // 上流をスキャンライン単位で描画して転写
+    ViewPort dstView = bitmap_.view();
+    for (int y = 0; y < height; ++y) {
+        RenderRequest rowRequest;
+        rowRequest.width = static_cast<int16_t>(width);
+        rowRequest.height = 1;
+        rowRequest.origin = {bitmapOriginX_, bitmapOriginY_ + to_fixed(y)};
+
+        RenderResponse& resp = upstream->pullProcess(rowRequest);
+        if (resp.isValid()) {
+            consolidateIfNeeded(resp);
+            const ViewPort src = resp.view();
+            const int offsetX = from_fixed(resp.origin.x - rowRequest.origin.x);
+            const int xStart = std::max(0, offsetX);
+            const int xEnd = std::min(width, offsetX + static_cast<int>(src.width));
+            if (xStart < xEnd && src.height > 0) {
+                auto* dstRow = static_cast<uint8_t*>(dstView.pixelAt(0, y));
+                const auto* srcRow = static_cast<const uint8_t*>(src.pixelAt(xStart - offsetX, 0));
+                std::memcpy(dstRow + xStart * 4, srcRow, static_cast<size_t>(xEnd - xStart) * 4);
+
+                // 左右の透明ピクセルを有効範囲から除外
+                int s = xStart, e = xEnd;
+                while (s < e && dstRow[s * 4 + 3] == 0) ++s;
+                while (e > s && dstRow[(e - 1) * 4 + 3] == 0) --e;
+                if (s < e) {
+                    rowRanges_[static_cast<size_t>(y)] = DataRange{static_cast<int16_t>(s),
+                                                                   static_cast<int16_t>(e)};
+                }
+            }
+        }
+        // 行ごとにResponseプールを解放（描画中は下流にResponseを渡していない）
+        if (context_) {
+            context_->resetScanlineResources();
+        }
+    }
+
+    valid_ = true;
+    ++renderCount_;
+    cache_detail::s_usage += bitmap_.totalBytes();
+
+    cachedPrepare_ = PrepareResponse();
+    cachedPrepare_.status = PrepareStatus::Prepared;
+    cachedPrepare_.width = static_cast<int16_t>(width);
+    cachedPrepare_.height = static_cast<int16_t>(height);
+    cachedPrepare_.origin = {bitmapOriginX_, bitmapOriginY_};
+    cachedPrepare_.preferredFormat = PixelFormatIDs::RGBA8_Straight;
+    return true;
+}
+
+// ============================================================================
+// CacheNode - getDataRange / onPullProcess 実装
+// ============================================================================
+
+DataRange CacheNode::getDataRange(const RenderRequest& request) const {
+    if (passThrough_ || !valid_) {
+        Node* upstream = upstreamNode(0);
+        return upstream ? upstream->getDataRange(request) : DataRange{0, 0};
+    }
+    const int y = from_fixed(request.origin.y - bitmapOriginY_);
+    if (y < 0 || y >= static_cast<int>(rowRanges_.size())) return DataRange{0, 0};
+    const DataRange& row = rowRanges_[static_cast<size_t>(y)];
+    if (!row.hasData()) return DataRange{0, 0};
+
+    // ビットマップ座標 → リクエスト座標
+    const int offsetX = from_fixed(bitmapOriginX_ - request.origin.x);
+    const int start = std::max(0, row.startX + offsetX);
+    const int end = std::min<int>(request.width, row.endX + offsetX);
+    return (start < end) ? DataRange{static_cast<int16_t>(start), static_cast<int16_t>(end)}
+                         : DataRange{0, 0};
+}
+
+RenderResponse& CacheNode::onPullProcess(const RenderRequest& request) {
+    if (passThrough_ || !valid_) {
+        Node* upstream = upstreamNode(0);
+        return upstream ? upstream->pullProcess(request) : makeEmptyResponse(request.origin);
+    }
+
+    FLEXIMG_METRICS_SCOPE(NodeType::Cache);
+
+    DataRange range = getDataRange(request);
+    if (!range.hasData()) {
+        return makeEmptyResponse(request.origin);
+    }
+
+    // ビットマップ行のサブビュー（参照モード、メモリ確保なし）
+    const int offsetX = from_fixed(bitmapOriginX_ - request.origin.x);
+    const int y = from_fixed(request.origin.y - bitmapOriginY_);
+    ImageBuffer result(view_ops::subView(bitmap_.view(),
+                                         static_cast<int_fast16_t>(range.startX - offsetX),
+                                         static_cast<int_fast16_t>(y),
+                                         static_cast<int_fast16_t>(range.endX - range.startX), 1));
+    Point adjustedOrigin = {request.origin.x + to_fixed(static_cast<int>(range.startX)),
+                            request.origin.y};
+    return makeResponse(std::move(result), adjustedOrigin);
+}
+
+} // namespace FLEXIMG_NAMESPACE
+
+#endif // FLEXIMG_IMPLEMENTATION
+
+#endif // FLEXIMG_CACHE_NODE_H
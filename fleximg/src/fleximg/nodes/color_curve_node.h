@@ -0,0 +1,204 @@
+#ifndef FLEXIMG_COLOR_CURVE_NODE_H
+#define FLEXIMG_COLOR_CURVE_NODE_H
+
+#include "filter_node_base.h"
+
+namespace FLEXIMG_NAMESPACE {
+
+// ========================================================================
+// ColorCurveNode - トーンカーブ（色調補正）フィルタノード
+// ========================================================================
+//
+// 明るさ・コントラスト・ガンマ・レベル補正・任意カーブを、prepare 時に
+// チャンネル別の256エントリLUT（R, G, B, A）へまとめ、ピクセルごとにLUTを引くだけで適用します。
+// - 補正の順序: レベル入力 → ガンマ → レベル出力 → 明るさ → コントラスト → RGBカーブ → チャンネル別カーブ
+// - 明るさ・コントラスト・ガンマ・レベル補正は RGB のみに適用（アルファはアルファカーブのみ）
+// - 明るさは BrightnessNode と同じ（amount × 255 を加算）
+// - パレット付きインデックス形式の入力では、ピクセルではなくパレットへ適用
+//
+// 使用例:
+//   ColorCurveNode curve;
+//   curve.setContrast(0.2f);
+//   curve.setGamma(1.2f);
+//   curve.setLevels(16, 235);
+//   src >> curve >> sink;
+//
+
+class ColorCurveNode : public FilterNodeBase {
+public:
+    /// 任意カーブの適用先
+    enum class Channel : uint8_t {
+        RGB,    ///< R, G, B 共通（チャンネル別カーブの前に適用）
+        Red,
+        Green,
+        Blue,
+        Alpha
+    };
+
+    // ========================================
+    // パラメータ設定
+    // ========================================
+
+    /// 明るさ（-1.0〜1.0、0.0で変化なし）
+    void setBrightness(float amount) { brightness_ = amount; invalidateLut(); }
+    float brightness() const { return brightness_; }
+
+    /// コントラスト（-1.0〜1.0、0.0で変化なし、-1.0で中間グレー、1.0で二値化）
+    void setContrast(float amount) { contrast_ = amount; invalidateLut(); }
+    float contrast() const { return contrast_; }
+
+    /// ガンマ（出力 = 入力^(1/gamma)、1.0で変化なし、1より大きいと明るく）
+    void setGamma(float gamma) { gamma_ = gamma; invalidateLut(); }
+    float gamma() const { return gamma_; }
+
+    /// レベル補正（入力の黒点・白点を出力の黒点・白点へ線形に写像）
+    void setLevels(uint8_t inBlack, uint8_t inWhite, uint8_t outBlack = 0, uint8_t outWhite = 255) {
+        inBlack_ = inBlack;
+        inWhite_ = inWhite;
+        outBlack_ = outBlack;
+        outWhite_ = outWhite;
+        invalidateLut();
+    }
+    uint8_t inputBlack() const { return inBlack_; }
+    uint8_t inputWhite() const { return inWhite_; }
+    uint8_t outputBlack() const { return outBlack_; }
+    uint8_t outputWhite() const { return outWhite_; }
+
+    /// 任意カーブ（256エントリ、内容はコピーする）。nullptr で解除
+    void setCurve(Channel channel, const uint8_t* curve);
+    bool hasCurve(Channel channel) const {
+        return (curveMask_ & (1u << static_cast<uint8_t>(channel))) != 0;
+    }
+
+    /// 全ての補正を初期状態（変化なし）に戻す
+    void reset();
+
+    /// コンパイル済みLUT（R, G, B, A の順に各256エントリ、prepare 後に有効）
+    const uint8_t* lut() const { return lut_; }
+
+    // ========================================
+    // Node インターフェース
+    // ========================================
+
+    const char* name() const override { return "ColorCurveNode"; }
+
+    /// 補正をLUTへコンパイル（パラメータ変更時のみ）
+    void prepare(const RenderRequest& screenInfo) override;
+
+protected:
+    filters::LineFilterFunc getFilterFunc() const override {
+        return &filters::color_curve_line;
+    }
+    int nodeTypeForMetrics() const override { return NodeType::ColorCurve; }
+
+private:
+    void invalidateLut() {
+        lutValid_ = false;
+        markModified();
+    }
+    void compileLut();
+
+    float brightness_ = 0.0f;
+    float contrast_ = 0.0f;
+    float gamma_ = 1.0f;
+    uint8_t inBlack_ = 0;
+    uint8_t inWhite_ = 255;
+    uint8_t outBlack_ = 0;
+    uint8_t outWhite_ = 255;
+
+    // 任意カーブ（Channel 順）と設定済みビット
+    uint8_t curves_[5][256] = {};
+    uint8_t curveMask_ = 0;
+
+    // コンパイル済みLUT（R, G, B, A）
+    uint8_t lut_[4 * 256] = {};
+    bool lutValid_ = false;
+};
+
+} // namespace FLEXIMG_NAMESPACE
+
+// =============================================================================
+// 実装部
+// =============================================================================
+#ifdef FLEXIMG_IMPLEMENTATION
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace FLEXIMG_NAMESPACE {
+
+void ColorCurveNode::setCurve(Channel channel, const uint8_t* curve) {
+    const auto index = static_cast<uint8_t>(channel);
+    if (curve) {
+        std::memcpy(curves_[index], curve, 256);
+        curveMask_ = static_cast<uint8_t>(curveMask_ | (1u << index));
+    } else {
+        curveMask_ = static_cast<uint8_t>(curveMask_ & ~(1u << index));
+    }
+    invalidateLut();
+}
+
+void ColorCurveNode::reset() {
+    brightness_ = 0.0f;
+    contrast_ = 0.0f;
+    gamma_ = 1.0f;
+    inBlack_ = 0;
+    inWhite_ = 255;
+    outBlack_ = 0;
+    outWhite_ = 255;
+    curveMask_ = 0;
+    invalidateLut();
+}
+
+void ColorCurveNode::prepare(const RenderRequest& screenInfo) {
+    (void)screenInfo;
+    if (!lutValid_) {
+        compileLut();
+        lutValid_ = true;
+    }
+    // コピー・ムーブ後も自身のLUTを指すよう毎回設定
+    params_.lut = lut_;
+}
+
+void ColorCurveNode::compileLut() {
+    // RGB 共通の補正（float で合成し、最後に1回だけ丸める）
+    const float inBlack = static_cast<float>(inBlack_);
+    const float inRange = std::max(1.0f, static_cast<float>(inWhite_) - inBlack);
+    const float outBlack = static_cast<float>(outBlack_);
+    const float outRange = static_cast<float>(outWhite_) - outBlack;
+    const float invGamma = 1.0f / std::max(0.01f, gamma_);
+    const auto adjustment = static_cast<float>(static_cast<int_fast16_t>(brightness_ * 255.0f));
+    const float contrast = std::max(-1.0f, std::min(1.0f, contrast_));
+    const float contrastFactor = (contrast >= 0.0f)
+        ? 1.0f / std::max(1.0f - contrast, 1.0f / 256.0f) : 1.0f + contrast;
+
+    uint8_t* lutR = lut_;
+    uint8_t* lutG = lut_ + 256;
+    uint8_t* lutB = lut_ + 512;
+    uint8_t* lutA = lut_ + 768;
+    for (int_fast16_t v = 0; v < 256; v++) {
+        float x = (static_cast<float>(v) - inBlack) / inRange;
+        x = std::max(0.0f, std::min(1.0f, x));
+        if (invGamma != 1.0f) {
+            x = std::pow(x, invGamma);
+        }
+        float y = outBlack + x * outRange;
+        y = std::max(0.0f, std::min(255.0f, y + adjustment));
+        y = (y - 127.5f) * contrastFactor + 127.5f;
+        const auto value = static_cast<uint8_t>(std::max(0.0f, std::min(255.0f, y)) + 0.5f);
+        const uint8_t rgb = hasCurve(Channel::RGB)
+            ? curves_[static_cast<uint8_t>(Channel::RGB)][value] : value;
+        lutR[v] = hasCurve(Channel::Red) ? curves_[static_cast<uint8_t>(Channel::Red)][rgb] : rgb;
+        lutG[v] = hasCurve(Channel::Green) ? curves_[static_cast<uint8_t>(Channel::Green)][rgb] : rgb;
+        lutB[v] = hasCurve(Channel::Blue) ? curves_[static_cast<uint8_t>(Channel::Blue)][rgb] : rgb;
+        lutA[v] = hasCurve(Channel::Alpha)
+            ? curves_[static_cast<uint8_t>(Channel::Alpha)][v] : static_cast<uint8_t>(v);
+    }
+}
+
+} // namespace FLEXIMG_NAMESPACE
+
+#endif // FLEXIMG_IMPLEMENTATION
+
+#endif // FLEXIMG_COLOR_CURVE_NODE_H
@@ -6,6 +6,7 @@
 #include "../core/perf_metrics.h"
 #include "../image/image_buffer.h"
 #include "../image/pixel_format.h"
+#include "../operations/blend_modes.h"
 #include "../operations/canvas_utils.h"
 
 namespace FLEXIMG_NAMESPACE {
@@ -26,6 +27,38 @@ namespace FLEXIMG_NAMESPACE {
 // - 入力ポート1以降が順に背面に合成
 // - 既に不透明なピクセルは後のレイヤー処理をスキップ
 //
+// 遮蔽カリング:
+// - 2番目以降の入力は、合成バッファのαから「まだ不透明でない区間」を求め、
+//   その区間だけにRenderRequestを絞り込んで上流を評価する
+// - 入力の有効範囲がすべて不透明なら、その上流は評価しない
+// - 短い不透明区間（kMinOcclusionRun未満）で隔てられた区間は結合し、
+//   1入力あたりのリクエスト数は kMaxVisibleSpans 以下に抑える
+//
+// Y区間インデックス:
+// - Prepare時に各上流のPrepareResponse（AABB）から行範囲を求め、
+//   16行（kBucketShift）単位のバケットに入力番号を登録する（CSR形式、入力番号順）
+// - getDataRange/onPullProcess はスキャンラインの行に有効な入力のみを評価し、
+//   入力数が多い場合のコストを O(入力数) から O(有効な入力数) に抑える
+// - AABBが空の上流は範囲不明として全行で評価する
+//
+// ブレンドモード（入力ごと、setBlendMode）:
+// - 入力iのモードは「入力iを、より背面の入力（i+1以降）の合成結果に重ねる方法」
+// - Normal のみの場合は従来通り前面からunder合成
+// - Normal 以外を含む場合:
+//   1. 最前面の非Normal入力より前面の入力は、合成バッファにunder合成（遮蔽カリング有効）
+//   2. 最背面の非Normal入力より背面の入力は、背景バッファにunder合成
+//   3. その間の入力を背面から順にモードの合成関数で背景バッファに重ねる
+//   4. 背景バッファを合成バッファの背面にunder合成
+// - 合成関数（blend::BlendModeDescriptor）はPrepare時に解決し、内側ループで分岐しない
+// - 遮蔽カリングは前面のNormal入力が不透明な区間に対して全入力で有効
+//
+// セグメント合成:
+// - 上流の getDataSegments を統合し、離れた領域（画面両端のスプライト等）を
+//   1つの和集合区間にまとめずセグメントリストとして保持する
+// - 複数セグメントの場合、合成バッファはセグメント内のみゼロ初期化・合成し、
+//   出力RenderResponseに有効セグメントを設定する（セグメント外は未初期化）
+// - 隙間が kMinSegmentGap 以下のセグメントは結合する
+//
 // アフィン変換はAffineCapability Mixinから継承:
 // - setMatrix(), matrix()
 // - setRotation(), setScale(), setTranslation(), setRotationScale()
@@ -37,6 +70,7 @@ namespace FLEXIMG_NAMESPACE {
 //   fg >> composite;             // ポート0（最前面）
 //   mid.connectTo(composite, 1); // ポート1（中間）
 //   bg.connectTo(composite, 2);  // ポート2（最背面）
+//   composite.setBlendMode(1, BlendMode::Multiply);  // 中間を乗算で背面に重ねる
 //   composite >> sink;
 //
 
@@ -44,6 +78,7 @@ class CompositeNode : public Node, public AffineCapability {
 public:
     explicit CompositeNode(int_fast16_t inputCount = 2) {
         initPorts(inputCount, 1);  // 入力N、出力1
+        blendModes_.assign(inputs_.size(), BlendMode::Normal);
     }
 
     // ========================================
@@ -59,17 +94,36 @@ public:
                 inputs_[static_cast<size_t>(i)] = core::Port(this, static_cast<int>(i));
             }
         }
+        blendModes_.resize(static_cast<size_t>(count), BlendMode::Normal);
+        markModified();
     }
 
     int_fast16_t inputCount() const {
         return static_cast<int_fast16_t>(inputs_.size());
     }
 
+    // ========================================
+    // ブレンドモード
+    // ========================================
+
+    // 入力indexのブレンドモードを設定（デフォルト: Normal）
+    void setBlendMode(int_fast16_t index, BlendMode mode) {
+        if (index < 0 || index >= inputCount()) return;
+        blendModes_[static_cast<size_t>(index)] = mode;
+        markModified();
+    }
+
+    BlendMode blendMode(int_fast16_t index) const {
+        if (index < 0 || index >= inputCount()) return BlendMode::Normal;
+        return blendModes_[static_cast<size_t>(index)];
+    }
+
     // ========================================
     // Node インターフェース
     // ========================================
 
     const char* name() const override { return "CompositeNode"; }
+    uint32_t generation() const override { return Node::generation() + matrixGeneration(); }
 
     // ========================================
     // Template Method フック
@@ -87,15 +141,65 @@ public:
     // getDataRange: 全上流のgetDataRange和集合を返す
     DataRange getDataRange(const RenderRequest& request) const override;
 
+    // getDataSegments: 全上流のセグメントを統合して返す
+    int_fast16_t getDataSegments(const RenderRequest& request,
+                                 DataRange* segments, int_fast16_t maxCount) const override;
+
 protected:
     int nodeTypeForMetrics() const override { return NodeType::Composite; }
 
 private:
-    // getDataRangeキャッシュ（同一スキャンラインでの重複計算を回避）
+    // 遮蔽カリングのパラメータ
+    static constexpr int_fast16_t kMinOcclusionRun = 16;  // これ未満の不透明区間は分割しない
+    static constexpr int_fast16_t kMaxVisibleSpans = 4;   // 1セグメント・1入力あたりの最大リクエスト数
+    static constexpr int_fast16_t kMinSegmentGap = 16;    // これ以下の隙間のセグメントは結合
+
+    // 合成バッファ上の [startX, endX)（request座標系）から不透明でない区間を収集
+    // 戻り値: 区間数（0=全て不透明）
+    static int_fast16_t collectVisibleSpans(const uint8_t* compositeRow, int16_t bufStartX,
+                                            int16_t startX, int16_t endX, DataRange* spans);
+
+    // 入力ごとのブレンドモードと、Prepare時に解決した合成関数
+    // 非Normal入力の範囲 [blendFirst_, blendLast_]（なければ blendFirst_ = 入力数）
+    std::vector<BlendMode> blendModes_;
+    std::vector<blend::BlendOverFunc> blendFuncs_;
+    int_fast16_t blendFirst_ = 0;
+    int_fast16_t blendLast_ = -1;
+
+    // Y区間インデックスのパラメータ
+    static constexpr int_fast16_t kBucketShift = 4;        // バケット高さ 16行
+    static constexpr int32_t kBoundsMargin = 1;            // AABBの上下に加える余裕（行）
+
+    // 入力ごとの行範囲 [rowTop, rowBottom)（unbounded: 範囲不明、全行で評価）
+    struct InputBounds {
+        int32_t rowTop = 0;
+        int32_t rowBottom = 0;
+        bool unbounded = true;
+    };
+    std::vector<InputBounds> inputBounds_;
+    std::vector<uint32_t> bucketStart_;       // bucketStart_[b]..bucketStart_[b+1] が bucketInputs_ の範囲
+    std::vector<uint16_t> bucketInputs_;
+    std::vector<uint16_t> unboundedInputs_;   // バケット範囲外の行で評価する入力
+    int32_t bucketTop_ = 0;
+
+    // 行範囲からバケットを構築（Prepare時）
+    void buildInputIndex();
+
+    // スキャンラインの行に有効な入力を activeInputs_ に収集（入力番号順）
+    void collectActiveInputs(const RenderRequest& request) const;
+    mutable std::vector<uint16_t> activeInputs_;
+
+    // 範囲キャッシュを更新（同一リクエストなら何もしない）
+    // activeInputs_ もリクエストに合わせて更新する
+    void updateRangeCache(const RenderRequest& request) const;
+
+    // getDataRange/getDataSegmentsキャッシュ（同一スキャンラインでの重複計算を回避）
     mutable struct {
         Point origin = {0, 0};
         int16_t width = 0;
-        DataRange range = {0, 0};
+        DataRange range = {0, 0};                    // セグメントの和集合
+        DataRange segments[MAX_DATA_SEGMENTS];
+        int_fast16_t segmentCount = 0;
         bool valid = false;
     } dataRangeCache_;
 };
@@ -136,6 +240,7 @@ PrepareResponse CompositeNode::onPullPrepare(const PrepareRequest& request) {
 
     // 全上流へ伝播し、結果をマージ（AABB和集合）
     auto numInputs = inputCount();
+    inputBounds_.assign(static_cast<size_t>(numInputs), InputBounds());
     for (int_fast16_t i = 0; i < numInputs; ++i) {
         Node* upstream = upstreamNode(i);
         if (upstream) {
@@ -153,6 +258,14 @@ PrepareResponse CompositeNode::onPullPrepare(const PrepareRequest& request) {
             float right = left + static_cast<float>(result.width);
             float bottom = top + static_cast<float>(result.height);
 
+            // Y区間インデックス用の行範囲
+            if (result.width > 0 && result.height > 0) {
+                InputBounds& bounds = inputBounds_[static_cast<size_t>(i)];
+                bounds.rowTop = from_fixed_floor(result.origin.y) - kBoundsMargin;
+                bounds.rowBottom = bounds.rowTop + result.height + kBoundsMargin * 2 + 1;
+                bounds.unbounded = false;
+            }
+
             if (validUpstreamCount == 0) {
                 // 最初の結果でベースを初期化
                 merged.preferredFormat = result.preferredFormat;
@@ -199,6 +312,20 @@ PrepareResponse CompositeNode::onPullPrepare(const PrepareRequest& request) {
 
     // getDataRangeキャッシュを無効化（アフィン行列が変わる可能性があるため）
     dataRangeCache_.valid = false;
+    buildInputIndex();
+
+    // ブレンドモードの合成関数を解決
+    blendFuncs_.resize(static_cast<size_t>(numInputs));
+    blendFirst_ = numInputs;
+    blendLast_ = -1;
+    for (int_fast16_t i = 0; i < numInputs; ++i) {
+        const BlendMode mode = blendMode(i);
+        blendFuncs_[static_cast<size_t>(i)] = blend::descriptor(mode).blendOver;
+        if (mode != BlendMode::Normal) {
+            if (blendFirst_ == numInputs) blendFirst_ = i;
+            blendLast_ = i;
+        }
+    }
 
     return merged;
 }
@@ -214,96 +341,358 @@ void CompositeNode::onPullFinalize() {
     }
 }
 
-// getDataRange: 全上流のgetDataRange和集合を返す
-// 同一スキャンラインでの重複呼び出しはキャッシュで高速化
-DataRange CompositeNode::getDataRange(const RenderRequest& request) const {
+// 各入力の行範囲を kBucketShift 単位のバケットに登録（CSR形式）
+// バケット内は入力番号順（= 前面から順）に並ぶ
+// 範囲不明の入力は全バケットと unboundedInputs_ に登録する
+void CompositeNode::buildInputIndex() {
+    bucketStart_.clear();
+    bucketInputs_.clear();
+    unboundedInputs_.clear();
+
+    int32_t top = INT32_MAX, bottom = INT32_MIN;
+    for (size_t i = 0; i < inputBounds_.size(); ++i) {
+        const InputBounds& b = inputBounds_[i];
+        if (b.unbounded) {
+            unboundedInputs_.push_back(static_cast<uint16_t>(i));
+            continue;
+        }
+        top = std::min(top, b.rowTop);
+        bottom = std::max(bottom, b.rowBottom);
+    }
+    if (top >= bottom) return;
+
+    bucketTop_ = top;
+    const auto bucketOf = [this](int32_t row) {
+        return static_cast<size_t>((row - bucketTop_) >> kBucketShift);
+    };
+    const size_t bucketCount = bucketOf(bottom - 1) + 1;
+    const auto firstBucket = [&](const InputBounds& b) { return b.unbounded ? 0 : bucketOf(b.rowTop); };
+    const auto lastBucket = [&](const InputBounds& b) {
+        return b.unbounded ? bucketCount - 1 : bucketOf(b.rowBottom - 1);
+    };
+
+    // 1パス目: バケットごとの件数、2パス目: 登録
+    bucketStart_.assign(bucketCount + 1, 0);
+    for (const auto& b : inputBounds_) {
+        for (size_t k = firstBucket(b); k <= lastBucket(b); ++k) {
+            ++bucketStart_[k + 1];
+        }
+    }
+    for (size_t k = 0; k < bucketCount; ++k) {
+        bucketStart_[k + 1] += bucketStart_[k];
+    }
+    bucketInputs_.resize(bucketStart_[bucketCount]);
+    std::vector<uint32_t> cursor(bucketStart_.begin(), bucketStart_.end() - 1);
+    for (size_t i = 0; i < inputBounds_.size(); ++i) {
+        const InputBounds& b = inputBounds_[i];
+        for (size_t k = firstBucket(b); k <= lastBucket(b); ++k) {
+            bucketInputs_[cursor[k]++] = static_cast<uint16_t>(i);
+        }
+    }
+}
+
+// スキャンラインの行に有効な入力を収集
+// インデックス未構築（Prepare前・入力数変更後）や複数行リクエストは全入力
+void CompositeNode::collectActiveInputs(const RenderRequest& request) const {
+    activeInputs_.clear();
+    const auto numInputs = inputCount();
+    if (request.height != 1 || inputBounds_.size() != static_cast<size_t>(numInputs)) {
+        for (int_fast16_t i = 0; i < numInputs; ++i) {
+            activeInputs_.push_back(static_cast<uint16_t>(i));
+        }
+        return;
+    }
+
+    const int32_t row = from_fixed_floor(request.origin.y);
+    const size_t bucket = (row >= bucketTop_)
+        ? static_cast<size_t>((row - bucketTop_) >> kBucketShift) : bucketStart_.size();
+    if (bucket + 1 < bucketStart_.size()) {
+        for (uint32_t k = bucketStart_[bucket]; k < bucketStart_[bucket + 1]; ++k) {
+            const uint16_t index = bucketInputs_[k];
+            const InputBounds& b = inputBounds_[index];
+            if (b.unbounded || (row >= b.rowTop && row < b.rowBottom)) {
+                activeInputs_.push_back(index);
+            }
+        }
+    } else {
+        activeInputs_.assign(unboundedInputs_.begin(), unboundedInputs_.end());
+    }
+}
+
+// 全上流のセグメントを統合してキャッシュ
+// 上流ごとのセグメントを作業配列に追加し、溢れる前に正規化（結合）する
+void CompositeNode::updateRangeCache(const RenderRequest& request) const {
     // キャッシュヒットチェック
     if (dataRangeCache_.valid
         && dataRangeCache_.origin.x == request.origin.x
         && dataRangeCache_.origin.y == request.origin.y
         && dataRangeCache_.width == request.width) {
-        return dataRangeCache_.range;
+        return;
     }
 
-    auto numInputs = inputCount();
-    int_fast16_t startX = request.width;  // 右端で初期化
-    int_fast16_t endX = 0;                // 左端で初期化
+    DataRange merged[MAX_DATA_SEGMENTS * 2];
+    int_fast16_t count = 0;
 
-    for (int_fast16_t i = 0; i < numInputs; ++i) {
+    // この行に有効な入力のみを評価
+    collectActiveInputs(request);
+    for (const uint16_t i : activeInputs_) {
         Node* upstream = upstreamNode(i);
         if (!upstream) continue;
 
-        DataRange range = upstream->getDataRange(request);
-        if (!range.hasData()) continue;
-
-        // 和集合を更新
-        if (range.startX < startX) startX = range.startX;
-        if (range.endX > endX) endX = range.endX;
+        DataRange segs[MAX_DATA_SEGMENTS];
+        int_fast16_t n = upstream->getDataSegments(request, segs, MAX_DATA_SEGMENTS);
+        for (int_fast16_t k = 0; k < n; ++k) {
+            if (count == MAX_DATA_SEGMENTS * 2) {
+                count = normalizeDataSegments(merged, count, MAX_DATA_SEGMENTS, kMinSegmentGap);
+            }
+            merged[count++] = segs[k];
+        }
     }
+    count = normalizeDataSegments(merged, count, MAX_DATA_SEGMENTS, kMinSegmentGap);
 
+    for (int_fast16_t k = 0; k < count; ++k) {
+        dataRangeCache_.segments[k] = merged[k];
+    }
+    dataRangeCache_.segmentCount = count;
     // startX >= endX はデータなし
-    DataRange result = (startX < endX)
-        ? DataRange{static_cast<int16_t>(startX), static_cast<int16_t>(endX)}
+    dataRangeCache_.range = (count > 0)
+        ? DataRange{merged[0].startX, merged[count - 1].endX}
         : DataRange{0, 0};
-
-    // キャッシュ更新
     dataRangeCache_.origin = request.origin;
     dataRangeCache_.width = request.width;
-    dataRangeCache_.range = result;
     dataRangeCache_.valid = true;
+}
 
-    return result;
+// getDataRange: 全上流のセグメントの和集合を返す
+// 同一スキャンラインでの重複呼び出しはキャッシュで高速化
+DataRange CompositeNode::getDataRange(const RenderRequest& request) const {
+    updateRangeCache(request);
+    return dataRangeCache_.range;
+}
+
+// getDataSegments: 統合済みセグメントを返す
+// maxCount を超える場合は末尾のセグメントをまとめる
+int_fast16_t CompositeNode::getDataSegments(const RenderRequest& request,
+                                            DataRange* segments, int_fast16_t maxCount) const {
+    updateRangeCache(request);
+    const int_fast16_t count = dataRangeCache_.segmentCount;
+    if (maxCount <= 0 || count == 0) return 0;
+    const int_fast16_t n = std::min(count, maxCount);
+    for (int_fast16_t k = 0; k < n; ++k) {
+        segments[k] = dataRangeCache_.segments[k];
+    }
+    segments[n - 1].endX = dataRangeCache_.segments[count - 1].endX;
+    return n;
+}
+
+int_fast16_t CompositeNode::collectVisibleSpans(const uint8_t* compositeRow, int16_t bufStartX,
+                                               int16_t startX, int16_t endX, DataRange* spans) {
+    const uint8_t* alpha = compositeRow + (startX - bufStartX) * 4 + 3;
+    int_fast16_t count = 0;
+    int_fast16_t x = startX;
+    while (x < endX) {
+        // 不透明区間をスキップ
+        while (x < endX && *alpha == 255) { ++x; alpha += 4; }
+        if (x >= endX) break;
+        const int_fast16_t spanStart = x;
+        while (x < endX && *alpha != 255) { ++x; alpha += 4; }
+
+        // 直前の区間との間の不透明区間が短い、または区間数が上限なら結合
+        if (count > 0 && (spanStart - spans[count - 1].endX < kMinOcclusionRun
+                          || count == kMaxVisibleSpans)) {
+            spans[count - 1].endX = static_cast<int16_t>(x);
+        } else {
+            spans[count++] = DataRange{static_cast<int16_t>(spanStart), static_cast<int16_t>(x)};
+        }
+    }
+    return count;
 }
 
 // onPullProcess: 複数の上流から画像を取得してunder合成
 // 単一バッファ事前確保方式:
-// - getDataRangeで合成範囲を事前計算
-// - hintRangeサイズの合成バッファをゼロ初期化で確保
+// - getDataSegmentsで合成範囲（セグメントリスト）を事前計算
+// - hintRangeサイズの合成バッファを確保し、セグメント内をゼロ初期化
 // - 各上流の結果をblendFromで直接書き込み
+// - 2番目以降の上流は、まだ不透明でない区間のみをリクエスト（遮蔽カリング）
+// - ブレンドモードを含む場合は背景バッファで背面から合成（クラス説明を参照）
+// - 複数セグメントの場合は出力にセグメントを設定（セグメント外は未初期化）
 RenderResponse& CompositeNode::onPullProcess(const RenderRequest& request) {
     auto numInputs = inputCount();
     if (numInputs == 0) return makeEmptyResponse(request.origin);
 
-    // 1. hintRange取得（キャッシュ付き）
-    DataRange hintRange = getDataRange(request);
-    if (!hintRange.hasData()) return makeEmptyResponse(request.origin);
+    // 1. セグメント取得（キャッシュ付き）
+    DataRange segments[MAX_DATA_SEGMENTS];
+    const int_fast16_t segmentCount = getDataSegments(request, segments, MAX_DATA_SEGMENTS);
+    if (segmentCount == 0) return makeEmptyResponse(request.origin);
+    const DataRange hintRange{segments[0].startX, segments[segmentCount - 1].endX};
+
+    // 2. 合成バッファ確保
+    // 複数セグメント: セグメント内のみゼロ初期化（プール枯渇時は全体をゼロ初期化）
+    DataRange* bufSegments = (segmentCount > 1)
+        ? context_->acquireSegments(static_cast<int>(segmentCount)) : nullptr;
+    const bool sparse = (bufSegments != nullptr);
 
-    // 2. 合成バッファ確保（ゼロ初期化）
     int16_t hintWidth = static_cast<int16_t>(hintRange.endX - hintRange.startX);
     Point compositeOrigin = request.origin;
     compositeOrigin.x += to_fixed(hintRange.startX);
 
     RenderResponse& resp = context_->acquireResponse();
     ImageBuffer* compositeBuf = resp.createBuffer(
-        hintWidth, 1, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+        hintWidth, 1, PixelFormatIDs::RGBA8_Straight,
+        sparse ? InitPolicy::Uninitialized : InitPolicy::Zero);
 
     if (!compositeBuf || !compositeBuf->isValid()) {
         return resp;  // alloc失敗
     }
     compositeBuf->setOrigin(compositeOrigin);
+    uint8_t* compositeRow = static_cast<uint8_t*>(compositeBuf->data());
+
+    if (sparse) {
+        // セグメントをバッファ左端基準に変換し、セグメント内のみゼロ初期化
+        for (int_fast16_t k = 0; k < segmentCount; ++k) {
+            bufSegments[k] = DataRange{
+                static_cast<int16_t>(segments[k].startX - hintRange.startX),
+                static_cast<int16_t>(segments[k].endX - hintRange.startX)};
+            std::memset(compositeRow + bufSegments[k].startX * 4, 0,
+                        static_cast<size_t>(bufSegments[k].width()) * 4);
+        }
+    }
+    // request座標系 → 合成バッファのstartX()座標系（blendFromのクリップ範囲用）
+    const int_fast16_t bufOffset = compositeBuf->startX() - hintRange.startX;
 
     // 3. 各上流を処理
-    for (int_fast16_t i = 0; i < numInputs; ++i) {
+    // target: 合成先バッファ、blendFunc: nullptrならunder合成、それ以外はモードの合成関数
+    bool hasContent = false;  // 合成バッファに描画済みか（未描画なら遮蔽判定不要）
+    auto compositeInput = [&](int_fast16_t i, ImageBuffer& target, blend::BlendOverFunc blendFunc) {
         Node* upstream = upstreamNode(i);
-        if (!upstream) continue;
+        if (!upstream) return;
+
+        // 入力の有効範囲をセグメントごとに絞り込み、
+        // 描画済みなら、まだ不透明でない区間のみを求める（遮蔽カリング）
+        DataRange spans[MAX_DATA_SEGMENTS * kMaxVisibleSpans];
+        int_fast16_t spanCount = 0;
+        const bool narrowed = hasContent || sparse;
+        if (narrowed) {
+            DataRange inputRange = upstream->getDataRange(request);
+            for (int_fast16_t k = 0; k < segmentCount; ++k) {
+                const int16_t startX = std::max(inputRange.startX, segments[k].startX);
+                const int16_t endX = std::min(inputRange.endX, segments[k].endX);
+                if (startX >= endX) continue;
+                if (hasContent) {
+                    spanCount += collectVisibleSpans(compositeRow, hintRange.startX,
+                                                     startX, endX, spans + spanCount);
+                } else {
+                    spans[spanCount++] = DataRange{startX, endX};
+                }
+            }
+            if (spanCount == 0) return;  // 範囲外または全て不透明: 上流を評価しない
+        } else {
+            spans[0] = DataRange{0, request.width};
+            spanCount = 1;
+        }
+
+        for (int_fast16_t s = 0; s < spanCount; ++s) {
+            // 区間に絞り込んだリクエスト（全幅の場合は元のリクエストのまま）
+            RenderRequest spanRequest = request;
+            int_fast16_t clipStartX = INT16_MIN;
+            int_fast16_t clipEndX = INT16_MAX;
+            if (narrowed) {
+                spanRequest.origin.x += to_fixed(spans[s].startX);
+                spanRequest.width = spans[s].width();
+                // 疎バッファではセグメント外（未初期化）に書き込まない
+                if (sparse) {
+                    clipStartX = bufOffset + spans[s].startX;
+                    clipEndX = bufOffset + spans[s].endX;
+                }
+            }
+
+            RenderResponse& input = upstream->pullProcess(spanRequest);
+            if (!input.isValid()) {
+                context_->releaseResponse(input);
+                continue;
+            }
+
+            FLEXIMG_METRICS_SCOPE(NodeType::Composite);
+
+            if (!input.hasBuffer()) {
+                context_->releaseResponse(input);
+                continue;
+            }
+            if (blendFunc) {
+                // ブレンドモード: RGBA8_Straightに揃えて合成関数で重ねる
+                consolidateIfNeeded(input, PixelFormatIDs::RGBA8_Straight);
+                const ImageBuffer& src = input.buffer();
+                const int_fast16_t startX = std::max<int_fast16_t>(
+                    {src.startX(), target.startX(), clipStartX});
+                const int_fast16_t endX = std::min<int_fast16_t>(
+                    {src.endX(), target.endX(), clipEndX});
+                if (startX < endX) {
+                    blendFunc(static_cast<uint8_t*>(target.data()) + (startX - target.startX()) * 4,
+                              static_cast<const uint8_t*>(src.data()) + (startX - src.startX()) * 4,
+                              static_cast<size_t>(endX - startX));
+                }
+            } else if (input.hasSegments()) {
+                // 上流が疎バッファならセグメント単位でblendFrom
+                const ImageBuffer& src = input.buffer();
+                for (int_fast16_t k = 0; k < input.segmentCount(); ++k) {
+                    const DataRange& seg = input.segments()[k];
+                    target.blendFrom(
+                        src,
+                        std::max<int_fast16_t>(clipStartX, src.startX() + seg.startX),
+                        std::min<int_fast16_t>(clipEndX, src.startX() + seg.endX));
+                }
+            } else {
+                target.blendFrom(input.buffer(), clipStartX, clipEndX);
+            }
+            if (&target == compositeBuf) hasContent = true;
 
-        RenderResponse& input = upstream->pullProcess(request);
-        if (!input.isValid()) {
             context_->releaseResponse(input);
-            continue;
         }
+    };
 
-        FLEXIMG_METRICS_SCOPE(NodeType::Composite);
+    // この行に有効な入力（入力番号順、getDataSegmentsで更新済み）
+    const uint16_t* active = activeInputs_.data();
+    const auto activeCount = static_cast<int_fast16_t>(activeInputs_.size());
 
-        // 上流のバッファをblendFrom
-        if (input.hasBuffer()) {
-            compositeBuf->blendFrom(input.buffer());
-        }
+    // 3a. 最前面の非Normal入力より前面: 合成バッファにunder合成
+    const int_fast16_t frontEnd = std::min(blendFirst_, numInputs);
+    int_fast16_t a = 0;
+    for (; a < activeCount && active[a] < frontEnd; ++a) {
+        compositeInput(active[a], *compositeBuf, nullptr);
+    }
 
-        context_->releaseResponse(input);
+    // 3b. ブレンドモードを含む場合: 背景バッファで背面から合成し、合成バッファの背面に重ねる
+    if (a < activeCount) {
+        ImageBuffer backdrop(hintWidth, 1, PixelFormatIDs::RGBA8_Straight,
+                             InitPolicy::Zero, context_->allocator());
+        if (backdrop.isValid()) {
+            backdrop.setOrigin(compositeOrigin);
+            const int_fast16_t lastBlend = std::min<int_fast16_t>(blendLast_, numInputs - 1);
+            // 最背面の非Normal入力より背面（Normalのみ）はunder合成
+            int_fast16_t b = a;
+            while (b < activeCount && active[b] <= lastBlend) ++b;
+            for (int_fast16_t k = b; k < activeCount; ++k) {
+                compositeInput(active[k], backdrop, nullptr);
+            }
+            // 非Normal入力を含む区間は背面から順にモードの合成関数で重ねる
+            for (int_fast16_t k = b - 1; k >= a; --k) {
+                compositeInput(active[k], backdrop, blendFuncs_[active[k]]);
+            }
+            if (sparse) {
+                for (int_fast16_t k = 0; k < segmentCount; ++k) {
+                    compositeBuf->blendFrom(backdrop, bufOffset + segments[k].startX,
+                                            bufOffset + segments[k].endX);
+                }
+            } else {
+                compositeBuf->blendFrom(backdrop);
+            }
+        }
     }
 
     resp.origin = compositeOrigin;
+    if (sparse) {
+        resp.setSegments(bufSegments, segmentCount);
+    }
     return resp;
 }
 
@@ -0,0 +1,929 @@
+#ifndef FLEXIMG_CONVOLUTION_NODE_H
+#define FLEXIMG_CONVOLUTION_NODE_H
+
+#include "../core/node.h"
+#include "../core/perf_metrics.h"
+#include "../core/render_context.h"
+#include "../image/image_buffer.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace FLEXIMG_NAMESPACE {
+
+// ========================================================================
+// ConvolutionNode - 汎用畳み込みフィルタノード（シャープ・エッジ検出・エンボス）
+// ========================================================================
+//
+// 入力画像に最大 7×7 の整数カーネルを適用します。
+// - 入力: 1ポート
+// - 出力: 1ポート（RGBA8_Straight、上流が Alpha8 / Grayscale8 なら同じフォーマット）
+// - カーネル: width × height（各 1〜7）の整数重み（行優先、±kMaxWeight）
+// - divisor: 重み付き和の除数（0 で重みの合計、合計が0なら1）
+// - bias: 除算後に加えるオフセット（ストレート値、エンボスの中間灰色など）
+//
+// 計算（相関、アンカーはカーネル中央 ((width-1)/2, (height-1)/2)）:
+// - RGBA8: プリマルチプライド [R×A/255, G×A/255, B×A/255, A] に適用し、
+//   A を [0, 255]、RGB を [0, A] に飽和させてからストレートへ戻す
+// - preserveAlpha: A は中心ピクセルの値をそのまま使い、RGB のみ畳み込む
+//   （重みの合計が0のエッジ検出などで出力が透明になるのを防ぐ）
+// - 単一チャンネルパス: Alpha8 / Grayscale8 は値を直接畳み込む（preserveAlpha は無視）
+//
+// 処理方式（スキャンライン）:
+// - 上流の行を16bit整数の行リング（height 行）に保持する（VerticalBlurNode と同様）
+// - 積和は2タップずつ 16bit × 16bit → 32bit の pmaddwd（SSE2 / AVX2）で計算
+// - 分離可能なカーネル（重み行列が 列ベクトル × 行ベクトル に分解できる）は
+//   prepare 時に自動検出し、水平 width タップ → 行リング → 垂直 height タップの
+//   2段で処理する（タップ数 width×height → width+height）
+//
+// 制約:
+// - pull型のみ対応
+//
+// 使用例:
+//   ConvolutionNode sharpen;
+//   sharpen.setSharpen(1);
+//   camera >> sharpen >> sink;
+//
+//   static const int16_t sobelX[] = {-1, 0, 1, -2, 0, 2, -1, 0, 1};
+//   ConvolutionNode edge;
+//   edge.setKernel(3, 3, sobelX, 1, 128);  // 分離可能として処理される
+//   edge.setPreserveAlpha(true);
+//
+
+class ConvolutionNode : public Node {
+public:
+    ConvolutionNode() {
+        initPorts(1, 1);
+        weights_[0] = 1;  // 既定: 1×1 恒等カーネル（パススルー）
+    }
+
+    // ========================================
+    // パラメータ設定
+    // ========================================
+
+    // パラメータ上限
+    static constexpr int kMaxKernelSize = 7;
+    static constexpr int kMaxWeight = 1023;  // 32bit 累積が溢れない範囲
+
+    // weights: height 行 × width 列（行優先）
+    void setKernel(int_fast16_t width, int_fast16_t height, const int16_t* weights,
+                   int32_t divisor = 0, int16_t bias = 0) {
+        kernelWidth_ = clampSize(width);
+        kernelHeight_ = clampSize(height);
+        int32_t sum = 0;
+        for (int i = 0; i < kMaxKernelSize * kMaxKernelSize; i++) {
+            weights_[i] = 0;
+        }
+        for (int_fast16_t i = 0; i < kernelWidth_ * kernelHeight_; i++) {
+            const int16_t w = weights ? weights[i] : 0;
+            weights_[i] = static_cast<int16_t>((w < -kMaxWeight) ? -kMaxWeight : (w > kMaxWeight) ? kMaxWeight : w);
+            sum += weights_[i];
+        }
+        divisor_ = (divisor != 0) ? divisor : (sum != 0) ? sum : 1;
+        bias_ = bias;
+        markModified();
+    }
+
+    void setPreserveAlpha(bool preserve) {
+        preserveAlpha_ = preserve;
+        markModified();
+    }
+
+    // プリセット: シャープ（中心 1+4s、上下左右 -s）
+    void setSharpen(int16_t strength = 1) {
+        const int16_t s = std::max<int16_t>(0, std::min<int16_t>(strength, 255));
+        const int16_t k[] = {0, static_cast<int16_t>(-s), 0,
+                             static_cast<int16_t>(-s), static_cast<int16_t>(1 + 4 * s), static_cast<int16_t>(-s),
+                             0, static_cast<int16_t>(-s), 0};
+        setKernel(3, 3, k, 1, 0);
+        setPreserveAlpha(false);
+    }
+
+    // プリセット: エッジ検出（8近傍ラプラシアン、アルファ保持）
+    void setEdgeDetect() {
+        static const int16_t k[] = {-1, -1, -1, -1, 8, -1, -1, -1, -1};
+        setKernel(3, 3, k, 1, 0);
+        setPreserveAlpha(true);
+    }
+
+    // プリセット: エンボス（左上から右下への起伏、中間灰色 128 基準、アルファ保持）
+    void setEmboss() {
+        static const int16_t k[] = {-1, -1, 0, -1, 0, 1, 0, 1, 1};
+        setKernel(3, 3, k, 1, 128);
+        setPreserveAlpha(true);
+    }
+
+    int16_t kernelWidth() const { return kernelWidth_; }
+    int16_t kernelHeight() const { return kernelHeight_; }
+    int16_t weight(int_fast16_t x, int_fast16_t y) const {
+        return weights_[y * kernelWidth_ + x];
+    }
+    int32_t divisor() const { return divisor_; }
+    int16_t bias() const { return bias_; }
+    bool preserveAlpha() const { return preserveAlpha_; }
+
+    // 直近の prepare で分離可能カーネルとして処理されたか
+    bool isSeparable() const { return separable_; }
+
+    // ========================================
+    // Node インターフェース
+    // ========================================
+
+    const char* name() const override { return "ConvolutionNode"; }
+
+    // getDataRange: 水平は上流範囲のカーネル幅分の拡張、垂直はカーネル高さ分の行の和集合
+    DataRange getDataRange(const RenderRequest& request) const override;
+
+    void finalize() override;
+
+protected:
+    int nodeTypeForMetrics() const override { return NodeType::Convolution; }
+
+    PrepareResponse onPullPrepare(const PrepareRequest& request) override;
+    RenderResponse& onPullProcess(const RenderRequest& request) override;
+
+private:
+    int16_t kernelWidth_ = 1;
+    int16_t kernelHeight_ = 1;
+    int16_t weights_[kMaxKernelSize * kMaxKernelSize] = {};
+    int32_t divisor_ = 1;
+    int16_t bias_ = 0;
+    bool preserveAlpha_ = false;
+
+    static int16_t clampSize(int_fast16_t size) {
+        return static_cast<int16_t>((size < 1) ? 1 : (size > kMaxKernelSize) ? kMaxKernelSize : size);
+    }
+
+    // アンカー（カーネル中央）と出力の拡張量
+    int_fast16_t anchorX() const { return (kernelWidth_ - 1) / 2; }
+    int_fast16_t anchorY() const { return (kernelHeight_ - 1) / 2; }
+    int_fast16_t expandLeft() const { return kernelWidth_ - 1 - anchorX(); }
+    int_fast16_t expandTop() const { return kernelHeight_ - 1 - anchorY(); }
+
+    // 0 でない重み（row: カーネル行、col: カーネル列）
+    struct Tap {
+        int16_t row;
+        int16_t col;
+        int16_t weight;
+    };
+
+    // prepare で決定する処理方式
+    bool passThrough_ = true;
+    bool separable_ = false;
+    std::vector<Tap> taps_;      // 非分離: 全タップ / 分離: 垂直タップ（col=0）
+    std::vector<Tap> rowTaps_;   // 分離: 水平タップ（row=0）
+    int_fast16_t rowShift_ = 0;  // 分離: 水平結果を16bitに収める右シフト量
+    float scale_ = 1.0f;         // 累積値 → 出力値（2^rowShift / divisor）
+
+    // 行リング（16bit、プリマルチプライド [R, G, B, A] または単一チャンネル値）
+    // 非分離: 上流の行（パディング幅 = cacheWidth_ + kernelWidth_ - 1）
+    // 分離: 水平タップ適用後の行（幅 = cacheWidth_）
+    PixelFormatID channelFormat_ = nullptr;  // 単一チャンネルパスのフォーマット（nullptr = RGBA8）
+    int16_t cacheWidth_ = 0;
+    int_fixed cacheOriginX_ = 0;
+    size_t ringStride_ = 0;                  // 1行の要素数
+    std::vector<int16_t> ring_;
+    std::vector<int32_t> slotRow_;           // 各スロットに格納中の行（INT32_MIN = 未使用）
+    std::vector<DataRange> slotRange_;       // 各スロットの格納範囲（範囲外は0）
+    std::vector<int16_t> alphaRing_;         // 分離 + preserveAlpha: 中心アルファの行リング（幅 cacheWidth_）
+    std::vector<int16_t> line_;              // 分離: 上流の1行（パディング幅、範囲外は0）
+    DataRange lineRange_{0, 0};
+    std::vector<int32_t> acc_;               // 積和の累積（再利用）
+
+    // getDataRange/pullProcess 間のキャッシュ
+    struct DataRangeCache {
+        Point origin = {INT32_MIN, INT32_MIN};
+        int16_t startX = 0;
+        int16_t endX = 0;
+    };
+    mutable DataRangeCache rangeCache_;
+
+    // getDataRange のスライディングウィンドウ（VerticalBlurNode と同じ単調デック方式）
+    struct RowQueue {
+        std::vector<int32_t> rows;
+        size_t head = 0;
+        size_t count = 0;
+
+        void reset(size_t capacity) { rows.assign(capacity, 0); head = 0; count = 0; }
+        bool empty() const { return count == 0; }
+        int32_t front() const { return rows[head]; }
+        int32_t back() const { return rows[(head + count - 1) % rows.size()]; }
+        void popFront() { head = (head + 1) % rows.size(); --count; }
+        void popBack() { --count; }
+        void pushBack(int32_t row) { rows[(head + count) % rows.size()] = row; ++count; }
+    };
+    struct RangeWindow {
+        std::vector<DataRange> history;
+        RowQueue minStart;
+        RowQueue maxEnd;
+        Point origin = {INT32_MIN, INT32_MIN};
+        int16_t width = 0;
+        bool valid = false;
+
+        size_t slot(int32_t row) const {
+            const auto n = static_cast<int32_t>(history.size());
+            const int32_t m = row % n;
+            return static_cast<size_t>(m < 0 ? m + n : m);
+        }
+    };
+    mutable RangeWindow rangeWindow_;
+
+    PixelFormatID workFormat() const { return channelFormat_ ? channelFormat_ : PixelFormatIDs::RGBA8_Straight; }
+    size_t lanes() const { return channelFormat_ ? 1 : 4; }
+    int16_t paddedWidth() const { return static_cast<int16_t>(cacheWidth_ + kernelWidth_ - 1); }
+
+    // カーネルの分解と16bit固定小数点の準備（passThrough_ / separable_ / taps_ を決定）
+    void planKernel();
+
+    // 水平方向の1行のデータ範囲（上流範囲をカーネル幅分拡張）
+    DataRange horizontalRange(const RenderRequest& request) const;
+    void pushRangeRow(const RenderRequest& request, int_fast16_t dy) const;
+
+    // 上流の行 srcY をパディング幅の16bit行 dst に格納（stored: 前回の格納範囲、更新される）
+    void fetchRow(int_fast32_t srcY, int16_t* dst, DataRange& stored);
+    // 出力行 y に必要な上流行をリングに揃える
+    void ensureRows(int_fast32_t y);
+    void storeSeparableRow(int_fast32_t srcY, size_t slot);
+
+    // taps を rows（カーネル行ごとの先頭）に適用し acc_ に count ピクセル分累積
+    void accumulateTaps(const std::vector<Tap>& taps, const int16_t* const* rows, size_t count);
+};
+
+} // namespace FLEXIMG_NAMESPACE
+
+// =============================================================================
+// 実装部
+// =============================================================================
+#ifdef FLEXIMG_IMPLEMENTATION
+
+#if defined(FLEXIMG_HAS_AVX2)
+#include <immintrin.h>
+#elif defined(FLEXIMG_HAS_SSE2)
+#include <emmintrin.h>
+#endif
+
+namespace FLEXIMG_NAMESPACE {
+
+namespace convolution_detail {
+
+// 2タップ積和: acc[k] += wa * a[k] + wb * b[k]
+// weights: (wb << 16) | (uint16)wa（pmaddwd の隣接ペアに対応）
+
+static inline void macPairScalar(int32_t* acc, const int16_t* a, const int16_t* b,
+                                 int32_t wa, int32_t wb, size_t begin, size_t n) {
+    for (size_t k = begin; k < n; k++) {
+        acc[k] += wa * a[k] + wb * b[k];
+    }
+}
+
+#ifdef FLEXIMG_HAS_SSE2
+// 8要素/反復
+static inline size_t macPairSSE2(int32_t* acc, const int16_t* a, const int16_t* b,
+                                 int32_t weights, size_t n) {
+    const __m128i w = _mm_set1_epi32(weights);
+    size_t k = 0;
+    for (; k + 8 <= n; k += 8) {
+        const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + k));
+        const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + k));
+        __m128i* s = reinterpret_cast<__m128i*>(acc + k);
+        _mm_storeu_si128(s, _mm_add_epi32(_mm_loadu_si128(s),
+                                          _mm_madd_epi16(_mm_unpacklo_epi16(va, vb), w)));
+        _mm_storeu_si128(s + 1, _mm_add_epi32(_mm_loadu_si128(s + 1),
+                                              _mm_madd_epi16(_mm_unpackhi_epi16(va, vb), w)));
+    }
+    return k;
+}
+#endif // FLEXIMG_HAS_SSE2
+
+#ifdef FLEXIMG_HAS_AVX2
+// 16要素/反復（unpack は128bitレーン単位のため、結果を要素順に並べ替えて累積）
+static inline size_t macPairAVX2(int32_t* acc, const int16_t* a, const int16_t* b,
+                                 int32_t weights, size_t n) {
+    const __m256i w = _mm256_set1_epi32(weights);
+    size_t k = 0;
+    for (; k + 16 <= n; k += 16) {
+        const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + k));
+        const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + k));
+        const __m256i lo = _mm256_madd_epi16(_mm256_unpacklo_epi16(va, vb), w);  // k0-3 | k8-11
+        const __m256i hi = _mm256_madd_epi16(_mm256_unpackhi_epi16(va, vb), w);  // k4-7 | k12-15
+        __m256i* s = reinterpret_cast<__m256i*>(acc + k);
+        _mm256_storeu_si256(s, _mm256_add_epi32(_mm256_loadu_si256(s),
+                                                _mm256_permute2x128_si256(lo, hi, 0x20)));
+        _mm256_storeu_si256(s + 1, _mm256_add_epi32(_mm256_loadu_si256(s + 1),
+                                                    _mm256_permute2x128_si256(lo, hi, 0x31)));
+    }
+    return k;
+}
+#endif // FLEXIMG_HAS_AVX2
+
+static inline void macPair(int32_t* acc, const int16_t* a, const int16_t* b,
+                           int16_t wa, int16_t wb, size_t n) {
+    const auto weights = static_cast<int32_t>(
+        (static_cast<uint32_t>(static_cast<uint16_t>(wb)) << 16) | static_cast<uint16_t>(wa));
+#if defined(FLEXIMG_HAS_AVX2)
+    const size_t done = macPairAVX2(acc, a, b, weights, n);
+#elif defined(FLEXIMG_HAS_SSE2)
+    const size_t done = macPairSSE2(acc, a, b, weights, n);
+#else
+    const size_t done = 0;
+    (void)weights;
+#endif
+    macPairScalar(acc, a, b, wa, wb, done, n);
+}
+
+// x / 255 の四捨五入（0 ≤ x ≤ 65025）
+static inline int16_t div255(uint32_t x) {
+    return static_cast<int16_t>((x + 128 + ((x + 128) >> 8)) >> 8);
+}
+
+// RGBA8_Straight count ピクセル → プリマルチプライド16bit
+static inline void premultiplyRow(int16_t* dst, const uint8_t* src, size_t count) {
+    for (size_t i = 0; i < count; i++, src += 4, dst += 4) {
+        const uint32_t a = src[3];
+        dst[0] = div255(src[0] * a);
+        dst[1] = div255(src[1] * a);
+        dst[2] = div255(src[2] * a);
+        dst[3] = static_cast<int16_t>(a);
+    }
+}
+
+// 累積値 → 出力値（SIMD 版とスカラー版は同じ float 演算順序で結果が一致する）
+// - A = trunc(clamp(ΣA × scale + 0.5, 0, 255))（preserveAlpha 時は中心アルファ）
+// - P = trunc(clamp(ΣP × scale + bias × A / 255 + 0.5, 0, A))
+// - C = trunc(P × (255 / A) + 0.5)
+// centerA: preserveAlpha 時の中心アルファ（centerStride 要素間隔）、nullptr なら A も畳み込み結果
+
+static inline void resolvePixelScalar(uint8_t* dst, const int32_t* acc, float scale,
+                                      float biasScale, const int16_t* centerA) {
+    const float af = centerA
+        ? static_cast<float>(*centerA)
+        : static_cast<float>(static_cast<int32_t>(
+              std::min(std::max(static_cast<float>(acc[3]) * scale + 0.5f, 0.0f), 255.0f)));
+    if (af == 0.0f) {
+        dst[0] = dst[1] = dst[2] = dst[3] = 0;
+        return;
+    }
+    const float biasP = biasScale * af;
+    const float unpremul = 255.0f / af;
+    for (int c = 0; c < 3; c++) {
+        const auto p = static_cast<float>(static_cast<int32_t>(
+            std::min(std::max(static_cast<float>(acc[c]) * scale + biasP + 0.5f, 0.0f), af)));
+        dst[c] = static_cast<uint8_t>(p * unpremul + 0.5f);
+    }
+    dst[3] = static_cast<uint8_t>(af);
+}
+
+static inline void resolvePixel1chScalar(uint8_t* dst, int32_t acc, float scale, float bias) {
+    *dst = static_cast<uint8_t>(std::min(std::max(static_cast<float>(acc) * scale + bias + 0.5f, 0.0f), 255.0f));
+}
+
+#ifdef FLEXIMG_HAS_SSE2
+// 1ピクセル/反復
+static inline size_t resolveRowRGBASSE2(uint8_t* dst, const int32_t* acc, size_t count, float scale,
+                                        float biasScale, const int16_t* centerA, size_t centerStride) {
+    const __m128 vScale = _mm_set1_ps(scale);
+    const __m128 vBias = _mm_set1_ps(biasScale);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 c255 = _mm_set1_ps(255.0f);
+    const __m128i maskRGB = _mm_set_epi32(0, -1, -1, -1);
+    const __m128i zeroI = _mm_setzero_si128();
+    for (size_t i = 0; i < count; i++) {
+        const __m128 v = _mm_mul_ps(_mm_cvtepi32_ps(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc + i * 4))), vScale);
+        __m128 af;
+        if (centerA) {
+            af = _mm_set1_ps(static_cast<float>(centerA[i * centerStride]));
+        } else {
+            const __m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(
+                _mm_min_ps(_mm_max_ps(_mm_add_ps(v, half), zero), c255)));
+            af = _mm_shuffle_ps(t, t, 0xFF);
+        }
+        __m128 p = _mm_min_ps(_mm_max_ps(_mm_add_ps(_mm_add_ps(v, _mm_mul_ps(vBias, af)), half), zero), af);
+        p = _mm_cvtepi32_ps(_mm_cvttps_epi32(p));
+        // A=0 のレーンは 0×inf=NaN になるが、最後にマスクで0にする
+        __m128i q = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(p, _mm_div_ps(c255, af)), half));
+        q = _mm_or_si128(_mm_and_si128(q, maskRGB), _mm_andnot_si128(maskRGB, _mm_cvttps_epi32(af)));
+        q = _mm_andnot_si128(_mm_castps_si128(_mm_cmpeq_ps(af, zero)), q);
+        const __m128i packed = _mm_packus_epi16(_mm_packs_epi32(q, q), zeroI);
+        const auto bits = static_cast<uint32_t>(_mm_cvtsi128_si32(packed));
+        std::memcpy(dst + i * 4, &bits, 4);
+    }
+    return count;
+}
+
+// 4要素/反復
+static inline size_t resolveRow1chSSE2(uint8_t* dst, const int32_t* acc, size_t count, float scale,
+                                       float bias) {
+    const __m128 vScale = _mm_set1_ps(scale);
+    const __m128 vBias = _mm_set1_ps(bias);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 c255 = _mm_set1_ps(255.0f);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128 v = _mm_mul_ps(_mm_cvtepi32_ps(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc + i))), vScale);
+        const __m128i q = _mm_cvttps_epi32(
+            _mm_min_ps(_mm_max_ps(_mm_add_ps(_mm_add_ps(v, vBias), half), zero), c255));
+        const __m128i packed = _mm_packus_epi16(_mm_packs_epi32(q, q), q);
+        const auto bits = static_cast<uint32_t>(_mm_cvtsi128_si32(packed));
+        std::memcpy(dst + i, &bits, 4);
+    }
+    return i;
+}
+#endif // FLEXIMG_HAS_SSE2
+
+// 累積値 count ピクセル分から RGBA8_Straight 出力行を計算
+static inline void resolveRowRGBA(uint8_t* dst, const int32_t* acc, size_t count, float scale,
+                                  int32_t bias, const int16_t* centerA, size_t centerStride) {
+    const float biasScale = static_cast<float>(bias) / 255.0f;
+#ifdef FLEXIMG_HAS_SSE2
+    size_t i = resolveRowRGBASSE2(dst, acc, count, scale, biasScale, centerA, centerStride);
+#else
+    size_t i = 0;
+#endif
+    for (; i < count; i++) {
+        resolvePixelScalar(dst + i * 4, acc + i * 4, scale, biasScale,
+                           centerA ? centerA + i * centerStride : nullptr);
+    }
+}
+
+// 累積値 count 要素から単一チャンネル出力行を計算
+static inline void resolveRow1ch(uint8_t* dst, const int32_t* acc, size_t count, float scale,
+                                 int32_t bias) {
+    const auto biasF = static_cast<float>(bias);
+#ifdef FLEXIMG_HAS_SSE2
+    size_t i = resolveRow1chSSE2(dst, acc, count, scale, biasF);
+#else
+    size_t i = 0;
+#endif
+    for (; i < count; i++) {
+        resolvePixel1chScalar(dst + i, acc[i], scale, biasF);
+    }
+}
+
+static inline int32_t gcd(int32_t a, int32_t b) {
+    while (b != 0) {
+        const int32_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+} // namespace convolution_detail
+
+// ============================================================================
+// ConvolutionNode - カーネルの準備
+// ============================================================================
+
+void ConvolutionNode::planKernel() {
+    const int_fast16_t kw = kernelWidth_;
+    const int_fast16_t kh = kernelHeight_;
+    taps_.clear();
+    rowTaps_.clear();
+    separable_ = false;
+    rowShift_ = 0;
+
+    passThrough_ = (kw == 1 && kh == 1 && weights_[0] == divisor_ && bias_ == 0);
+    if (passThrough_) return;
+
+    // 分離可能判定: 最初の非0行を gcd で割った行ベクトル r に対し、
+    // 全行が r の整数倍（係数 c[i]）なら K[i][j] = c[i] * r[j]
+    int16_t rowVec[kMaxKernelSize] = {};
+    int16_t colVec[kMaxKernelSize] = {};
+    if (kw > 1 && kh > 1) {
+        int_fast16_t firstRow = -1;
+        for (int_fast16_t i = 0; i < kh && firstRow < 0; i++) {
+            for (int_fast16_t j = 0; j < kw; j++) {
+                if (weights_[i * kw + j] != 0) { firstRow = i; break; }
+            }
+        }
+        if (firstRow >= 0) {
+            const int16_t* base = &weights_[firstRow * kw];
+            int32_t g = 0;
+            int_fast16_t pivot = -1;
+            for (int_fast16_t j = 0; j < kw; j++) {
+                g = convolution_detail::gcd(g, std::abs(static_cast<int32_t>(base[j])));
+                if (pivot < 0 && base[j] != 0) pivot = j;
+            }
+            if (base[pivot] < 0) g = -g;
+            for (int_fast16_t j = 0; j < kw; j++) {
+                rowVec[j] = static_cast<int16_t>(base[j] / g);
+            }
+            separable_ = true;
+            for (int_fast16_t i = 0; i < kh && separable_; i++) {
+                const int16_t* r = &weights_[i * kw];
+                if (r[pivot] % rowVec[pivot] != 0) { separable_ = false; break; }
+                colVec[i] = static_cast<int16_t>(r[pivot] / rowVec[pivot]);
+                for (int_fast16_t j = 0; j < kw; j++) {
+                    if (r[j] != colVec[i] * rowVec[j]) { separable_ = false; break; }
+                }
+            }
+        }
+    }
+
+    if (separable_) {
+        int32_t rowAbsSum = 0;
+        for (int_fast16_t j = 0; j < kw; j++) {
+            if (rowVec[j] != 0) rowTaps_.push_back(Tap{0, static_cast<int16_t>(j), rowVec[j]});
+            rowAbsSum += std::abs(static_cast<int32_t>(rowVec[j]));
+        }
+        for (int_fast16_t i = 0; i < kh; i++) {
+            if (colVec[i] != 0) taps_.push_back(Tap{static_cast<int16_t>(i), 0, colVec[i]});
+        }
+        // 水平結果の最大絶対値（丸め込み）が int16 に収まるシフト量
+        const int32_t maxAbs = 255 * rowAbsSum;
+        while (((maxAbs + ((1 << rowShift_) >> 1)) >> rowShift_) > INT16_MAX) {
+            ++rowShift_;
+        }
+    } else {
+        for (int_fast16_t i = 0; i < kh; i++) {
+            for (int_fast16_t j = 0; j < kw; j++) {
+                const int16_t w = weights_[i * kw + j];
+                if (w != 0) taps_.push_back(Tap{static_cast<int16_t>(i), static_cast<int16_t>(j), w});
+            }
+        }
+    }
+    scale_ = static_cast<float>(static_cast<double>(1 << rowShift_) / divisor_);
+}
+
+// ============================================================================
+// ConvolutionNode - データ範囲
+// ============================================================================
+
+DataRange ConvolutionNode::horizontalRange(const RenderRequest& request) const {
+    Node* upstream = upstreamNode(0);
+    if (!upstream) return DataRange();
+    if (kernelWidth_ == 1) return upstream->getDataRange(request);
+
+    // 出力 x はパディング座標 [x, x + kernelWidth) の入力を参照する
+    RenderRequest inputReq;
+    inputReq.width = static_cast<int16_t>(request.width + kernelWidth_ - 1);
+    inputReq.height = 1;
+    inputReq.origin.x = request.origin.x - to_fixed(static_cast<int>(anchorX()));
+    inputReq.origin.y = request.origin.y;
+    const DataRange upstreamRange = upstream->getDataRange(inputReq);
+    if (!upstreamRange.hasData()) return DataRange();
+
+    const auto startX = static_cast<int16_t>(std::max<int_fast16_t>(0, upstreamRange.startX - (kernelWidth_ - 1)));
+    const auto endX = static_cast<int16_t>(std::min<int_fast16_t>(request.width, upstreamRange.endX));
+    return (startX < endX) ? DataRange{startX, endX} : DataRange();
+}
+
+DataRange ConvolutionNode::getDataRange(const RenderRequest& request) const {
+    Node* upstream = upstreamNode(0);
+    if (!upstream) return DataRange();
+    if (passThrough_ || kernelHeight_ == 1) return passThrough_ ? upstream->getDataRange(request)
+                                                                : horizontalRange(request);
+
+    if (rangeCache_.origin.x == request.origin.x &&
+        rangeCache_.origin.y == request.origin.y) {
+        if (rangeCache_.startX >= rangeCache_.endX) return DataRange{0, 0};
+        return DataRange{rangeCache_.startX, rangeCache_.endX};
+    }
+
+    // 出力行Yは上流の行 Y-anchorY〜Y-anchorY+height-1 の和集合
+    const int_fast16_t top = anchorY();
+    const int_fast16_t bottom = kernelHeight_ - 1 - anchorY();
+    RangeWindow& window = rangeWindow_;
+    const bool sameColumn = window.valid && window.origin.x == request.origin.x
+                         && window.width == request.width;
+
+    if (sameColumn && request.origin.y == window.origin.y + to_fixed(1)) {
+        window.origin.y = request.origin.y;
+        pushRangeRow(request, bottom);
+        const int32_t firstRow = from_fixed_floor(request.origin.y) - static_cast<int32_t>(top);
+        while (!window.minStart.empty() && window.minStart.front() < firstRow) window.minStart.popFront();
+        while (!window.maxEnd.empty() && window.maxEnd.front() < firstRow) window.maxEnd.popFront();
+    } else if (!sameColumn || request.origin.y != window.origin.y) {
+        const auto windowRows = static_cast<size_t>(kernelHeight_);
+        window.history.assign(windowRows, DataRange{0, 0});
+        window.minStart.reset(windowRows);
+        window.maxEnd.reset(windowRows);
+        window.origin = request.origin;
+        window.width = request.width;
+        window.valid = true;
+        for (auto dy = static_cast<int_fast16_t>(-top); dy <= bottom; ++dy) {
+            pushRangeRow(request, dy);
+        }
+    }
+
+    int16_t startX = INT16_MAX;
+    int16_t endX = INT16_MIN;
+    if (!window.minStart.empty()) {
+        startX = window.history[window.slot(window.minStart.front())].startX;
+        endX = window.history[window.slot(window.maxEnd.front())].endX;
+    }
+    rangeCache_.origin = request.origin;
+    rangeCache_.startX = startX;
+    rangeCache_.endX = endX;
+
+    if (startX >= endX) return DataRange{0, 0};
+    return DataRange{startX, endX};
+}
+
+void ConvolutionNode::pushRangeRow(const RenderRequest& request, int_fast16_t dy) const {
+    RangeWindow& window = rangeWindow_;
+    RenderRequest rowRequest = request;
+    rowRequest.origin.y = request.origin.y + to_fixed(static_cast<int>(dy));
+    const DataRange rowRange = horizontalRange(rowRequest);
+
+    const int32_t row = from_fixed_floor(rowRequest.origin.y);
+    window.history[window.slot(row)] = rowRange;
+    if (!rowRange.hasData()) return;
+
+    while (!window.minStart.empty()
+           && window.history[window.slot(window.minStart.back())].startX >= rowRange.startX) {
+        window.minStart.popBack();
+    }
+    window.minStart.pushBack(row);
+    while (!window.maxEnd.empty()
+           && window.history[window.slot(window.maxEnd.back())].endX <= rowRange.endX) {
+        window.maxEnd.popBack();
+    }
+    window.maxEnd.pushBack(row);
+}
+
+// ============================================================================
+// ConvolutionNode - Template Method フック実装
+// ============================================================================
+
+PrepareResponse ConvolutionNode::onPullPrepare(const PrepareRequest& request) {
+    Node* upstream = upstreamNode(0);
+    if (!upstream) {
+        PrepareResponse result;
+        result.status = PrepareStatus::Prepared;
+        return result;
+    }
+
+    PrepareResponse result = upstream->pullPrepare(request);
+    if (!result.ok()) {
+        return result;
+    }
+    rangeWindow_.valid = false;
+    rangeCache_.origin = {INT32_MIN, INT32_MIN};
+    planKernel();
+    if (passThrough_) {
+        return result;
+    }
+
+    // 1バイト1チャンネルの上流は単一チャンネルパスで処理（出力も同じフォーマット）
+    channelFormat_ = isSingleChannel8(result.preferredFormat) ? result.preferredFormat : nullptr;
+
+    // AABB: 左に width-1-anchorX、上に height-1-anchorY、合計でカーネルサイズ-1 拡張
+    result.width = static_cast<int16_t>(result.width + kernelWidth_ - 1);
+    result.origin.x = result.origin.x - to_fixed(static_cast<int>(expandLeft()));
+    result.height = static_cast<int16_t>(result.height + kernelHeight_ - 1);
+    result.origin.y = result.origin.y - to_fixed(static_cast<int>(expandTop()));
+
+    cacheOriginX_ = result.origin.x;
+    cacheWidth_ = result.width;
+    const size_t rows = static_cast<size_t>(kernelHeight_);
+    const size_t paddedLanes = static_cast<size_t>(paddedWidth()) * lanes();
+    ringStride_ = separable_ ? static_cast<size_t>(cacheWidth_) * lanes() : paddedLanes;
+    ring_.assign(ringStride_ * rows, 0);
+    slotRow_.assign(rows, INT32_MIN);
+    slotRange_.assign(rows, DataRange{0, 0});
+    acc_.assign(static_cast<size_t>(cacheWidth_) * lanes(), 0);
+    if (separable_) {
+        line_.assign(paddedLanes, 0);
+        lineRange_ = DataRange{0, 0};
+        if (preserveAlpha_ && !channelFormat_) {
+            alphaRing_.assign(static_cast<size_t>(cacheWidth_) * rows, 0);
+        }
+    }
+
+#ifdef FLEXIMG_DEBUG_PERF_METRICS
+    const size_t cacheBytes = (ring_.size() + line_.size() + alphaRing_.size()) * sizeof(int16_t)
+                            + acc_.size() * sizeof(int32_t);
+    PerfMetrics::instance().nodes[NodeType::Convolution].recordAlloc(
+        cacheBytes, cacheWidth_, kernelHeight_);
+#endif
+    return result;
+}
+
+void ConvolutionNode::finalize() {
+    channelFormat_ = nullptr;
+    ring_ = std::vector<int16_t>();
+    slotRow_ = std::vector<int32_t>();
+    slotRange_ = std::vector<DataRange>();
+    alphaRing_ = std::vector<int16_t>();
+    line_ = std::vector<int16_t>();
+    acc_ = std::vector<int32_t>();
+    rangeCache_ = DataRangeCache();
+    rangeWindow_ = RangeWindow();
+}
+
+RenderResponse& ConvolutionNode::onPullProcess(const RenderRequest& request) {
+    Node* upstream = upstreamNode(0);
+    if (!upstream) return makeEmptyResponse(request.origin);
+
+    if (passThrough_) {
+        return upstream->pullProcess(request);
+    }
+
+    DataRange range;
+    if (rangeCache_.origin.x == request.origin.x &&
+        rangeCache_.origin.y == request.origin.y) {
+        range = DataRange{rangeCache_.startX, rangeCache_.endX};
+    } else {
+        range = getDataRange(request);
+    }
+    if (!range.hasData()) {
+        return makeEmptyResponse(request.origin);
+    }
+
+    // データ範囲とキャッシュの交差領域（キャッシュ座標）
+    const int_fixed cacheLeft = cacheOriginX_;
+    const int_fixed cacheRight = cacheLeft + to_fixed(cacheWidth_);
+    const int_fixed interLeft = std::max(cacheLeft, request.origin.x + to_fixed(range.startX));
+    const int_fixed interRight = std::min(cacheRight, request.origin.x + to_fixed(range.endX));
+    if (interLeft >= interRight) {
+        return makeEmptyResponse(request.origin);
+    }
+    const auto srcStartX = static_cast<int_fast16_t>(from_fixed_floor(interLeft - cacheLeft));
+    const auto srcEndX = static_cast<int_fast16_t>(from_fixed_ceil(interRight - cacheLeft));
+    const auto count = static_cast<size_t>(srcEndX - srcStartX);
+
+    const int_fast32_t y = from_fixed_floor(request.origin.y);
+    ensureRows(y);
+
+    FLEXIMG_METRICS_SCOPE(NodeType::Convolution);
+
+    // カーネル行 i → 上流行 y - anchorY + i のリング行（出力 srcStartX の位置）
+    const size_t ln = lanes();
+    const int16_t* rows[kMaxKernelSize];
+    for (int_fast16_t i = 0; i < kernelHeight_; i++) {
+        int_fast32_t slot = (y - anchorY() + i) % kernelHeight_;
+        if (slot < 0) slot += kernelHeight_;
+        rows[i] = ring_.data() + static_cast<size_t>(slot) * ringStride_ + static_cast<size_t>(srcStartX) * ln;
+    }
+    accumulateTaps(taps_, rows, count);
+
+    ImageBuffer output(static_cast<int_fast16_t>(count), 1, workFormat(), InitPolicy::Uninitialized);
+    auto* dst = static_cast<uint8_t*>(output.view().data);
+    if (channelFormat_) {
+        convolution_detail::resolveRow1ch(dst, acc_.data(), count, scale_, bias_);
+    } else {
+        // 中心アルファ: 非分離はリングの中心行（パディング座標 x + anchorX の A）、
+        // 分離はアルファリング
+        const int16_t* centerA = nullptr;
+        size_t centerStride = 4;
+        if (preserveAlpha_) {
+            int_fast32_t slot = y % kernelHeight_;
+            if (slot < 0) slot += kernelHeight_;
+            if (separable_) {
+                centerA = alphaRing_.data() + static_cast<size_t>(slot) * static_cast<size_t>(cacheWidth_)
+                        + static_cast<size_t>(srcStartX);
+                centerStride = 1;
+            } else {
+                centerA = ring_.data() + static_cast<size_t>(slot) * ringStride_
+                        + static_cast<size_t>(srcStartX + anchorX()) * 4 + 3;
+            }
+        }
+        convolution_detail::resolveRowRGBA(dst, acc_.data(), count, scale_, bias_, centerA, centerStride);
+    }
+
+#ifdef FLEXIMG_DEBUG_PERF_METRICS
+    auto& metrics = PerfMetrics::instance().nodes[NodeType::Convolution];
+    metrics.requestedPixels += static_cast<uint64_t>(request.width) * 1;
+    metrics.usedPixels += static_cast<uint64_t>(count) * 1;
+    metrics.recordAlloc(output.totalBytes(), output.width(), output.height());
+#endif
+
+    return makeResponse(std::move(output), Point{cacheLeft + to_fixed(static_cast<int>(srcStartX)), request.origin.y});
+}
+
+// ============================================================================
+// ConvolutionNode - 行リング
+// ============================================================================
+
+void ConvolutionNode::fetchRow(int_fast32_t srcY, int16_t* dst, DataRange& stored) {
+    const size_t ln = lanes();
+    // 前回の格納範囲をクリア（範囲外は常に0）
+    if (stored.hasData()) {
+        std::memset(dst + static_cast<size_t>(stored.startX) * ln, 0,
+                    static_cast<size_t>(stored.endX - stored.startX) * ln * sizeof(int16_t));
+    }
+    stored = DataRange{0, 0};
+
+    Node* upstream = upstreamNode(0);
+    RenderRequest rowReq;
+    rowReq.width = paddedWidth();
+    rowReq.height = 1;
+    rowReq.origin.x = cacheOriginX_ - to_fixed(static_cast<int>(anchorX()));
+    rowReq.origin.y = to_fixed(static_cast<int>(srcY));
+    if (!upstream->getDataRange(rowReq).hasData()) return;
+
+    RenderResponse& result = upstream->pullProcess(rowReq);
+    if (result.isValid()) {
+        consolidateIfNeeded(result, workFormat());
+        const ViewPort src = result.view();
+        const auto srcOffsetX = static_cast<int_fast16_t>(from_fixed(result.origin.x - rowReq.origin.x));
+        const int_fast16_t begin = std::max<int_fast16_t>(0, srcOffsetX);
+        const int_fast16_t end = std::min<int_fast16_t>(rowReq.width, static_cast<int_fast16_t>(srcOffsetX + src.width));
+        if (begin < end) {
+            const auto* s = static_cast<const uint8_t*>(src.pixelAt(static_cast<int>(begin - srcOffsetX), 0));
+            const auto n = static_cast<size_t>(end - begin);
+            int16_t* d = dst + static_cast<size_t>(begin) * ln;
+            if (channelFormat_) {
+                for (size_t i = 0; i < n; i++) d[i] = s[i];
+            } else {
+                convolution_detail::premultiplyRow(d, s, n);
+            }
+            stored = DataRange{static_cast<int16_t>(begin), static_cast<int16_t>(end)};
+        }
+    }
+    if (context_) {
+        context_->releaseResponse(result);
+    }
+}
+
+void ConvolutionNode::ensureRows(int_fast32_t y) {
+    const int_fast32_t first = y - anchorY();
+    for (int_fast32_t r = first; r < first + kernelHeight_; r++) {
+        int_fast32_t slot = r % kernelHeight_;
+        if (slot < 0) slot += kernelHeight_;
+        const auto s = static_cast<size_t>(slot);
+        if (slotRow_[s] == static_cast<int32_t>(r)) continue;
+        slotRow_[s] = static_cast<int32_t>(r);
+        if (separable_) {
+            storeSeparableRow(r, s);
+        } else {
+            fetchRow(r, ring_.data() + s * ringStride_, slotRange_[s]);
+        }
+    }
+}
+
+void ConvolutionNode::storeSeparableRow(int_fast32_t srcY, size_t slot) {
+    const size_t ln = lanes();
+    int16_t* dst = ring_.data() + slot * ringStride_;
+    int16_t* alpha = alphaRing_.empty() ? nullptr : alphaRing_.data() + slot * static_cast<size_t>(cacheWidth_);
+    DataRange& stored = slotRange_[slot];
+    if (stored.hasData()) {
+        std::memset(dst + static_cast<size_t>(stored.startX) * ln, 0,
+                    static_cast<size_t>(stored.endX - stored.startX) * ln * sizeof(int16_t));
+        if (alpha) {
+            std::memset(alpha + stored.startX, 0,
+                        static_cast<size_t>(stored.endX - stored.startX) * sizeof(int16_t));
+        }
+    }
+    stored = DataRange{0, 0};
+
+    fetchRow(srcY, line_.data(), lineRange_);
+    if (!lineRange_.hasData()) return;
+
+    // 水平タップの出力範囲: パディング範囲 [ps, pe) → キャッシュ座標 [ps - (width-1), pe)
+    const int_fast16_t start = std::max<int_fast16_t>(0, lineRange_.startX - (kernelWidth_ - 1));
+    const int_fast16_t end = std::min<int_fast16_t>(cacheWidth_, lineRange_.endX);
+    if (start >= end) return;
+    const auto count = static_cast<size_t>(end - start);
+
+    const int16_t* rows[1] = {line_.data() + static_cast<size_t>(start) * ln};
+    accumulateTaps(rowTaps_, rows, count);
+
+    int16_t* out = dst + static_cast<size_t>(start) * ln;
+    const size_t n = count * ln;
+    if (rowShift_ == 0) {
+        for (size_t i = 0; i < n; i++) out[i] = static_cast<int16_t>(acc_[i]);
+    } else {
+        const int32_t half = 1 << (rowShift_ - 1);
+        for (size_t i = 0; i < n; i++) out[i] = static_cast<int16_t>((acc_[i] + half) >> rowShift_);
+    }
+    if (alpha) {
+        // 中心アルファ: キャッシュ x → パディング x + anchorX
+        const int16_t* src = line_.data() + static_cast<size_t>(start + anchorX()) * 4 + 3;
+        for (size_t i = 0; i < count; i++) alpha[static_cast<size_t>(start) + i] = src[i * 4];
+    }
+    stored = DataRange{static_cast<int16_t>(start), static_cast<int16_t>(end)};
+}
+
+void ConvolutionNode::accumulateTaps(const std::vector<Tap>& taps, const int16_t* const* rows, size_t count) {
+    const size_t ln = lanes();
+    const size_t n = count * ln;
+    std::memset(acc_.data(), 0, n * sizeof(int32_t));
+    // 2タップずつ pmaddwd で積和（奇数個の最後は重み0と組にする）
+    for (size_t t = 0; t < taps.size(); t += 2) {
+        const Tap& ta = taps[t];
+        const int16_t* a = rows[ta.row] + static_cast<size_t>(ta.col) * ln;
+        if (t + 1 < taps.size()) {
+            const Tap& tb = taps[t + 1];
+            const int16_t* b = rows[tb.row] + static_cast<size_t>(tb.col) * ln;
+            convolution_detail::macPair(acc_.data(), a, b, ta.weight, tb.weight, n);
+        } else {
+            convolution_detail::macPair(acc_.data(), a, a, ta.weight, 0, n);
+        }
+    }
+}
+
+} // namespace FLEXIMG_NAMESPACE
+
+#endif // FLEXIMG_IMPLEMENTATION
+
+#endif // FLEXIMG_CONVOLUTION_NODE_H
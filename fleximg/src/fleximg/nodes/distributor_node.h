@@ -66,6 +66,7 @@ public:
     // ========================================
 
     const char* name() const override { return "DistributorNode"; }
+    uint32_t generation() const override { return Node::generation() + matrixGeneration(); }
     int nodeTypeForMetrics() const override { return NodeType::Distributor; }
 
     // ========================================
@@ -0,0 +1,535 @@
+#ifndef FLEXIMG_DROP_SHADOW_NODE_H
+#define FLEXIMG_DROP_SHADOW_NODE_H
+
+#include "../core/node.h"
+#include "../core/perf_metrics.h"
+#include "../core/render_context.h"
+#include "../image/image_buffer.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace FLEXIMG_NAMESPACE {
+
+// ========================================================================
+// DropShadowNode - ドロップシャドウノード
+// ========================================================================
+//
+// 入力画像のアルファからぼかした影を生成し、入力画像の下に合成します。
+// - 入力: 1ポート
+// - 出力: 1ポート（RGBA8_Straight）
+// - radius: ぼかし半径（0-127、パスあたり。影の広がり = radius * passes）
+// - passes: ボックスブラー適用回数（1-3、3でガウシアン近似）
+// - offset: 影のずらし量（スクリーンピクセル単位）
+// - color:  影の色とアルファ（RGBA8、アルファ0で影なし＝パススルー）
+//
+// 処理方式:
+// - pullPrepare 時に「上流AABB ∩ 影がスクリーンに届く範囲」の上流を
+//   スキャンライン単位で描画し、アルファのみを低解像度マップに縮小蓄積する
+//   （RGBは保持しない。面積平均で 1/downsample に縮小）
+// - 低解像度マップ上で水平/垂直ボックスブラーを passes 回適用
+// - pullProcess では上流の1行と、マップからバイリニア補間で拡大した影アルファを
+//   1パスで合成する（Output = Input over Shadow、ストレートアルファ）
+// - 上流は prepare 時と process 時の2回評価される
+//
+// ダウンサンプル（setDownsample）:
+// - 0: 自動（radius * passes が 8 未満で等倍、24 未満で 1/2、それ以上で 1/4）
+// - 1 / 2 / 4: 固定
+// - 縮小時のぼかし半径は radius / downsample（四捨五入、最小1）
+//
+// 制約:
+// - pull型のみ対応
+// - 射影変換・ワープが伝播されている場合は影を生成せずパススルー
+//
+// 使用例:
+//   DropShadowNode shadow;
+//   shadow.setRadius(8);
+//   shadow.setOffset(4, 4);
+//   shadow.setColor(0, 0, 0, 128);
+//   icon >> shadow >> composite;
+//
+
+namespace drop_shadow_detail {
+
+// 床関数除算（b > 0）
+inline int_fast32_t floorDiv(int_fast32_t a, int_fast32_t b) {
+    return (a >= 0) ? a / b : -((-a + b - 1) / b);
+}
+
+// 天井関数除算（b > 0）
+inline int_fast32_t ceilDiv(int_fast32_t a, int_fast32_t b) {
+    return -floorDiv(-a, b);
+}
+
+} // namespace drop_shadow_detail
+
+class DropShadowNode : public Node {
+public:
+    DropShadowNode() {
+        initPorts(1, 1);  // 入力1、出力1
+    }
+
+    // ========================================
+    // パラメータ設定
+    // ========================================
+
+    // パラメータ上限
+    static constexpr int kMaxRadius = 127;
+    static constexpr int kMaxPasses = 3;
+    static constexpr int kMaxOffset = 1024;
+
+    void setRadius(int_fast16_t radius) {
+        radius_ = static_cast<int16_t>((radius < 0) ? 0 : (radius > kMaxRadius) ? kMaxRadius : radius);
+        markModified();
+    }
+
+    void setPasses(int_fast16_t passes) {
+        passes_ = static_cast<int16_t>((passes < 1) ? 1 : (passes > kMaxPasses) ? kMaxPasses : passes);
+        markModified();
+    }
+
+    void setOffset(int_fast16_t dx, int_fast16_t dy) {
+        offsetX_ = static_cast<int16_t>(std::min<int_fast16_t>(kMaxOffset, std::max<int_fast16_t>(-kMaxOffset, dx)));
+        offsetY_ = static_cast<int16_t>(std::min<int_fast16_t>(kMaxOffset, std::max<int_fast16_t>(-kMaxOffset, dy)));
+        markModified();
+    }
+
+    void setColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a = 255) {
+        color_[0] = r;
+        color_[1] = g;
+        color_[2] = b;
+        color_[3] = a;
+        markModified();
+    }
+
+    // 縮小率（0=自動、1/2/4、それ以外は近い値に丸める）
+    void setDownsample(int_fast16_t factor) {
+        downsample_ = static_cast<int16_t>((factor <= 0) ? 0 : (factor < 2) ? 1 : (factor < 4) ? 2 : 4);
+        markModified();
+    }
+
+    int16_t radius() const { return radius_; }
+    int16_t passes() const { return passes_; }
+    int16_t offsetX() const { return offsetX_; }
+    int16_t offsetY() const { return offsetY_; }
+    int16_t downsample() const { return downsample_; }
+    const uint8_t* color() const { return color_; }
+
+    // 実際に使用する縮小率（自動選択を解決した値）
+    int_fast16_t effectiveDownsample() const {
+        if (downsample_ > 0) return downsample_;
+        const int_fast16_t spread = radius_ * passes_;
+        return (spread < 8) ? 1 : (spread < 24) ? 2 : 4;
+    }
+
+    // ========================================
+    // Node インターフェース
+    // ========================================
+
+    const char* name() const override { return "DropShadowNode"; }
+
+    // getDataRange: 上流のデータ範囲と影の範囲の和集合
+    DataRange getDataRange(const RenderRequest& request) const override;
+
+protected:
+    int nodeTypeForMetrics() const override { return NodeType::DropShadow; }
+
+    PrepareResponse onPullPrepare(const PrepareRequest& request) override;
+    RenderResponse& onPullProcess(const RenderRequest& request) override;
+    void onPullFinalize() override;
+
+private:
+    int16_t radius_ = 4;
+    int16_t passes_ = 1;
+    int16_t offsetX_ = 4;
+    int16_t offsetY_ = 4;
+    int16_t downsample_ = 0;        // 0=自動
+    uint8_t color_[4] = {0, 0, 0, 128};
+
+    // 影アルファマップ（低解像度、prepare で構築、finalize で破棄）
+    bool passThrough_ = true;
+    std::vector<uint8_t> map_;
+    std::vector<DataRange> mapRowRanges_;  // 各行の非ゼロ範囲（セル単位）
+    std::vector<uint32_t> lerpRow_;        // 垂直補間済みの行（左右に1セルのゼロ余白）
+    int_fixed mapOriginX_ = 0;             // マップ左上の影空間ワールド座標（オフセット適用後）
+    int_fixed mapOriginY_ = 0;
+    int16_t mapWidth_ = 0;
+    int16_t mapHeight_ = 0;
+    int16_t scale_ = 1;
+
+    // 縮小解像度でのパスあたりブラー半径
+    int_fast16_t lowResRadius() const {
+        if (radius_ == 0) return 0;
+        return std::max<int_fast16_t>(1, (radius_ + scale_ / 2) / scale_);
+    }
+
+    // 1セル分の補間ステップ（256 = 1セル）と、ピクセル0の中心に対応するセル位置
+    int_fast32_t cellStep() const { return 256 / scale_; }
+    int_fast32_t cellBase() const { return 128 / scale_ - 128; }
+
+    void buildShadowMap(Node* upstream, const PrepareRequest& request,
+                        const PrepareResponse& upstreamResult);
+    void blurShadowMap();
+    static void boxBlurLine(uint8_t* data, size_t stride, int_fast16_t count,
+                            int_fast16_t radius, uint8_t* work);
+
+    // 行 originY の補間元セル行と重み、非ゼロのセル範囲を取得
+    bool shadowRowCells(int_fixed originY, int_fast32_t& iy, int_fast32_t& fy,
+                        DataRange& cells) const;
+
+    // request 座標系での影の範囲
+    DataRange shadowRange(const RenderRequest& request) const;
+};
+
+} // namespace FLEXIMG_NAMESPACE
+
+// =============================================================================
+// 実装部
+// =============================================================================
+#ifdef FLEXIMG_IMPLEMENTATION
+
+namespace FLEXIMG_NAMESPACE {
+
+// ============================================================================
+// DropShadowNode - 影マップ構築
+// ============================================================================
+
+void DropShadowNode::buildShadowMap(Node* upstream, const PrepareRequest& request,
+                                    const PrepareResponse& upstreamResult) {
+    scale_ = static_cast<int16_t>(effectiveDownsample());
+    const int margin = static_cast<int>(lowResRadius() * passes_) + 1;  // +1: バイリニア補間分
+    const int spread = margin * scale_;
+
+    // 描画範囲: 上流AABB ∩ 影がスクリーンに届くソース範囲（スクリーン相対座標）
+    int srcL = 0, srcT = 0, srcR = 0, srcB = 0;
+    if (upstreamResult.width > 0 && upstreamResult.height > 0) {
+        const int_fixed relX = upstreamResult.origin.x - request.origin.x;
+        const int_fixed relY = upstreamResult.origin.y - request.origin.y;
+        srcL = std::max(from_fixed_floor(relX), -offsetX_ - spread);
+        srcT = std::max(from_fixed_floor(relY), -offsetY_ - spread);
+        srcR = std::min(from_fixed_ceil(relX + to_fixed(upstreamResult.width)),
+                        request.width - offsetX_ + spread);
+        srcB = std::min(from_fixed_ceil(relY + to_fixed(upstreamResult.height)),
+                        request.height - offsetY_ + spread);
+    }
+    if (srcL >= srcR || srcT >= srcB) {
+        mapWidth_ = 0;
+        mapHeight_ = 0;
+        map_.clear();
+        mapRowRanges_.clear();
+        return;
+    }
+
+    const int mapX0 = srcL - spread;
+    const int mapY0 = srcT - spread;
+    mapWidth_ = static_cast<int16_t>((srcR - srcL + scale_ - 1) / scale_ + margin * 2);
+    mapHeight_ = static_cast<int16_t>((srcB - srcT + scale_ - 1) / scale_ + margin * 2);
+    map_.assign(static_cast<size_t>(mapWidth_) * static_cast<size_t>(mapHeight_), 0);
+    lerpRow_.assign(static_cast<size_t>(mapWidth_) + 2, 0);
+    mapOriginX_ = request.origin.x + to_fixed(mapX0 + offsetX_);
+    mapOriginY_ = request.origin.y + to_fixed(mapY0 + offsetY_);
+
+#ifdef FLEXIMG_DEBUG_PERF_METRICS
+    PerfMetrics::instance().nodes[NodeType::DropShadow].recordAlloc(
+        map_.size() + lerpRow_.size() * sizeof(uint32_t), mapWidth_, mapHeight_);
+#endif
+
+    // 上流をスキャンライン単位で描画し、アルファをセル単位に面積平均で縮小
+    const int width = srcR - srcL;
+    const auto area = static_cast<uint32_t>(scale_ * scale_);
+    std::vector<uint16_t> accum(static_cast<size_t>(mapWidth_), 0);
+    for (int y = srcT; y < srcB; ++y) {
+        RenderRequest rowRequest;
+        rowRequest.width = static_cast<int16_t>(width);
+        rowRequest.height = 1;
+        rowRequest.origin = {request.origin.x + to_fixed(srcL), request.origin.y + to_fixed(y)};
+
+        RenderResponse& resp = upstream->pullProcess(rowRequest);
+        if (resp.isValid()) {
+            consolidateIfNeeded(resp);
+            const ViewPort src = resp.view();
+            const int offset = from_fixed(resp.origin.x - rowRequest.origin.x);
+            const int xStart = std::max(0, offset);
+            const int xEnd = std::min(width, offset + static_cast<int>(src.width));
+            if (xStart < xEnd && src.height > 0) {
+                const auto* srcRow = static_cast<const uint8_t*>(src.pixelAt(0, 0));
+                for (int x = xStart; x < xEnd; ++x) {
+                    accum[static_cast<size_t>(margin + x / scale_)] +=
+                        srcRow[static_cast<size_t>(x - offset) * 4 + 3];
+                }
+            }
+        }
+        // 行ごとにResponseプールを解放（描画中は下流にResponseを渡していない）
+        if (context_) {
+            context_->resetScanlineResources();
+        }
+
+        const int localY = y - srcT;
+        if (localY % scale_ == scale_ - 1 || y == srcB - 1) {
+            uint8_t* cellRow = &map_[static_cast<size_t>(margin + localY / scale_) * static_cast<size_t>(mapWidth_)];
+            for (size_t i = 0; i < accum.size(); ++i) {
+                cellRow[i] = static_cast<uint8_t>((accum[i] + area / 2) / area);
+                accum[i] = 0;
+            }
+        }
+    }
+
+    blurShadowMap();
+
+    // 各行の非ゼロ範囲を記録（getDataRange と空行のスキップに使用）
+    mapRowRanges_.assign(static_cast<size_t>(mapHeight_), DataRange{0, 0});
+    for (int j = 0; j < mapHeight_; ++j) {
+        const uint8_t* row = &map_[static_cast<size_t>(j) * static_cast<size_t>(mapWidth_)];
+        int s = 0, e = mapWidth_;
+        while (s < e && row[s] == 0) ++s;
+        while (e > s && row[e - 1] == 0) --e;
+        if (s < e) {
+            mapRowRanges_[static_cast<size_t>(j)] = DataRange{static_cast<int16_t>(s), static_cast<int16_t>(e)};
+        }
+    }
+}
+
+void DropShadowNode::blurShadowMap() {
+    const int_fast16_t r = lowResRadius();
+    if (r == 0) return;
+
+    std::vector<uint8_t> work(static_cast<size_t>(std::max(mapWidth_, mapHeight_)));
+    const auto stride = static_cast<size_t>(mapWidth_);
+    for (int_fast16_t pass = 0; pass < passes_; ++pass) {
+        for (int_fast16_t y = 0; y < mapHeight_; ++y) {
+            boxBlurLine(&map_[static_cast<size_t>(y) * stride], 1, mapWidth_, r, work.data());
+        }
+        for (int_fast16_t x = 0; x < mapWidth_; ++x) {
+            boxBlurLine(&map_[static_cast<size_t>(x)], stride, mapHeight_, r, work.data());
+        }
+    }
+}
+
+// 1次元ボックスブラー（範囲外はゼロ、スライディングウィンドウ）
+void DropShadowNode::boxBlurLine(uint8_t* data, size_t stride, int_fast16_t count,
+                                 int_fast16_t radius, uint8_t* work) {
+    for (int_fast16_t i = 0; i < count; ++i) {
+        work[i] = data[static_cast<size_t>(i) * stride];
+    }
+    const auto ks = static_cast<uint32_t>(radius * 2 + 1);
+    uint32_t sum = 0;
+    for (int_fast16_t k = 0; k <= radius && k < count; ++k) {
+        sum += work[k];
+    }
+    for (int_fast16_t i = 0; i < count; ++i) {
+        data[static_cast<size_t>(i) * stride] = static_cast<uint8_t>((sum + ks / 2) / ks);
+        if (i + radius + 1 < count) sum += work[i + radius + 1];
+        if (i - radius >= 0) sum -= work[i - radius];
+    }
+}
+
+// ============================================================================
+// DropShadowNode - 影の範囲計算
+// ============================================================================
+
+bool DropShadowNode::shadowRowCells(int_fixed originY, int_fast32_t& iy, int_fast32_t& fy,
+                                    DataRange& cells) const {
+    if (mapWidth_ == 0 || mapHeight_ == 0) return false;
+    const int_fast32_t v = from_fixed(originY - mapOriginY_) * cellStep() + cellBase();
+    iy = drop_shadow_detail::floorDiv(v, 256);
+    fy = v - iy * 256;
+
+    int16_t start = INT16_MAX, end = INT16_MIN;
+    for (int_fast32_t j = iy; j <= iy + 1; ++j) {
+        if (j < 0 || j >= mapHeight_ || (j == iy + 1 && fy == 0)) continue;
+        const DataRange& r = mapRowRanges_[static_cast<size_t>(j)];
+        if (!r.hasData()) continue;
+        start = std::min(start, r.startX);
+        end = std::max(end, r.endX);
+    }
+    if (start >= end) return false;
+    cells = DataRange{start, end};
+    return true;
+}
+
+DataRange DropShadowNode::shadowRange(const RenderRequest& request) const {
+    int_fast32_t iy = 0, fy = 0;
+    DataRange cells;
+    if (!shadowRowCells(request.origin.y, iy, fy, cells)) return DataRange{0, 0};
+
+    // 補間位置 u = px * step + base が ((start-1)*256, end*256) の画素が非ゼロになりうる
+    const int_fast32_t step = cellStep();
+    const int_fast32_t base = cellBase();
+    const int_fast32_t pxStart = drop_shadow_detail::ceilDiv((cells.startX - 1) * 256 + 1 - base, step);
+    const int_fast32_t pxEnd = drop_shadow_detail::ceilDiv(cells.endX * 256 - base, step);
+    const int_fast32_t toRequest = from_fixed(mapOriginX_ - request.origin.x);
+    const auto start = static_cast<int_fast32_t>(std::max<int_fast32_t>(0, pxStart + toRequest));
+    const auto end = static_cast<int_fast32_t>(std::min<int_fast32_t>(request.width, pxEnd + toRequest));
+    return (start < end) ? DataRange{static_cast<int16_t>(start), static_cast<int16_t>(end)}
+                         : DataRange{0, 0};
+}
+
+DataRange DropShadowNode::getDataRange(const RenderRequest& request) const {
+    Node* upstream = upstreamNode(0);
+    DataRange range = upstream ? upstream->getDataRange(request) : DataRange{0, 0};
+    if (passThrough_) return range;
+
+    DataRange shadow = shadowRange(request);
+    if (!shadow.hasData()) return range;
+    if (!range.hasData()) return shadow;
+    return DataRange{std::min(range.startX, shadow.startX), std::max(range.endX, shadow.endX)};
+}
+
+// ============================================================================
+// DropShadowNode - Template Method フック実装
+// ============================================================================
+
+PrepareResponse DropShadowNode::onPullPrepare(const PrepareRequest& request) {
+    Node* upstream = upstreamNode(0);
+    if (!upstream) {
+        passThrough_ = true;
+        PrepareResponse result;
+        result.status = PrepareStatus::Prepared;
+        return result;
+    }
+
+    PrepareResponse result = upstream->pullPrepare(request);
+    if (!result.ok()) {
+        return result;
+    }
+
+    // 射影変換・ワープ下ではスクリーン空間の影を定義できないためパススルー
+    passThrough_ = request.hasPerspective || request.warp != nullptr || color_[3] == 0;
+    if (passThrough_ || result.width <= 0 || result.height <= 0) {
+        return result;
+    }
+
+    buildShadowMap(upstream, request, result);
+
+    // AABB を影の範囲（オフセット + 広がり）まで拡張
+    const int spread = static_cast<int>(lowResRadius() * passes_ + 1) * scale_;
+    const int_fixed left = std::min(result.origin.x, result.origin.x + to_fixed(offsetX_ - spread));
+    const int_fixed top = std::min(result.origin.y, result.origin.y + to_fixed(offsetY_ - spread));
+    const int_fixed right = std::max(result.origin.x + to_fixed(result.width),
+                                     result.origin.x + to_fixed(result.width + offsetX_ + spread));
+    const int_fixed bottom = std::max(result.origin.y + to_fixed(result.height),
+                                      result.origin.y + to_fixed(result.height + offsetY_ + spread));
+    result.origin = {left, top};
+    result.width = static_cast<int16_t>(std::min<int_fixed>(INT16_MAX, from_fixed_ceil(right - left)));
+    result.height = static_cast<int16_t>(std::min<int_fixed>(INT16_MAX, from_fixed_ceil(bottom - top)));
+    result.preferredFormat = PixelFormatIDs::RGBA8_Straight;
+    return result;
+}
+
+void DropShadowNode::onPullFinalize() {
+    map_.clear();
+    map_.shrink_to_fit();
+    mapRowRanges_.clear();
+    lerpRow_.clear();
+    mapWidth_ = 0;
+    mapHeight_ = 0;
+    finalize();
+    Node* upstream = upstreamNode(0);
+    if (upstream) {
+        upstream->pullFinalize();
+    }
+}
+
+RenderResponse& DropShadowNode::onPullProcess(const RenderRequest& request) {
+    Node* upstream = upstreamNode(0);
+    if (!upstream) return makeEmptyResponse(request.origin);
+    if (passThrough_) {
+        return upstream->pullProcess(request);
+    }
+
+    const DataRange shadow = shadowRange(request);
+    RenderResponse& input = upstream->pullProcess(request);
+    if (!shadow.hasData()) {
+        // 影のない行は上流をそのまま返す
+        return input;
+    }
+
+    FLEXIMG_METRICS_SCOPE(NodeType::DropShadow);
+
+    // 入力行（RGBA8_Straight）のリクエスト座標系での範囲
+    int srcStart = 0, srcEnd = 0, srcOffset = 0;
+    const uint8_t* srcRow = nullptr;
+    if (input.isValid()) {
+        consolidateIfNeeded(input);
+        const ViewPort src = input.view();
+        srcOffset = from_fixed(input.origin.x - request.origin.x);
+        srcStart = std::max(0, srcOffset);
+        srcEnd = std::min<int>(request.width, srcOffset + static_cast<int>(src.width));
+        srcRow = static_cast<const uint8_t*>(src.pixelAt(0, 0));
+    }
+    int start = shadow.startX, end = shadow.endX;
+    if (srcStart < srcEnd) {
+        start = std::min(start, srcStart);
+        end = std::max(end, srcEnd);
+    }
+
+    // 影マップの2行を垂直補間（lerpRow_[i + 1] = セル i、値域 0..255*256）
+    int_fast32_t iy = 0, fy = 0;
+    DataRange cells;
+    shadowRowCells(request.origin.y, iy, fy, cells);
+    std::fill(lerpRow_.begin(), lerpRow_.end(), 0u);
+    for (int_fast32_t j = iy; j <= iy + 1; ++j) {
+        if (j < 0 || j >= mapHeight_) continue;
+        const auto weight = static_cast<uint32_t>((j == iy) ? 256 - fy : fy);
+        if (weight == 0) continue;
+        const uint8_t* row = &map_[static_cast<size_t>(j) * static_cast<size_t>(mapWidth_)];
+        for (int i = cells.startX; i < cells.endX; ++i) {
+            lerpRow_[static_cast<size_t>(i) + 1] += row[i] * weight;
+        }
+    }
+
+    ImageBuffer output(static_cast<int_fast16_t>(end - start), 1, PixelFormatIDs::RGBA8_Straight,
+                       InitPolicy::Uninitialized);
+    auto* dst = static_cast<uint8_t*>(output.view().data);
+
+    // 出力x → 補間位置 u（256 = 1セル）
+    const int_fast32_t step = cellStep();
+    int_fast32_t u = (from_fixed(request.origin.x - mapOriginX_) + start) * step + cellBase();
+    const uint32_t sr = color_[0], sg = color_[1], sb = color_[2], scA = color_[3];
+
+    for (int x = start; x < end; ++x, u += step, dst += 4) {
+        // 影アルファ（水平補間 + 影色のアルファ）
+        uint32_t sa = 0;
+        const int_fast32_t ix = drop_shadow_detail::floorDiv(u, 256);
+        if (ix >= -1 && ix < mapWidth_) {
+            const auto fx = static_cast<uint32_t>(u - ix * 256);
+            const uint32_t a = (lerpRow_[static_cast<size_t>(ix + 1)] * (256 - fx)
+                              + lerpRow_[static_cast<size_t>(ix + 2)] * fx + 32768) >> 16;
+            sa = (a * scA + 127) / 255;
+        }
+
+        const uint8_t* s = (x >= srcStart && x < srcEnd)
+                         ? srcRow + static_cast<size_t>(x - srcOffset) * 4 : nullptr;
+        const uint32_t srcA = s ? s[3] : 0;
+        if (srcA == 255 || sa == 0) {
+            // 入力が不透明 / 影なし: 入力をそのまま
+            if (s) {
+                dst[0] = s[0]; dst[1] = s[1]; dst[2] = s[2]; dst[3] = s[3];
+            } else {
+                dst[0] = dst[1] = dst[2] = dst[3] = 0;
+            }
+        } else if (srcA == 0) {
+            dst[0] = static_cast<uint8_t>(sr);
+            dst[1] = static_cast<uint8_t>(sg);
+            dst[2] = static_cast<uint8_t>(sb);
+            dst[3] = static_cast<uint8_t>(sa);
+        } else {
+            // Input over Shadow（ストレートアルファ、重みは 0..255*255）
+            const uint32_t wIn = srcA * 255;
+            const uint32_t wShadow = sa * (255 - srcA);
+            const uint32_t wTotal = wIn + wShadow;
+            dst[0] = static_cast<uint8_t>((s[0] * wIn + sr * wShadow + wTotal / 2) / wTotal);
+            dst[1] = static_cast<uint8_t>((s[1] * wIn + sg * wShadow + wTotal / 2) / wTotal);
+            dst[2] = static_cast<uint8_t>((s[2] * wIn + sb * wShadow + wTotal / 2) / wTotal);
+            dst[3] = static_cast<uint8_t>((wTotal + 127) / 255);
+        }
+    }
+
+    return makeResponse(std::move(output), Point{request.origin.x + to_fixed(start), request.origin.y});
+}
+
+} // namespace FLEXIMG_NAMESPACE
+
+#endif // FLEXIMG_IMPLEMENTATION
+
+#endif // FLEXIMG_DROP_SHADOW_NODE_H
@@ -0,0 +1,585 @@
+#ifndef FLEXIMG_FAST_BLUR_NODE_H
+#define FLEXIMG_FAST_BLUR_NODE_H
+
+#include "../core/node.h"
+#include "../core/perf_metrics.h"
+#include "../core/render_context.h"
+#include "../image/image_buffer.h"
+#include "horizontal_blur_node.h"
+#include "vertical_blur_node.h"
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <vector>
+
+namespace FLEXIMG_NAMESPACE {
+
+// ========================================================================
+// FastBlurNode - 縮小ぼかしノード（縮小 → ボックスブラー → 拡大）
+// ========================================================================
+//
+// 大きな半径のぼかしを縮小解像度で行います。
+// - 入力: 1ポート
+// - 出力: 1ポート（RGBA8_Straight）
+// - radius: ぼかし半径（等倍換算、0-1016、パスあたり）
+// - passes: ボックスブラー適用回数（1-3、3でガウシアン近似）
+// - downsample: 縮小率（0=自動、1/2/4/8）
+//
+// 処理方式（スキャンライン）:
+// - 内部に 縮小ステージ >> HorizontalBlurNode >> VerticalBlurNode の
+//   サブパイプラインを持ち、縮小解像度の座標系で駆動する
+// - 縮小ステージは上流を downsample 行ずつプルし、downsample×downsample の
+//   ブロックをプリマルチプライドで面積平均して縮小行を作る
+// - ぼかしは既存のスライディングウィンドウ実装（半径 radius / downsample）
+// - 出力行は縮小行2本からバイリニア補間で拡大する（縮小行は2本だけ保持し、
+//   内部パイプラインには常に下方向の連続したリクエストになる）
+//
+// 自動選択の閾値（setAutoThresholds）:
+// - 広がり radius * passes が to2 以上で 1/2、to4 以上で 1/4、to8 以上で 1/8
+// - 既定値は 8 / 24 / 64（DropShadowNode の自動選択と同じ境界 + 1/8）
+// - 閾値を上げるほど等倍に近い品質、下げるほど高速・省メモリ
+//
+// 計測（FLEXIMG_DEBUG_PERF_METRICS）:
+// - 内部のぼかしは HorizontalBlur / VerticalBlur として計上される
+// - FastBlur の savedBytes に等倍で同じぼかしを行った場合との作業メモリ差、
+//   savedPixels に縮小により省略したぼかし画素数を記録する
+//
+// 制約:
+// - pull型のみ対応
+// - 縮小後の半径は VerticalBlurNode::kMaxRadius で頭打ちになる
+// - 出力は等倍のボックスブラーと一致しない（縮小・補間による近似）
+//
+// 使用例:
+//   FastBlurNode blur;
+//   blur.setRadius(60);
+//   blur.setPasses(3);
+//   background >> blur >> composite;
+//
+
+class FastBlurNode : public Node {
+public:
+    FastBlurNode() : decimator_(this) {
+        initPorts(1, 1);  // 入力1、出力1
+        decimator_ >> hblur_ >> vblur_;
+    }
+
+    // 内部パイプラインが自身を参照するためコピー不可
+    FastBlurNode(const FastBlurNode&) = delete;
+    FastBlurNode& operator=(const FastBlurNode&) = delete;
+
+    // ========================================
+    // パラメータ設定
+    // ========================================
+
+    // パラメータ上限
+    static constexpr int kMaxDownsample = 8;
+    static constexpr int kMaxRadius = VerticalBlurNode::kMaxRadius * kMaxDownsample;
+    static constexpr int kMaxPasses = 3;
+
+    void setRadius(int_fast16_t radius) {
+        radius_ = static_cast<int16_t>((radius < 0) ? 0 : (radius > kMaxRadius) ? kMaxRadius : radius);
+        markModified();
+    }
+
+    void setPasses(int_fast16_t passes) {
+        passes_ = static_cast<int16_t>((passes < 1) ? 1 : (passes > kMaxPasses) ? kMaxPasses : passes);
+        markModified();
+    }
+
+    // 縮小率（0=自動、1/2/4/8、それ以外は小さい側に丸める）
+    void setDownsample(int_fast16_t factor) {
+        downsample_ = static_cast<int16_t>((factor <= 0) ? 0 : (factor < 2) ? 1 : (factor < 4) ? 2
+                                         : (factor < 8) ? 4 : 8);
+        markModified();
+    }
+
+    // 自動選択の閾値（広がり radius * passes、to2 ≤ to4 ≤ to8 に揃える）
+    void setAutoThresholds(int_fast16_t to2, int_fast16_t to4, int_fast16_t to8) {
+        autoTo2_ = static_cast<int16_t>(std::max<int_fast16_t>(1, to2));
+        autoTo4_ = static_cast<int16_t>(std::max<int_fast16_t>(autoTo2_, to4));
+        autoTo8_ = static_cast<int16_t>(std::max<int_fast16_t>(autoTo4_, to8));
+        markModified();
+    }
+
+    int16_t radius() const { return radius_; }
+    int16_t passes() const { return passes_; }
+    int16_t downsample() const { return downsample_; }
+    int16_t autoThreshold2() const { return autoTo2_; }
+    int16_t autoThreshold4() const { return autoTo4_; }
+    int16_t autoThreshold8() const { return autoTo8_; }
+
+    // 実際に使用する縮小率（自動選択を解決した値）
+    int_fast16_t effectiveDownsample() const {
+        if (downsample_ > 0) return downsample_;
+        const int_fast32_t spread = radius_ * passes_;
+        return (spread >= autoTo8_) ? 8 : (spread >= autoTo4_) ? 4 : (spread >= autoTo2_) ? 2 : 1;
+    }
+
+    // 縮小解像度でのパスあたりブラー半径
+    int_fast16_t lowResRadius() const {
+        if (radius_ == 0) return 0;
+        const int_fast16_t s = effectiveDownsample();
+        return std::min<int_fast16_t>(VerticalBlurNode::kMaxRadius,
+                                      std::max<int_fast16_t>(1, (radius_ + s / 2) / s));
+    }
+
+    // ========================================
+    // Node インターフェース
+    // ========================================
+
+    const char* name() const override { return "FastBlurNode"; }
+
+    // getDataRange: 拡張後のAABBとリクエストの交差（保守的）
+    DataRange getDataRange(const RenderRequest& request) const override;
+
+protected:
+    int nodeTypeForMetrics() const override { return NodeType::FastBlur; }
+
+    PrepareResponse onPullPrepare(const PrepareRequest& request) override;
+    RenderResponse& onPullProcess(const RenderRequest& request) override;
+    void onPullFinalize() override;
+
+private:
+    // ========================================
+    // 縮小ステージ（内部パイプラインの入力端）
+    // ========================================
+    //
+    // 縮小座標系: 縮小画素 (i, j) は等倍のワールド座標
+    // [anchor + i * s, anchor + (i + 1) * s) × [anchor + j * s, ...) に対応する
+    class Decimator : public Node {
+    public:
+        explicit Decimator(FastBlurNode* owner) : owner_(owner) {
+            initPorts(0, 1);  // 入力なし（所有ノードの上流を直接プル）、出力1
+        }
+        const char* name() const override { return "FastBlurNode::Decimator"; }
+        DataRange getDataRange(const RenderRequest& request) const override;
+
+    protected:
+        int nodeTypeForMetrics() const override { return NodeType::FastBlur; }
+        PrepareResponse onPullPrepare(const PrepareRequest& request) override;
+        RenderResponse& onPullProcess(const RenderRequest& request) override;
+        void onPullFinalize() override { finalize(); }
+
+    private:
+        FastBlurNode* owner_;
+        std::vector<uint32_t> sums_;  // 縮小1行分の [ΣC×A, ΣC×A, ΣC×A, ΣA]
+
+        // 縮小行 j・列 [i0, i1) に対応する等倍のリクエスト（k = ブロック内の行）
+        RenderRequest fullRequest(int_fast32_t i0, int_fast32_t i1, int_fast32_t j, int_fast32_t k) const;
+    };
+
+    int16_t radius_ = 16;
+    int16_t passes_ = 3;
+    int16_t downsample_ = 0;        // 0=自動
+    int16_t autoTo2_ = 8;
+    int16_t autoTo4_ = 24;
+    int16_t autoTo8_ = 64;
+
+    Decimator decimator_;
+    HorizontalBlurNode hblur_;
+    VerticalBlurNode vblur_;
+
+    // prepare で決定する座標系（finalize で破棄）
+    bool passThrough_ = true;
+    int16_t scale_ = 1;
+    int_fixed anchorX_ = 0;         // 縮小画素 (0, 0) 左上のワールド座標（整数）
+    int_fixed anchorY_ = 0;
+    int_fast32_t lowWidth_ = 0;     // 上流AABBの縮小サイズ
+    int_fast32_t lowHeight_ = 0;
+    int_fast32_t lowLeft_ = 0;      // ぼかし後の縮小AABB [lowLeft_, +lowRowWidth_) × [lowTop_, lowBottom_)
+    int_fast32_t lowRowWidth_ = 0;
+    int_fast32_t lowTop_ = 0;
+    int_fast32_t lowBottom_ = 0;
+
+    // 縮小行2本（プリマルチプライド [C×A, C×A, C×A, A]、左右に1画素のゼロ余白）
+    std::vector<uint32_t> lowRows_[2];
+    int_fast32_t lowRowIndex_[2] = {INT32_MIN, INT32_MIN};
+    std::vector<uint32_t> lerpRow_;  // 垂直補間済みの行（値 × 256）
+
+    // 1縮小画素分の補間ステップ（256 = 1画素）と、等倍画素0の中心に対応する位置
+    int_fast32_t cellStep() const { return 256 / scale_; }
+    int_fast32_t cellBase() const { return 128 / scale_ - 128; }
+
+    size_t lowRowStride() const { return static_cast<size_t>(lowRowWidth_ + 2) * 4; }
+
+    // 縮小行 j を slot に取得（範囲外はゼロ行）
+    void loadLowRow(int_fast32_t j, int slot);
+    // 縮小行 j を保持しているスロット（なければ -1）
+    int findLowRow(int_fast32_t j) const {
+        return (lowRowIndex_[0] == j) ? 0 : (lowRowIndex_[1] == j) ? 1 : -1;
+    }
+};
+
+} // namespace FLEXIMG_NAMESPACE
+
+// =============================================================================
+// 実装部
+// =============================================================================
+#ifdef FLEXIMG_IMPLEMENTATION
+
+namespace FLEXIMG_NAMESPACE {
+
+namespace fast_blur_detail {
+
+// 床関数除算（b > 0）
+inline int_fast32_t floorDiv(int_fast32_t a, int_fast32_t b) {
+    return (a >= 0) ? a / b : -((-a + b - 1) / b);
+}
+
+} // namespace fast_blur_detail
+
+// ============================================================================
+// FastBlurNode::Decimator - 縮小ステージ
+// ============================================================================
+
+RenderRequest FastBlurNode::Decimator::fullRequest(int_fast32_t i0, int_fast32_t i1,
+                                                   int_fast32_t j, int_fast32_t k) const {
+    const int s = owner_->scale_;
+    RenderRequest req;
+    req.width = static_cast<int16_t>((i1 - i0) * s);
+    req.height = 1;
+    req.origin = {owner_->anchorX_ + to_fixed(static_cast<int>(i0) * s),
+                  owner_->anchorY_ + to_fixed(static_cast<int>(j) * s + static_cast<int>(k))};
+    return req;
+}
+
+DataRange FastBlurNode::Decimator::getDataRange(const RenderRequest& request) const {
+    Node* upstream = owner_->upstreamNode(0);
+    const int_fast32_t j = from_fixed(request.origin.y);
+    if (!upstream || j < 0 || j >= owner_->lowHeight_) return DataRange{0, 0};
+    const int_fast32_t reqX = from_fixed(request.origin.x);
+    const int_fast32_t i0 = std::max<int_fast32_t>(0, reqX);
+    const int_fast32_t i1 = std::min<int_fast32_t>(owner_->lowWidth_, reqX + request.width);
+    if (i0 >= i1) return DataRange{0, 0};
+
+    // ブロック内の各行の上流データ範囲の和集合を縮小画素に丸める
+    const int s = owner_->scale_;
+    int_fast32_t start = INT32_MAX, end = INT32_MIN;
+    for (int k = 0; k < s; ++k) {
+        const DataRange r = upstream->getDataRange(fullRequest(i0, i1, j, k));
+        if (!r.hasData()) continue;
+        start = std::min<int_fast32_t>(start, r.startX / s);
+        end = std::max<int_fast32_t>(end, (r.endX + s - 1) / s);
+    }
+    if (start >= end) return DataRange{0, 0};
+    return DataRange{static_cast<int16_t>(i0 + start - reqX), static_cast<int16_t>(i0 + end - reqX)};
+}
+
+PrepareResponse FastBlurNode::Decimator::onPullPrepare(const PrepareRequest& request) {
+    (void)request;
+    // 上流は所有ノードが prepare 済み。縮小座標系での上流AABBを返す
+    PrepareResponse result;
+    result.status = PrepareStatus::Prepared;
+    result.origin = {0, 0};
+    result.width = static_cast<int16_t>(owner_->lowWidth_);
+    result.height = static_cast<int16_t>(owner_->lowHeight_);
+    result.preferredFormat = PixelFormatIDs::RGBA8_Straight;
+    return result;
+}
+
+RenderResponse& FastBlurNode::Decimator::onPullProcess(const RenderRequest& request) {
+    Node* upstream = owner_->upstreamNode(0);
+    const int_fast32_t j = from_fixed(request.origin.y);
+    const int_fast32_t reqX = from_fixed(request.origin.x);
+    const int_fast32_t i0 = std::max<int_fast32_t>(0, reqX);
+    const int_fast32_t i1 = std::min<int_fast32_t>(owner_->lowWidth_, reqX + request.width);
+    if (!upstream || j < 0 || j >= owner_->lowHeight_ || i0 >= i1) {
+        return makeEmptyResponse(request.origin);
+    }
+
+    const int s = owner_->scale_;
+    const auto cells = static_cast<size_t>(i1 - i0);
+    sums_.assign(cells * 4, 0);
+    bool hasData = false;
+
+    for (int k = 0; k < s; ++k) {
+        const RenderRequest fullReq = fullRequest(i0, i1, j, k);
+        if (!upstream->getDataRange(fullReq).hasData()) continue;
+        RenderResponse& resp = upstream->pullProcess(fullReq);
+        if (resp.isValid()) {
+            consolidateIfNeeded(resp);
+            FLEXIMG_METRICS_SCOPE(NodeType::FastBlur);
+            const ViewPort src = resp.view();
+            const int_fast32_t offset = from_fixed(resp.origin.x - fullReq.origin.x);
+            const int_fast32_t xStart = std::max<int_fast32_t>(0, offset);
+            const int_fast32_t xEnd = std::min<int_fast32_t>(fullReq.width, offset + src.width);
+            if (xStart < xEnd && src.height > 0) {
+                // プリマルチプライドで面積合計（ΣC×A ≤ 255×255×64）
+                const auto* p = static_cast<const uint8_t*>(src.pixelAt(static_cast<int>(xStart - offset), 0));
+                for (int_fast32_t x = xStart; x < xEnd; ++x, p += 4) {
+                    const uint32_t a = p[3];
+                    if (a == 0) continue;
+                    uint32_t* sum = &sums_[static_cast<size_t>(x / s) * 4];
+                    sum[0] += p[0] * a;
+                    sum[1] += p[1] * a;
+                    sum[2] += p[2] * a;
+                    sum[3] += a;
+                    hasData = true;
+                }
+            }
+        }
+        if (context_) {
+            context_->releaseResponse(resp);
+        }
+    }
+    if (!hasData) return makeEmptyResponse(request.origin);
+
+    FLEXIMG_METRICS_SCOPE(NodeType::FastBlur);
+    ImageBuffer output(static_cast<int_fast16_t>(cells), 1, PixelFormatIDs::RGBA8_Straight,
+                       InitPolicy::Uninitialized);
+    auto* dst = static_cast<uint8_t*>(output.view().data);
+    const auto area = static_cast<uint32_t>(s * s);
+    for (size_t i = 0; i < cells; ++i, dst += 4) {
+        const uint32_t* sum = &sums_[i * 4];
+        const uint32_t sumA = sum[3];
+        if (sumA == 0) {
+            dst[0] = dst[1] = dst[2] = dst[3] = 0;
+            continue;
+        }
+        dst[0] = static_cast<uint8_t>((sum[0] + sumA / 2) / sumA);
+        dst[1] = static_cast<uint8_t>((sum[1] + sumA / 2) / sumA);
+        dst[2] = static_cast<uint8_t>((sum[2] + sumA / 2) / sumA);
+        dst[3] = static_cast<uint8_t>((sumA + area / 2) / area);
+    }
+    return makeResponse(std::move(output), Point{to_fixed(static_cast<int>(i0)), request.origin.y});
+}
+
+// ============================================================================
+// FastBlurNode - 縮小行の取得
+// ============================================================================
+
+void FastBlurNode::loadLowRow(int_fast32_t j, int slot) {
+    std::vector<uint32_t>& row = lowRows_[slot];
+    std::fill(row.begin(), row.end(), 0u);
+    lowRowIndex_[slot] = j;
+    if (j < lowTop_ || j >= lowBottom_) return;
+
+    RenderRequest req;
+    req.width = static_cast<int16_t>(lowRowWidth_);
+    req.height = 1;
+    req.origin = {to_fixed(static_cast<int>(lowLeft_)), to_fixed(static_cast<int>(j))};
+    RenderResponse& resp = vblur_.pullProcess(req);
+    if (resp.isValid()) {
+        consolidateIfNeeded(resp);
+        FLEXIMG_METRICS_SCOPE(NodeType::FastBlur);
+        const ViewPort src = resp.view();
+        const int_fast32_t offset = from_fixed(resp.origin.x) - lowLeft_;
+        const int_fast32_t xStart = std::max<int_fast32_t>(0, offset);
+        const int_fast32_t xEnd = std::min<int_fast32_t>(lowRowWidth_, offset + src.width);
+        if (xStart < xEnd && src.height > 0) {
+            const auto* p = static_cast<const uint8_t*>(src.pixelAt(static_cast<int>(xStart - offset), 0));
+            uint32_t* d = &row[static_cast<size_t>(xStart + 1) * 4];
+            for (int_fast32_t x = xStart; x < xEnd; ++x, p += 4, d += 4) {
+                const uint32_t a = p[3];
+                d[0] = p[0] * a;
+                d[1] = p[1] * a;
+                d[2] = p[2] * a;
+                d[3] = a;
+            }
+        }
+#ifdef FLEXIMG_DEBUG_PERF_METRICS
+        // 縮小行1本は等倍の scale_ 行分のぼかしを代替する
+        PerfMetrics::instance().nodes[NodeType::FastBlur].savedPixels +=
+            static_cast<uint32_t>(lowRowWidth_) * static_cast<uint32_t>(scale_ * scale_ - 1);
+#endif
+    }
+    if (context_) {
+        context_->releaseResponse(resp);
+    }
+}
+
+// ============================================================================
+// FastBlurNode - データ範囲
+// ============================================================================
+
+DataRange FastBlurNode::getDataRange(const RenderRequest& request) const {
+    if (passThrough_) {
+        Node* upstream = upstreamNode(0);
+        return upstream ? upstream->getDataRange(request) : DataRange{0, 0};
+    }
+    const int_fixed top = anchorY_ + to_fixed(static_cast<int>(lowTop_ * scale_));
+    const int_fixed bottom = anchorY_ + to_fixed(static_cast<int>(lowBottom_ * scale_));
+    if (request.origin.y < top || request.origin.y >= bottom) return DataRange{0, 0};
+
+    const int_fixed rel = anchorX_ + to_fixed(static_cast<int>(lowLeft_ * scale_)) - request.origin.x;
+    const auto start = std::max<int_fast32_t>(0, from_fixed_floor(rel));
+    const auto end = std::min<int_fast32_t>(
+        request.width, from_fixed_ceil(rel + to_fixed(static_cast<int>(lowRowWidth_ * scale_))));
+    return (start < end) ? DataRange{static_cast<int16_t>(start), static_cast<int16_t>(end)}
+                         : DataRange{0, 0};
+}
+
+// ============================================================================
+// FastBlurNode - Template Method フック実装
+// ============================================================================
+
+PrepareResponse FastBlurNode::onPullPrepare(const PrepareRequest& request) {
+    Node* upstream = upstreamNode(0);
+    if (!upstream) {
+        passThrough_ = true;
+        PrepareResponse result;
+        result.status = PrepareStatus::Prepared;
+        return result;
+    }
+
+    PrepareResponse result = upstream->pullPrepare(request);
+    if (!result.ok()) {
+        return result;
+    }
+
+    const int_fast16_t lowRadius = lowResRadius();
+    passThrough_ = lowRadius == 0 || result.width <= 0 || result.height <= 0;
+    if (passThrough_) {
+        return result;
+    }
+
+    // 縮小座標系: 上流AABBの左上（整数に切り下げ）を縮小画素 (0, 0) の左上とする
+    scale_ = static_cast<int16_t>(effectiveDownsample());
+    const int left = from_fixed_floor(result.origin.x);
+    const int top = from_fixed_floor(result.origin.y);
+    const int fullW = from_fixed_ceil(result.origin.x + to_fixed(result.width)) - left;
+    const int fullH = from_fixed_ceil(result.origin.y + to_fixed(result.height)) - top;
+    anchorX_ = to_fixed(left);
+    anchorY_ = to_fixed(top);
+    lowWidth_ = (fullW + scale_ - 1) / scale_;
+    lowHeight_ = (fullH + scale_ - 1) / scale_;
+
+    // 内部パイプラインを縮小座標系で prepare（縮小ステージは上流を再度 prepare しない）
+    hblur_.setRadius(lowRadius);
+    hblur_.setPasses(passes_);
+    vblur_.setRadius(lowRadius);
+    vblur_.setPasses(passes_);
+    PrepareRequest lowRequest;
+    lowRequest.width = static_cast<int16_t>(lowWidth_);
+    lowRequest.height = static_cast<int16_t>(lowHeight_);
+    lowRequest.context = request.context;
+    PrepareResponse low = vblur_.pullPrepare(lowRequest);
+    if (!low.ok()) {
+        return low;
+    }
+    lowLeft_ = from_fixed_floor(low.origin.x);
+    lowRowWidth_ = low.width;
+    lowTop_ = from_fixed_floor(low.origin.y);
+    lowBottom_ = lowTop_ + low.height;
+
+    for (auto& row : lowRows_) {
+        row.assign(lowRowStride(), 0u);
+    }
+    lowRowIndex_[0] = lowRowIndex_[1] = INT32_MIN;
+    lerpRow_.assign(lowRowStride(), 0u);
+
+#ifdef FLEXIMG_DEBUG_PERF_METRICS
+    auto& metrics = PerfMetrics::instance().nodes[NodeType::FastBlur];
+    const size_t ownBytes = lowRowStride() * sizeof(uint32_t) * 3;
+    metrics.recordAlloc(ownBytes, static_cast<int_fast16_t>(lowRowWidth_ + 2), 3);
+    // 等倍で同じぼかし（HorizontalBlur + VerticalBlur）を行った場合の VerticalBlur 作業メモリとの差
+    auto vblurBytes = [&](size_t radius, size_t width) {
+        return static_cast<size_t>(passes_) * ((radius * 2 + 1) * width * 4 + width * 16);
+    };
+    const size_t spread = static_cast<size_t>(radius_) * static_cast<size_t>(passes_);
+    const size_t fullBytes = vblurBytes(static_cast<size_t>(radius_), static_cast<size_t>(fullW) + spread * 2);
+    const size_t lowBytes = vblurBytes(static_cast<size_t>(lowRadius), static_cast<size_t>(lowRowWidth_)) + ownBytes;
+    if (fullBytes > lowBytes) {
+        metrics.savedBytes += static_cast<uint32_t>(fullBytes - lowBytes);
+    }
+#endif
+
+    // AABB をぼかし後の縮小AABBの等倍範囲に拡張
+    result.origin = {anchorX_ + to_fixed(static_cast<int>(lowLeft_ * scale_)),
+                     anchorY_ + to_fixed(static_cast<int>(lowTop_ * scale_))};
+    result.width = static_cast<int16_t>(std::min<int_fast32_t>(INT16_MAX, lowRowWidth_ * scale_));
+    result.height = static_cast<int16_t>(std::min<int_fast32_t>(INT16_MAX, (lowBottom_ - lowTop_) * scale_));
+    result.preferredFormat = PixelFormatIDs::RGBA8_Straight;
+    return result;
+}
+
+void FastBlurNode::onPullFinalize() {
+    if (!passThrough_) {
+        vblur_.pullFinalize();
+    }
+    for (auto& row : lowRows_) {
+        row = std::vector<uint32_t>();
+    }
+    lerpRow_ = std::vector<uint32_t>();
+    lowRowIndex_[0] = lowRowIndex_[1] = INT32_MIN;
+    finalize();
+    Node* upstream = upstreamNode(0);
+    if (upstream) {
+        upstream->pullFinalize();
+    }
+}
+
+RenderResponse& FastBlurNode::onPullProcess(const RenderRequest& request) {
+    Node* upstream = upstreamNode(0);
+    if (!upstream) return makeEmptyResponse(request.origin);
+    if (passThrough_) {
+        return upstream->pullProcess(request);
+    }
+
+    const DataRange range = getDataRange(request);
+    if (!range.hasData()) {
+        return makeEmptyResponse(request.origin);
+    }
+
+    // 補間元の縮小行 iy, iy + 1 と重み fy（256 = 1行）
+    const int_fast32_t step = cellStep();
+    const int_fast32_t v = from_fixed(request.origin.y - anchorY_) * step + cellBase();
+    const int_fast32_t iy = fast_blur_detail::floorDiv(v, 256);
+    const auto fy = static_cast<uint32_t>(v - iy * 256);
+
+    // 保持していない行を取得（内部パイプラインへは下方向の連続リクエストになる）
+    if (findLowRow(iy) < 0) {
+        loadLowRow(iy, (findLowRow(iy + 1) == 0) ? 1 : 0);
+    }
+    if (fy != 0 && findLowRow(iy + 1) < 0) {
+        loadLowRow(iy + 1, 1 - findLowRow(iy));
+    }
+
+    FLEXIMG_METRICS_SCOPE(NodeType::FastBlur);
+
+    // 垂直補間（lerpRow_ = row0 × (256 - fy) + row1 × fy、ΣC×A ≤ 65025×256）
+    const uint32_t* row0 = lowRows_[findLowRow(iy)].data();
+    const size_t stride = lowRowStride();
+    if (fy == 0) {
+        for (size_t i = 0; i < stride; ++i) lerpRow_[i] = row0[i] << 8;
+    } else {
+        const uint32_t* row1 = lowRows_[findLowRow(iy + 1)].data();
+        for (size_t i = 0; i < stride; ++i) lerpRow_[i] = row0[i] * (256 - fy) + row1[i] * fy;
+    }
+
+    // 水平補間して出力（重み合計 65536、ΣC×A ≤ 65025×65536 < 2^32）
+    const int start = range.startX, end = range.endX;
+    ImageBuffer output(static_cast<int_fast16_t>(end - start), 1, PixelFormatIDs::RGBA8_Straight,
+                       InitPolicy::Uninitialized);
+    auto* dst = static_cast<uint8_t*>(output.view().data);
+    int_fast32_t u = (from_fixed(request.origin.x - anchorX_) + start) * step + cellBase() - lowLeft_ * 256;
+    for (int x = start; x < end; ++x, u += step, dst += 4) {
+        const int_fast32_t ix = fast_blur_detail::floorDiv(u, 256);
+        if (ix < -1 || ix >= lowRowWidth_) {
+            dst[0] = dst[1] = dst[2] = dst[3] = 0;
+            continue;
+        }
+        const auto fx = static_cast<uint32_t>(u - ix * 256);
+        const uint32_t* l = &lerpRow_[static_cast<size_t>(ix + 1) * 4];
+        const uint32_t* r = l + 4;
+        const uint32_t a = l[3] * (256 - fx) + r[3] * fx;
+        const uint32_t a8 = (a + 32768) >> 16;
+        if (a8 == 0) {
+            dst[0] = dst[1] = dst[2] = dst[3] = 0;
+            continue;
+        }
+        for (int c = 0; c < 3; ++c) {
+            const uint32_t pm = l[c] * (256 - fx) + r[c] * fx;
+            dst[c] = static_cast<uint8_t>((static_cast<uint64_t>(pm) + a / 2) / a);
+        }
+        dst[3] = static_cast<uint8_t>(a8);
+    }
+
+    return makeResponse(std::move(output), Point{request.origin.x + to_fixed(start), request.origin.y});
+}
+
+} // namespace FLEXIMG_NAMESPACE
+
+#endif // FLEXIMG_IMPLEMENTATION
+
+#endif // FLEXIMG_FAST_BLUR_NODE_H
@@ -5,6 +5,7 @@
 #include "../core/perf_metrics.h"
 #include "../image/image_buffer.h"
 #include "../operations/filters.h"
+#include <vector>
 
 namespace FLEXIMG_NAMESPACE {
 
@@ -35,6 +36,19 @@ namespace FLEXIMG_NAMESPACE {
 //       const char* name() const override { return "BrightnessNode"; }
 //   };
 //
+// 連続したフィルタの融合（pull型）:
+//   BrightnessNode >> GrayscaleNode >> AlphaNode のように直結したフィルタノード（入力マージン0）は、
+//   prepare 時に最下流のノードがまとめ、上流の先頭ノードの入力を直接取得して
+//   filters::apply_line_chain で全段を1パスで適用する（途中のノードの pullProcess は呼ばれない）。
+//   各段の関数とパラメータは process 時に各ノードから読み出す。
+//
+// インデックスカラー入力のパレット適用:
+//   入力マージン0のフィルタ（appliesToPalette()）は、入力がパレット付きのインデックス形式の場合、
+//   ピクセルを RGBA8 に展開せずパレットの各エントリへフィルタを適用し（フレームごとに1回）、
+//   インデックス形式のまま差し替えたパレットを付けて下流へ渡す。
+//   上流の PrepareResponse::preferredFormat がインデックス形式なら prepare 時にパレット領域を確保し、
+//   下流へもインデックス形式を伝える（それ以外は RGBA8_Straight を伝える）。
+//
 
 class FilterNodeBase : public Node {
 public:
@@ -48,13 +62,24 @@ public:
 
     const char* name() const override { return "FilterNodeBase"; }
 
+    const FilterNodeBase* asFilterNode() const override { return this; }
+
+    // prepare 時に融合した段数（自身を含む、1 = 融合なし）
+    int_fast16_t fusedStageCount() const { return fusedCount_; }
+
     // ========================================
     // Template Method フック
     // ========================================
 
+    // onPullPrepare: 上流を準備した後、直結した上流のフィルタノードを融合する
+    PrepareResponse onPullPrepare(const PrepareRequest& request) override;
+
     // onPullProcess: マージン追加とメトリクス記録を行い、process() に委譲
+    // （融合時は上流の先頭ノードの入力に全段を適用）
     RenderResponse& onPullProcess(const RenderRequest& request) override;
 
+    void finalize() override;
+
 protected:
     // ========================================
     // 派生クラスがオーバーライドするフック
@@ -66,6 +91,10 @@ protected:
     /// 入力マージン（ブラー等で拡大が必要な場合にオーバーライド）
     virtual int computeInputMargin() const { return 0; }
 
+    /// インデックス形式の入力でパレットへ適用するか
+    /// （既定: 入力マージン0。ピクセル位置に依存するフィルタは false を返すこと）
+    virtual bool appliesToPalette() const { return computeInputMargin() == 0; }
+
     /// メトリクス用ノードタイプ（派生クラスで実装）
     int nodeTypeForMetrics() const override = 0;
 
@@ -74,11 +103,29 @@ protected:
     RenderResponse& process(RenderResponse& input,
                             const RenderRequest& request) override;
 
+    // input を RGBA8_Straight の所有バッファにして、加工する行の先頭を返す
+    uint8_t* prepareWorkingRow(RenderResponse& input);
+
+    // input がパレット付きインデックス形式なら、フィルタ済みパレットに差し替えて true を返す
+    bool filterPalette(RenderResponse& input,
+                       const filters::LineFilterStage* stages, int_fast16_t stageCount);
+
     // ========================================
     // パラメータ（派生クラスからアクセス可能）
     // ========================================
 
     filters::LineFilterParams params_;
+
+private:
+    // 融合した段（[0] が最上流、[fusedCount_ - 1] が自身）と、その上流
+    const FilterNodeBase* fused_[filters::kMaxLineFilterStages] = {};
+    int_fast16_t fusedCount_ = 1;
+    Node* fusedUpstream_ = nullptr;
+
+    // フィルタ済みパレット（RGBA8_Straight × 256、finalize で無効化）と変換元
+    std::vector<uint8_t> palette_;
+    PixelAuxInfo paletteSource_;
+    bool paletteValid_ = false;
 };
 
 } // namespace FLEXIMG_NAMESPACE
@@ -94,8 +141,58 @@ namespace FLEXIMG_NAMESPACE {
 // FilterNodeBase - Template Method フック実装
 // ============================================================================
 
-RenderResponse& FilterNodeBase::onPullProcess(const RenderRequest& request) {
+PrepareResponse FilterNodeBase::onPullPrepare(const PrepareRequest& request) {
+    PrepareResponse result = Node::onPullPrepare(request);
+    fusedCount_ = 1;
+    fusedUpstream_ = nullptr;
+    paletteValid_ = false;
+    if (!result.ok()) {
+        return result;
+    }
+
+    // 上流がインデックス形式ならパレット適用の領域を確保し、出力もインデックス形式のまま
+    if (appliesToPalette() && result.preferredFormat && result.preferredFormat->isIndexed) {
+        palette_.reserve(256 * 4);
+    } else {
+        result.preferredFormat = PixelFormatIDs::RGBA8_Straight;
+    }
+
+    if (computeInputMargin() != 0) {
+        return result;
+    }
+
+    // 直結した上流のフィルタノード（ポートは1対1なので出力先は自身のみ）を遡る
+    const FilterNodeBase* chain[filters::kMaxLineFilterStages];
+    int_fast16_t count = 0;
+    chain[count++] = this;
     Node* upstream = upstreamNode(0);
+    while (upstream && count < filters::kMaxLineFilterStages) {
+        const FilterNodeBase* filter = upstream->asFilterNode();
+        if (!filter || filter->computeInputMargin() != 0) break;
+        chain[count++] = filter;
+        upstream = filter->upstreamNode(0);
+    }
+    if (count < 2 || !upstream) {
+        return result;
+    }
+
+    for (int_fast16_t i = 0; i < count; i++) {
+        fused_[i] = chain[count - 1 - i];
+    }
+    fusedCount_ = count;
+    fusedUpstream_ = upstream;
+    return result;
+}
+
+void FilterNodeBase::finalize() {
+    fusedCount_ = 1;
+    fusedUpstream_ = nullptr;
+    paletteValid_ = false;
+    palette_ = std::vector<uint8_t>();
+}
+
+RenderResponse& FilterNodeBase::onPullProcess(const RenderRequest& request) {
+    Node* upstream = fusedUpstream_ ? fusedUpstream_ : upstreamNode(0);
     if (!upstream) return makeEmptyResponse(request.origin);
 
     int margin = computeInputMargin();
@@ -111,15 +208,35 @@ RenderResponse& FilterNodeBase::onPullProcess(const RenderRequest& request) {
     RenderResponse& input = upstream->pullProcess(inputReq);
     if (!input.isValid()) return input;
 
-    // process() を呼ぶ（Node基底クラスの設計に沿う）
-    return process(input, request);
+    if (!fusedUpstream_) {
+        // process() を呼ぶ（Node基底クラスの設計に沿う）
+        return process(input, request);
+    }
+
+    // 融合: 全段を1パスで適用
+    FLEXIMG_METRICS_SCOPE(nodeTypeForMetrics());
+    filters::LineFilterStage stages[filters::kMaxLineFilterStages];
+    for (int_fast16_t i = 0; i < fusedCount_; i++) {
+        stages[i].func = fused_[i]->getFilterFunc();
+        stages[i].params = fused_[i]->params_;
+    }
+    bool palette = true;
+    for (int_fast16_t i = 0; i < fusedCount_; i++) {
+        palette = palette && fused_[i]->appliesToPalette();
+    }
+    if (palette && filterPalette(input, stages, fusedCount_)) {
+        return input;
+    }
+    uint8_t* row = prepareWorkingRow(input);
+    filters::apply_line_chain(row, input.buffer().view().width, stages, fusedCount_);
+    return input;
 }
 
 // ============================================================================
 // FilterNodeBase - process() 共通実装
 // ============================================================================
 //
-// スキャンライン必須仕様（height=1）前提の共通処理:
+// スキャンライン必須仕様（height=1）前提の共通処理（push型、融合なしの pull型）:
 // 1. RGBA8_Straight形式に変換
 // 2. ラインフィルタ関数を適用
 // 3. パフォーマンス計測（デバッグビルド時）
@@ -130,20 +247,75 @@ RenderResponse& FilterNodeBase::process(RenderResponse& input,
     (void)request;  // スキャンライン必須仕様では未使用
     FLEXIMG_METRICS_SCOPE(nodeTypeForMetrics());
 
+    // ラインフィルタを適用（height=1前提、既知フィルタはSIMD経路）
+    const filters::LineFilterStage stage{getFilterFunc(), params_};
+    if (appliesToPalette() && filterPalette(input, &stage, 1)) {
+        return input;
+    }
+    uint8_t* row = prepareWorkingRow(input);
+    filters::apply_line_chain(row, input.buffer().view().width, &stage, 1);
+
+    // inputをそのまま返す（借用元への変更が反映される）
+    return input;
+}
+
+uint8_t* FilterNodeBase::prepareWorkingRow(RenderResponse& input) {
     // フォーマット変換を実行（メトリクス記録付き）
     consolidateIfNeeded(input, PixelFormatIDs::RGBA8_Straight);
 
-    // input.buffer() を直接加工
-    ImageBuffer& working = input.buffer();
-    ViewPort workingView = working.view();
+    // 参照モード（ソース画像・共有バッファ）は編集禁止: 所有バッファにコピー
+    if (!input.buffer().ownsMemory()) {
+        input.replaceBuffer(convertFormat(std::move(input.buffer()), PixelFormatIDs::RGBA8_Straight));
+    }
 
-    // ラインフィルタを適用（height=1前提）
+    // input.buffer() を直接加工
     // ViewPortのx,yオフセットを考慮してpixelAt(0,0)を使用
-    uint8_t* row = static_cast<uint8_t*>(workingView.pixelAt(0, 0));
-    getFilterFunc()(row, workingView.width, params_);
+    return static_cast<uint8_t*>(input.buffer().view().pixelAt(0, 0));
+}
 
-    // inputをそのまま返す（借用元への変更が反映される）
-    return input;
+bool FilterNodeBase::filterPalette(RenderResponse& input,
+                                   const filters::LineFilterStage* stages, int_fast16_t stageCount) {
+    PixelFormatID format = input.buffer().formatID();
+    PixelAuxInfo& aux = input.buffer().auxInfo();
+    if (!format || !format->isIndexed || !aux.palette || !aux.paletteFormat
+        || aux.paletteColorCount == 0) {
+        return false;
+    }
+
+    // 同一フレーム内で同じパレットなら前回の結果を再利用
+    const bool sameSource = paletteValid_
+        && aux.palette == paletteSource_.palette
+        && aux.paletteFormat == paletteSource_.paletteFormat
+        && aux.paletteColorCount == paletteSource_.paletteColorCount
+        && aux.colorKeyRGBA8 == paletteSource_.colorKeyRGBA8
+        && aux.colorKeyReplace == paletteSource_.colorKeyReplace;
+    if (!sameSource) {
+        // ピクセル経路と同じ変換器でパレットを RGBA8 に展開（カラーキーの扱いも一致）
+        const auto count = static_cast<int_fast16_t>(std::min<uint16_t>(aux.paletteColorCount, 256));
+        PixelAuxInfo source = aux;
+        source.pixelOffsetInByte = 0;
+        FormatConverter converter = resolveConverter(PixelFormatIDs::Index8,
+                                                     PixelFormatIDs::RGBA8_Straight, &source);
+        if (!converter) return false;
+
+        uint8_t indices[256];
+        for (int_fast16_t i = 0; i < count; i++) {
+            indices[i] = static_cast<uint8_t>(i);
+        }
+        palette_.assign(256 * 4, 0);
+        converter(palette_.data(), indices, static_cast<size_t>(count));
+        filters::apply_line_chain(palette_.data(), count, stages, stageCount);
+        paletteSource_ = source;
+        paletteValid_ = true;
+    }
+
+    // インデックスはそのまま、パレットのみ差し替え（カラーキーは展開時に適用済み）
+    aux.palette = palette_.data();
+    aux.paletteFormat = PixelFormatIDs::RGBA8_Straight;
+    aux.paletteColorCount = paletteSource_.paletteColorCount;
+    aux.colorKeyRGBA8 = 0;
+    aux.colorKeyReplace = 0;
+    return true;
 }
 
 } // namespace FLEXIMG_NAMESPACE
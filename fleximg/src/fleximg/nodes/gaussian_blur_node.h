@@ -0,0 +1,676 @@
+#ifndef FLEXIMG_GAUSSIAN_BLUR_NODE_H
+#define FLEXIMG_GAUSSIAN_BLUR_NODE_H
+
+#include "../core/node.h"
+#include "../core/perf_metrics.h"
+#include "../core/render_context.h"
+#include "../image/image_buffer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace FLEXIMG_NAMESPACE {
+
+// ========================================================================
+// GaussianBlurNode - ガウシアンブラーノード（再帰フィルタ、σに依存しない計算量）
+// ========================================================================
+//
+// 入力画像に2次元ガウシアンブラーを適用します。
+// - 入力: 1ポート
+// - 出力: 1ポート（RGBA8_Straight）
+// - sigma: ガウス関数の標準偏差（0.5未満はパススルー、上限 kMaxSigma）
+//
+// 処理方式（Young–van Vliet の3次再帰フィルタ）:
+// - 各方向に因果（前進）と反因果（後退）の3次IIRを1回ずつ適用する
+//   （係数は σ のみで決まり、1ピクセルあたりの演算量は σ によらず一定）
+// - 計算はプリマルチプライドの float で行い、出力時にストレートへ戻す
+// - 水平: 上流の1行ごとに前進/後退を適用（データ範囲 ± lookahead のみ）
+// - 垂直: 前進フィルタは3行分の状態を持ち回して行ごとに進める
+//   後退フィルタは下方向の行が必要なため、出力をブロック（lookahead 行単位）で
+//   まとめて確定させる。前進の結果を lookahead + ブロック行のリングに保持し、
+//   ブロック末尾 + lookahead 行から後退させてブロック内の行を出力する
+//
+// lookahead（= ceil(3σ) + 1）:
+// - 後退フィルタは lookahead 先で打ち切り、その位置の前進値で状態を初期化する
+//   （定常値による初期化。打ち切り誤差は 1〜2 レベル程度）
+// - AABB は上下左右に lookahead ずつ拡張される
+//
+// メモリ消費量（概算、幅 W = 上流幅 + 2 * lookahead）:
+// - 前進リング: (ブロック行 + lookahead) * W * 8 bytes（uint16 × 4ch）
+// - 状態・作業行: W * 16 bytes × 7行 + 出力ブロック W * 4 bytes × ブロック行
+// - 例: sigma=50, 上流 1920 幅 → 約7MB
+//
+// スキャンライン処理:
+// - 下方向への連続したリクエストは前進状態を引き継いでブロック単位で処理
+// - それ以外（上方向・離れた行）は lookahead 行手前から前進をやり直す
+//
+// 制約:
+// - pull型のみ対応
+// - 非連続なリクエスト（タイル分割など）では前進の再計算が発生する
+//
+// 使用例:
+//   GaussianBlurNode blur;
+//   blur.setSigma(20.0f);
+//   background >> blur >> composite;
+//
+
+namespace gaussian_blur_detail {
+
+// Young–van Vliet 再帰フィルタ係数
+// w[n] = b * x[n] + a1 * w[n-1] + a2 * w[n-2] + a3 * w[n-3]
+struct Coefficients {
+    float b = 1.0f;
+    float a1 = 0.0f;
+    float a2 = 0.0f;
+    float a3 = 0.0f;
+};
+
+inline Coefficients computeCoefficients(float sigma) {
+    const double s = static_cast<double>(sigma);
+    const double q = (s >= 2.5) ? 0.98711 * s - 0.96330
+                                : 3.97156 - 4.14554 * std::sqrt(1.0 - 0.26891 * s);
+    const double q2 = q * q;
+    const double q3 = q2 * q;
+    const double b0 = 1.57825 + 2.44413 * q + 1.4281 * q2 + 0.422205 * q3;
+    const double b1 = 2.44413 * q + 2.85619 * q2 + 1.26661 * q3;
+    const double b2 = -(1.4281 * q2 + 1.26661 * q3);
+    const double b3 = 0.422205 * q3;
+    Coefficients c;
+    c.a1 = static_cast<float>(b1 / b0);
+    c.a2 = static_cast<float>(b2 / b0);
+    c.a3 = static_cast<float>(b3 / b0);
+    // 直流ゲインが正確に1になるよう b を残差から求める
+    c.b = static_cast<float>(1.0 - (b1 + b2 + b3) / b0);
+    return c;
+}
+
+} // namespace gaussian_blur_detail
+
+class GaussianBlurNode : public Node {
+public:
+    GaussianBlurNode() {
+        initPorts(1, 1);  // 入力1、出力1
+    }
+
+    // ========================================
+    // パラメータ設定
+    // ========================================
+
+    // パラメータ範囲
+    // kMaxSigma: float の再帰計算誤差が 0.5 レベル未満に収まる範囲
+    static constexpr float kMinSigma = 0.5f;
+    static constexpr float kMaxSigma = 64.0f;
+
+    void setSigma(float sigma) {
+        sigma_ = (sigma > 0.0f) ? std::min(sigma, kMaxSigma) : 0.0f;
+        markModified();
+    }
+
+    float sigma() const { return sigma_; }
+
+    // 後退フィルタの打ち切り距離（= AABB の拡張量）
+    int_fast16_t lookahead() const {
+        return static_cast<int_fast16_t>(std::ceil(sigma_ * 3.0f)) + 1;
+    }
+
+    // ========================================
+    // Node インターフェース
+    // ========================================
+
+    const char* name() const override { return "GaussianBlurNode"; }
+
+    // getDataRange: 拡張後の上流AABBとリクエストの交差（保守的）
+    DataRange getDataRange(const RenderRequest& request) const override;
+
+protected:
+    int nodeTypeForMetrics() const override { return NodeType::GaussianBlur; }
+
+    PrepareResponse onPullPrepare(const PrepareRequest& request) override;
+    RenderResponse& onPullProcess(const RenderRequest& request) override;
+    void onPullFinalize() override;
+
+private:
+    float sigma_ = 8.0f;
+
+    // prepare で決定する処理範囲
+    bool passThrough_ = true;
+    gaussian_blur_detail::Coefficients coeffs_;
+    int_fast16_t lookahead_ = 0;
+    int_fast16_t blockRows_ = 0;
+    int_fixed cacheOriginX_ = 0;     // 作業行左端のワールド座標（上流AABB - lookahead）
+    int16_t cacheWidth_ = 0;         // 作業行の幅（上流AABB幅 + 2 * lookahead）
+    int_fast32_t srcTop_ = 0;        // 上流AABBの行範囲 [srcTop_, srcBottom_)
+    int_fast32_t srcBottom_ = 0;
+    int_fast32_t top_ = 0;           // 出力行範囲 [top_, bottom_)
+    int_fast32_t bottom_ = 0;
+
+    // 作業バッファ（prepare で確保、finalize で破棄）
+    std::vector<float> line_;        // 水平フィルタ用の1行
+    std::vector<float> fwdState_;    // 垂直前進の状態3行
+    std::vector<float> bwdState_;    // 垂直後退の状態3行
+    std::vector<uint16_t> ring_;     // 垂直前進の結果（値 × 256）、(blockRows_ + lookahead_) 行
+    std::vector<uint8_t> block_;     // 確定した出力ブロック（RGBA8_Straight）
+    int fwdHead_ = 0;                // fwdState_ の最新行（w[n-1]）のインデックス
+
+    // スキャンライン状態
+    int_fast32_t fwdY_ = 0;          // 次に前進フィルタを適用する行
+    int_fast32_t blockY_ = 0;        // block_ の先頭行
+    int_fast32_t blockEnd_ = 0;      // block_ の終端行（blockY_ == blockEnd_ で無効）
+
+    size_t rowFloats() const { return static_cast<size_t>(cacheWidth_) * 4; }
+    int_fast32_t ringRows() const { return blockRows_ + lookahead_; }
+
+    uint16_t* ringRow(int_fast32_t y) {
+        int_fast32_t slot = y % ringRows();
+        if (slot < 0) slot += ringRows();
+        return &ring_[static_cast<size_t>(slot) * rowFloats()];
+    }
+
+    // 上流の1行を取得して水平フィルタを適用し、line_ に格納（データがなければ false）
+    bool fetchFilteredRow(Node* upstream, int_fast32_t y);
+
+    // 1行分の垂直前進フィルタを進め、結果をリングに格納
+    void advanceForward(Node* upstream, bool replicateInit);
+
+    // y を含む出力ブロックを確定させる
+    void computeBlock(Node* upstream, int_fast32_t y);
+};
+
+} // namespace FLEXIMG_NAMESPACE
+
+// =============================================================================
+// 実装部
+// =============================================================================
+#ifdef FLEXIMG_IMPLEMENTATION
+
+#if defined(FLEXIMG_HAS_SSE2)
+#include <emmintrin.h>
+#endif
+
+namespace FLEXIMG_NAMESPACE {
+
+// ========================================
+// 再帰フィルタカーネル
+// ========================================
+//
+// 値はプリマルチプライドの float（値域 0..255）、1ピクセル4ch インターリーブ。
+// SSE2 版は1ピクセル（水平）または4要素（垂直）を __m128 で処理し、
+// スカラー版と同じ演算順序で計算する。
+
+namespace gaussian_blur_detail {
+
+static inline float clampf(float v, float lo, float hi) {
+    return (v <= lo) ? lo : (v >= hi) ? hi : v;
+}
+
+// 水平の前進/後退フィルタ（in-place、[begin, end) の外側は0として扱う）
+static inline void filterLineScalar(float* line, int_fast32_t begin, int_fast32_t end, const Coefficients& c) {
+    float w1[4] = {0, 0, 0, 0}, w2[4] = {0, 0, 0, 0}, w3[4] = {0, 0, 0, 0};
+    // 前進: begin より左は0なので状態0から開始（厳密）
+    for (int_fast32_t n = begin; n < end; ++n) {
+        float* p = line + n * 4;
+        for (int ch = 0; ch < 4; ++ch) {
+            const float w = c.b * p[ch] + c.a1 * w1[ch] + c.a2 * w2[ch] + c.a3 * w3[ch];
+            w3[ch] = w2[ch];
+            w2[ch] = w1[ch];
+            w1[ch] = w;
+            p[ch] = w;
+        }
+    }
+    // 後退: end で打ち切り、末尾の前進値（定常値）で状態を初期化
+    const float* last = line + (end - 1) * 4;
+    for (int ch = 0; ch < 4; ++ch) {
+        w1[ch] = w2[ch] = w3[ch] = last[ch];
+    }
+    for (int_fast32_t n = end - 1; n >= begin; --n) {
+        float* p = line + n * 4;
+        for (int ch = 0; ch < 4; ++ch) {
+            const float w = c.b * p[ch] + c.a1 * w1[ch] + c.a2 * w2[ch] + c.a3 * w3[ch];
+            w3[ch] = w2[ch];
+            w2[ch] = w1[ch];
+            w1[ch] = w;
+            p[ch] = w;
+        }
+    }
+}
+
+// 垂直前進の1行: s3 = b*x + a1*s1 + a2*s2 + a3*s3（x == nullptr は入力0）
+// 結果を値 × 256 の uint16 でリング行に格納
+static inline void forwardRowScalar(const float* x, const float* s1, const float* s2, float* s3,
+                                    uint16_t* out, size_t begin, size_t count, const Coefficients& c) {
+    for (size_t i = begin; i < count; ++i) {
+        const float in = x ? c.b * x[i] : 0.0f;
+        const float w = in + c.a1 * s1[i] + c.a2 * s2[i] + c.a3 * s3[i];
+        s3[i] = w;
+        out[i] = static_cast<uint16_t>(clampf(w * 256.0f + 0.5f, 0.0f, 65535.0f));
+    }
+}
+
+// 垂直後退の1行: b3 = b*f + a1*b1 + a2*b2 + a3*b3（f はリング行）
+static inline void backwardRowScalar(const uint16_t* f, const float* b1, const float* b2, float* b3,
+                                     size_t begin, size_t count, const Coefficients& c) {
+    constexpr float inv256 = 1.0f / 256.0f;
+    for (size_t i = begin; i < count; ++i) {
+        b3[i] = c.b * (f[i] * inv256) + c.a1 * b1[i] + c.a2 * b2[i] + c.a3 * b3[i];
+    }
+}
+
+// プリマルチプライド float → RGBA8_Straight
+static inline void resolvePixelScalar(uint8_t* out, const float* p) {
+    const float a = p[3];
+    if (a < 0.5f) {
+        out[0] = out[1] = out[2] = out[3] = 0;
+        return;
+    }
+    const float k = 255.0f / a;
+    for (int ch = 0; ch < 3; ++ch) {
+        out[ch] = static_cast<uint8_t>(clampf(p[ch] * k + 0.5f, 0.0f, 255.0f));
+    }
+    out[3] = static_cast<uint8_t>(clampf(a + 0.5f, 0.0f, 255.0f));
+}
+
+#ifdef FLEXIMG_HAS_SSE2
+static inline void filterLineSSE2(float* line, int_fast32_t begin, int_fast32_t end, const Coefficients& c) {
+    const __m128 vb = _mm_set1_ps(c.b);
+    const __m128 va1 = _mm_set1_ps(c.a1);
+    const __m128 va2 = _mm_set1_ps(c.a2);
+    const __m128 va3 = _mm_set1_ps(c.a3);
+    __m128 w1 = _mm_setzero_ps(), w2 = w1, w3 = w1;
+    for (int_fast32_t n = begin; n < end; ++n) {
+        float* p = line + n * 4;
+        const __m128 w = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(vb, _mm_loadu_ps(p)), _mm_mul_ps(va1, w1)),
+                                               _mm_mul_ps(va2, w2)), _mm_mul_ps(va3, w3));
+        w3 = w2;
+        w2 = w1;
+        w1 = w;
+        _mm_storeu_ps(p, w);
+    }
+    w1 = w2 = w3 = _mm_loadu_ps(line + (end - 1) * 4);
+    for (int_fast32_t n = end - 1; n >= begin; --n) {
+        float* p = line + n * 4;
+        const __m128 w = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(vb, _mm_loadu_ps(p)), _mm_mul_ps(va1, w1)),
+                                               _mm_mul_ps(va2, w2)), _mm_mul_ps(va3, w3));
+        w3 = w2;
+        w2 = w1;
+        w1 = w;
+        _mm_storeu_ps(p, w);
+    }
+}
+
+// 4要素/反復（処理済み要素数を返す）
+static inline size_t forwardRowSSE2(const float* x, const float* s1, const float* s2, float* s3,
+                                    uint16_t* out, size_t count, const Coefficients& c) {
+    const __m128 vb = _mm_set1_ps(c.b);
+    const __m128 va1 = _mm_set1_ps(c.a1);
+    const __m128 va2 = _mm_set1_ps(c.a2);
+    const __m128 va3 = _mm_set1_ps(c.a3);
+    const __m128 scale = _mm_set1_ps(256.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 maxV = _mm_set1_ps(65535.0f);
+    const __m128i bias = _mm_set1_epi32(32768);
+    const __m128i flip = _mm_set1_epi16(static_cast<int16_t>(-32768));
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128 in = x ? _mm_mul_ps(vb, _mm_loadu_ps(x + i)) : _mm_setzero_ps();
+        const __m128 w = _mm_add_ps(_mm_add_ps(_mm_add_ps(in, _mm_mul_ps(va1, _mm_loadu_ps(s1 + i))),
+                                               _mm_mul_ps(va2, _mm_loadu_ps(s2 + i))),
+                                    _mm_mul_ps(va3, _mm_loadu_ps(s3 + i)));
+        _mm_storeu_ps(s3 + i, w);
+        // uint16 へ飽和変換（SSE2 に packus_epi32 がないため符号付きにずらして pack）
+        const __m128 v = _mm_min_ps(_mm_max_ps(_mm_add_ps(_mm_mul_ps(w, scale), half), _mm_setzero_ps()), maxV);
+        const __m128i q = _mm_sub_epi32(_mm_cvttps_epi32(v), bias);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out + i), _mm_xor_si128(_mm_packs_epi32(q, q), flip));
+    }
+    return i;
+}
+
+static inline size_t backwardRowSSE2(const uint16_t* f, const float* b1, const float* b2, float* b3,
+                                     size_t count, const Coefficients& c) {
+    const __m128 vb = _mm_set1_ps(c.b);
+    const __m128 va1 = _mm_set1_ps(c.a1);
+    const __m128 va2 = _mm_set1_ps(c.a2);
+    const __m128 va3 = _mm_set1_ps(c.a3);
+    const __m128 inv256 = _mm_set1_ps(1.0f / 256.0f);
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128i fi = _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(f + i)), zero);
+        const __m128 fv = _mm_mul_ps(_mm_cvtepi32_ps(fi), inv256);
+        const __m128 w = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(vb, fv), _mm_mul_ps(va1, _mm_loadu_ps(b1 + i))),
+                                               _mm_mul_ps(va2, _mm_loadu_ps(b2 + i))),
+                                    _mm_mul_ps(va3, _mm_loadu_ps(b3 + i)));
+        _mm_storeu_ps(b3 + i, w);
+    }
+    return i;
+}
+
+// 1ピクセル/反復
+static inline void resolveRowSSE2(uint8_t* out, const float* row, size_t pixels) {
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 maxV = _mm_set1_ps(255.0f);
+    const __m128 c255 = _mm_set1_ps(255.0f);
+    const __m128 alphaMask = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+    for (size_t x = 0; x < pixels; ++x, out += 4) {
+        const __m128 p = _mm_loadu_ps(row + x * 4);
+        const __m128 a = _mm_shuffle_ps(p, p, _MM_SHUFFLE(3, 3, 3, 3));
+        if (_mm_cvtss_f32(a) < 0.5f) {
+            out[0] = out[1] = out[2] = out[3] = 0;
+            continue;
+        }
+        // RGB = p × (255 / a)、A = a
+        const __m128 rgb = _mm_mul_ps(p, _mm_div_ps(c255, a));
+        const __m128 v = _mm_or_ps(_mm_andnot_ps(alphaMask, rgb), _mm_and_ps(alphaMask, p));
+        const __m128i q = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_add_ps(v, half), _mm_setzero_ps()), maxV));
+        const __m128i q16 = _mm_packs_epi32(q, q);
+        const int packed = _mm_cvtsi128_si32(_mm_packus_epi16(q16, q16));
+        std::memcpy(out, &packed, 4);
+    }
+}
+#endif // FLEXIMG_HAS_SSE2
+
+static inline void filterLine(float* line, int_fast32_t begin, int_fast32_t end, const Coefficients& c) {
+    if (end <= begin) return;
+#if defined(FLEXIMG_HAS_SSE2)
+    filterLineSSE2(line, begin, end, c);
+#else
+    filterLineScalar(line, begin, end, c);
+#endif
+}
+
+static inline void forwardRow(const float* x, const float* s1, const float* s2, float* s3,
+                              uint16_t* out, size_t count, const Coefficients& c) {
+#if defined(FLEXIMG_HAS_SSE2)
+    const size_t done = forwardRowSSE2(x, s1, s2, s3, out, count, c);
+#else
+    const size_t done = 0;
+#endif
+    forwardRowScalar(x, s1, s2, s3, out, done, count, c);
+}
+
+static inline void backwardRow(const uint16_t* f, const float* b1, const float* b2, float* b3,
+                               size_t count, const Coefficients& c) {
+#if defined(FLEXIMG_HAS_SSE2)
+    const size_t done = backwardRowSSE2(f, b1, b2, b3, count, c);
+#else
+    const size_t done = 0;
+#endif
+    backwardRowScalar(f, b1, b2, b3, done, count, c);
+}
+
+static inline void resolveRow(uint8_t* out, const float* row, size_t pixels) {
+#if defined(FLEXIMG_HAS_SSE2)
+    resolveRowSSE2(out, row, pixels);
+#else
+    for (size_t x = 0; x < pixels; ++x) {
+        resolvePixelScalar(out + x * 4, row + x * 4);
+    }
+#endif
+}
+
+} // namespace gaussian_blur_detail
+
+// ============================================================================
+// GaussianBlurNode - フィルタ処理
+// ============================================================================
+
+bool GaussianBlurNode::fetchFilteredRow(Node* upstream, int_fast32_t y) {
+    std::fill(line_.begin(), line_.end(), 0.0f);
+    if (y < srcTop_ || y >= srcBottom_) return false;
+
+    RenderRequest rowRequest;
+    rowRequest.width = cacheWidth_;
+    rowRequest.height = 1;
+    rowRequest.origin = {cacheOriginX_, to_fixed(static_cast<int>(y))};
+    if (!upstream->getDataRange(rowRequest).hasData()) return false;
+
+    RenderResponse& resp = upstream->pullProcess(rowRequest);
+    int_fast32_t start = 0, end = 0;
+    if (resp.isValid()) {
+        consolidateIfNeeded(resp);
+        const ViewPort src = resp.view();
+        const int_fast32_t offset = from_fixed(resp.origin.x - cacheOriginX_);
+        start = std::max<int_fast32_t>(0, offset);
+        end = std::min<int_fast32_t>(cacheWidth_, offset + src.width);
+        if (start < end && src.height > 0) {
+            FLEXIMG_METRICS_SCOPE(NodeType::GaussianBlur);
+            // プリマルチプライドの float へ（値域 0..255）
+            const auto* s = static_cast<const uint8_t*>(src.pixelAt(static_cast<int>(start - offset), 0));
+            float* d = &line_[static_cast<size_t>(start) * 4];
+            constexpr float inv255 = 1.0f / 255.0f;
+            for (int_fast32_t x = start; x < end; ++x, s += 4, d += 4) {
+                const float a = s[3];
+                const float k = a * inv255;
+                d[0] = s[0] * k;
+                d[1] = s[1] * k;
+                d[2] = s[2] * k;
+                d[3] = a;
+            }
+        }
+    }
+    if (context_) {
+        context_->releaseResponse(resp);
+    }
+    if (start >= end) return false;
+
+    FLEXIMG_METRICS_SCOPE(NodeType::GaussianBlur);
+    // データ範囲 ± lookahead の外は寄与が打ち切り誤差以下なので0のまま
+    gaussian_blur_detail::filterLine(line_.data(), std::max<int_fast32_t>(0, start - lookahead_),
+                                     std::min<int_fast32_t>(cacheWidth_, end + lookahead_), coeffs_);
+    return true;
+}
+
+void GaussianBlurNode::advanceForward(Node* upstream, bool replicateInit) {
+    const int_fast32_t y = fwdY_++;
+    const bool hasData = fetchFilteredRow(upstream, y);
+
+    FLEXIMG_METRICS_SCOPE(NodeType::GaussianBlur);
+    const size_t count = rowFloats();
+    float* state = fwdState_.data();
+    float* s1 = state + static_cast<size_t>(fwdHead_) * count;
+    float* s2 = state + static_cast<size_t>((fwdHead_ + 2) % 3) * count;
+    float* s3 = state + static_cast<size_t>((fwdHead_ + 1) % 3) * count;
+    if (replicateInit) {
+        // 途中の行から開始: 最初の行が上方へ続いていたとみなす（定常値）
+        std::memcpy(s1, line_.data(), count * sizeof(float));
+        std::memcpy(s2, line_.data(), count * sizeof(float));
+        std::memcpy(s3, line_.data(), count * sizeof(float));
+    }
+    // 入力0の行は状態の減衰のみ
+    gaussian_blur_detail::forwardRow(hasData ? line_.data() : nullptr, s1, s2, s3, ringRow(y), count, coeffs_);
+    fwdHead_ = (fwdHead_ + 1) % 3;  // s3 が最新行になる
+}
+
+void GaussianBlurNode::computeBlock(Node* upstream, int_fast32_t y) {
+    const bool sequential = (blockEnd_ > blockY_) && (y == blockEnd_);
+    const int_fast32_t y0 = y;
+    const int_fast32_t outEnd = std::min<int_fast32_t>(y0 + blockRows_, bottom_);
+    const int_fast32_t lookEnd = std::min<int_fast32_t>(y0 + blockRows_ + lookahead_, bottom_);
+
+    if (!sequential) {
+        // 前進を lookahead 行手前からやり直す（top_ からなら状態0で厳密）
+        const int_fast32_t start = std::max<int_fast32_t>(top_, y0 - lookahead_);
+        std::fill(fwdState_.begin(), fwdState_.end(), 0.0f);
+        fwdHead_ = 0;
+        fwdY_ = start;
+        if (start > top_) {
+            advanceForward(upstream, true);
+        }
+    }
+    while (fwdY_ < lookEnd) {
+        advanceForward(upstream, false);
+    }
+
+    FLEXIMG_METRICS_SCOPE(NodeType::GaussianBlur);
+
+    // 後退: lookEnd で打ち切り、その位置の前進値で状態を初期化
+    const size_t count = rowFloats();
+    const size_t pixels = static_cast<size_t>(cacheWidth_);
+    float* b1 = bwdState_.data();
+    float* b2 = b1 + count;
+    float* b3 = b2 + count;
+    constexpr float inv256 = 1.0f / 256.0f;
+    {
+        const uint16_t* f = ringRow(lookEnd - 1);
+        for (size_t i = 0; i < count; ++i) {
+            b1[i] = b2[i] = b3[i] = f[i] * inv256;
+        }
+    }
+    for (int_fast32_t n = lookEnd - 1; n >= y0; --n) {
+        gaussian_blur_detail::backwardRow(ringRow(n), b1, b2, b3, count, coeffs_);
+        // 状態行を回転（b3 が最新）
+        float* newest = b3;
+        b3 = b2;
+        b2 = b1;
+        b1 = newest;
+        if (n >= outEnd) continue;
+
+        // プリマルチプライド → RGBA8_Straight
+        gaussian_blur_detail::resolveRow(&block_[static_cast<size_t>(n - y0) * pixels * 4], b1, pixels);
+    }
+
+    blockY_ = y0;
+    blockEnd_ = outEnd;
+}
+
+// ============================================================================
+// GaussianBlurNode - データ範囲
+// ============================================================================
+
+DataRange GaussianBlurNode::getDataRange(const RenderRequest& request) const {
+    if (passThrough_) {
+        Node* upstream = upstreamNode(0);
+        return upstream ? upstream->getDataRange(request) : DataRange{0, 0};
+    }
+    const int_fast32_t y = from_fixed(request.origin.y);
+    if (y < top_ || y >= bottom_) return DataRange{0, 0};
+
+    const int_fixed rel = cacheOriginX_ - request.origin.x;
+    const auto start = std::max<int_fast32_t>(0, from_fixed_floor(rel));
+    const auto end = std::min<int_fast32_t>(request.width, from_fixed_ceil(rel + to_fixed(cacheWidth_)));
+    return (start < end) ? DataRange{static_cast<int16_t>(start), static_cast<int16_t>(end)}
+                         : DataRange{0, 0};
+}
+
+// ============================================================================
+// GaussianBlurNode - Template Method フック実装
+// ============================================================================
+
+PrepareResponse GaussianBlurNode::onPullPrepare(const PrepareRequest& request) {
+    Node* upstream = upstreamNode(0);
+    if (!upstream) {
+        passThrough_ = true;
+        PrepareResponse result;
+        result.status = PrepareStatus::Prepared;
+        return result;
+    }
+
+    PrepareResponse result = upstream->pullPrepare(request);
+    if (!result.ok()) {
+        return result;
+    }
+
+    passThrough_ = sigma_ < kMinSigma;
+    if (passThrough_ || result.width <= 0 || result.height <= 0) {
+        return result;
+    }
+
+    coeffs_ = gaussian_blur_detail::computeCoefficients(sigma_);
+    lookahead_ = lookahead();
+    blockRows_ = std::max<int_fast16_t>(lookahead_, 16);
+
+    cacheOriginX_ = result.origin.x - to_fixed(static_cast<int>(lookahead_));
+    cacheWidth_ = static_cast<int16_t>(std::min<int_fast32_t>(INT16_MAX, result.width + lookahead_ * 2));
+    srcTop_ = from_fixed_floor(result.origin.y);
+    srcBottom_ = from_fixed_ceil(result.origin.y + to_fixed(result.height));
+    top_ = srcTop_ - lookahead_;
+    bottom_ = srcBottom_ + lookahead_;
+
+    const size_t count = rowFloats();
+    line_.assign(count, 0.0f);
+    fwdState_.assign(count * 3, 0.0f);
+    bwdState_.assign(count * 3, 0.0f);
+    ring_.assign(count * static_cast<size_t>(ringRows()), 0);
+    block_.assign(static_cast<size_t>(cacheWidth_) * 4 * static_cast<size_t>(blockRows_), 0);
+    fwdY_ = top_;
+    blockY_ = blockEnd_ = top_;
+
+#ifdef FLEXIMG_DEBUG_PERF_METRICS
+    PerfMetrics::instance().nodes[NodeType::GaussianBlur].recordAlloc(
+        (line_.size() + fwdState_.size() + bwdState_.size()) * sizeof(float)
+            + ring_.size() * sizeof(uint16_t) + block_.size(),
+        cacheWidth_, static_cast<int>(ringRows()));
+#endif
+
+    // AABB を上下左右に lookahead ずつ拡張
+    result.origin = {cacheOriginX_, to_fixed(static_cast<int>(top_))};
+    result.width = cacheWidth_;
+    result.height = static_cast<int16_t>(std::min<int_fast32_t>(INT16_MAX, bottom_ - top_));
+    result.preferredFormat = PixelFormatIDs::RGBA8_Straight;
+    return result;
+}
+
+void GaussianBlurNode::onPullFinalize() {
+    line_ = std::vector<float>();
+    fwdState_ = std::vector<float>();
+    bwdState_ = std::vector<float>();
+    ring_ = std::vector<uint16_t>();
+    block_ = std::vector<uint8_t>();
+    cacheWidth_ = 0;
+    blockY_ = blockEnd_ = 0;
+    finalize();
+    Node* upstream = upstreamNode(0);
+    if (upstream) {
+        upstream->pullFinalize();
+    }
+}
+
+RenderResponse& GaussianBlurNode::onPullProcess(const RenderRequest& request) {
+    Node* upstream = upstreamNode(0);
+    if (!upstream) return makeEmptyResponse(request.origin);
+    if (passThrough_) {
+        return upstream->pullProcess(request);
+    }
+
+    const DataRange range = getDataRange(request);
+    if (!range.hasData()) {
+        return makeEmptyResponse(request.origin);
+    }
+
+    // y を含むブロックが未確定なら計算（上流のプルを含む）
+    const int_fast32_t y = from_fixed(request.origin.y);
+    if (y < blockY_ || y >= blockEnd_) {
+        computeBlock(upstream, y);
+    }
+
+    FLEXIMG_METRICS_SCOPE(NodeType::GaussianBlur);
+
+    // 作業行とリクエストの交差（VerticalBlurNode と同じ丸め方式）
+    const int_fixed reqLeft = request.origin.x;
+    const int_fixed interLeft = std::max(cacheOriginX_, reqLeft);
+    const int_fixed interRight = std::min(cacheOriginX_ + to_fixed(cacheWidth_),
+                                          reqLeft + to_fixed(request.width));
+    const auto srcStartX = static_cast<int_fast16_t>(from_fixed_floor(interLeft - cacheOriginX_));
+    const auto srcEndX = static_cast<int_fast16_t>(from_fixed_ceil(interRight - cacheOriginX_));
+    const auto outputWidth = static_cast<int_fast16_t>(srcEndX - srcStartX);
+
+#ifdef FLEXIMG_DEBUG_PERF_METRICS
+    auto& metrics = PerfMetrics::instance().nodes[NodeType::GaussianBlur];
+    metrics.requestedPixels += static_cast<uint64_t>(request.width);
+    metrics.usedPixels += static_cast<uint64_t>(outputWidth);
+#endif
+
+    ImageBuffer output(outputWidth, 1, PixelFormatIDs::RGBA8_Straight, InitPolicy::Uninitialized);
+    const size_t rowOffset = static_cast<size_t>(y - blockY_) * static_cast<size_t>(cacheWidth_) * 4;
+    std::memcpy(output.view().data, &block_[rowOffset + static_cast<size_t>(srcStartX) * 4],
+                static_cast<size_t>(outputWidth) * 4);
+
+    return makeResponse(std::move(output), Point{interLeft, request.origin.y});
+}
+
+} // namespace FLEXIMG_NAMESPACE
+
+#endif // FLEXIMG_IMPLEMENTATION
+
+#endif // FLEXIMG_GAUSSIAN_BLUR_NODE_H
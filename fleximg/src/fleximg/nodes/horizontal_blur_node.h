@@ -27,6 +27,11 @@ namespace FLEXIMG_NAMESPACE {
 // - 水平ブラーはスキャンライン処理のため、メモリ消費は少ない
 // - 1行分のバッファ: width * 4 bytes 程度
 //
+// 単一チャンネルパス（pull型）:
+// - 上流の preferredFormat が Alpha8 / Grayscale8 の場合、値をそのまま
+//   ボックス平均する1チャンネルカーネルを使用し、同じフォーマットで出力する
+//   （範囲外は0として扱う。RGBA8 へ変換せず、バッファと合計は1/4）
+//
 // 使用例:
 //   HorizontalBlurNode hblur;
 //   hblur.setRadius(6);
@@ -53,10 +58,12 @@ public:
 
     void setRadius(int_fast16_t radius) {
         radius_ = static_cast<int16_t>((radius < 0) ? 0 : (radius > kMaxRadius) ? kMaxRadius : radius);
+        markModified();
     }
 
     void setPasses(int_fast16_t passes) {
         passes_ = static_cast<int16_t>((passes < 1) ? 1 : (passes > kMaxPasses) ? kMaxPasses : passes);
+        markModified();
     }
 
     int16_t radius() const { return radius_; }
@@ -137,9 +144,15 @@ private:
     int16_t radius_ = 5;
     int16_t passes_ = 1;  // 1-3の範囲、デフォルト1
 
+    // 単一チャンネルパスのフォーマット（nullptr = RGBA8パス、pullPrepareで決定）
+    PixelFormatID channelFormat_ = nullptr;
+
     // 水平方向ブラー処理（共通）
     void applyHorizontalBlur(const ViewPort& srcView, int_fast16_t inputOffset, ImageBuffer& output);
 
+    // 水平方向ブラー処理（1チャンネル: Alpha8 / Grayscale8）
+    void applyHorizontalBlur1ch(const ViewPort& srcView, int_fast16_t inputOffset, ImageBuffer& output);
+
     // ブラー済みピクセルを書き込み
     void writeBlurredPixel(uint8_t* row, int_fast16_t x, uint32_t sumR, uint32_t sumG,
                            uint32_t sumB, uint32_t sumA) {
@@ -189,6 +202,10 @@ PrepareResponse HorizontalBlurNode::onPullPrepare(const PrepareRequest& request)
         return upstreamResult;
     }
 
+    // 1バイト1チャンネルの上流は単一チャンネルパスで処理（出力も同じフォーマット）
+    channelFormat_ = isSingleChannel8(upstreamResult.preferredFormat)
+                   ? upstreamResult.preferredFormat : nullptr;
+
     // 水平ぼかしはX方向に radius * passes 分拡張する
     // AABBの幅を拡張し、originのXをシフト（左方向に拡大）
     auto expansion = static_cast<int_fast16_t>(radius_ * passes_);
@@ -224,8 +241,12 @@ RenderResponse& HorizontalBlurNode::onPullProcess(const RenderRequest& request)
     RenderResponse& input = upstream->pullProcess(inputReq);
     if (!input.isValid()) return makeEmptyResponse(request.origin);
 
+    // 作業フォーマット（単一チャンネルパスでは上流と同じ1バイトフォーマット）
+    const PixelFormatID workFormat = channelFormat_ ? channelFormat_ : PixelFormatIDs::RGBA8_Straight;
+    const size_t bpp = channelFormat_ ? 1 : 4;
+
     // バッファ準備
-    consolidateIfNeeded(input);
+    consolidateIfNeeded(input, workFormat);
 
     FLEXIMG_METRICS_SCOPE(NodeType::HorizontalBlur);
 
@@ -235,9 +256,8 @@ RenderResponse& HorizontalBlurNode::onPullProcess(const RenderRequest& request)
     metrics.usedPixels += static_cast<uint64_t>(inputReq.width) * 1;
 #endif
 
-    // RGBA8_Straightに変換
-    ImageBuffer buffer = convertFormat(ImageBuffer(input.buffer()),
-                                       PixelFormatIDs::RGBA8_Straight);
+    // 作業フォーマットに変換
+    ImageBuffer buffer = convertFormat(ImageBuffer(input.buffer()), workFormat);
 
     // 上流から返されたoriginを保存
     Point currentOrigin = input.origin;
@@ -250,17 +270,20 @@ RenderResponse& HorizontalBlurNode::onPullProcess(const RenderRequest& request)
 
 #ifdef FLEXIMG_DEBUG_PERF_METRICS
         if (pass == 0) {
-            metrics.recordAlloc(static_cast<size_t>(outputWidth) * 4, outputWidth, 1);
+            metrics.recordAlloc(static_cast<size_t>(outputWidth) * bpp, outputWidth, 1);
         }
 #endif
 
         // 出力バッファを確保
-        ImageBuffer output(outputWidth, 1, PixelFormatIDs::RGBA8_Straight,
-                          InitPolicy::Uninitialized);
+        ImageBuffer output(outputWidth, 1, workFormat, InitPolicy::Uninitialized);
 
         // 水平方向スライディングウィンドウでブラー処理
         // inputOffset = -radius (出力を左に拡張)
-        applyHorizontalBlur(srcView, -radius_, output);
+        if (channelFormat_) {
+            applyHorizontalBlur1ch(srcView, -radius_, output);
+        } else {
+            applyHorizontalBlur(srcView, -radius_, output);
+        }
 
         // origin.xを左に拡張した分だけ減らす（ワールド座標で左に移動）
         currentOrigin.x = currentOrigin.x - to_fixed(radius_);
@@ -291,8 +314,7 @@ RenderResponse& HorizontalBlurNode::onPullProcess(const RenderRequest& request)
     // 出力バッファを確保（必要幅のみ、ゼロ初期化）
     // 出力バッファ左端のワールド座標 = リクエスト左端 + blurredStartX
     int_fixed outputOriginX = request.origin.x + to_fixed(blurredStartX);
-    ImageBuffer output(outputWidth, 1, PixelFormatIDs::RGBA8_Straight,
-                      InitPolicy::Zero);
+    ImageBuffer output(outputWidth, 1, workFormat, InitPolicy::Zero);
     const uint8_t* srcRow = static_cast<const uint8_t*>(buffer.view().data);
     uint8_t* dstRow = static_cast<uint8_t*>(output.view().data);
 
@@ -307,9 +329,9 @@ RenderResponse& HorizontalBlurNode::onPullProcess(const RenderRequest& request)
 
     // 有効な範囲をコピー（範囲外は既にゼロ初期化済み）
     if (copyWidth > 0) {
-        std::memcpy(dstRow + dstStartX * 4,
-                   srcRow + srcStartX * 4,
-                   static_cast<size_t>(copyWidth) * 4);
+        std::memcpy(dstRow + static_cast<size_t>(dstStartX) * bpp,
+                   srcRow + static_cast<size_t>(srcStartX) * bpp,
+                   static_cast<size_t>(copyWidth) * bpp);
     }
 
     return makeResponse(std::move(output), Point{outputOriginX, request.origin.y});
@@ -429,6 +451,39 @@ void HorizontalBlurNode::applyHorizontalBlur(const ViewPort& srcView, int_fast16
     }
 }
 
+// 水平方向ブラー処理（1チャンネル）
+// 範囲外は0として合計し、カーネルサイズで割る（RGBA8パスのアルファと同じ計算）
+void HorizontalBlurNode::applyHorizontalBlur1ch(const ViewPort& srcView, int_fast16_t inputOffset, ImageBuffer& output) {
+    const uint8_t* srcRow = static_cast<const uint8_t*>(srcView.data);
+    uint8_t* dstRow = static_cast<uint8_t*>(output.view().data);
+    auto inputWidth = static_cast<int_fast16_t>(srcView.width);
+    auto outputWidth = static_cast<int_fast16_t>(output.width());
+    const auto ks = static_cast<uint32_t>(kernelSize());
+
+    // 初期ウィンドウの合計（出力x=0に対応）
+    uint32_t sum = 0;
+    for (auto kx = static_cast<int_fast16_t>(-radius_); kx <= radius_; kx++) {
+        auto srcX = static_cast<int_fast16_t>(inputOffset + kx);
+        if (srcX >= 0 && srcX < inputWidth) {
+            sum += srcRow[srcX];
+        }
+    }
+    dstRow[0] = static_cast<uint8_t>(sum / ks);
+
+    // スライディング: x = 1 to outputWidth-1
+    for (int_fast16_t x = 1; x < outputWidth; x++) {
+        auto oldSrcX = static_cast<int_fast16_t>(inputOffset + x - 1 - radius_);
+        if (oldSrcX >= 0 && oldSrcX < inputWidth) {
+            sum -= srcRow[oldSrcX];
+        }
+        auto newSrcX = static_cast<int_fast16_t>(inputOffset + x + radius_);
+        if (newSrcX >= 0 && newSrcX < inputWidth) {
+            sum += srcRow[newSrcX];
+        }
+        dstRow[x] = static_cast<uint8_t>(sum / ks);
+    }
+}
+
 } // namespace FLEXIMG_NAMESPACE
 
 #endif // FLEXIMG_IMPLEMENTATION
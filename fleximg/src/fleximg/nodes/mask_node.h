@@ -0,0 +1,486 @@
+#ifndef FLEXIMG_MASK_NODE_H
+#define FLEXIMG_MASK_NODE_H
+
+#include "../core/node.h"
+#include "../core/perf_metrics.h"
+#include "../image/image_buffer.h"
+#include "../image/pixel_format.h"
+
+namespace FLEXIMG_NAMESPACE {
+
+// ========================================================================
+// MaskNode - マスク適用ノード
+// ========================================================================
+//
+// 入力画像1枚にマスクを適用し、アルファを変調します。
+// - 入力ポート0: 画像
+// - 入力ポート1: マスク
+// - 出力: 1ポート（RGBA8_Straight）
+//
+// 計算式:
+//   Output.rgb = Input.rgb
+//   Output.a   = Input.a × Mask
+//   （Mask=0 のピクセルは透明の黒 (0,0,0,0)）
+//
+// マスク値の取り出し（MaskMode）:
+// - 1チャンネル形式（Alpha8 / Grayscale8 / Grayscale1,2,4）: モードによらず画素値そのもの
+// - Alpha:     多チャンネル形式はアルファチャンネル
+// - Luminance: 多チャンネル形式は BT.601 輝度 × アルファ
+// - setInverted(true) で 255 - Mask を使用（マスク範囲外は Mask=0 → 反転で全面表示）
+//
+// MatteNode との違い:
+// - 入力は画像1枚 + マスク（背景なし）
+// - bit-packed Grayscale マスクを unpackIndexBits で直接係数列に展開し、
+//   RGBA8 への変換パスを経由しない（Alpha8/Grayscale8 もバイト値を直接使用）
+//
+// 最適化:
+// - 処理順序: マスク → 入力（マスクの左右0領域を除外して入力要求を縮小）
+// - 係数0の区間は入力の変換・書き込みを行わない（出力はゼロ初期化済み）
+// - 係数255の区間はアルファ変調をスキップ
+//
+// 使用例:
+//   MaskNode mask;
+//   image >> mask;                 // ポート0（画像）
+//   maskSrc.connectTo(mask, 1);    // ポート1（マスク）
+//   mask >> renderer >> sink;
+//
+
+class MaskNode : public Node {
+public:
+    enum class MaskMode : uint8_t {
+        Alpha,      // アルファチャンネルをマスクに使用
+        Luminance,  // 輝度 × アルファをマスクに使用
+    };
+
+    MaskNode() {
+        initPorts(2, 1);  // 入力2（画像/マスク）、出力1
+    }
+
+    // ========================================
+    // パラメータ設定
+    // ========================================
+
+    void setMode(MaskMode mode) { mode_ = mode; markModified(); }
+    MaskMode mode() const { return mode_; }
+
+    void setInverted(bool inverted) { inverted_ = inverted; markModified(); }
+    bool inverted() const { return inverted_; }
+
+    // ========================================
+    // Node インターフェース
+    // ========================================
+
+    const char* name() const override { return "MaskNode"; }
+
+    // getDataRange: 入力範囲（非反転時はマスク範囲との交差）
+    DataRange getDataRange(const RenderRequest& request) const override;
+
+protected:
+    // ========================================
+    // Template Method フック
+    // ========================================
+
+    PrepareResponse onPullPrepare(const PrepareRequest& request) override;
+    void onPullFinalize() override;
+    RenderResponse& onPullProcess(const RenderRequest& request) override;
+
+    int nodeTypeForMetrics() const override { return NodeType::Mask; }
+
+private:
+    MaskMode mode_ = MaskMode::Alpha;
+    bool inverted_ = false;
+
+    // マスク1行を係数（0-255、反転適用済み）に展開
+    void readMaskRow(uint8_t* dst, const ViewPort& maskView, const PixelAuxInfo* aux,
+                     int_fast16_t srcX, int_fast16_t srcY, int_fast16_t count) const;
+};
+
+} // namespace FLEXIMG_NAMESPACE
+
+// =============================================================================
+// 実装部
+// =============================================================================
+#ifdef FLEXIMG_IMPLEMENTATION
+
+#include <cstring>
+
+namespace FLEXIMG_NAMESPACE {
+
+// ============================================================================
+// MaskNode - 内部ヘルパー
+// ============================================================================
+
+namespace mask_detail {
+
+// bit-packed Grayscale → 係数（0-MaxVal を 0-255 にスケールし、反転をXORで適用）
+template<int BitsPerPixel, BitOrder Order>
+static void unpackGrayMask(uint8_t* dst, const uint8_t* row, int_fast32_t srcX,
+                           int_fast16_t count, uint8_t invXor) {
+    const int_fast32_t bitPos = srcX * BitsPerPixel;
+    bit_packed_detail::unpackIndexBits<BitsPerPixel, Order>(
+        dst, row + (bitPos >> 3), static_cast<size_t>(count),
+        static_cast<uint8_t>((bitPos & 7) / BitsPerPixel));
+    constexpr int Scale = 255 / ((1 << BitsPerPixel) - 1);
+    for (int_fast16_t i = 0; i < count; ++i) {
+        dst[i] = static_cast<uint8_t>((dst[i] * Scale) ^ invXor);
+    }
+}
+
+// 係数列の非0区間を探す（4px単位で0をスキップ）
+// 戻り値: 非0区間の開始位置（なければ count）、outEnd に終了位置
+static int_fast16_t findNonZeroRun(const uint8_t* coef, int_fast16_t x, int_fast16_t count,
+                                   int_fast16_t& outEnd) {
+    while (x + 4 <= count) {
+        uint32_t c4;
+        std::memcpy(&c4, coef + x, 4);
+        if (c4 != 0) break;
+        x += 4;
+    }
+    while (x < count && coef[x] == 0) ++x;
+    int_fast16_t end = x;
+    while (end < count && coef[end] != 0) ++end;
+    outEnd = end;
+    return x;
+}
+
+// RGBA8_Straight 行のアルファを係数で変調（255区間は4px単位でスキップ）
+static void applyMaskCoef(uint8_t* d, const uint8_t* coef, int_fast16_t count) {
+    int_fast16_t i = 0;
+    while (i < count) {
+        if (i + 4 <= count) {
+            uint32_t c4;
+            std::memcpy(&c4, coef + i, 4);
+            if (c4 == 0xFFFFFFFFu) {
+                i += 4;
+                continue;
+            }
+        }
+        const uint_fast16_t c = coef[i];
+        if (c != 255) {
+            // 256スケール正規化: c_256 = c + (c >> 7)
+            uint8_t* p = d + i * 4 + 3;
+            *p = static_cast<uint8_t>((*p * (c + (c >> 7))) >> 8);
+        }
+        ++i;
+    }
+}
+
+} // namespace mask_detail
+
+// ============================================================================
+// MaskNode - Template Method フック実装
+// ============================================================================
+
+PrepareResponse MaskNode::onPullPrepare(const PrepareRequest& request) {
+    PrepareResponse merged;
+    merged.status = PrepareStatus::Prepared;
+
+    // 両上流へ伝播（出力のAABBは入力画像のもの）
+    for (int i = 0; i < 2; ++i) {
+        Node* upstream = upstreamNode(i);
+        if (!upstream) continue;
+        PrepareResponse result = upstream->pullPrepare(request);
+        if (!result.ok()) {
+            return result;  // エラーを伝播
+        }
+        if (i == 0) {
+            merged = result;
+        }
+    }
+    merged.preferredFormat = PixelFormatIDs::RGBA8_Straight;
+
+    // 準備処理
+    RenderRequest screenInfo;
+    screenInfo.width = request.width;
+    screenInfo.height = request.height;
+    screenInfo.origin = request.origin;
+    prepare(screenInfo);
+
+    return merged;
+}
+
+void MaskNode::onPullFinalize() {
+    finalize();
+    for (int i = 0; i < 2; ++i) {
+        Node* upstream = upstreamNode(i);
+        if (upstream) {
+            upstream->pullFinalize();
+        }
+    }
+}
+
+// ============================================================================
+// MaskNode - getDataRange実装
+// ============================================================================
+
+DataRange MaskNode::getDataRange(const RenderRequest& request) const {
+    Node* inputNode = upstreamNode(0);
+    Node* maskNode = upstreamNode(1);
+    if (!inputNode) return DataRange{};
+
+    DataRange range = inputNode->getDataRange(request);
+    if (inverted_ || !range.hasData()) return range;
+
+    // 非反転: マスク範囲外は係数0
+    DataRange maskRange = maskNode ? maskNode->getDataRange(request) : DataRange{};
+    auto startX = std::max(range.startX, maskRange.startX);
+    auto endX = std::min(range.endX, maskRange.endX);
+    return (maskRange.hasData() && startX < endX) ? DataRange{startX, endX} : DataRange{};
+}
+
+// ============================================================================
+// MaskNode - マスク読み出し
+// ============================================================================
+
+void MaskNode::readMaskRow(uint8_t* dst, const ViewPort& maskView, const PixelAuxInfo* aux,
+                           int_fast16_t srcX, int_fast16_t srcY, int_fast16_t count) const {
+    const PixelFormatID fmt = maskView.formatID;
+    const uint8_t invXor = inverted_ ? 0xFF : 0x00;
+    const uint8_t* row = static_cast<const uint8_t*>(maskView.data)
+                       + (maskView.y + srcY) * maskView.stride;
+    const int_fast32_t x = maskView.x + srcX;
+
+    // bit-packed Grayscale: 係数列へ直接展開
+    if (fmt == PixelFormatIDs::Grayscale1_MSB) {
+        mask_detail::unpackGrayMask<1, BitOrder::MSBFirst>(dst, row, x, count, invXor);
+        return;
+    }
+    if (fmt == PixelFormatIDs::Grayscale1_LSB) {
+        mask_detail::unpackGrayMask<1, BitOrder::LSBFirst>(dst, row, x, count, invXor);
+        return;
+    }
+    if (fmt == PixelFormatIDs::Grayscale2_MSB) {
+        mask_detail::unpackGrayMask<2, BitOrder::MSBFirst>(dst, row, x, count, invXor);
+        return;
+    }
+    if (fmt == PixelFormatIDs::Grayscale2_LSB) {
+        mask_detail::unpackGrayMask<2, BitOrder::LSBFirst>(dst, row, x, count, invXor);
+        return;
+    }
+    if (fmt == PixelFormatIDs::Grayscale4_MSB) {
+        mask_detail::unpackGrayMask<4, BitOrder::MSBFirst>(dst, row, x, count, invXor);
+        return;
+    }
+    if (fmt == PixelFormatIDs::Grayscale4_LSB) {
+        mask_detail::unpackGrayMask<4, BitOrder::LSBFirst>(dst, row, x, count, invXor);
+        return;
+    }
+
+    // 1バイト1チャンネル（Alpha8 / Grayscale8）: バイト値をそのまま使用
+    if (fmt == PixelFormatIDs::Alpha8 || fmt == PixelFormatIDs::Grayscale8) {
+        const uint8_t* src = row + x;
+        if (invXor) {
+            for (int_fast16_t i = 0; i < count; ++i) {
+                dst[i] = static_cast<uint8_t>(src[i] ^ invXor);
+            }
+        } else {
+            std::memcpy(dst, src, static_cast<size_t>(count));
+        }
+        return;
+    }
+
+    // その他: チャンク単位でRGBA8_Straightに変換し、アルファまたは輝度×アルファを抽出
+    auto converter = resolveConverter(fmt, PixelFormatIDs::RGBA8_Straight, aux);
+    if (!converter) {
+        std::memset(dst, invXor, static_cast<size_t>(count));
+        return;
+    }
+    const int_fast32_t pixelBits = fmt->bitsPerPixel;
+    constexpr int_fast16_t CHUNK_SIZE = 64;
+    uint8_t tempBuf[CHUNK_SIZE * 4];
+    for (int_fast16_t done = 0; done < count; done += CHUNK_SIZE) {
+        const auto chunk = std::min<int_fast16_t>(CHUNK_SIZE, static_cast<int_fast16_t>(count - done));
+        // bit-packed（Index1/2/4等）はビット単位で位置を求める
+        const int_fast32_t totalBits = (x + done) * pixelBits;
+        converter.ctx.pixelOffsetInByte = static_cast<uint8_t>((totalBits & 7) >> (pixelBits >> 1));
+        converter(tempBuf, row + (totalBits >> 3), static_cast<size_t>(chunk));
+        for (int_fast16_t i = 0; i < chunk; ++i) {
+            const uint8_t* p = tempBuf + i * 4;
+            uint_fast16_t v = p[3];
+            if (mode_ == MaskMode::Luminance) {
+                // BT.601: Y = (77*R + 150*G + 29*B + 128) >> 8
+                uint_fast16_t lum = (77u * p[0] + 150u * p[1] + 29u * p[2] + 128u) >> 8;
+                v = (lum * (v + (v >> 7))) >> 8;
+            }
+            dst[done + i] = static_cast<uint8_t>(v ^ invXor);
+        }
+    }
+}
+
+// ============================================================================
+// MaskNode - onPullProcess実装
+// ============================================================================
+//
+// 処理フロー:
+// 1. 出力X範囲の決定（非反転時は入力 ∩ マスク）
+// 2. マスク取得 → 係数列（Alpha8相当、行ごと）に展開
+// 3. 非反転時: 係数の左右0領域を除外して入力要求を縮小
+// 4. 入力取得 → 係数非0区間のみRGBA8_Straightへ変換し、アルファ変調
+//
+
+RenderResponse& MaskNode::onPullProcess(const RenderRequest& request) {
+    Node* inputNode = upstreamNode(0);
+    Node* maskNode = upstreamNode(1);
+    if (!inputNode) return makeEmptyResponse(request.origin);
+
+    // ========================================================================
+    // Step 1: 出力X範囲
+    // ========================================================================
+
+    DataRange outRange = inputNode->getDataRange(request);
+    DataRange maskRange = maskNode ? maskNode->getDataRange(request) : DataRange{};
+    if (!inverted_) {
+        auto startX = std::max(outRange.startX, maskRange.startX);
+        auto endX = std::min(outRange.endX, maskRange.endX);
+        outRange = (maskRange.hasData() && startX < endX) ? DataRange{startX, endX} : DataRange{};
+    }
+    if (!outRange.hasData()) return makeEmptyResponse(request.origin);
+
+    // ========================================================================
+    // Step 2: マスク取得（出力範囲に絞る）
+    // ========================================================================
+
+    RenderResponse* maskResultPtr = nullptr;
+    if (maskNode && maskRange.hasData()) {
+        RenderRequest maskRequest = request;
+        auto clampStart = std::max(outRange.startX, maskRange.startX);
+        auto clampEnd = std::min(outRange.endX, maskRange.endX);
+        if (clampStart < clampEnd) {
+            maskRequest.origin.x = request.origin.x + to_fixed(clampStart);
+            maskRequest.width = static_cast<int16_t>(clampEnd - clampStart);
+            RenderResponse& maskResult = maskNode->pullProcess(maskRequest);
+            if (maskResult.isValid()) {
+                // セグメント間の隙間をゼロ埋めするのみ（フォーマットは維持）
+                consolidateIfNeeded(maskResult, nullptr);
+                maskResultPtr = &maskResult;
+            }
+        }
+    }
+
+    if (!maskResultPtr) {
+        // マスクなし: 非反転は全面透明、反転は入力をそのまま返す
+        if (!inverted_) return makeEmptyResponse(request.origin);
+        return inputNode->pullProcess(request);
+    }
+
+    FLEXIMG_METRICS_SCOPE(NodeType::Mask);
+
+    // 係数バッファ（出力範囲 × リクエスト行、範囲外は Mask=0 → 反転適用）
+    auto outStart = static_cast<int_fast16_t>(outRange.startX);
+    auto outWidth = static_cast<int_fast16_t>(outRange.endX - outRange.startX);
+    const auto outHeight = static_cast<int_fast16_t>(request.height);
+    ImageBuffer coefBuf(outWidth, outHeight, PixelFormatIDs::Alpha8,
+                        InitPolicy::Uninitialized, allocator());
+    {
+        ViewPort coefView = coefBuf.view();
+        const ViewPort maskView = maskResultPtr->view();
+        const PixelAuxInfo* maskAux = &maskResultPtr->buffer().auxInfo();
+        const int_fixed originX = request.origin.x + to_fixed(static_cast<int>(outStart));
+        const auto maskOffsetX = static_cast<int_fast16_t>(from_fixed(maskResultPtr->origin.x - originX));
+        const auto maskOffsetY = static_cast<int_fast16_t>(from_fixed(maskResultPtr->origin.y - request.origin.y));
+        const auto maskXStart = std::max<int_fast16_t>(0, maskOffsetX);
+        const auto maskXEnd = std::min<int_fast16_t>(outWidth, static_cast<int_fast16_t>(maskOffsetX + maskView.width));
+        const uint8_t fill = inverted_ ? 255 : 0;
+
+        for (int_fast16_t y = 0; y < outHeight; ++y) {
+            auto* coef = static_cast<uint8_t*>(coefView.pixelAt(0, static_cast<int>(y)));
+            const auto srcY = static_cast<int_fast16_t>(y - maskOffsetY);
+            if (maskXStart >= maskXEnd ||
+                static_cast<unsigned>(srcY) >= static_cast<unsigned>(maskView.height)) {
+                std::memset(coef, fill, static_cast<size_t>(outWidth));
+                continue;
+            }
+            if (maskXStart > 0) {
+                std::memset(coef, fill, static_cast<size_t>(maskXStart));
+            }
+            readMaskRow(coef + maskXStart, maskView, maskAux,
+                        static_cast<int_fast16_t>(maskXStart - maskOffsetX), srcY,
+                        static_cast<int_fast16_t>(maskXEnd - maskXStart));
+            if (maskXEnd < outWidth) {
+                std::memset(coef + maskXEnd, fill, static_cast<size_t>(outWidth - maskXEnd));
+            }
+        }
+    }
+
+    // ========================================================================
+    // Step 3: 係数の左右0領域を除外（全行の和集合）
+    // ========================================================================
+
+    int_fast16_t leftSkip = outWidth;
+    int_fast16_t rightEnd = 0;
+    for (int_fast16_t y = 0; y < outHeight; ++y) {
+        const auto* coef = static_cast<const uint8_t*>(coefBuf.view().pixelAt(0, static_cast<int>(y)));
+        int_fast16_t runEnd = 0;
+        auto first = mask_detail::findNonZeroRun(coef, 0, outWidth, runEnd);
+        if (first >= outWidth) continue;
+        if (first < leftSkip) leftSkip = first;
+        auto last = outWidth;
+        while (last > runEnd && coef[last - 1] == 0) --last;
+        if (last > rightEnd) rightEnd = last;
+    }
+    if (leftSkip >= rightEnd) return makeEmptyResponse(request.origin);
+
+    // ========================================================================
+    // Step 4: 入力取得・係数非0区間のみ変換してアルファ変調
+    // ========================================================================
+
+    RenderRequest inputRequest = request;
+    inputRequest.origin.x = request.origin.x + to_fixed(static_cast<int>(outStart + leftSkip));
+    inputRequest.width = static_cast<int16_t>(rightEnd - leftSkip);
+    RenderResponse& inputResult = inputNode->pullProcess(inputRequest);
+    if (!inputResult.isValid()) return makeEmptyResponse(request.origin);
+    consolidateIfNeeded(inputResult, nullptr);
+
+    const auto width = static_cast<int_fast16_t>(rightEnd - leftSkip);
+    ImageBuffer outputBuf(width, outHeight, PixelFormatIDs::RGBA8_Straight,
+                          InitPolicy::Zero, allocator());
+#ifdef FLEXIMG_DEBUG_PERF_METRICS
+    PerfMetrics::instance().nodes[NodeType::Mask].recordAlloc(
+        outputBuf.totalBytes(), outputBuf.width(), outputBuf.height());
+#endif
+
+    auto converter = resolveConverter(inputResult.buffer().formatID(),
+                                      PixelFormatIDs::RGBA8_Straight,
+                                      &inputResult.buffer().auxInfo());
+    if (converter) {
+        const ViewPort inView = inputResult.view();
+        ViewPort outView = outputBuf.view();
+        const int_fast32_t inPixelBits = inView.formatID->bitsPerPixel;
+        const auto inOffsetX = static_cast<int_fast16_t>(
+            from_fixed(inputResult.origin.x - inputRequest.origin.x));
+        const auto inOffsetY = static_cast<int_fast16_t>(
+            from_fixed(inputResult.origin.y - request.origin.y));
+        const auto xStart = std::max<int_fast16_t>(0, inOffsetX);
+        const auto xEnd = std::min<int_fast16_t>(width, static_cast<int_fast16_t>(inOffsetX + inView.width));
+
+        for (int_fast16_t y = 0; y < outHeight; ++y) {
+            const auto srcY = static_cast<int_fast16_t>(y - inOffsetY);
+            if (static_cast<unsigned>(srcY) >= static_cast<unsigned>(inView.height)) continue;
+            const auto* coef = static_cast<const uint8_t*>(coefBuf.view().pixelAt(static_cast<int>(leftSkip), static_cast<int>(y)));
+            const uint8_t* srcRow = static_cast<const uint8_t*>(inView.data)
+                                  + (inView.y + srcY) * inView.stride;
+            auto* dstRow = static_cast<uint8_t*>(outView.pixelAt(0, static_cast<int>(y)));
+
+            int_fast16_t runEnd = 0;
+            for (auto x = mask_detail::findNonZeroRun(coef, xStart, xEnd, runEnd);
+                 x < xEnd;
+                 x = mask_detail::findNonZeroRun(coef, runEnd, xEnd, runEnd)) {
+                const int_fast32_t srcBits = (inView.x + x - inOffsetX) * inPixelBits;
+                converter.ctx.pixelOffsetInByte = static_cast<uint8_t>((srcBits & 7) >> (inPixelBits >> 1));
+                converter(dstRow + x * 4, srcRow + (srcBits >> 3),
+                          static_cast<size_t>(runEnd - x));
+                mask_detail::applyMaskCoef(dstRow + x * 4, coef + x,
+                                           static_cast<int_fast16_t>(runEnd - x));
+            }
+        }
+    }
+
+    return makeResponse(std::move(outputBuf),
+                        Point{inputRequest.origin.x, request.origin.y});
+}
+
+} // namespace FLEXIMG_NAMESPACE
+
+#endif // FLEXIMG_IMPLEMENTATION
+
+#endif // FLEXIMG_MASK_NODE_H
@@ -32,6 +32,8 @@ namespace FLEXIMG_NAMESPACE {
 // - マスクの有効範囲スキャン: 左右の0連続領域を除外し、前景要求範囲を縮小
 // - ランレングス処理: 同一alpha値の連続区間をまとめて処理
 // - alpha=0/255の特殊ケース: memcpy/memsetで高速処理
+// - SIMD（SSE2/AVX2）: 16/32px単位のベクトル比較で0/255ランを判定し、
+//   中間alphaは4/8px単位でlerp（スカラー版とビット一致）
 //
 // 使用例:
 //   MatteNode matte;
@@ -66,6 +68,9 @@ public:
 
     // fgなし領域の行処理（ベンチマーク用ラッパー）
     static void benchProcessRowNoFg(uint8_t* d, const uint8_t* m, int pixelCount);
+
+    // 行処理をスカラー実装に固定（SIMD版との比較用）
+    static void benchSetForceScalar(bool forceScalar);
 #endif
 
 protected:
@@ -163,6 +168,13 @@ private:
 // =============================================================================
 #ifdef FLEXIMG_IMPLEMENTATION
 
+#include <cstring>
+#if defined(FLEXIMG_HAS_AVX2)
+#include <immintrin.h>
+#elif defined(FLEXIMG_HAS_SSE2)
+#include <emmintrin.h>
+#endif
+
 namespace FLEXIMG_NAMESPACE {
 
 // ============================================================================
@@ -621,12 +633,12 @@ scan_right:
 // ============================================================================
 
 // ----------------------------------------------------------------------------
-// processRowNoFg: fgなし領域の行処理
+// processRowNoFgScalar: fgなし領域の行処理（スカラー版）
 // - alpha=0: スキップ（出力には既にbgがある）
 // - alpha=255: 透明(0,0,0,0)に書き込み（fgがないため）
 // - 中間alpha: bgをフェード（out = out * (1-alpha)）
 // ----------------------------------------------------------------------------
-static inline void processRowNoFg(
+static inline void processRowNoFgScalar(
     uint8_t* __restrict__ d,
     const uint8_t* __restrict__ m,
     int_fast16_t pixelCount)
@@ -727,12 +739,12 @@ handle_alpha_0:
 }
 
 // ----------------------------------------------------------------------------
-// processRowWithFg: fg領域の行処理
+// processRowWithFgScalar: fg領域の行処理（スカラー版）
 // - alpha=0: スキップ（出力には既にbgがある）
 // - alpha=255: fgをコピー
 // - 中間alpha: フルブレンド（out = out*(1-alpha) + fg*alpha）
 // ----------------------------------------------------------------------------
-static inline void processRowWithFg(
+static inline void processRowWithFgScalar(
     uint8_t* __restrict__ d,
     const uint8_t* __restrict__ m,
     const uint8_t* __restrict__ s,
@@ -841,6 +853,197 @@ handle_alpha_0:
     goto blend;
 }
 
+// ----------------------------------------------------------------------------
+// SIMD版の行処理
+// ----------------------------------------------------------------------------
+//
+// スカラー版と同じ256スケール演算（alpha_256 = a + (a >> 7)）をチャンネル単位の
+// 16bit乗算で行うため、結果はスカラー版とビット一致する。
+// この式は alpha=0 で out=bg、alpha=255 で out=fg（fgなしは0）となるので、
+// 0/255が混在するブロックも例外処理なしでそのままlerpできる。
+//
+// マスクは16px(SSE2)/32px(AVX2)単位でベクトル比較し、
+// - 全0: スキップ
+// - 全255: fgコピー（fgなしは0書き込み）
+// - それ以外: 4px(SSE2)/8px(AVX2)単位で同様に判定し、混在部分のみlerp
+// 端数はスカラー版で処理する。
+//
+
+#if defined(BENCH_M5STACK) || defined(BENCH_NATIVE)
+static bool s_matteForceScalar = false;
+#endif
+
+#ifdef FLEXIMG_HAS_SSE2
+
+// 4px分のlerp: out = d*(256-a256) + s*a256 >> 8（WithFg=false なら s=0）
+template<bool WithFg>
+static inline __m128i matteLerp4SSE2(__m128i dv, __m128i sv, const uint8_t* m) {
+    const __m128i zero = _mm_setzero_si128();
+    uint32_t m4;
+    std::memcpy(&m4, m, 4);
+    // a0..a3 を16bitに展開し、各ピクセルの4チャンネルへ複製
+    __m128i a = _mm_unpacklo_epi8(_mm_cvtsi32_si128(static_cast<int>(m4)), zero);
+    a = _mm_add_epi16(a, _mm_srli_epi16(a, 7));
+    a = _mm_unpacklo_epi16(a, a);
+    const __m128i aLo = _mm_unpacklo_epi32(a, a);  // px0, px1
+    const __m128i aHi = _mm_unpackhi_epi32(a, a);  // px2, px3
+    const __m128i k256 = _mm_set1_epi16(256);
+    __m128i rLo = _mm_mullo_epi16(_mm_unpacklo_epi8(dv, zero), _mm_sub_epi16(k256, aLo));
+    __m128i rHi = _mm_mullo_epi16(_mm_unpackhi_epi8(dv, zero), _mm_sub_epi16(k256, aHi));
+    if (WithFg) {
+        rLo = _mm_add_epi16(rLo, _mm_mullo_epi16(_mm_unpacklo_epi8(sv, zero), aLo));
+        rHi = _mm_add_epi16(rHi, _mm_mullo_epi16(_mm_unpackhi_epi8(sv, zero), aHi));
+    }
+    return _mm_packus_epi16(_mm_srli_epi16(rLo, 8), _mm_srli_epi16(rHi, 8));
+}
+
+template<bool WithFg>
+static inline void processRowSSE2(
+    uint8_t* __restrict__ d,
+    const uint8_t* __restrict__ m,
+    const uint8_t* __restrict__ s,
+    int_fast16_t pixelCount)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i full = _mm_set1_epi8(-1);
+    while (pixelCount >= 16) {
+        const __m128i mv = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m));
+        const int zeroBits = _mm_movemask_epi8(_mm_cmpeq_epi8(mv, zero));
+        if (zeroBits != 0xFFFF) {
+            const int fullBits = _mm_movemask_epi8(_mm_cmpeq_epi8(mv, full));
+            if (fullBits == 0xFFFF) {
+                if (WithFg) std::memcpy(d, s, 64);
+                else std::memset(d, 0, 64);
+            } else {
+                for (int_fast16_t q = 0; q < 16; q += 4) {
+                    if (((zeroBits >> q) & 0xF) == 0xF) continue;
+                    __m128i* dq = reinterpret_cast<__m128i*>(d + q * 4);
+                    __m128i sv = WithFg
+                        ? _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + q * 4))
+                        : zero;
+                    if (((fullBits >> q) & 0xF) != 0xF) {
+                        sv = matteLerp4SSE2<WithFg>(_mm_loadu_si128(dq), sv, m + q);
+                    }
+                    _mm_storeu_si128(dq, sv);
+                }
+            }
+        }
+        d += 64;
+        m += 16;
+        if (WithFg) s += 64;
+        pixelCount -= 16;
+    }
+    if (WithFg) processRowWithFgScalar(d, m, s, pixelCount);
+    else processRowNoFgScalar(d, m, pixelCount);
+}
+
+#endif // FLEXIMG_HAS_SSE2
+
+#ifdef FLEXIMG_HAS_AVX2
+
+// 8px分のlerp（下位レーン: px0-3、上位レーン: px4-7）
+template<bool WithFg>
+static inline __m256i matteLerp8AVX2(__m256i dv, __m256i sv, const uint8_t* m) {
+    const __m256i zero = _mm256_setzero_si256();
+    uint64_t m8;
+    std::memcpy(&m8, m, 8);
+    // 8バイトのマスクを各レーンへ配置し、各ピクセルの4チャンネルへ複製
+    const __m256i rep = _mm256_setr_epi8(
+        0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3,
+        4, 4, 4, 4, 5, 5, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7);
+    const __m256i a8 = _mm256_shuffle_epi8(_mm256_set1_epi64x(static_cast<long long>(m8)), rep);
+    __m256i aLo = _mm256_unpacklo_epi8(a8, zero);
+    __m256i aHi = _mm256_unpackhi_epi8(a8, zero);
+    aLo = _mm256_add_epi16(aLo, _mm256_srli_epi16(aLo, 7));
+    aHi = _mm256_add_epi16(aHi, _mm256_srli_epi16(aHi, 7));
+    const __m256i k256 = _mm256_set1_epi16(256);
+    __m256i rLo = _mm256_mullo_epi16(_mm256_unpacklo_epi8(dv, zero), _mm256_sub_epi16(k256, aLo));
+    __m256i rHi = _mm256_mullo_epi16(_mm256_unpackhi_epi8(dv, zero), _mm256_sub_epi16(k256, aHi));
+    if (WithFg) {
+        rLo = _mm256_add_epi16(rLo, _mm256_mullo_epi16(_mm256_unpacklo_epi8(sv, zero), aLo));
+        rHi = _mm256_add_epi16(rHi, _mm256_mullo_epi16(_mm256_unpackhi_epi8(sv, zero), aHi));
+    }
+    return _mm256_packus_epi16(_mm256_srli_epi16(rLo, 8), _mm256_srli_epi16(rHi, 8));
+}
+
+template<bool WithFg>
+static inline void processRowAVX2(
+    uint8_t* __restrict__ d,
+    const uint8_t* __restrict__ m,
+    const uint8_t* __restrict__ s,
+    int_fast16_t pixelCount)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i full = _mm256_set1_epi8(-1);
+    while (pixelCount >= 32) {
+        const __m256i mv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(m));
+        const auto zeroBits = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(mv, zero)));
+        if (zeroBits != 0xFFFFFFFFu) {
+            const auto fullBits = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(mv, full)));
+            if (fullBits == 0xFFFFFFFFu) {
+                if (WithFg) std::memcpy(d, s, 128);
+                else std::memset(d, 0, 128);
+            } else {
+                for (int_fast16_t q = 0; q < 32; q += 8) {
+                    if (((zeroBits >> q) & 0xFFu) == 0xFFu) continue;
+                    __m256i* dq = reinterpret_cast<__m256i*>(d + q * 4);
+                    __m256i sv = WithFg
+                        ? _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + q * 4))
+                        : zero;
+                    if (((fullBits >> q) & 0xFFu) != 0xFFu) {
+                        sv = matteLerp8AVX2<WithFg>(_mm256_loadu_si256(dq), sv, m + q);
+                    }
+                    _mm256_storeu_si256(dq, sv);
+                }
+            }
+        }
+        d += 128;
+        m += 32;
+        if (WithFg) s += 128;
+        pixelCount -= 32;
+    }
+    processRowSSE2<WithFg>(d, m, s, pixelCount);
+}
+
+#endif // FLEXIMG_HAS_AVX2
+
+// ----------------------------------------------------------------------------
+// processRowNoFg / processRowWithFg: 利用可能な最速の実装へ振り分け
+// ----------------------------------------------------------------------------
+
+static inline void processRowNoFg(uint8_t* d, const uint8_t* m, int_fast16_t pixelCount) {
+#if defined(BENCH_M5STACK) || defined(BENCH_NATIVE)
+    if (s_matteForceScalar) {
+        processRowNoFgScalar(d, m, pixelCount);
+        return;
+    }
+#endif
+#if defined(FLEXIMG_HAS_AVX2)
+    processRowAVX2<false>(d, m, nullptr, pixelCount);
+#elif defined(FLEXIMG_HAS_SSE2)
+    processRowSSE2<false>(d, m, nullptr, pixelCount);
+#else
+    processRowNoFgScalar(d, m, pixelCount);
+#endif
+}
+
+static inline void processRowWithFg(uint8_t* d, const uint8_t* m, const uint8_t* s,
+                                    int_fast16_t pixelCount) {
+#if defined(BENCH_M5STACK) || defined(BENCH_NATIVE)
+    if (s_matteForceScalar) {
+        processRowWithFgScalar(d, m, s, pixelCount);
+        return;
+    }
+#endif
+#if defined(FLEXIMG_HAS_AVX2)
+    processRowAVX2<true>(d, m, s, pixelCount);
+#elif defined(FLEXIMG_HAS_SSE2)
+    processRowSSE2<true>(d, m, s, pixelCount);
+#else
+    processRowWithFgScalar(d, m, s, pixelCount);
+#endif
+}
+
 // ----------------------------------------------------------------------------
 
 void MatteNode::applyMatteOverlay(ImageBuffer& output, int_fast16_t outWidth,
@@ -916,6 +1119,10 @@ void MatteNode::benchProcessRowWithFg(uint8_t* d, const uint8_t* m, const uint8_
 void MatteNode::benchProcessRowNoFg(uint8_t* d, const uint8_t* m, int pixelCount) {
     processRowNoFg(d, m, static_cast<int_fast16_t>(pixelCount));
 }
+
+void MatteNode::benchSetForceScalar(bool forceScalar) {
+    s_matteForceScalar = forceScalar;
+}
 #endif
 
 } // namespace FLEXIMG_NAMESPACE
@@ -0,0 +1,650 @@
+#ifndef FLEXIMG_MEDIAN_NODE_H
+#define FLEXIMG_MEDIAN_NODE_H
+
+#include "../core/node.h"
+#include "../core/perf_metrics.h"
+#include "../core/render_context.h"
+#include "../image/image_buffer.h"
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace FLEXIMG_NAMESPACE {
+
+// ========================================================================
+// MedianNode - メディアンフィルタノード
+// ========================================================================
+//
+// (2*radius+1) × (2*radius+1) の正方形領域の中央値を出力します（ノイズ除去用）。
+// - 入力: 1ポート
+// - 出力: 1ポート（RGBA8_Straight、上流が Alpha8 / Grayscale8 なら同じフォーマット）
+// - 範囲外は0（透明）として扱う
+//
+// チャンネルごとの処理:
+// - RGBA8: プリマルチプライド [R×A/255, G×A/255, B×A/255, A] の各チャンネルの中央値
+//   （P ≤ A の大小関係は順位統計でも保たれる）を出力時にストレートへ戻す
+// - 単一チャンネルパス: Alpha8 / Grayscale8 は値を直接処理する
+//
+// 処理方式（Perreault の定数時間メディアン）:
+// - 列ごとに縦 2*radius+1 行分のヒストグラム（粗: 16ビン、細: 256ビン）を保持し、
+//   スキャンラインが1行進むごとに出ていく行を減算・入ってくる行を加算する
+// - 行内ではカーネルの粗ヒストグラムを列ヒストグラムの加減算でスライドさせ、
+//   中央値を含む粗ビンを決めてから、その細ビン16個だけを遅延更新して値を求める
+// - ヒストグラムの加減算とビンの探索は SSE2 / AVX2（16ビン同時、探索は累積和で分岐なし）
+// - 計算量は半径によらず1ピクセル・1チャンネルあたりほぼ一定
+//
+// メモリ消費量（概算）:
+// - 列ヒストグラム: (width + radius * 2) * channels * 272 bytes（列内のカウントは8bit）
+// - 行リング: (radius * 2 + 1) * (width + radius * 2) * channels bytes
+// - 例: radius=8, width=640, RGBA8 → 約0.8MB
+//
+// スキャンライン処理:
+// - 下方向への連続したリクエストは1行あたり上流1行の取得で処理
+// - 上方向・radius 行以上離れた行へのリクエストは radius * 2 + 1 行を取得し直す
+//
+// 制約:
+// - pull型のみ対応
+//
+// 使用例:
+//   MedianNode denoise;
+//   denoise.setRadius(2);
+//   sensor >> denoise >> sink;
+//
+
+class MedianNode : public Node {
+public:
+    MedianNode() {
+        initPorts(1, 1);
+    }
+
+    // ========================================
+    // パラメータ設定
+    // ========================================
+
+    // パラメータ上限（カーネルの要素数 65×65 が16bitカウンタに収まる範囲）
+    static constexpr int kMaxRadius = 32;
+
+    void setRadius(int_fast16_t radius) {
+        radius_ = static_cast<int16_t>((radius < 0) ? 0 : (radius > kMaxRadius) ? kMaxRadius : radius);
+        markModified();
+    }
+
+    int16_t radius() const { return radius_; }
+
+    // ========================================
+    // Node インターフェース
+    // ========================================
+
+    const char* name() const override { return "MedianNode"; }
+
+    // getDataRange: 上下 radius 行の和集合を左右 radius 拡張（BlurNode と同じ範囲）
+    DataRange getDataRange(const RenderRequest& request) const override;
+
+    void finalize() override;
+
+protected:
+    int nodeTypeForMetrics() const override { return NodeType::Median; }
+
+    PrepareResponse onPullPrepare(const PrepareRequest& request) override;
+    RenderResponse& onPullProcess(const RenderRequest& request) override;
+
+private:
+    int16_t radius_ = 1;
+
+    int_fast16_t kernelSize() const { return radius_ * 2 + 1; }
+
+    // ヒストグラム: 粗16ビン（上位4bit）、細は粗ビンごとに16ビン（下位4bit）
+    static constexpr size_t kBins = 16;
+
+    PixelFormatID channelFormat_ = nullptr;  // 単一チャンネルパスのフォーマット（nullptr = RGBA8）
+    int16_t cacheWidth_ = 0;
+    int_fixed cacheOriginX_ = 0;
+    std::vector<uint8_t> coarse_;            // 列の粗ヒストグラム [channel][paddedX][16]（列内は最大65行で8bit）
+    std::vector<uint8_t> fine_;              // 列の細ヒストグラム [channel][粗ビン][paddedX][16]
+                                             // （同じ粗ビンの隣接列が連続し、スライド・再計算が連続アクセスになる）
+    std::vector<uint8_t> ring_;              // 行リング（パディング幅、プリマルチプライド、範囲外は0）
+    std::vector<uint8_t> result_;            // 中央値の行（プリマルチプライド、再利用）
+    int32_t topRow_ = 0;                     // 列ヒストグラムが表す先頭行（top〜top+kernelSize-1）
+    bool columnsValid_ = false;
+
+    // getDataRange/pullProcess 間のキャッシュ
+    struct DataRangeCache {
+        Point origin = {INT32_MIN, INT32_MIN};
+        int16_t startX = 0;
+        int16_t endX = 0;
+    };
+    mutable DataRangeCache rangeCache_;
+
+    // getDataRange のスライディングウィンドウ（VerticalBlurNode と同じ単調デック方式）
+    struct RowQueue {
+        std::vector<int32_t> rows;
+        size_t head = 0;
+        size_t count = 0;
+
+        void reset(size_t capacity) { rows.assign(capacity, 0); head = 0; count = 0; }
+        bool empty() const { return count == 0; }
+        int32_t front() const { return rows[head]; }
+        int32_t back() const { return rows[(head + count - 1) % rows.size()]; }
+        void popFront() { head = (head + 1) % rows.size(); --count; }
+        void popBack() { --count; }
+        void pushBack(int32_t row) { rows[(head + count) % rows.size()] = row; ++count; }
+    };
+    struct RangeWindow {
+        std::vector<DataRange> history;
+        RowQueue minStart;
+        RowQueue maxEnd;
+        Point origin = {INT32_MIN, INT32_MIN};
+        int16_t width = 0;
+        bool valid = false;
+
+        size_t slot(int32_t row) const {
+            const auto n = static_cast<int32_t>(history.size());
+            const int32_t m = row % n;
+            return static_cast<size_t>(m < 0 ? m + n : m);
+        }
+    };
+    mutable RangeWindow rangeWindow_;
+
+    PixelFormatID workFormat() const { return channelFormat_ ? channelFormat_ : PixelFormatIDs::RGBA8_Straight; }
+    size_t channels() const { return channelFormat_ ? 1 : 4; }
+    size_t paddedWidth() const { return static_cast<size_t>(cacheWidth_) + static_cast<size_t>(radius_) * 2; }
+    uint8_t* ringRow(int32_t y) {
+        const auto k = static_cast<int32_t>(kernelSize());
+        const int32_t m = y % k;
+        return ring_.data() + static_cast<size_t>(m < 0 ? m + k : m) * paddedWidth() * channels();
+    }
+
+    DataRange horizontalRange(const RenderRequest& request) const;
+    void pushRangeRow(const RenderRequest& request, int_fast16_t dy) const;
+
+    // 列ヒストグラムを行 y - radius 〜 y + radius に合わせる
+    void advanceColumns(int32_t y);
+    // 行 y を上流から行リングへ取得（プリマルチプライド）
+    void fetchRow(int32_t y, uint8_t* dst);
+    // 行リングの1行を列ヒストグラムへ加算（sign = +1）/ 減算（sign = -1）
+    void accumulateRow(const uint8_t* row, int sign);
+    // キャッシュ座標 [startX, endX) の中央値を result_ へ
+    void computeMedians(size_t startX, size_t endX);
+};
+
+} // namespace FLEXIMG_NAMESPACE
+
+// =============================================================================
+// 実装部
+// =============================================================================
+#ifdef FLEXIMG_IMPLEMENTATION
+
+#if defined(FLEXIMG_HAS_AVX2)
+#include <immintrin.h>
+#elif defined(FLEXIMG_HAS_SSE2)
+#include <emmintrin.h>
+#endif
+
+namespace FLEXIMG_NAMESPACE {
+
+namespace median_detail {
+
+// dst[0..16) += add[0..16)（列ヒストグラムは8bit、カーネルヒストグラムは16bit）
+static inline void histAdd16(uint16_t* dst, const uint8_t* add) {
+#if defined(FLEXIMG_HAS_AVX2)
+    const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst));
+    const __m256i a = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(add)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), _mm256_add_epi16(d, a));
+#elif defined(FLEXIMG_HAS_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(add));
+    const __m128i d0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst));
+    const __m128i d1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + 8));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_add_epi16(d0, _mm_unpacklo_epi8(a, zero)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 8), _mm_add_epi16(d1, _mm_unpackhi_epi8(a, zero)));
+#else
+    for (int i = 0; i < 16; i++) dst[i] = static_cast<uint16_t>(dst[i] + add[i]);
+#endif
+}
+
+// dst[0..16) += add[0..16) - sub[0..16)
+static inline void histAddSub16(uint16_t* dst, const uint8_t* add, const uint8_t* sub) {
+#if defined(FLEXIMG_HAS_AVX2)
+    const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst));
+    const __m256i a = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(add)));
+    const __m256i s = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(sub)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), _mm256_sub_epi16(_mm256_add_epi16(d, a), s));
+#elif defined(FLEXIMG_HAS_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(add));
+    const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sub));
+    const __m128i d0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst));
+    const __m128i d1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + 8));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst),
+                     _mm_sub_epi16(_mm_add_epi16(d0, _mm_unpacklo_epi8(a, zero)), _mm_unpacklo_epi8(s, zero)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 8),
+                     _mm_sub_epi16(_mm_add_epi16(d1, _mm_unpackhi_epi8(a, zero)), _mm_unpackhi_epi8(s, zero)));
+#else
+    for (int i = 0; i < 16; i++) dst[i] = static_cast<uint16_t>(dst[i] + add[i] - sub[i]);
+#endif
+}
+
+// 16ビンのヒストグラムで累積数が rank を超える最初のビンを返し、acc にそれより前のビンの合計を加える
+// （SSE2: 累積和と比較で分岐なし。カウントは最大 65×65 で符号付き16bitに収まる）
+static inline size_t findBin16(const uint16_t* hist, uint32_t rank, uint32_t& acc) {
+#if defined(FLEXIMG_HAS_SSE2)
+    __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hist));
+    __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hist + 8));
+    lo = _mm_add_epi16(lo, _mm_slli_si128(lo, 2));
+    hi = _mm_add_epi16(hi, _mm_slli_si128(hi, 2));
+    lo = _mm_add_epi16(lo, _mm_slli_si128(lo, 4));
+    hi = _mm_add_epi16(hi, _mm_slli_si128(hi, 4));
+    lo = _mm_add_epi16(lo, _mm_slli_si128(lo, 8));
+    hi = _mm_add_epi16(hi, _mm_slli_si128(hi, 8));
+    const __m128i last = _mm_shufflehi_epi16(lo, 0xFF);
+    hi = _mm_add_epi16(hi, _mm_unpackhi_epi64(last, last));
+
+    // 累積数 ≤ rank - acc のビン数 = 求めるビンの位置
+    const __m128i limit = _mm_set1_epi16(static_cast<int16_t>(rank - acc));
+    const __m128i le = _mm_packs_epi16(_mm_cmpgt_epi16(lo, limit), _mm_cmpgt_epi16(hi, limit));
+    const __m128i ones = _mm_andnot_si128(le, _mm_set1_epi8(1));
+    const __m128i sums = _mm_sad_epu8(ones, _mm_setzero_si128());
+    const auto b = static_cast<size_t>(_mm_cvtsi128_si32(sums) + _mm_cvtsi128_si32(_mm_srli_si128(sums, 8)));
+    if (b > 0) {
+        alignas(16) uint16_t prefix[16];
+        _mm_store_si128(reinterpret_cast<__m128i*>(prefix), lo);
+        _mm_store_si128(reinterpret_cast<__m128i*>(prefix + 8), hi);
+        acc += prefix[b - 1];
+    }
+    return b;
+#else
+    size_t b = 0;
+    while (acc + hist[b] <= rank) {
+        acc += hist[b];
+        ++b;
+    }
+    return b;
+#endif
+}
+
+// x / 255 の四捨五入（0 ≤ x ≤ 65025）
+static inline uint8_t div255(uint32_t x) {
+    return static_cast<uint8_t>((x + 128 + ((x + 128) >> 8)) >> 8);
+}
+
+// RGBA8_Straight → プリマルチプライド RGBA8
+static inline void premultiplyRow(uint8_t* dst, const uint8_t* src, size_t count) {
+    for (size_t i = 0; i < count; i++, src += 4, dst += 4) {
+        const uint32_t a = src[3];
+        dst[0] = div255(src[0] * a);
+        dst[1] = div255(src[1] * a);
+        dst[2] = div255(src[2] * a);
+        dst[3] = static_cast<uint8_t>(a);
+    }
+}
+
+// プリマルチプライド RGBA8 → RGBA8_Straight（各チャンネルの値 ≤ A）
+static inline void unpremultiplyRow(uint8_t* dst, const uint8_t* src, size_t count) {
+    for (size_t i = 0; i < count; i++, src += 4, dst += 4) {
+        const uint8_t a = src[3];
+        if (a == 255 || a == 0) {
+            std::memcpy(dst, src, 4);
+            continue;
+        }
+        const float k = 255.0f / static_cast<float>(a);
+        for (int c = 0; c < 3; c++) {
+            dst[c] = static_cast<uint8_t>(static_cast<float>(src[c]) * k + 0.5f);
+        }
+        dst[3] = a;
+    }
+}
+
+} // namespace median_detail
+
+// ============================================================================
+// MedianNode - データ範囲
+// ============================================================================
+
+DataRange MedianNode::horizontalRange(const RenderRequest& request) const {
+    Node* upstream = upstreamNode(0);
+    if (!upstream) return DataRange();
+
+    // 出力 x はパディング座標 [x, x + 2*radius] の入力を参照する
+    const int_fast16_t r = radius_;
+    RenderRequest inputReq;
+    inputReq.width = static_cast<int16_t>(request.width + r * 2);
+    inputReq.height = 1;
+    inputReq.origin.x = request.origin.x - to_fixed(static_cast<int>(r));
+    inputReq.origin.y = request.origin.y;
+    const DataRange upstreamRange = upstream->getDataRange(inputReq);
+    if (!upstreamRange.hasData()) return DataRange();
+
+    const auto startX = static_cast<int16_t>(std::max<int_fast16_t>(0, upstreamRange.startX - r * 2));
+    const auto endX = static_cast<int16_t>(std::min<int_fast16_t>(request.width, upstreamRange.endX));
+    return (startX < endX) ? DataRange{startX, endX} : DataRange();
+}
+
+DataRange MedianNode::getDataRange(const RenderRequest& request) const {
+    Node* upstream = upstreamNode(0);
+    if (!upstream) return DataRange();
+    if (radius_ == 0) return upstream->getDataRange(request);
+
+    if (rangeCache_.origin.x == request.origin.x &&
+        rangeCache_.origin.y == request.origin.y) {
+        if (rangeCache_.startX >= rangeCache_.endX) return DataRange{0, 0};
+        return DataRange{rangeCache_.startX, rangeCache_.endX};
+    }
+
+    // 出力行Yは上流の行 Y-radius〜Y+radius の和集合
+    const int_fast16_t r = radius_;
+    RangeWindow& window = rangeWindow_;
+    const bool sameColumn = window.valid && window.origin.x == request.origin.x
+                         && window.width == request.width;
+
+    if (sameColumn && request.origin.y == window.origin.y + to_fixed(1)) {
+        window.origin.y = request.origin.y;
+        pushRangeRow(request, r);
+        const int32_t firstRow = from_fixed_floor(request.origin.y) - static_cast<int32_t>(r);
+        while (!window.minStart.empty() && window.minStart.front() < firstRow) window.minStart.popFront();
+        while (!window.maxEnd.empty() && window.maxEnd.front() < firstRow) window.maxEnd.popFront();
+    } else if (!sameColumn || request.origin.y != window.origin.y) {
+        const auto windowRows = static_cast<size_t>(kernelSize());
+        window.history.assign(windowRows, DataRange{0, 0});
+        window.minStart.reset(windowRows);
+        window.maxEnd.reset(windowRows);
+        window.origin = request.origin;
+        window.width = request.width;
+        window.valid = true;
+        for (auto dy = static_cast<int_fast16_t>(-r); dy <= r; ++dy) {
+            pushRangeRow(request, dy);
+        }
+    }
+
+    int16_t startX = INT16_MAX;
+    int16_t endX = INT16_MIN;
+    if (!window.minStart.empty()) {
+        startX = window.history[window.slot(window.minStart.front())].startX;
+        endX = window.history[window.slot(window.maxEnd.front())].endX;
+    }
+    rangeCache_.origin = request.origin;
+    rangeCache_.startX = startX;
+    rangeCache_.endX = endX;
+
+    if (startX >= endX) return DataRange{0, 0};
+    return DataRange{startX, endX};
+}
+
+void MedianNode::pushRangeRow(const RenderRequest& request, int_fast16_t dy) const {
+    RangeWindow& window = rangeWindow_;
+    RenderRequest rowRequest = request;
+    rowRequest.origin.y = request.origin.y + to_fixed(static_cast<int>(dy));
+    const DataRange rowRange = horizontalRange(rowRequest);
+
+    const int32_t row = from_fixed_floor(rowRequest.origin.y);
+    window.history[window.slot(row)] = rowRange;
+    if (!rowRange.hasData()) return;
+
+    while (!window.minStart.empty()
+           && window.history[window.slot(window.minStart.back())].startX >= rowRange.startX) {
+        window.minStart.popBack();
+    }
+    window.minStart.pushBack(row);
+    while (!window.maxEnd.empty()
+           && window.history[window.slot(window.maxEnd.back())].endX <= rowRange.endX) {
+        window.maxEnd.popBack();
+    }
+    window.maxEnd.pushBack(row);
+}
+
+// ============================================================================
+// MedianNode - Template Method フック実装
+// ============================================================================
+
+PrepareResponse MedianNode::onPullPrepare(const PrepareRequest& request) {
+    Node* upstream = upstreamNode(0);
+    if (!upstream) {
+        PrepareResponse result;
+        result.status = PrepareStatus::Prepared;
+        return result;
+    }
+
+    PrepareResponse result = upstream->pullPrepare(request);
+    if (!result.ok()) {
+        return result;
+    }
+    rangeWindow_.valid = false;
+    rangeCache_.origin = {INT32_MIN, INT32_MIN};
+    columnsValid_ = false;
+    if (radius_ == 0) {
+        return result;
+    }
+
+    // 1バイト1チャンネルの上流は単一チャンネルパスで処理（出力も同じフォーマット）
+    channelFormat_ = isSingleChannel8(result.preferredFormat) ? result.preferredFormat : nullptr;
+
+    // AABB: 上下左右に radius 拡張（範囲外の0を含めた中央値が0でない可能性がある領域）
+    result.width = static_cast<int16_t>(result.width + radius_ * 2);
+    result.height = static_cast<int16_t>(result.height + radius_ * 2);
+    result.origin.x = result.origin.x - to_fixed(static_cast<int>(radius_));
+    result.origin.y = result.origin.y - to_fixed(static_cast<int>(radius_));
+
+    cacheWidth_ = result.width;
+    cacheOriginX_ = result.origin.x;
+    const size_t ch = channels();
+    coarse_.assign(ch * paddedWidth() * kBins, 0);
+    fine_.assign(ch * kBins * paddedWidth() * kBins, 0);
+    ring_.assign(static_cast<size_t>(kernelSize()) * paddedWidth() * ch, 0);
+    result_.assign(static_cast<size_t>(cacheWidth_) * ch, 0);
+
+#ifdef FLEXIMG_DEBUG_PERF_METRICS
+    PerfMetrics::instance().nodes[NodeType::Median].recordAlloc(
+        coarse_.size() + fine_.size() + ring_.size() + result_.size(), cacheWidth_, kernelSize());
+#endif
+
+    return result;
+}
+
+void MedianNode::finalize() {
+    channelFormat_ = nullptr;
+    coarse_ = std::vector<uint8_t>();
+    fine_ = std::vector<uint8_t>();
+    ring_ = std::vector<uint8_t>();
+    result_ = std::vector<uint8_t>();
+    columnsValid_ = false;
+    rangeCache_ = DataRangeCache();
+    rangeWindow_ = RangeWindow();
+}
+
+RenderResponse& MedianNode::onPullProcess(const RenderRequest& request) {
+    Node* upstream = upstreamNode(0);
+    if (!upstream) return makeEmptyResponse(request.origin);
+
+    if (radius_ == 0) {
+        return upstream->pullProcess(request);
+    }
+
+    DataRange range;
+    if (rangeCache_.origin.x == request.origin.x &&
+        rangeCache_.origin.y == request.origin.y) {
+        range = DataRange{rangeCache_.startX, rangeCache_.endX};
+    } else {
+        range = getDataRange(request);
+    }
+    if (!range.hasData()) {
+        return makeEmptyResponse(request.origin);
+    }
+
+    // データ範囲とキャッシュの交差領域（キャッシュ座標）
+    const int_fixed cacheLeft = cacheOriginX_;
+    const int_fixed cacheRight = cacheLeft + to_fixed(cacheWidth_);
+    const int_fixed interLeft = std::max(cacheLeft, request.origin.x + to_fixed(range.startX));
+    const int_fixed interRight = std::min(cacheRight, request.origin.x + to_fixed(range.endX));
+    if (interLeft >= interRight) {
+        return makeEmptyResponse(request.origin);
+    }
+    const auto srcStartX = static_cast<size_t>(from_fixed_floor(interLeft - cacheLeft));
+    const auto srcEndX = static_cast<size_t>(from_fixed_ceil(interRight - cacheLeft));
+    const size_t count = srcEndX - srcStartX;
+
+    advanceColumns(from_fixed_floor(request.origin.y));
+
+    FLEXIMG_METRICS_SCOPE(NodeType::Median);
+
+    computeMedians(srcStartX, srcEndX);
+    ImageBuffer output(static_cast<int_fast16_t>(count), 1, workFormat(), InitPolicy::Uninitialized);
+    auto* dst = static_cast<uint8_t*>(output.view().data);
+    if (channelFormat_) {
+        std::memcpy(dst, result_.data() + srcStartX, count);
+    } else {
+        median_detail::unpremultiplyRow(dst, result_.data() + srcStartX * 4, count);
+    }
+
+#ifdef FLEXIMG_DEBUG_PERF_METRICS
+    auto& metrics = PerfMetrics::instance().nodes[NodeType::Median];
+    metrics.requestedPixels += static_cast<uint64_t>(request.width) * 1;
+    metrics.usedPixels += static_cast<uint64_t>(count) * 1;
+    metrics.recordAlloc(output.totalBytes(), output.width(), output.height());
+#endif
+
+    return makeResponse(std::move(output), Point{cacheLeft + to_fixed(static_cast<int>(srcStartX)), request.origin.y});
+}
+
+// ============================================================================
+// MedianNode - 列ヒストグラム
+// ============================================================================
+
+void MedianNode::advanceColumns(int32_t y) {
+    const auto k = static_cast<int32_t>(kernelSize());
+    const int32_t top = y - radius_;
+    const int32_t step = top - topRow_;
+    if (columnsValid_ && step == 0) return;
+
+    if (!columnsValid_ || step < 0 || step > radius_) {
+        // やり直し: 列ヒストグラムをクリアして kernelSize 行を取り込む
+        std::fill(coarse_.begin(), coarse_.end(), static_cast<uint8_t>(0));
+        std::fill(fine_.begin(), fine_.end(), static_cast<uint8_t>(0));
+        for (int32_t row = top; row < top + k; row++) {
+            uint8_t* slot = ringRow(row);
+            fetchRow(row, slot);
+            accumulateRow(slot, +1);
+        }
+        topRow_ = top;
+        columnsValid_ = true;
+        return;
+    }
+
+    // 下方向: 出ていく行と入ってくる行は同じリングスロットを使う
+    for (int32_t row = topRow_ + k; row < top + k; row++) {
+        uint8_t* slot = ringRow(row);
+        accumulateRow(slot, -1);
+        fetchRow(row, slot);
+        accumulateRow(slot, +1);
+    }
+    topRow_ = top;
+}
+
+void MedianNode::fetchRow(int32_t y, uint8_t* dst) {
+    const size_t ch = channels();
+    std::memset(dst, 0, paddedWidth() * ch);
+
+    Node* upstream = upstreamNode(0);
+    RenderRequest rowReq;
+    rowReq.width = cacheWidth_;
+    rowReq.height = 1;
+    rowReq.origin.x = cacheOriginX_;
+    rowReq.origin.y = to_fixed(static_cast<int>(y));
+    if (!upstream->getDataRange(rowReq).hasData()) return;
+
+    RenderResponse& result = upstream->pullProcess(rowReq);
+    if (result.isValid()) {
+        consolidateIfNeeded(result, workFormat());
+        const ViewPort src = result.view();
+        const auto srcOffsetX = static_cast<int_fast16_t>(from_fixed(result.origin.x - rowReq.origin.x));
+        const int_fast16_t begin = std::max<int_fast16_t>(0, srcOffsetX);
+        const int_fast16_t end = std::min<int_fast16_t>(cacheWidth_, static_cast<int_fast16_t>(srcOffsetX + src.width));
+        if (begin < end) {
+            const auto* s = static_cast<const uint8_t*>(src.pixelAt(static_cast<int>(begin - srcOffsetX), 0));
+            uint8_t* d = dst + (static_cast<size_t>(radius_) + static_cast<size_t>(begin)) * ch;
+            const auto n = static_cast<size_t>(end - begin);
+            if (channelFormat_) {
+                std::memcpy(d, s, n);
+            } else {
+                median_detail::premultiplyRow(d, s, n);
+            }
+        }
+    }
+    if (context_) {
+        context_->releaseResponse(result);
+    }
+}
+
+void MedianNode::accumulateRow(const uint8_t* row, int sign) {
+    const size_t ch = channels();
+    const size_t width = paddedWidth();
+    const auto delta = static_cast<uint8_t>(sign);  // -1 は 0xFF（8bitの加算で減算になる）
+    for (size_t c = 0; c < ch; c++) {
+        uint8_t* coarse = coarse_.data() + c * width * kBins;
+        uint8_t* fine = fine_.data() + c * kBins * width * kBins;
+        const uint8_t* src = row + c;
+        for (size_t x = 0; x < width; x++, src += ch) {
+            const size_t hi = *src >> 4;
+            const size_t lo = *src & 15;
+            uint8_t& cb = coarse[x * kBins + hi];
+            uint8_t& fb = fine[(hi * width + x) * kBins + lo];
+            cb = static_cast<uint8_t>(cb + delta);
+            fb = static_cast<uint8_t>(fb + delta);
+        }
+    }
+}
+
+void MedianNode::computeMedians(size_t startX, size_t endX) {
+    const size_t ch = channels();
+    const size_t width = paddedWidth();
+    const auto k = static_cast<size_t>(kernelSize());
+    const auto rank = static_cast<uint32_t>((k * k) / 2);  // 0始まりの中央の順位
+
+    for (size_t c = 0; c < ch; c++) {
+        const uint8_t* cols = coarse_.data() + c * width * kBins;
+        const uint8_t* fineCols = fine_.data() + c * kBins * width * kBins;
+        // カーネルヒストグラム（粗は毎ピクセル、細は使う粗ビンだけ遅延更新）
+        alignas(32) uint16_t coarse[kBins] = {};
+        alignas(32) uint16_t fine[kBins][kBins] = {};
+        size_t fineX[kBins];
+        std::fill(fineX, fineX + kBins, SIZE_MAX);
+
+        // 出力 x（キャッシュ座標）はパディング座標の列 [x, x + k) を参照する
+        for (size_t j = startX; j < startX + k; j++) {
+            median_detail::histAdd16(coarse, cols + j * kBins);
+        }
+        for (size_t x = startX; x < endX; x++) {
+            if (x > startX) {
+                median_detail::histAddSub16(coarse, cols + (x + k - 1) * kBins, cols + (x - 1) * kBins);
+            }
+
+            // 中央値を含む粗ビン
+            uint32_t acc = 0;
+            const size_t b = median_detail::findBin16(coarse, rank, acc);
+
+            // 細ビンの更新: 前回位置から近ければスライド、離れていれば列の和を取り直す
+            uint16_t* f = fine[b];
+            const uint8_t* seg = fineCols + b * width * kBins;
+            if (fineX[b] == SIZE_MAX || x - fineX[b] > static_cast<size_t>(radius_)) {
+                std::memset(f, 0, sizeof(fine[b]));
+                for (size_t j = x; j < x + k; j++) {
+                    median_detail::histAdd16(f, seg + j * kBins);
+                }
+            } else {
+                for (size_t p = fineX[b] + 1; p <= x; p++) {
+                    median_detail::histAddSub16(f, seg + (p + k - 1) * kBins, seg + (p - 1) * kBins);
+                }
+            }
+            fineX[b] = x;
+
+            const size_t i = median_detail::findBin16(f, rank, acc);
+            result_[x * ch + c] = static_cast<uint8_t>(b * kBins + i);
+        }
+    }
+}
+
+} // namespace FLEXIMG_NAMESPACE
+
+#endif // FLEXIMG_IMPLEMENTATION
+
+#endif // FLEXIMG_MEDIAN_NODE_H
@@ -0,0 +1,693 @@
+#ifndef FLEXIMG_MORPHOLOGY_NODE_H
+#define FLEXIMG_MORPHOLOGY_NODE_H
+
+#include "../core/node.h"
+#include "../core/perf_metrics.h"
+#include "../core/render_context.h"
+#include "../image/image_buffer.h"
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace FLEXIMG_NAMESPACE {
+
+// ========================================================================
+// MorphologyNode - モルフォロジーフィルタノード（収縮・膨張・オープン・クローズ）
+// ========================================================================
+//
+// 矩形の構造要素 (2*radiusX+1) × (2*radiusY+1) で最小値 / 最大値フィルタを適用します。
+// - 入力: 1ポート
+// - 出力: 1ポート（RGBA8_Straight、上流が Alpha8 / Grayscale8 なら同じフォーマット）
+// - Erode: 収縮（最小値）、Dilate: 膨張（最大値）
+// - Open: 収縮 → 膨張（小さな点・細い線の除去）、Close: 膨張 → 収縮（小さな穴の充填）
+// - 範囲外は0（透明）として扱う
+//
+// チャンネルごとの処理:
+// - RGBA8: プリマルチプライド [R×A/255, G×A/255, B×A/255, A] の各チャンネルに適用し、
+//   出力時にストレートへ戻す（透明ピクセルの色が結果に混ざらない）
+// - 単一チャンネルパス: Alpha8 / Grayscale8 は値を直接処理する
+//
+// 処理方式（van Herk / Gil-Werman、半径によらず1要素あたり約3回の min/max）:
+// - 水平: 行をカーネル幅のブロックに分け、ブロック内の前方累積 g と後方累積 h から
+//   out[x] = op(h[x], g[x + 2r]) で求める
+// - 垂直: 同じ分割を行方向に行う。ブロック内の行を行リング（2ブロック分）に保持し、
+//   ブロックが揃った時点で後方累積 h を上書きで計算、前方累積 g は1行の累積行で持つ
+// - 行単位の min/max は SSE2 / AVX2（16 / 32 バイト同時）
+// - Open / Close は2つのステージをパイプライン接続する（VerticalBlurNode の passes と同様）
+//
+// メモリ消費量（概算）:
+// - 各ステージ: (radiusY * 2 + 1) * 2 * width * bpp bytes（行リング）+ width * bpp * 2
+// - 例: radius=32, width=640, RGBA8 → 約170KB / ステージ
+//
+// スキャンライン処理:
+// - 下方向への連続したリクエストは1行あたり上流1行の取得で処理
+// - 上方向・大きく離れた行へのリクエストは radiusY * 2 + 1 行を取得し直す
+//
+// 制約:
+// - pull型のみ対応
+//
+// 使用例:
+//   MorphologyNode cleanup;
+//   cleanup.setOperation(MorphologyNode::Operation::Open);
+//   cleanup.setRadius(2);
+//   mask >> cleanup >> maskNode;
+//
+
+class MorphologyNode : public Node {
+public:
+    enum class Operation : uint8_t {
+        Erode,   // 収縮（最小値）
+        Dilate,  // 膨張（最大値）
+        Open,    // 収縮 → 膨張
+        Close    // 膨張 → 収縮
+    };
+
+    MorphologyNode() {
+        initPorts(1, 1);
+    }
+
+    // ========================================
+    // パラメータ設定
+    // ========================================
+
+    // パラメータ上限（ブラーノードと同じ）
+    static constexpr int kMaxRadius = 127;
+
+    void setOperation(Operation op) {
+        operation_ = op;
+        markModified();
+    }
+
+    // 水平・垂直に同じ半径を設定
+    void setRadius(int_fast16_t radius) {
+        setRadius(radius, radius);
+    }
+
+    void setRadius(int_fast16_t radiusX, int_fast16_t radiusY) {
+        radiusX_ = clampRadius(radiusX);
+        radiusY_ = clampRadius(radiusY);
+        markModified();
+    }
+
+    void setRadiusX(int_fast16_t radius) {
+        radiusX_ = clampRadius(radius);
+        markModified();
+    }
+
+    void setRadiusY(int_fast16_t radius) {
+        radiusY_ = clampRadius(radius);
+        markModified();
+    }
+
+    Operation operation() const { return operation_; }
+    int16_t radiusX() const { return radiusX_; }
+    int16_t radiusY() const { return radiusY_; }
+
+    // ========================================
+    // Node インターフェース
+    // ========================================
+
+    const char* name() const override { return "MorphologyNode"; }
+
+    // getDataRange: 膨張は上下 radiusY 行の和集合を radiusX 拡張、収縮は同じ行を radiusX 縮小
+    DataRange getDataRange(const RenderRequest& request) const override;
+
+    void finalize() override;
+
+protected:
+    int nodeTypeForMetrics() const override { return NodeType::Morphology; }
+
+    PrepareResponse onPullPrepare(const PrepareRequest& request) override;
+    RenderResponse& onPullProcess(const RenderRequest& request) override;
+
+private:
+    Operation operation_ = Operation::Dilate;
+    int16_t radiusX_ = 1;
+    int16_t radiusY_ = 1;
+
+    static int16_t clampRadius(int_fast16_t radius) {
+        return static_cast<int16_t>((radius < 0) ? 0 : (radius > kMaxRadius) ? kMaxRadius : radius);
+    }
+
+    int_fast16_t kernelSizeY() const { return radiusY_ * 2 + 1; }
+    bool passThrough() const { return radiusX_ == 0 && radiusY_ == 0; }
+    // 行キャッシュの左右の拡張量（最終的に膨張する操作のみ。Open の膨張は収縮後の範囲内に収まる）
+    int_fast16_t marginX() const {
+        return (operation_ == Operation::Dilate || operation_ == Operation::Close) ? radiusX_ : 0;
+    }
+
+    // ステージ（1回の収縮または膨張）
+    struct MorphStage {
+        bool dilate = false;
+        std::vector<uint8_t> blocks;    // 行リング: 2ブロック × kernelSizeY 行
+                                        //   （完了ブロック = 後方累積 h、進行中ブロック = 入力行）
+        std::vector<uint8_t> running;   // 進行中ブロックの前方累積 g（最新行まで）
+        std::vector<uint8_t> out;       // 出力行
+        int32_t nextRow = 0;            // 次に取り込む行
+        int32_t blockStart = 0;         // 進行中ブロックの先頭行
+        int32_t completedStart = 0;     // 完了ブロックの先頭行
+        int_fast16_t currentHalf = 0;   // 進行中ブロックが使う blocks の半分（0 / 1）
+        bool valid = false;
+
+        // getDataRange 用のスライディングウィンドウ（膨張のみ使用）
+        struct RowQueue {
+            std::vector<int32_t> rows;
+            size_t head = 0;
+            size_t count = 0;
+
+            void reset(size_t capacity) { rows.assign(capacity, 0); head = 0; count = 0; }
+            bool empty() const { return count == 0; }
+            int32_t front() const { return rows[head]; }
+            int32_t back() const { return rows[(head + count - 1) % rows.size()]; }
+            void popFront() { head = (head + 1) % rows.size(); --count; }
+            void popBack() { --count; }
+            void pushBack(int32_t row) { rows[(head + count) % rows.size()] = row; ++count; }
+        };
+        struct RangeWindow {
+            std::vector<DataRange> history;
+            RowQueue minStart;
+            RowQueue maxEnd;
+            Point origin = {INT32_MIN, INT32_MIN};
+            int_fast32_t width = 0;
+            bool valid = false;
+
+            size_t slot(int32_t row) const {
+                const auto n = static_cast<int32_t>(history.size());
+                const int32_t m = row % n;
+                return static_cast<size_t>(m < 0 ? m + n : m);
+            }
+        };
+        mutable RangeWindow rangeWindow;
+    };
+
+    std::vector<MorphStage> stages_;
+    PixelFormatID channelFormat_ = nullptr;  // 単一チャンネルパスのフォーマット（nullptr = RGBA8）
+    int16_t cacheWidth_ = 0;
+    int_fixed cacheOriginX_ = 0;
+    std::vector<uint8_t> line_;              // 水平処理の入力行（左右 radiusX のゼロパディング付き）
+    std::vector<uint8_t> lineG_;             // 水平の前方累積（再利用）
+    std::vector<uint8_t> lineH_;             // 水平の後方累積（再利用）
+
+    // getDataRange/pullProcess 間のキャッシュ
+    struct DataRangeCache {
+        Point origin = {INT32_MIN, INT32_MIN};
+        int16_t startX = 0;
+        int16_t endX = 0;
+    };
+    mutable DataRangeCache rangeCache_;
+
+    PixelFormatID workFormat() const { return channelFormat_ ? channelFormat_ : PixelFormatIDs::RGBA8_Straight; }
+    size_t bytesPerPixel() const { return channelFormat_ ? 1 : 4; }
+    size_t rowBytes() const { return static_cast<size_t>(cacheWidth_) * bytesPerPixel(); }
+
+    // ステージ s の出力行のデータ範囲（request 座標、幅は任意）
+    DataRange stageRange(size_t s, const RenderRequest& request) const;
+    // ステージ s の水平処理後の1行のデータ範囲
+    DataRange stageRowRange(size_t s, const RenderRequest& request) const;
+    void pushRangeRow(size_t s, const RenderRequest& request, int_fast16_t dy) const;
+
+    void initializeStages();
+    // ステージ s の出力行 y を計算して返す（stages_[s].out、キャッシュ座標）
+    const uint8_t* stageRow(size_t s, int32_t y);
+    // ステージ s に入力行 y を取り込む（水平処理 → 行リング・前方累積の更新）
+    void ingestRow(size_t s, int32_t y);
+    // 上流の行 y を line_ の中央（パディングの内側）にプリマルチプライドで格納
+    void fetchSourceRow(int32_t y);
+};
+
+} // namespace FLEXIMG_NAMESPACE
+
+// =============================================================================
+// 実装部
+// =============================================================================
+#ifdef FLEXIMG_IMPLEMENTATION
+
+#if defined(FLEXIMG_HAS_AVX2)
+#include <immintrin.h>
+#elif defined(FLEXIMG_HAS_SSE2)
+#include <emmintrin.h>
+#endif
+
+namespace FLEXIMG_NAMESPACE {
+
+namespace morphology_detail {
+
+template<bool Max>
+static inline uint8_t op(uint8_t a, uint8_t b) {
+    return Max ? std::max(a, b) : std::min(a, b);
+}
+
+// dst[i] = op(a[i], b[i])（dst は a / b と同じでもよい）
+template<bool Max>
+static inline void rowOp(uint8_t* dst, const uint8_t* a, const uint8_t* b, size_t n) {
+    size_t i = 0;
+#if defined(FLEXIMG_HAS_AVX2)
+    for (; i + 32 <= n; i += 32) {
+        const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+                            Max ? _mm256_max_epu8(va, vb) : _mm256_min_epu8(va, vb));
+    }
+#endif
+#if defined(FLEXIMG_HAS_SSE2)
+    for (; i + 16 <= n; i += 16) {
+        const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                         Max ? _mm_max_epu8(va, vb) : _mm_min_epu8(va, vb));
+    }
+#endif
+    for (; i < n; i++) {
+        dst[i] = op<Max>(a[i], b[i]);
+    }
+}
+
+static inline void rowOp(bool dilate, uint8_t* dst, const uint8_t* a, const uint8_t* b, size_t n) {
+    if (dilate) {
+        rowOp<true>(dst, a, b, n);
+    } else {
+        rowOp<false>(dst, a, b, n);
+    }
+}
+
+// 水平 van Herk / Gil-Werman
+// src: (width + 2r) ピクセル、dst[x] = op(src[x .. x + 2r])（ピクセルあたり bpp バイト、チャンネルごと）
+// g / h: (width + 2r) * bpp バイトの作業領域
+template<bool Max>
+static inline void hgwLine(uint8_t* dst, const uint8_t* src, size_t width, size_t radius, size_t bpp,
+                           uint8_t* g, uint8_t* h) {
+    const size_t len = (width + radius * 2) * bpp;
+    const size_t block = (radius * 2 + 1) * bpp;
+    for (size_t b = 0; b < len; b += block) {
+        const size_t e = std::min(b + block, len);
+        std::memcpy(g + b, src + b, bpp);
+        for (size_t i = b + bpp; i < e; i++) {
+            g[i] = op<Max>(g[i - bpp], src[i]);
+        }
+        std::memcpy(h + e - bpp, src + e - bpp, bpp);
+        for (size_t i = e - bpp; i-- > b;) {
+            h[i] = op<Max>(h[i + bpp], src[i]);
+        }
+    }
+    rowOp<Max>(dst, h, g + radius * 2 * bpp, width * bpp);
+}
+
+// x / 255 の四捨五入（0 ≤ x ≤ 65025）
+static inline uint8_t div255(uint32_t x) {
+    return static_cast<uint8_t>((x + 128 + ((x + 128) >> 8)) >> 8);
+}
+
+// RGBA8_Straight → プリマルチプライド RGBA8
+static inline void premultiplyRow(uint8_t* dst, const uint8_t* src, size_t count) {
+    for (size_t i = 0; i < count; i++, src += 4, dst += 4) {
+        const uint32_t a = src[3];
+        dst[0] = div255(src[0] * a);
+        dst[1] = div255(src[1] * a);
+        dst[2] = div255(src[2] * a);
+        dst[3] = static_cast<uint8_t>(a);
+    }
+}
+
+// プリマルチプライド RGBA8 → RGBA8_Straight（各チャンネルの値 ≤ A）
+static inline void unpremultiplyRow(uint8_t* dst, const uint8_t* src, size_t count) {
+    for (size_t i = 0; i < count; i++, src += 4, dst += 4) {
+        const uint8_t a = src[3];
+        if (a == 255 || a == 0) {
+            std::memcpy(dst, src, 4);
+            continue;
+        }
+        const float k = 255.0f / static_cast<float>(a);
+        for (int c = 0; c < 3; c++) {
+            dst[c] = static_cast<uint8_t>(static_cast<float>(src[c]) * k + 0.5f);
+        }
+        dst[3] = a;
+    }
+}
+
+} // namespace morphology_detail
+
+// ============================================================================
+// MorphologyNode - データ範囲
+// ============================================================================
+
+DataRange MorphologyNode::stageRowRange(size_t s, const RenderRequest& request) const {
+    // 上流（前段ステージ）を左右 radiusX 拡張して問い合わせる
+    const int_fast16_t r = radiusX_;
+    RenderRequest inputReq = request;
+    inputReq.width = static_cast<int16_t>(request.width + r * 2);
+    inputReq.origin.x = request.origin.x - to_fixed(static_cast<int>(r));
+    DataRange in;
+    if (s == 0) {
+        Node* upstream = upstreamNode(0);
+        in = upstream ? upstream->getDataRange(inputReq) : DataRange();
+    } else {
+        in = stageRange(s - 1, inputReq);
+    }
+    if (!in.hasData()) return DataRange();
+
+    // inputReq 座標 → request 座標（-r）、膨張は両側 +r、収縮は両側 -r
+    int_fast16_t startX = in.startX - r * 2;
+    int_fast16_t endX = in.endX;
+    if (!stages_[s].dilate) {
+        startX = in.startX;
+        endX = in.endX - r * 2;
+    }
+    startX = std::max<int_fast16_t>(0, startX);
+    endX = std::min<int_fast16_t>(request.width, endX);
+    return (startX < endX) ? DataRange{static_cast<int16_t>(startX), static_cast<int16_t>(endX)} : DataRange();
+}
+
+DataRange MorphologyNode::stageRange(size_t s, const RenderRequest& request) const {
+    const MorphStage& stage = stages_[s];
+    // 収縮: 出力行 y は入力行 y の範囲に含まれる（保守的に行 y のみ）
+    if (!stage.dilate || radiusY_ == 0) return stageRowRange(s, request);
+
+    // 膨張: 上下 radiusY 行の和集合（VerticalBlurNode と同じ単調デック方式）
+    const int_fast16_t expansion = radiusY_;
+    auto& window = stage.rangeWindow;
+    const bool sameColumn = window.valid && window.origin.x == request.origin.x
+                         && window.width == request.width;
+
+    if (sameColumn && request.origin.y == window.origin.y + to_fixed(1)) {
+        window.origin.y = request.origin.y;
+        pushRangeRow(s, request, expansion);
+        const int32_t firstRow = from_fixed_floor(request.origin.y) - static_cast<int32_t>(expansion);
+        while (!window.minStart.empty() && window.minStart.front() < firstRow) window.minStart.popFront();
+        while (!window.maxEnd.empty() && window.maxEnd.front() < firstRow) window.maxEnd.popFront();
+    } else if (!sameColumn || request.origin.y != window.origin.y) {
+        const auto windowRows = static_cast<size_t>(expansion * 2 + 1);
+        window.history.assign(windowRows, DataRange{0, 0});
+        window.minStart.reset(windowRows);
+        window.maxEnd.reset(windowRows);
+        window.origin = request.origin;
+        window.width = request.width;
+        window.valid = true;
+        for (auto dy = static_cast<int_fast16_t>(-expansion); dy <= expansion; ++dy) {
+            pushRangeRow(s, request, dy);
+        }
+    }
+
+    if (window.minStart.empty()) return DataRange();
+    const int16_t startX = window.history[window.slot(window.minStart.front())].startX;
+    const int16_t endX = window.history[window.slot(window.maxEnd.front())].endX;
+    return (startX < endX) ? DataRange{startX, endX} : DataRange();
+}
+
+void MorphologyNode::pushRangeRow(size_t s, const RenderRequest& request, int_fast16_t dy) const {
+    auto& window = stages_[s].rangeWindow;
+    RenderRequest rowRequest = request;
+    rowRequest.origin.y = request.origin.y + to_fixed(static_cast<int>(dy));
+    const DataRange rowRange = stageRowRange(s, rowRequest);
+
+    const int32_t row = from_fixed_floor(rowRequest.origin.y);
+    window.history[window.slot(row)] = rowRange;
+    if (!rowRange.hasData()) return;
+
+    while (!window.minStart.empty()
+           && window.history[window.slot(window.minStart.back())].startX >= rowRange.startX) {
+        window.minStart.popBack();
+    }
+    window.minStart.pushBack(row);
+    while (!window.maxEnd.empty()
+           && window.history[window.slot(window.maxEnd.back())].endX <= rowRange.endX) {
+        window.maxEnd.popBack();
+    }
+    window.maxEnd.pushBack(row);
+}
+
+DataRange MorphologyNode::getDataRange(const RenderRequest& request) const {
+    Node* upstream = upstreamNode(0);
+    if (!upstream) return DataRange();
+    if (passThrough() || stages_.empty()) return upstream->getDataRange(request);
+
+    if (rangeCache_.origin.x == request.origin.x &&
+        rangeCache_.origin.y == request.origin.y) {
+        if (rangeCache_.startX >= rangeCache_.endX) return DataRange{0, 0};
+        return DataRange{rangeCache_.startX, rangeCache_.endX};
+    }
+
+    const DataRange range = stageRange(stages_.size() - 1, request);
+    rangeCache_.origin = request.origin;
+    rangeCache_.startX = range.startX;
+    rangeCache_.endX = range.endX;
+    return range.hasData() ? range : DataRange{0, 0};
+}
+
+// ============================================================================
+// MorphologyNode - Template Method フック実装
+// ============================================================================
+
+PrepareResponse MorphologyNode::onPullPrepare(const PrepareRequest& request) {
+    Node* upstream = upstreamNode(0);
+    if (!upstream) {
+        PrepareResponse result;
+        result.status = PrepareStatus::Prepared;
+        return result;
+    }
+
+    PrepareResponse result = upstream->pullPrepare(request);
+    if (!result.ok()) {
+        return result;
+    }
+    rangeCache_.origin = {INT32_MIN, INT32_MIN};
+    stages_.clear();
+    if (passThrough()) {
+        return result;
+    }
+
+    // 1バイト1チャンネルの上流は単一チャンネルパスで処理（出力も同じフォーマット）
+    channelFormat_ = isSingleChannel8(result.preferredFormat) ? result.preferredFormat : nullptr;
+
+    // 行キャッシュは膨張分を含む幅で確保（収縮のみなら上流と同じ幅）
+    const int_fast16_t margin = marginX();
+    cacheWidth_ = static_cast<int16_t>(result.width + margin * 2);
+    cacheOriginX_ = result.origin.x - to_fixed(static_cast<int>(margin));
+    initializeStages();
+
+#ifdef FLEXIMG_DEBUG_PERF_METRICS
+    size_t cacheBytes = line_.size() * 3;
+    for (const auto& stage : stages_) {
+        cacheBytes += stage.blocks.size() + stage.running.size() + stage.out.size();
+    }
+    PerfMetrics::instance().nodes[NodeType::Morphology].recordAlloc(
+        cacheBytes, cacheWidth_, kernelSizeY() * 2);
+#endif
+
+    // AABB: 最終的に膨張する操作（Dilate / Close）のみ拡張
+    // （Open は収縮後の膨張で元の範囲を超えない）
+    if (operation_ == Operation::Dilate || operation_ == Operation::Close) {
+        result.width = static_cast<int16_t>(result.width + radiusX_ * 2);
+        result.origin.x = result.origin.x - to_fixed(static_cast<int>(radiusX_));
+        result.height = static_cast<int16_t>(result.height + radiusY_ * 2);
+        result.origin.y = result.origin.y - to_fixed(static_cast<int>(radiusY_));
+    }
+    return result;
+}
+
+void MorphologyNode::finalize() {
+    stages_.clear();
+    channelFormat_ = nullptr;
+    line_ = std::vector<uint8_t>();
+    lineG_ = std::vector<uint8_t>();
+    lineH_ = std::vector<uint8_t>();
+    rangeCache_ = DataRangeCache();
+}
+
+RenderResponse& MorphologyNode::onPullProcess(const RenderRequest& request) {
+    Node* upstream = upstreamNode(0);
+    if (!upstream) return makeEmptyResponse(request.origin);
+
+    if (passThrough() || stages_.empty()) {
+        return upstream->pullProcess(request);
+    }
+
+    DataRange range;
+    if (rangeCache_.origin.x == request.origin.x &&
+        rangeCache_.origin.y == request.origin.y) {
+        range = DataRange{rangeCache_.startX, rangeCache_.endX};
+    } else {
+        range = getDataRange(request);
+    }
+    if (!range.hasData()) {
+        return makeEmptyResponse(request.origin);
+    }
+
+    // データ範囲とキャッシュの交差領域（キャッシュ座標）
+    const int_fixed cacheLeft = cacheOriginX_;
+    const int_fixed cacheRight = cacheLeft + to_fixed(cacheWidth_);
+    const int_fixed interLeft = std::max(cacheLeft, request.origin.x + to_fixed(range.startX));
+    const int_fixed interRight = std::min(cacheRight, request.origin.x + to_fixed(range.endX));
+    if (interLeft >= interRight) {
+        return makeEmptyResponse(request.origin);
+    }
+    const auto srcStartX = static_cast<int_fast16_t>(from_fixed_floor(interLeft - cacheLeft));
+    const auto srcEndX = static_cast<int_fast16_t>(from_fixed_ceil(interRight - cacheLeft));
+    const auto count = static_cast<size_t>(srcEndX - srcStartX);
+
+    const uint8_t* row = stageRow(stages_.size() - 1, from_fixed_floor(request.origin.y));
+
+    FLEXIMG_METRICS_SCOPE(NodeType::Morphology);
+
+    ImageBuffer output(static_cast<int_fast16_t>(count), 1, workFormat(), InitPolicy::Uninitialized);
+    auto* dst = static_cast<uint8_t*>(output.view().data);
+    const size_t bpp = bytesPerPixel();
+    if (channelFormat_) {
+        std::memcpy(dst, row + static_cast<size_t>(srcStartX) * bpp, count * bpp);
+    } else {
+        morphology_detail::unpremultiplyRow(dst, row + static_cast<size_t>(srcStartX) * bpp, count);
+    }
+
+#ifdef FLEXIMG_DEBUG_PERF_METRICS
+    auto& metrics = PerfMetrics::instance().nodes[NodeType::Morphology];
+    metrics.requestedPixels += static_cast<uint64_t>(request.width) * 1;
+    metrics.usedPixels += static_cast<uint64_t>(count) * 1;
+    metrics.recordAlloc(output.totalBytes(), output.width(), output.height());
+#endif
+
+    return makeResponse(std::move(output), Point{cacheLeft + to_fixed(static_cast<int>(srcStartX)), request.origin.y});
+}
+
+// ============================================================================
+// MorphologyNode - ステージパイプライン
+// ============================================================================
+
+void MorphologyNode::initializeStages() {
+    const bool erodeFirst = (operation_ == Operation::Erode || operation_ == Operation::Open);
+    const size_t stageCount = (operation_ == Operation::Open || operation_ == Operation::Close) ? 2 : 1;
+    stages_.resize(stageCount);
+    const size_t bytes = rowBytes();
+    for (size_t s = 0; s < stageCount; s++) {
+        MorphStage& stage = stages_[s];
+        stage.dilate = (s == 0) ? !erodeFirst : erodeFirst;
+        stage.blocks.assign(bytes * static_cast<size_t>(kernelSizeY()) * 2, 0);
+        stage.running.assign(bytes, 0);
+        stage.out.assign(bytes, 0);
+        stage.valid = false;
+        stage.rangeWindow.valid = false;
+    }
+    const size_t paddedBytes = (static_cast<size_t>(cacheWidth_) + static_cast<size_t>(radiusX_) * 2) * bytesPerPixel();
+    line_.assign(paddedBytes, 0);
+    lineG_.assign(paddedBytes, 0);
+    lineH_.assign(paddedBytes, 0);
+}
+
+const uint8_t* MorphologyNode::stageRow(size_t s, int32_t y) {
+    MorphStage& stage = stages_[s];
+    const int32_t ks = static_cast<int32_t>(kernelSizeY());
+    const int32_t last = y + radiusY_;
+
+    // 取り込み済みの行を越えている・1ブロック以上先へ飛ぶ場合は y - radiusY からやり直す
+    if (!stage.valid || stage.nextRow > last + 1 || last + 1 - stage.nextRow > ks) {
+        stage.nextRow = y - radiusY_;
+        stage.blockStart = stage.nextRow;
+        stage.currentHalf = 0;
+        stage.valid = true;
+    }
+    while (stage.nextRow <= last) {
+        ingestRow(s, stage.nextRow++);
+    }
+
+    FLEXIMG_METRICS_SCOPE(NodeType::Morphology);
+
+    // 窓 [y - r, y + r] は完了ブロックの h[y - r] と進行中ブロックの g[y + r] に分かれる
+    // （y - r がブロック先頭なら y + r で完了したブロックそのもの、g も同じ値）
+    const size_t bytes = rowBytes();
+    const size_t completedHalf = static_cast<size_t>(1 - stage.currentHalf);
+    const uint8_t* h = stage.blocks.data()
+                     + (completedHalf * static_cast<size_t>(ks) + static_cast<size_t>(y - radiusY_ - stage.completedStart)) * bytes;
+    morphology_detail::rowOp(stage.dilate, stage.out.data(), h, stage.running.data(), bytes);
+    return stage.out.data();
+}
+
+void MorphologyNode::ingestRow(size_t s, int32_t y) {
+    MorphStage& stage = stages_[s];
+    const size_t bytes = rowBytes();
+    const size_t bpp = bytesPerPixel();
+    const auto ks = static_cast<size_t>(kernelSizeY());
+    uint8_t* center = line_.data() + static_cast<size_t>(radiusX_) * bpp;
+
+    // 入力行を line_ の中央へ
+    if (s == 0) {
+        fetchSourceRow(y);
+    } else {
+        std::memcpy(center, stageRow(s - 1, y), bytes);
+    }
+
+    FLEXIMG_METRICS_SCOPE(NodeType::Morphology);
+
+    // 水平処理 → 進行中ブロックの行スロット
+    const auto index = static_cast<size_t>(y - stage.blockStart);
+    uint8_t* blockBase = stage.blocks.data() + static_cast<size_t>(stage.currentHalf) * ks * bytes;
+    uint8_t* slot = blockBase + index * bytes;
+    if (radiusX_ == 0) {
+        std::memcpy(slot, center, bytes);
+    } else if (stage.dilate) {
+        morphology_detail::hgwLine<true>(slot, line_.data(), static_cast<size_t>(cacheWidth_),
+                                         static_cast<size_t>(radiusX_), bpp, lineG_.data(), lineH_.data());
+    } else {
+        morphology_detail::hgwLine<false>(slot, line_.data(), static_cast<size_t>(cacheWidth_),
+                                          static_cast<size_t>(radiusX_), bpp, lineG_.data(), lineH_.data());
+    }
+
+    // 前方累積 g
+    if (index == 0) {
+        std::memcpy(stage.running.data(), slot, bytes);
+    } else {
+        morphology_detail::rowOp(stage.dilate, stage.running.data(), stage.running.data(), slot, bytes);
+    }
+
+    // ブロック完了: 後方累積 h を上書きで計算し、完了ブロックとして入れ替える
+    if (index + 1 == ks) {
+        for (size_t i = ks - 1; i-- > 0;) {
+            uint8_t* r = blockBase + i * bytes;
+            morphology_detail::rowOp(stage.dilate, r, r, r + bytes, bytes);
+        }
+        stage.completedStart = stage.blockStart;
+        stage.blockStart = y + 1;
+        stage.currentHalf = 1 - stage.currentHalf;
+    }
+}
+
+void MorphologyNode::fetchSourceRow(int32_t y) {
+    const size_t bpp = bytesPerPixel();
+    uint8_t* center = line_.data() + static_cast<size_t>(radiusX_) * bpp;
+    std::memset(center, 0, rowBytes());
+
+    Node* upstream = upstreamNode(0);
+    RenderRequest rowReq;
+    rowReq.width = cacheWidth_;
+    rowReq.height = 1;
+    rowReq.origin.x = cacheOriginX_;
+    rowReq.origin.y = to_fixed(static_cast<int>(y));
+    if (!upstream->getDataRange(rowReq).hasData()) return;
+
+    RenderResponse& result = upstream->pullProcess(rowReq);
+    if (result.isValid()) {
+        consolidateIfNeeded(result, workFormat());
+        const ViewPort src = result.view();
+        const auto srcOffsetX = static_cast<int_fast16_t>(from_fixed(result.origin.x - rowReq.origin.x));
+        const int_fast16_t begin = std::max<int_fast16_t>(0, srcOffsetX);
+        const int_fast16_t end = std::min<int_fast16_t>(cacheWidth_, static_cast<int_fast16_t>(srcOffsetX + src.width));
+        if (begin < end) {
+            const auto* s = static_cast<const uint8_t*>(src.pixelAt(static_cast<int>(begin - srcOffsetX), 0));
+            uint8_t* d = center + static_cast<size_t>(begin) * bpp;
+            const auto n = static_cast<size_t>(end - begin);
+            if (channelFormat_) {
+                std::memcpy(d, s, n);
+            } else {
+                morphology_detail::premultiplyRow(d, s, n);
+            }
+        }
+    }
+    if (context_) {
+        context_->releaseResponse(result);
+    }
+}
+
+} // namespace FLEXIMG_NAMESPACE
+
+#endif // FLEXIMG_IMPLEMENTATION
+
+#endif // FLEXIMG_MORPHOLOGY_NODE_H
@@ -66,6 +66,7 @@ public:
 
         // 各区画のソースサイズを計算
         calcSrcPatchSizes();
+        markModified();
     }
 
     // 9patch互換画像（外周1pxがメタデータ）を渡す（メインAPI）
@@ -122,6 +123,7 @@ public:
             outputHeight_ = height;
             geometryValid_ = false;
         }
+        markModified();
     }
 
     // 基準点設定（pivot: 画像内のアンカーポイント、デフォルトは左上 (0,0)）
@@ -131,6 +133,7 @@ public:
             pivotY_ = y;
             geometryValid_ = false;  // アフィン行列の再計算が必要
         }
+        markModified();
     }
 
     // 配置位置設定（アフィン行列のtx/tyに加算）
@@ -140,6 +143,7 @@ public:
             positionY_ = y;
             geometryValid_ = false;  // アフィン行列の再計算が必要
         }
+        markModified();
     }
 
     // 補間モード設定（内部の全SourceNodeに適用）
@@ -151,6 +155,7 @@ public:
         for (int i = 0; i < 9; i++) {
             patches_[i].setInterpolationMode(mode);
         }
+        markModified();
     }
 
     // ========================================
@@ -169,6 +174,7 @@ public:
     int_fast16_t srcBottom() const { return srcBottom_; }
 
     const char* name() const override { return "NinePatchSourceNode"; }
+    uint32_t generation() const override { return Node::generation() + matrixGeneration(); }
     int nodeTypeForMetrics() const override { return NodeType::NinePatch; }
 
     // ========================================
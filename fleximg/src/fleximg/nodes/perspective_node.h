@@ -0,0 +1,142 @@
+#ifndef FLEXIMG_PERSPECTIVE_NODE_H
+#define FLEXIMG_PERSPECTIVE_NODE_H
+
+#include "../core/node.h"
+#include "../core/perf_metrics.h"
+
+namespace FLEXIMG_NAMESPACE {
+
+// ========================================================================
+// PerspectiveNode - 射影変換ノード
+// ========================================================================
+//
+// 入力画像に対して射影変換（3x3ホモグラフィ）を適用します。
+// - 入力: 1ポート
+// - 出力: 1ポート
+//
+// 特徴:
+// - AffineNodeと同様、行列を保持して上流のSourceNodeへ伝播するのみ
+// - 実際のサンプリングはSourceNodeが行う（スパン単位の透視補正DDA）
+//   Nスパンごとに正確な除算を行い、間は線形DDA（copyRowDDA）で補間
+// - 下流側から伝播されたアフィン行列は自身の行列に取り込み、
+//   上流側のAffineNodeは従来通りaffineMatrixに累積する
+//
+// 注意:
+// - プル型のみ対応（プッシュ型パイプラインではパススルー）
+//
+// 使用例:
+//   PerspectiveNode persp;
+//   // 画像矩形 (0,0)-(w,h) を四角形に写す（頂点順: 左上、右上、右下、左下）
+//   persp.setRectToQuad(w, h, -40, -30, 40, -30, 60, 30, -60, 30);
+//   src >> persp >> renderer >> sink;
+//
+
+class PerspectiveNode : public Node {
+public:
+    PerspectiveNode() {
+        initPorts(1, 1);  // 入力1、出力1
+    }
+
+    // ========================================
+    // 行列設定
+    // ========================================
+
+    void setMatrix(const PerspectiveMatrix& m) { matrix_ = m; markModified(); }
+    const PerspectiveMatrix& matrix() const { return matrix_; }
+
+    // ローカル矩形 (0,0)-(width,height) を四角形に写す行列を設定
+    // 頂点順: 左上(x0,y0)、右上(x1,y1)、右下(x2,y2)、左下(x3,y3)
+    // 矩形の座標はSourceNodeのpivot基準（pivot=0なら画像左上基準）
+    void setRectToQuad(float width, float height,
+                       float x0, float y0, float x1, float y1,
+                       float x2, float y2, float x3, float y3) {
+        if (width == 0.0f || height == 0.0f) return;
+        matrix_ = PerspectiveMatrix::squareToQuad(x0, y0, x1, y1, x2, y2, x3, y3)
+                * AffineMatrix::scale(1.0f / width, 1.0f / height);
+        markModified();
+    }
+
+    // ========================================
+    // Node インターフェース
+    // ========================================
+
+    const char* name() const override { return "PerspectiveNode"; }
+
+    // getDataSegments: 上流パススルー（範囲は上流のSourceNodeが変換込みで算出）
+    int_fast16_t getDataSegments(const RenderRequest& request,
+                                 DataRange* segments, int_fast16_t maxCount) const override {
+        Node* upstream = upstreamNode(0);
+        return upstream ? upstream->getDataSegments(request, segments, maxCount) : 0;
+    }
+
+protected:
+    // ========================================
+    // Template Method フック
+    // ========================================
+
+    // onPullPrepare: 射影行列を上流に伝播し、SourceNodeで一括実行
+    PrepareResponse onPullPrepare(const PrepareRequest& request) override;
+
+    // onPullProcess: 行列を保持するのみ、パススルー
+    RenderResponse& onPullProcess(const RenderRequest& request) override;
+
+    int nodeTypeForMetrics() const override { return NodeType::Perspective; }
+
+private:
+    PerspectiveMatrix matrix_;
+};
+
+} // namespace FLEXIMG_NAMESPACE
+
+// =============================================================================
+// 実装部
+// =============================================================================
+#ifdef FLEXIMG_IMPLEMENTATION
+
+namespace FLEXIMG_NAMESPACE {
+
+// ============================================================================
+// PerspectiveNode - Template Method フック実装
+// ============================================================================
+
+PrepareResponse PerspectiveNode::onPullPrepare(const PrepareRequest& request) {
+    // 上流に渡すためのコピーを作成し、自身の行列を累積
+    // 合成順序: 既存射影 * 下流側アフィン * 自身の行列
+    PrepareRequest upstreamRequest = request;
+    PerspectiveMatrix combined = upstreamRequest.hasPerspective
+                               ? upstreamRequest.perspectiveMatrix : PerspectiveMatrix();
+    if (upstreamRequest.hasAffine) {
+        combined = combined * upstreamRequest.affineMatrix;
+    }
+    upstreamRequest.perspectiveMatrix = combined * matrix_;
+    upstreamRequest.hasPerspective = true;
+
+    // 下流側アフィンは射影行列に取り込み済み
+    // 上流側のAffineNodeはここから新たに累積する
+    upstreamRequest.affineMatrix = AffineMatrix();
+    upstreamRequest.hasAffine = false;
+
+    // 上流へ伝播
+    Node* upstream = upstreamNode(0);
+    if (upstream) {
+        return upstream->pullPrepare(upstreamRequest);  // パススルー
+    }
+    // 上流なし: 有効なデータがないのでサイズ0を返す
+    PrepareResponse result;
+    result.status = PrepareStatus::Prepared;
+    return result;
+}
+
+RenderResponse& PerspectiveNode::onPullProcess(const RenderRequest& request) {
+    Node* upstream = upstreamNode(0);
+    if (upstream) {
+        return upstream->pullProcess(request);
+    }
+    return makeEmptyResponse(request.origin);
+}
+
+} // namespace FLEXIMG_NAMESPACE
+
+#endif // FLEXIMG_IMPLEMENTATION
+
+#endif // FLEXIMG_PERSPECTIVE_NODE_H
@@ -410,6 +410,11 @@ void RendererNode::applyDataRangeDebug(Node* upstream,
         }
     }
 
+    // 疎バッファはセグメント外をゼロ埋め（未初期化領域をコピーしない）
+    if (result.isValid()) {
+        consolidateIfNeeded(result, nullptr);
+    }
+
     // 実データをコピー（単一バッファ・フォーマット変換対応）
     if (result.isValid()) {
         const ImageBuffer& buf = result.buffer();
@@ -0,0 +1,251 @@
+#ifndef FLEXIMG_SHARED_NODE_H
+#define FLEXIMG_SHARED_NODE_H
+
+#include "../core/node.h"
+#include "../core/perf_metrics.h"
+#include "../core/render_context.h"
+#include "../image/image_buffer.h"
+#include <algorithm>
+
+namespace FLEXIMG_NAMESPACE {
+
+// ========================================================================
+// SharedNode - 共有出力ノード（DAG用、スキャンラインメモ化）
+// ========================================================================
+//
+// 1つの上流サブツリーの出力を複数の下流ノードで共有します。
+// グラフは原則として木構造に制限されていますが（docs/ideas/IDEA_DAG_PROHIBITION.md）、
+// SharedNode を明示的に挟んだ場合に限り DAG を構成できます。
+// - 入力: 1ポート
+// - 出力: コンストラクタで指定（デフォルト2）、各出力ポートに下流を1つずつ接続
+//
+// 動作:
+// - 直前のリクエストと同じ行で、そのX範囲に包含される RenderRequest は上流を
+//   再評価せず、メモ化した Response のバッファを参照モードで返す（重複計算なし）
+//   （下流ごとにデータ範囲へ絞り込んだリクエストもヒットする）
+// - 接続済みの全出力に配布した時点、または異なるリクエストが来た時点で
+//   メモの自身の参照を返却する（保持するのは常に1行分）
+// - 下流が受け取るのは参照モードImageBuffer（ownsMemory()==false）のため、
+//   変更したい下流は DistributorNode と同様にコピーを作成する
+//
+// 参照カウント:
+// - メモ化した Response は RenderContext の参照カウントで保持する
+//   （RenderContext::acquireSharedResponse）
+// - 下流が返却するまでメモは解放されないため、差し替え後も旧メモを参照中の
+//   下流は安全に読み出せる
+// - resetScanlineResources() で全参照は一括解放され、メモも無効化される
+//
+// 制約:
+// - prepare は最初に到達した下流の PrepareRequest で1回だけ行われる
+//   （2本目以降は Node::pullPrepare のDAG共有処理で結果を再利用）。
+//   分岐ごとに異なるアフィン変換を上流へ伝播する構成は不可
+//   （変換は SharedNode の上流側に置くこと）
+// - 下流が異なる行を交互に要求する場合（VerticalBlurNode の先読み等）や、
+//   狭いリクエストの後に広いリクエストが来る場合はメモがヒットせず
+//   上流を再評価する（結果は正しい）
+//
+// 使用例:
+//   SharedNode shared(2);
+//   bgSource >> blur >> shared;
+//   shared.connectTo(composite1, 0, 0);  // 出力0 → composite1
+//   shared.connectTo(composite2, 1, 1);  // 出力1 → composite2 の入力1
+//
+
+class SharedNode : public Node {
+public:
+    explicit SharedNode(int outputCount = 2) {
+        initPorts(1, outputCount);  // 入力1、出力N
+    }
+
+    // ========================================
+    // 出力管理（DistributorNode::setOutputCount と同様）
+    // ========================================
+
+    // 出力数を変更（既存接続は維持）
+    void setOutputCount(int_fast16_t count) {
+        if (count < 1) count = 1;
+        outputs_.resize(static_cast<size_t>(count));
+        for (int i = 0; i < count; ++i) {
+            if (outputs_[static_cast<size_t>(i)].owner == nullptr) {
+                outputs_[static_cast<size_t>(i)] = core::Port(this, i);
+            }
+        }
+    }
+
+    int outputCount() const {
+        return static_cast<int>(outputs_.size());
+    }
+
+    // ========================================
+    // 統計（メモのヒット/ミス回数、prepare時にリセット）
+    // ========================================
+
+    uint32_t hitCount() const { return hitCount_; }
+    uint32_t missCount() const { return missCount_; }
+
+    // ========================================
+    // Node インターフェース
+    // ========================================
+
+    const char* name() const override { return "SharedNode"; }
+    int nodeTypeForMetrics() const override { return NodeType::Shared; }
+
+    // getDataSegments: 上流のセグメントをパススルー
+    int_fast16_t getDataSegments(const RenderRequest& request,
+                                 DataRange* segments, int_fast16_t maxCount) const override {
+        Node* upstream = upstreamNode(0);
+        return upstream ? upstream->getDataSegments(request, segments, maxCount) : 0;
+    }
+
+protected:
+    PrepareResponse onPullPrepare(const PrepareRequest& request) override;
+    RenderResponse& onPullProcess(const RenderRequest& request) override;
+    void onPullFinalize() override;
+
+private:
+    RenderResponse* memo_ = nullptr;  // メモ化した上流Response（RenderContext所有）
+    uint32_t memoEpoch_ = 0;          // メモ取得時のスキャンライン世代
+    Point memoOrigin_;
+    int16_t memoWidth_ = 0;
+    int16_t memoHeight_ = 0;
+    int servedCount_ = 0;             // 現在のメモを配布した回数
+    uint32_t hitCount_ = 0;
+    uint32_t missCount_ = 0;
+
+    // メモが現在のスキャンラインで有効か
+    bool memoAlive() const {
+        return memo_ && context_ && memoEpoch_ == context_->scanlineEpoch();
+    }
+
+    // メモが request を包含するか（同一行・同一ピクセルグリッドでX範囲を包含）
+    bool memoCovers(const RenderRequest& request) const {
+        if (!memoAlive()) return false;
+        if (memoOrigin_.y != request.origin.y || memoHeight_ != request.height) return false;
+        const int_fixed dx = request.origin.x - memoOrigin_.x;
+        if ((dx & (INT_FIXED_ONE - 1)) != 0) return false;
+        const int offset = from_fixed(dx);
+        return offset >= 0 && offset + request.width <= memoWidth_;
+    }
+
+    // 接続済みの出力ポート数
+    int connectedOutputCount() const {
+        int count = 0;
+        for (int i = 0; i < outputCount(); ++i) {
+            if (downstreamNode(i)) ++count;
+        }
+        return count;
+    }
+};
+
+} // namespace FLEXIMG_NAMESPACE
+
+// =============================================================================
+// 実装部
+// =============================================================================
+#ifdef FLEXIMG_IMPLEMENTATION
+
+namespace FLEXIMG_NAMESPACE {
+
+// ============================================================================
+// SharedNode - Template Method フック実装
+// ============================================================================
+
+PrepareResponse SharedNode::onPullPrepare(const PrepareRequest& request) {
+    memo_ = nullptr;
+    hitCount_ = 0;
+    missCount_ = 0;
+    return Node::onPullPrepare(request);
+}
+
+void SharedNode::onPullFinalize() {
+    // メモはRenderContextのスキャンライン解放で返却済み
+    memo_ = nullptr;
+    finalize();
+    Node* upstream = upstreamNode(0);
+    if (upstream) {
+        upstream->pullFinalize();
+    }
+}
+
+RenderResponse& SharedNode::onPullProcess(const RenderRequest& request) {
+    Node* upstream = upstreamNode(0);
+    if (!upstream) return makeEmptyResponse(request.origin);
+
+    if (memoCovers(request)) {
+        ++hitCount_;
+        ++servedCount_;
+    } else {
+        ++missCount_;
+        // 旧メモの自身の参照を返却（下流が参照中なら保持される）
+        if (memoAlive()) {
+            context_->releaseResponse(*memo_);
+        }
+        memo_ = &upstream->pullProcess(request);
+        memoEpoch_ = context_->scanlineEpoch();
+        memoOrigin_ = request.origin;
+        memoWidth_ = request.width;
+        memoHeight_ = request.height;
+        servedCount_ = 1;
+    }
+
+    FLEXIMG_METRICS_SCOPE(NodeType::Shared);
+
+    // メモを参照する Response を作成（参照モード、メモリ確保なし）
+    RenderResponse& resp = context_->acquireSharedResponse(*memo_);
+    resp.origin = request.origin;
+    if (memo_->isValid()) {
+        // メモのバッファを request のX範囲に切り出す
+        const ImageBuffer& src = memo_->buffer();
+        const int offset = from_fixed(request.origin.x - memo_->origin.x);
+        const int start = std::max(0, offset);
+        const int end = std::min<int>(src.width(), offset + request.width);
+        if (start < end) {
+            // セグメント（疎バッファ）は切り出し範囲に合わせて詰め直す
+            const DataRange* segs = memo_->segments();
+            int_fast16_t segCount = memo_->segmentCount();
+            if (segCount > 0 && (start > 0 || end < src.width())) {
+                DataRange* clipped = context_->acquireSegments(static_cast<int>(segCount));
+                if (clipped) {
+                    int_fast16_t n = 0;
+                    for (int_fast16_t i = 0; i < segCount; ++i) {
+                        const int s = std::max<int>(segs[i].startX, start) - start;
+                        const int e = std::min<int>(segs[i].endX, end) - start;
+                        if (s < e) {
+                            clipped[n++] = DataRange{static_cast<int16_t>(s), static_cast<int16_t>(e)};
+                        }
+                    }
+                    segs = clipped;
+                    segCount = n;
+                } else {
+                    // セグメントプール枯渇: メモをゼロ埋めして通常バッファとして扱う
+                    consolidateIfNeeded(*memo_, nullptr);
+                    segs = nullptr;
+                    segCount = 0;
+                }
+            }
+            if (!segs || segCount > 0) {
+                ImageBuffer ref(src.subView(static_cast<int_fast16_t>(start), 0,
+                                            static_cast<int_fast16_t>(end - start), src.height()));
+                ref.auxInfo() = src.auxInfo();
+                const Point origin = {memo_->origin.x + to_fixed(start), memo_->origin.y};
+                ref.setOrigin(origin);
+                resp.addBuffer(std::move(ref));
+                resp.origin = origin;
+                resp.setSegments(segs, segCount);
+            }
+        }
+    }
+
+    // 全出力に配布済み: 自身の参照を返却（残りは下流の返却時に解放）
+    if (servedCount_ >= connectedOutputCount()) {
+        context_->releaseResponse(*memo_);
+        memo_ = nullptr;
+    }
+    return resp;
+}
+
+} // namespace FLEXIMG_NAMESPACE
+
+#endif // FLEXIMG_IMPLEMENTATION
+
+#endif // FLEXIMG_SHARED_NODE_H
@@ -71,6 +71,7 @@ public:
     int16_t canvasHeight() const { return target_.height; }
 
     const char* name() const override { return "SinkNode"; }
+    uint32_t generation() const override { return Node::generation() + matrixGeneration(); }
 
 protected:
     int nodeTypeForMetrics() const override { return NodeType::Sink; }
@@ -206,8 +207,13 @@ void SinkNode::onPushProcess(RenderResponse& input,
 
     FLEXIMG_METRICS_SCOPE(NodeType::Sink);
 
-    // フォーマット変換を実行
-    consolidateIfNeeded(input, target_.formatID);
+    // 疎バッファ（有効セグメント付き）はセグメント内のみを直接変換書き込みする
+    // アフィン変換時はゼロ埋め・フォーマット変換して通常のバッファとして扱う
+    const bool segmented = input.hasSegments() && !hasAffine_;
+    if (!segmented) {
+        // フォーマット変換を実行
+        consolidateIfNeeded(input, target_.formatID);
+    }
 
     // アフィン変換が伝播されている場合はDDA処理
     if (hasAffine_) {
@@ -240,12 +246,30 @@ void SinkNode::onPushProcess(RenderResponse& input,
         inputView.formatID, target_.formatID,
         &input.buffer().auxInfo());
 
-    if (converter) {
+    if (!converter) return;
+
+    if (segmented) {
+        // セグメントとクリップ範囲 [srcX, srcX + copyW) の交差部分のみ書き込み
+        // （セグメント外のターゲット画素は変更しない）
+        const int_fast32_t clipEnd = srcX + copyW;
         for (int_fast32_t y = 0; y < copyH; ++y) {
-            const void* srcRow = inputView.pixelAt(srcX, srcY + static_cast<int>(y));
-            void* dstRow = target_.pixelAt(dstX, dstY + static_cast<int>(y));
-            converter(dstRow, srcRow, static_cast<int>(copyW));
+            for (int_fast16_t k = 0; k < input.segmentCount(); ++k) {
+                const DataRange& seg = input.segments()[k];
+                const int_fast32_t s = std::max<int_fast32_t>(seg.startX, srcX);
+                const int_fast32_t e = std::min<int_fast32_t>(seg.endX, clipEnd);
+                if (s >= e) continue;
+                const void* srcRow = inputView.pixelAt(static_cast<int>(s), static_cast<int>(srcY + y));
+                void* dstRow = target_.pixelAt(static_cast<int>(dstX + s - srcX), static_cast<int>(dstY + y));
+                converter(dstRow, srcRow, static_cast<size_t>(e - s));
+            }
         }
+        return;
+    }
+
+    for (int_fast32_t y = 0; y < copyH; ++y) {
+        const void* srcRow = inputView.pixelAt(srcX, srcY + static_cast<int>(y));
+        void* dstRow = target_.pixelAt(dstX, dstY + static_cast<int>(y));
+        converter(dstRow, srcRow, static_cast<int>(copyW));
     }
 }
 
@@ -4,6 +4,7 @@
 #include "../core/node.h"
 #include "../core/affine_capability.h"
 #include "../core/perf_metrics.h"
+#include "../core/warp_mesh.h"
 #include "../image/viewport.h"
 #include "../image/image_buffer.h"
 #include "../operations/transform.h"
@@ -19,7 +20,8 @@ namespace FLEXIMG_NAMESPACE {
 
 enum class InterpolationMode {
     Nearest,   // 最近傍補間（デフォルト）
-    Bilinear   // バイリニア補間（RGBA8888のみ対応）
+    Bilinear,  // バイリニア補間（RGBA8888のみ対応）
+    EdgeAA     // 最近傍 + 境界ピクセルのみカバレッジαで補間（アフィン変換時のみ有効）
 };
 
 // ========================================================================
@@ -37,6 +39,23 @@ enum class InterpolationMode {
 //
 // setPosition() は setTranslation() のエイリアスとして提供（後方互換）
 //
+// 射影変換（PerspectiveNodeから伝播）:
+// - kPerspectiveSpan ピクセルごとに正確な除算でソース座標を求め、
+//   スパン内は線形DDA（copyRowDDA / copyRowDDABilinear）で補間する
+// - getDataRange はスキャンラインごとに射影を厳密に解いた範囲を返す
+//
+// ワープ（WarpNodeから伝播）:
+// - kWarpSpan ピクセルごとにメッシュ写像を正確に評価し、
+//   スパン内は線形DDAで補間する（スパン内でソース外に出る部分は透明）
+// - getDataRange はメッシュ外接矩形から求めた範囲を返す
+//
+// エッジAA（InterpolationMode::EdgeAA）:
+// - 内部は最近傍DDAのまま、ソース矩形の辺にかかる境界ピクセルのみ
+//   辺からの距離（出力ピクセル単位）に応じたカバレッジをαに乗算する
+// - フェード有効な辺（setEdgeFade）のみAAを適用し、出力範囲を遷移幅分拡張
+// - αを持たない形式の行はRGBA8_Straightに変換して出力（境界ピクセルがある行のみ）
+// - 射影変換・ワープ時は最近傍として扱う
+//
 
 class SourceNode : public Node, public AffineCapability {
 public:
@@ -51,17 +70,19 @@ public:
     }
 
     // ソース設定
-    void setSource(const ViewPort& vp) { source_ = vp; palette_ = PaletteData(); }
+    void setSource(const ViewPort& vp) { source_ = vp; palette_ = PaletteData(); markModified(); }
     void setSource(const ViewPort& vp, const PaletteData& palette) {
         source_ = vp;
         palette_ = palette;
+        markModified();
     }
 
     // 基準点設定（pivot: 画像内のアンカーポイント）
-    void setPivot(int_fixed x, int_fixed y) { pivotX_ = x; pivotY_ = y; }
+    void setPivot(int_fixed x, int_fixed y) { pivotX_ = x; pivotY_ = y; markModified(); }
     void setPivot(float x, float y) {
         pivotX_ = float_to_fixed(x);
         pivotY_ = float_to_fixed(y);
+        markModified();
     }
 
     // アクセサ
@@ -84,23 +105,26 @@ public:
     void setColorKey(uint32_t colorKeyRGBA8, uint32_t replaceRGBA8 = 0) {
         colorKeyRGBA8_ = colorKeyRGBA8;
         colorKeyReplace_ = replaceRGBA8;
+        markModified();
     }
     void clearColorKey() {
         colorKeyRGBA8_ = 0;
         colorKeyReplace_ = 0;
+        markModified();
     }
 
     // 補間モード設定
-    void setInterpolationMode(InterpolationMode mode) { interpolationMode_ = mode; }
+    void setInterpolationMode(InterpolationMode mode) { interpolationMode_ = mode; markModified(); }
     InterpolationMode interpolationMode() const { return interpolationMode_; }
 
-    // エッジフェードアウト設定（バイリニア補間時のみ有効）
+    // エッジフェードアウト設定（バイリニア補間・エッジAA時のみ有効）
     // フェード有効な辺では出力範囲が0.5ピクセル拡張され、境界がなめらかに透明化
     // フェード無効な辺では出力範囲はNearestと同じ、境界ピクセルはクランプ
-    void setEdgeFade(uint8_t flags) { edgeFadeFlags_ = flags; }
+    void setEdgeFade(uint8_t flags) { edgeFadeFlags_ = flags; markModified(); }
     uint8_t edgeFade() const { return edgeFadeFlags_; }
 
     const char* name() const override { return "SourceNode"; }
+    uint32_t generation() const override { return Node::generation() + matrixGeneration(); }
 
     // ========================================
     // Template Method フック
@@ -119,6 +143,12 @@ public:
     // AABB上限が必要な場合は getDataRangeBounds() を使用
     DataRange getDataRange(const RenderRequest& request) const override;
 
+    // 射影変換時の透視補正間隔（この間隔ごとに正確な除算を行う）
+    static constexpr int_fast16_t kPerspectiveSpan = 16;
+
+    // ワープ時のメッシュ評価間隔（この間隔ごとに写像を正確に評価する）
+    static constexpr int_fast16_t kWarpSpan = 16;
+
 private:
     ViewPort source_;
     PaletteData palette_;   // パレット情報（インデックスフォーマット用、非所有）
@@ -134,6 +164,14 @@ private:
     AffinePrecomputed affine_;     // 逆行列・ピクセル中心オフセット
     bool hasAffine_ = false;       // アフィン変換が伝播されているか
     bool useBilinear_ = false;     // バイリニア補間を使用するか（事前計算結果）
+    bool useEdgeAA_ = false;       // エッジAAを使用するか（事前計算結果）
+
+    // エッジAA: 各辺のカバレッジ遷移幅の半分（ソース座標系、Q16.16）
+    // 出力1ピクセルでαが0→1に変化するよう |∇u|/2, |∇v|/2 から求める（AA無効な辺は0）
+    int_fixed edgeAALeft_ = 0;
+    int_fixed edgeAARight_ = 0;
+    int_fixed edgeAATop_ = 0;
+    int_fixed edgeAABottom_ = 0;
 
     // フォーマット交渉（下流からの希望フォーマット）
     PixelFormatID preferredFormat_ = PixelFormatIDs::RGBA8_Straight;
@@ -150,6 +188,16 @@ private:
     int_fixed prepareOriginX_ = 0;
     int_fixed prepareOriginY_ = 0;
 
+    // 射影変換用（PerspectiveNodeから伝播、事前計算済み）
+    // ワールド座標 → ソースピクセル座標（pivot込み）の逆射影行列
+    PerspectiveMatrix invPerspective_;
+    bool hasPerspective_ = false;    // 射影変換が伝播されているか
+    bool perspectiveValid_ = false;  // 逆射影行列が有効か（特異行列でないか）
+
+    // ワープ用（WarpNodeから伝播、非所有）
+    // 有効時、invPerspective_ はワープ後の座標 → ソースピクセル座標を表す
+    const WarpField* warp_ = nullptr;
+
     // getDataRangeキャッシュ（同一スキャンラインでの重複計算を回避）
     // NinePatchSourceNode等から同一requestで複数回呼ばれるケースに対応
     mutable struct {
@@ -169,6 +217,44 @@ private:
 
     // アフィン変換付きプル処理（スキャンライン専用）
     RenderResponse& pullProcessWithAffine(const RenderRequest& request);
+
+    // エッジAA: 内部区間は最近傍DDA、境界ピクセルはソース端にクランプして転写
+    // innerStart/innerEnd: カバレッジ1の内部区間（バッファ内位置）
+    void copyRowEdgeAA(uint8_t* dstRow, int32_t count, int_fixed srcX, int_fixed srcY,
+                       int32_t& innerStart, int32_t& innerEnd) const;
+
+    // エッジAA: 境界ピクセルにカバレッジαを乗算（必要ならRGBA8_Straightへ変換）
+    void applyEdgeCoverage(RenderResponse& resp, int32_t count, int_fixed srcX, int_fixed srcY,
+                           int32_t innerStart, int32_t innerEnd) const;
+
+    // 射影変換の事前計算とAABB算出（onPullPrepareから呼ばれる）
+    PrepareResponse prepareWithPerspective(const PrepareRequest& request,
+                                           const AffineMatrix& combinedMatrix);
+
+    // 射影変換時のスキャンライン有効範囲を計算
+    // 戻り値: true=有効範囲あり, false=有効範囲なし
+    bool calcPerspectiveRange(const RenderRequest& request,
+                              int32_t& dxStart, int32_t& dxEnd) const;
+
+    // 射影変換付きプル処理（スキャンライン専用）
+    RenderResponse& pullProcessWithPerspective(const RenderRequest& request);
+
+    // ワープ時のスキャンライン有効範囲（メッシュ外接矩形から算出）
+    // 戻り値: true=有効範囲あり, false=有効範囲なし
+    bool calcWarpRange(const RenderRequest& request,
+                       int32_t& dxStart, int32_t& dxEnd) const;
+
+    // ワープ付きプル処理（スキャンライン専用）
+    RenderResponse& pullProcessWithWarp(const RenderRequest& request);
+
+    // DDA出力フォーマットを決定（アフィン/射影パス共通）
+    PixelFormatID ddaOutputFormat() const;
+
+    // パレット・カラーキー情報をPixelAuxInfoに詰める（なければnullptr）
+    const PixelAuxInfo* buildSourceAuxInfo(PixelAuxInfo& aux) const;
+
+    // パレット・カラーキー情報を出力ImageBufferに設定
+    void applyOutputAuxInfo(ImageBuffer& buf) const;
 };
 
 } // namespace FLEXIMG_NAMESPACE
@@ -204,8 +290,17 @@ PrepareResponse SourceNode::onPullPrepare(const PrepareRequest& request) {
         combinedMatrix = localMatrix_;  // 無変換時は単位行列
     }
 
+    // 射影変換・ワープが伝播されている場合は専用の事前計算を行う
+    // ワープ時も上流側の行列は逆射影行列として扱う（透視補正パスと共通）
+    warp_ = request.warp;
+    hasPerspective_ = request.hasPerspective || warp_ != nullptr;
+    if (hasPerspective_) {
+        return prepareWithPerspective(request, combinedMatrix);
+    }
+
     // 逆行列とピクセル中心オフセットを計算
     affine_ = precomputeInverseAffine(combinedMatrix);
+    useEdgeAA_ = false;
 
     if (affine_.isValid()) {
         const int32_t invA = affine_.invMatrix.a;
@@ -278,10 +373,34 @@ PrepareResponse SourceNode::onPullPrepare(const PrepareRequest& request) {
             fpWidth_ = source_.width << INT_FIXED_SHIFT;
             fpHeight_ = source_.height << INT_FIXED_SHIFT;
 
-            xs1_ = invA + (invA < 0 ? fpWidth_ : -1);
-            xs2_ = invA + (invA < 0 ? 0 : (fpWidth_ - 1));
-            ys1_ = invC + (invC < 0 ? fpHeight_ : -1);
-            ys2_ = invC + (invC < 0 ? 0 : (fpHeight_ - 1));
+            // エッジAA: AA有効な辺をカバレッジ遷移幅の半分だけ拡張
+            // u = ソースX座標の勾配は (invA, invB)、出力1ピクセルあたり |∇u| 進む
+            useEdgeAA_ = (interpolationMode_ == InterpolationMode::EdgeAA);
+            edgeAALeft_ = edgeAARight_ = edgeAATop_ = edgeAABottom_ = 0;
+            int32_t hpAStart = 0, hpAEnd = 0, hpCStart = 0, hpCEnd = 0;
+            if (useEdgeAA_) {
+                const float gradU = std::sqrt(fixed_to_float(invA) * fixed_to_float(invA)
+                                            + fixed_to_float(invB) * fixed_to_float(invB));
+                const float gradV = std::sqrt(fixed_to_float(invC) * fixed_to_float(invC)
+                                            + fixed_to_float(invD) * fixed_to_float(invD));
+                const int_fixed halfU = float_to_fixed(0.5f * gradU);
+                const int_fixed halfV = float_to_fixed(0.5f * gradV);
+                if (edgeFadeFlags_ & EdgeFade_Left)   edgeAALeft_ = halfU;
+                if (edgeFadeFlags_ & EdgeFade_Right)  edgeAARight_ = halfU;
+                if (edgeFadeFlags_ & EdgeFade_Top)    edgeAATop_ = halfV;
+                if (edgeFadeFlags_ & EdgeFade_Bottom) edgeAABottom_ = halfV;
+
+                // invA/invCの符号によって、どの辺がstart/endに対応するか変わる（バイリニアと同様）
+                hpAStart = invA >= 0 ? edgeAALeft_ : -edgeAARight_;
+                hpAEnd   = invA >= 0 ? edgeAARight_ : -edgeAALeft_;
+                hpCStart = invC >= 0 ? edgeAATop_ : -edgeAABottom_;
+                hpCEnd   = invC >= 0 ? edgeAABottom_ : -edgeAATop_;
+            }
+
+            xs1_ = invA + (invA < 0 ? fpWidth_ : -1) - hpAStart;
+            xs2_ = invA + (invA < 0 ? 0 : (fpWidth_ - 1)) + hpAEnd;
+            ys1_ = invC + (invC < 0 ? fpHeight_ : -1) - hpCStart;
+            ys2_ = invC + (invC < 0 ? 0 : (fpHeight_ - 1)) + hpCEnd;
 
             useBilinear_ = false;
         }
@@ -302,7 +421,7 @@ PrepareResponse SourceNode::onPullPrepare(const PrepareRequest& request) {
         // バイリニア補間時はedgeFade等の処理にDDAが必要なためスキップしない
         constexpr int_fixed one = 1 << INT_FIXED_SHIFT;
         bool isTranslationOnly =
-            !useBilinear_ &&
+            !useBilinear_ && !useEdgeAA_ &&
             invA == one &&
             invD == one &&
             invB == 0 &&
@@ -333,6 +452,12 @@ PrepareResponse SourceNode::onPullPrepare(const PrepareRequest& request) {
         if (edgeFadeFlags_ & EdgeFade_Right)   { aabbWidth += half; }
         if (edgeFadeFlags_ & EdgeFade_Top)    { aabbHeight += half; aabbPivotY += halfFixed; }
         if (edgeFadeFlags_ & EdgeFade_Bottom) { aabbHeight += half; }
+    } else if (useEdgeAA_) {
+        // エッジAAの遷移領域分を拡張
+        aabbWidth += fixed_to_float(edgeAALeft_ + edgeAARight_);
+        aabbHeight += fixed_to_float(edgeAATop_ + edgeAABottom_);
+        aabbPivotX += edgeAALeft_;
+        aabbPivotY += edgeAATop_;
     }
 
     calcAffineAABB(
@@ -351,6 +476,16 @@ RenderResponse& SourceNode::onPullProcess(const RenderRequest& request) {
         return makeEmptyResponse(request.origin);
     }
 
+    // ワープが伝播されている場合はメッシュ写像によるスパンDDA処理
+    if (warp_) {
+        return pullProcessWithWarp(request);
+    }
+
+    // 射影変換が伝播されている場合は透視補正DDA処理
+    if (hasPerspective_) {
+        return pullProcessWithPerspective(request);
+    }
+
     // アフィン変換が伝播されている場合はDDA処理
     if (hasAffine_) {
         return pullProcessWithAffine(request);
@@ -389,15 +524,8 @@ RenderResponse& SourceNode::onPullProcess(const RenderRequest& request) {
     ImageBuffer result(view_ops::subView(source_, srcX, srcY,
                                          static_cast<int_fast16_t>(validW),
                                          static_cast<int_fast16_t>(validH)));
-    // パレット情報を出力ImageBufferに設定
-    if (palette_) {
-        result.setPalette(palette_);
-    }
-    // カラーキー情報を出力ImageBufferに設定
-    if (colorKeyRGBA8_ != colorKeyReplace_) {
-        result.auxInfo().colorKeyRGBA8 = colorKeyRGBA8_;
-        result.auxInfo().colorKeyReplace = colorKeyReplace_;
-    }
+    // パレット・カラーキー情報を出力ImageBufferに設定
+    applyOutputAuxInfo(result);
 
     // origin = リクエストグリッドに整列（アフィンパスと同形式）
     Point adjustedOrigin = {
@@ -471,7 +599,7 @@ bool SourceNode::calcScanlineRange(const RenderRequest& request,
 // 同一リクエストの重複呼び出しはキャッシュで高速化
 DataRange SourceNode::getDataRange(const RenderRequest& request) const {
     // アフィン変換がない場合はAABBベースで十分（正確）
-    if (!hasAffine_) {
+    if (!hasAffine_ && !hasPerspective_) {
         return prepareResponse_.getDataRange(request);
     }
 
@@ -483,10 +611,13 @@ DataRange SourceNode::getDataRange(const RenderRequest& request) const {
         return dataRangeCache_.range;
     }
 
-    // calcScanlineRangeで正確な有効範囲を計算
+    // calcScanlineRange（射影時はcalcPerspectiveRange、ワープ時はcalcWarpRange）で有効範囲を計算
     int32_t dxStart = 0, dxEnd = 0;
     DataRange result;
-    if (calcScanlineRange(request, dxStart, dxEnd, nullptr, nullptr)) {
+    const bool hasRange = warp_ ? calcWarpRange(request, dxStart, dxEnd)
+        : hasPerspective_ ? calcPerspectiveRange(request, dxStart, dxEnd)
+        : calcScanlineRange(request, dxStart, dxEnd, nullptr, nullptr);
+    if (hasRange) {
         result = DataRange{static_cast<int16_t>(dxStart),
                            static_cast<int16_t>(dxEnd + 1)};
     } else {
@@ -522,24 +653,8 @@ RenderResponse& SourceNode::pullProcessWithAffine(const RenderRequest& request)
     // 空のResponseを取得し、バッファを直接作成（ムーブなし）
     int validWidth = dxEnd - dxStart + 1;
     RenderResponse& resp = makeEmptyResponse(adjustedOrigin);
-    // 出力フォーマット決定:
-    // - 1chバイリニア対応フォーマット（Alpha8等）: ソースフォーマット直接出力
-    // - その他のバイリニア: RGBA8_Straight出力
-    // - 最近傍: ソースフォーマット出力（ただしbit-packedはIndex8に展開）
-    PixelFormatID outFormat;
-    if (useBilinear_) {
-        outFormat = view_ops::canUseSingleChannelBilinear(source_.formatID, edgeFadeFlags_)
-                  ? source_.formatID : PixelFormatIDs::RGBA8_Straight;
-    } else {
-        // bit-packed形式の場合、DDAはIndex8形式で出力するため出力フォーマットをIndex8に
-        if (source_.formatID && source_.formatID->pixelsPerUnit > 1) {
-            outFormat = PixelFormatIDs::Index8;
-        } else {
-            outFormat = source_.formatID;
-        }
-    }
     ImageBuffer* output = resp.createBuffer(
-        validWidth, 1, outFormat, InitPolicy::Uninitialized);
+        validWidth, 1, ddaOutputFormat(), InitPolicy::Uninitialized);
 
     if (!output) {
         return resp;  // バッファ作成失敗時は空のResponseを返す
@@ -571,19 +686,17 @@ RenderResponse& SourceNode::pullProcessWithAffine(const RenderRequest& request)
         constexpr int_fixed halfPixel = 1 << (INT_FIXED_SHIFT - 1);
         // パレット情報をPixelAuxInfoとして渡す（Index8のパレット展開用）
         PixelAuxInfo auxInfo;
-        if (palette_) {
-            auxInfo.palette = palette_.data;
-            auxInfo.paletteFormat = palette_.format;
-            auxInfo.paletteColorCount = palette_.colorCount;
-        }
-        if (colorKeyRGBA8_ != colorKeyReplace_) {
-            auxInfo.colorKeyRGBA8 = colorKeyRGBA8_;
-            auxInfo.colorKeyReplace = colorKeyReplace_;
-        }
-        const PixelAuxInfo* auxPtr = (auxInfo.palette || auxInfo.colorKeyRGBA8 != auxInfo.colorKeyReplace)
-                                   ? &auxInfo : nullptr;
+        const PixelAuxInfo* auxPtr = buildSourceAuxInfo(auxInfo);
         view_ops::copyRowDDABilinear(dstRow, source_, validWidth,
             srcX_fixed + offsetX - halfPixel, srcY_fixed + offsetY - halfPixel, invA, invC, edgeFadeFlags_, auxPtr);
+    } else if (useEdgeAA_) {
+        // エッジAA: 内部は最近傍DDA、境界ピクセルのみカバレッジαを乗算
+        int32_t innerStart = 0, innerEnd = 0;
+        copyRowEdgeAA(static_cast<uint8_t*>(dstRow), validWidth, srcX_fixed, srcY_fixed,
+                      innerStart, innerEnd);
+        applyOutputAuxInfo(*output);
+        applyEdgeCoverage(resp, validWidth, srcX_fixed, srcY_fixed, innerStart, innerEnd);
+        return resp;
     } else {
         // 最近傍補間（BPP分岐は関数内部で実施）
         // view_ops::copyRowDDA(dstRow, source_, validWidth,
@@ -604,16 +717,542 @@ RenderResponse& SourceNode::pullProcessWithAffine(const RenderRequest& request)
        }
     }
 
+    // パレット・カラーキー情報を出力ImageBufferに設定
+    applyOutputAuxInfo(*output);
+
+    return resp;
+}
+
+// ============================================================================
+// SourceNode - エッジAA（InterpolationMode::EdgeAA）
+// ============================================================================
+
+// 内部区間（全辺でカバレッジ1）は最近傍DDAで一括転写し、
+// その外側の境界ピクセルはソース端にクランプした座標で1ピクセルずつ転写する
+void SourceNode::copyRowEdgeAA(uint8_t* dstRow, int32_t count, int_fixed srcX, int_fixed srcY,
+                               int32_t& innerStart, int32_t& innerEnd) const {
+    const int32_t invA = affine_.invMatrix.a;
+    const int32_t invC = affine_.invMatrix.c;
+
+    // カバレッジ1の条件: left <= u <= W - right（AA無効な辺は最近傍の範囲 [0, W)）
+    innerStart = 0;
+    innerEnd = count - 1;
+    transform::clipFixedRange(srcX, invA, edgeAALeft_,
+        fpWidth_ - (edgeAARight_ ? edgeAARight_ : 1), innerStart, innerEnd);
+    transform::clipFixedRange(srcY, invC, edgeAATop_,
+        fpHeight_ - (edgeAABottom_ ? edgeAABottom_ : 1), innerStart, innerEnd);
+
+    if (!source_.formatID || !source_.formatID->copyRowDDA) {
+        return;
+    }
+
+    // ViewPortのx,yオフセットをQ16.16固定小数点に変換
+    const int_fixed offsetX = static_cast<int32_t>(source_.x) << INT_FIXED_SHIFT;
+    const int_fixed offsetY = static_cast<int32_t>(source_.y) << INT_FIXED_SHIFT;
+    const auto bytesPerPixel = static_cast<size_t>(ddaOutputFormat()->bytesPerPixel);
+    const auto* srcData = static_cast<const uint8_t*>(source_.data);
+
+    int32_t t = 0;
+    while (t < count) {
+        if (t == innerStart && innerStart <= innerEnd) {
+            const int32_t len = innerEnd - innerStart + 1;
+            DDAParam param = { source_.stride, source_.width, source_.height,
+                               srcX + invA * t + offsetX, srcY + invC * t + offsetY,
+                               invA, invC, nullptr, nullptr };
+            source_.formatID->copyRowDDA(dstRow + static_cast<size_t>(t) * bytesPerPixel,
+                                         srcData, static_cast<int_fast16_t>(len), &param);
+            t += len;
+            continue;
+        }
+        const int_fixed x = std::min(std::max(srcX + invA * t, 0), fpWidth_ - 1);
+        const int_fixed y = std::min(std::max(srcY + invC * t, 0), fpHeight_ - 1);
+        DDAParam param = { source_.stride, source_.width, source_.height,
+                           x + offsetX, y + offsetY, 0, 0, nullptr, nullptr };
+        source_.formatID->copyRowDDA(dstRow + static_cast<size_t>(t) * bytesPerPixel,
+                                     srcData, 1, &param);
+        ++t;
+    }
+}
+
+// 境界ピクセルのカバレッジ: 各辺について (辺からの内側距離 + h) / 2h を [0, 1] にクランプ
+// （h = 遷移幅の半分、距離はソース座標系。出力ピクセル単位では 0.5 + 距離 に相当）
+void SourceNode::applyEdgeCoverage(RenderResponse& resp, int32_t count,
+                                   int_fixed srcX, int_fixed srcY,
+                                   int32_t innerStart, int32_t innerEnd) const {
+    // 境界ピクセルがなければ変換不要（最近傍と同じ出力）
+    if (innerStart == 0 && innerEnd == count - 1) {
+        return;
+    }
+
+    PixelFormatID fmt = resp.buffer().formatID();
+    if (fmt != PixelFormatIDs::RGBA8_Straight && fmt != PixelFormatIDs::Alpha8) {
+        resp.convertFormat(PixelFormatIDs::RGBA8_Straight);
+        fmt = resp.buffer().formatID();
+        if (fmt != PixelFormatIDs::RGBA8_Straight) {
+            return;  // 変換できない場合はAAなし
+        }
+    }
+
+    // 辺ごとのカバレッジ（0-256）、AA無効な辺は常に256
+    auto edgeCoverage = [](int_fixed dist, int_fixed half) -> int32_t {
+        if (half <= 0) return 256;
+        const int64_t c = (static_cast<int64_t>(dist + half) << 8) / (2 * static_cast<int64_t>(half));
+        return static_cast<int32_t>(std::min<int64_t>(std::max<int64_t>(c, 0), 256));
+    };
+
+    const int32_t invA = affine_.invMatrix.a;
+    const int32_t invC = affine_.invMatrix.c;
+    const bool isAlpha8 = (fmt == PixelFormatIDs::Alpha8);
+    const int32_t alphaOffset = isAlpha8 ? 0 : 3;
+    const int32_t stride = isAlpha8 ? 1 : 4;
+    uint8_t* row = static_cast<uint8_t*>(resp.buffer().data());
+
+    for (int32_t t = 0; t < count; ++t) {
+        if (t == innerStart && innerStart <= innerEnd) {
+            t = innerEnd;
+            continue;
+        }
+        const int_fixed u = srcX + invA * t;
+        const int_fixed v = srcY + invC * t;
+        int32_t cov = edgeCoverage(u, edgeAALeft_);
+        cov = (cov * edgeCoverage(fpWidth_ - u, edgeAARight_)) >> 8;
+        cov = (cov * edgeCoverage(v, edgeAATop_)) >> 8;
+        cov = (cov * edgeCoverage(fpHeight_ - v, edgeAABottom_)) >> 8;
+        uint8_t& a = row[t * stride + alphaOffset];
+        a = static_cast<uint8_t>((a * cov) >> 8);
+    }
+}
+
+// ============================================================================
+// SourceNode - 出力フォーマット・補助情報ヘルパー
+// ============================================================================
+
+// 出力フォーマット決定:
+// - 1chバイリニア対応フォーマット（Alpha8等）: ソースフォーマット直接出力
+// - その他のバイリニア: RGBA8_Straight出力
+// - 最近傍: ソースフォーマット出力（ただしbit-packedはIndex8に展開）
+PixelFormatID SourceNode::ddaOutputFormat() const {
+    if (useBilinear_) {
+        return view_ops::canUseSingleChannelBilinear(source_.formatID, edgeFadeFlags_)
+             ? source_.formatID : PixelFormatIDs::RGBA8_Straight;
+    }
+    // bit-packed形式の場合、DDAはIndex8形式で出力するため出力フォーマットをIndex8に
+    if (source_.formatID && source_.formatID->pixelsPerUnit > 1) {
+        return PixelFormatIDs::Index8;
+    }
+    return source_.formatID;
+}
+
+const PixelAuxInfo* SourceNode::buildSourceAuxInfo(PixelAuxInfo& aux) const {
+    if (palette_) {
+        aux.palette = palette_.data;
+        aux.paletteFormat = palette_.format;
+        aux.paletteColorCount = palette_.colorCount;
+    }
+    if (colorKeyRGBA8_ != colorKeyReplace_) {
+        aux.colorKeyRGBA8 = colorKeyRGBA8_;
+        aux.colorKeyReplace = colorKeyReplace_;
+    }
+    return (aux.palette || aux.colorKeyRGBA8 != aux.colorKeyReplace) ? &aux : nullptr;
+}
+
+void SourceNode::applyOutputAuxInfo(ImageBuffer& buf) const {
     // パレット情報を出力ImageBufferに設定
     if (palette_) {
-        output->setPalette(palette_);
+        buf.setPalette(palette_);
     }
     // カラーキー情報を出力ImageBufferに設定
     if (colorKeyRGBA8_ != colorKeyReplace_) {
-        output->auxInfo().colorKeyRGBA8 = colorKeyRGBA8_;
-        output->auxInfo().colorKeyReplace = colorKeyReplace_;
+        buf.auxInfo().colorKeyRGBA8 = colorKeyRGBA8_;
+        buf.auxInfo().colorKeyReplace = colorKeyReplace_;
+    }
+}
+
+// ============================================================================
+// SourceNode - 射影変換（PerspectiveNode伝播時）
+// ============================================================================
+
+PrepareResponse SourceNode::prepareWithPerspective(const PrepareRequest& request,
+                                                   const AffineMatrix& combinedMatrix) {
+    // 合成: 射影 * (下流アフィン * ローカル行列)
+    // ワープのみの場合は射影成分なし（ワープ後の座標 → ローカル座標の逆写像に使用）
+    const PerspectiveMatrix forward = request.hasPerspective
+        ? request.perspectiveMatrix * combinedMatrix : PerspectiveMatrix(combinedMatrix);
+
+    useBilinear_ = (interpolationMode_ == InterpolationMode::Bilinear)
+                && source_.formatID
+                && source_.formatID->copyQuadDDA;
+    useEdgeAA_ = false;  // 射影変換・ワープ時は最近傍として扱う
+    hasAffine_ = true;  // 平行移動のみの高速パス（subView参照）は使用しない
+    fpWidth_ = source_.width << INT_FIXED_SHIFT;
+    fpHeight_ = source_.height << INT_FIXED_SHIFT;
+
+    const float pivotX = fixed_to_float(pivotX_);
+    const float pivotY = fixed_to_float(pivotY_);
+
+    PerspectiveMatrix inv;
+    perspectiveValid_ = forward.inverse(inv);
+    if (perspectiveValid_) {
+        // ローカル座標（pivot基準）→ ソースピクセル座標への平行移動を合成
+        invPerspective_ = PerspectiveMatrix(1, 0, pivotX, 0, 1, pivotY, 0, 0, 1) * inv;
+    }
+
+    PrepareResponse result;
+    result.status = PrepareStatus::Prepared;
+    result.preferredFormat = source_.formatID;
+
+    // AABB: ソース矩形の4角を射影
+    // 1点でも視点の背後（w <= 0）にある場合、投影像は有界にならないため
+    // スクリーン全体を上限とする（スキャンライン単位の範囲はgetDataRangeで厳密化）
+    const float left = -pivotX;
+    const float top = -pivotY;
+    const float right = left + static_cast<float>(source_.width);
+    const float bottom = top + static_cast<float>(source_.height);
+    const float cornersX[4] = {left, right, right, left};
+    const float cornersY[4] = {top, top, bottom, bottom};
+
+    // int16_t座標に収めるためのクランプ範囲
+    constexpr float coordLimit = 16383.0f;
+    float minX = coordLimit, minY = coordLimit;
+    float maxX = -coordLimit, maxY = -coordLimit;
+    bool bounded = perspectiveValid_;
+    if (warp_) {
+        // ワープ時はメッシュ外接矩形がAABB（メッシュ外は出力されない）
+        bounded = bounded && warp_->bounds(minX, minY, maxX, maxY);
+    }
+    for (int_fast8_t i = 0; i < 4 && bounded && !warp_; ++i) {
+        const float x = cornersX[i], y = cornersY[i];
+        const float w = forward.g * x + forward.h * y + forward.i;
+        if (w <= 1e-6f) {
+            bounded = false;
+            break;
+        }
+        const float px = (forward.a * x + forward.b * y + forward.tx) / w;
+        const float py = (forward.c * x + forward.d * y + forward.ty) / w;
+        minX = std::min(minX, px); maxX = std::max(maxX, px);
+        minY = std::min(minY, py); maxY = std::max(maxY, py);
+    }
+
+    if (bounded) {
+        minX = std::max(minX, -coordLimit); maxX = std::min(maxX, coordLimit);
+        minY = std::max(minY, -coordLimit); maxY = std::min(maxY, coordLimit);
+        const float minXf = std::floor(minX);
+        const float minYf = std::floor(minY);
+        result.width = static_cast<int16_t>(std::max(0.0f, std::ceil(maxX) - minXf));
+        result.height = static_cast<int16_t>(std::max(0.0f, std::ceil(maxY) - minYf));
+        result.origin = {to_fixed(static_cast<int>(minXf)), to_fixed(static_cast<int>(minYf))};
+    } else if (perspectiveValid_) {
+        result.width = request.width;
+        result.height = request.height;
+        result.origin = request.origin;
+    }
+    return result;
+}
+
+// 射影変換時のスキャンライン有効範囲
+// 出力ピクセル中心 (x0 + dx, y) に対する逆射影 (u, v, w) は dx の1次式なので、
+// 「w > 0 かつ 0 <= u/w < srcW かつ 0 <= v/w < srcH」は
+// w を掛けた1次不等式5本に帰着し、その共通部分（区間）を解析的に求められる
+bool SourceNode::calcPerspectiveRange(const RenderRequest& request,
+                                      int32_t& dxStart, int32_t& dxEnd) const {
+    if (!perspectiveValid_) {
+        return false;
+    }
+
+    const PerspectiveMatrix& m = invPerspective_;
+    const float x0 = fixed_to_float(request.origin.x) + 0.5f;
+    const float y = fixed_to_float(request.origin.y) + 0.5f;
+    const float uq = m.a * x0 + m.b * y + m.tx;
+    const float vq = m.c * x0 + m.d * y + m.ty;
+    const float wq = m.g * x0 + m.h * y + m.i;
+    const float srcW = static_cast<float>(source_.width);
+    const float srcH = static_cast<float>(source_.height);
+
+    float lo = 0.0f;
+    float hi = static_cast<float>(request.width - 1);
+
+    // 不等式 a * dx + b >= 0（strict時は > 0）で区間を絞り込む
+    using transform::clipLinearRange;
+    clipLinearRange(m.g, wq, true, lo, hi);                                // w > 0（視点の手前）
+    clipLinearRange(m.a, uq, false, lo, hi);                               // u >= 0
+    clipLinearRange(srcW * m.g - m.a, srcW * wq - uq, true, lo, hi);       // u < srcW * w
+    clipLinearRange(m.c, vq, false, lo, hi);                               // v >= 0
+    clipLinearRange(srcH * m.g - m.c, srcH * wq - vq, true, lo, hi);       // v < srcH * w
+
+    if (lo > hi) {
+        return false;
+    }
+    dxStart = static_cast<int32_t>(lo);
+    dxEnd = static_cast<int32_t>(hi);
+    return true;
+}
+
+// 射影変換付きプル処理（スキャンライン専用）
+// kPerspectiveSpan ピクセルごとにソース座標を正確に除算で求め、
+// スパン内は既存のDDAカーネルで線形補間する（アフィンパスに近いコスト）
+RenderResponse& SourceNode::pullProcessWithPerspective(const RenderRequest& request) {
+    int32_t dxStart = 0, dxEnd = 0;
+    if (!calcPerspectiveRange(request, dxStart, dxEnd)) {
+        return makeEmptyResponse(request.origin);
+    }
+
+    Point adjustedOrigin = {
+        request.origin.x + to_fixed(dxStart),
+        request.origin.y
+    };
+
+    int validWidth = dxEnd - dxStart + 1;
+    RenderResponse& resp = makeEmptyResponse(adjustedOrigin);
+    PixelFormatID outFormat = ddaOutputFormat();
+    ImageBuffer* output = resp.createBuffer(
+        validWidth, 1, outFormat, InitPolicy::Uninitialized);
+    if (!output) {
+        return resp;
+    }
+    output->setOrigin(adjustedOrigin);
+
+#ifdef FLEXIMG_DEBUG_PERF_METRICS
+    PerfMetrics::instance().nodes[NodeType::Source].recordAlloc(
+        output->totalBytes(), output->width(), output->height());
+#endif
+
+    // 逆射影の dx に関する1次式係数（calcPerspectiveRange と同一）
+    const PerspectiveMatrix& m = invPerspective_;
+    const float x0 = fixed_to_float(request.origin.x) + 0.5f;
+    const float y = fixed_to_float(request.origin.y) + 0.5f;
+    const float uq = m.a * x0 + m.b * y + m.tx;
+    const float vq = m.c * x0 + m.d * y + m.ty;
+    const float wq = m.g * x0 + m.h * y + m.i;
+    const float srcW = static_cast<float>(source_.width);
+    const float srcH = static_cast<float>(source_.height);
+
+    // 正確なソース座標（Q16.16）を求める
+    // 範囲境界の浮動小数点誤差に備えてソース矩形内にクランプする
+    auto project = [&](int32_t dx, int_fixed& fx, int_fixed& fy) {
+        const auto fdx = static_cast<float>(dx);
+        const float invW = 1.0f / (m.g * fdx + wq);
+        const float sx = std::min(std::max((m.a * fdx + uq) * invW, 0.0f), srcW);
+        const float sy = std::min(std::max((m.c * fdx + vq) * invW, 0.0f), srcH);
+        fx = std::min(float_to_fixed(sx), fpWidth_ - 1);
+        fy = std::min(float_to_fixed(sy), fpHeight_ - 1);
+    };
+
+    uint8_t* dstRow = static_cast<uint8_t*>(output->data());
+    const auto dstBytesPerPixel = static_cast<size_t>(outFormat->bytesPerPixel);
+
+    PixelAuxInfo auxInfo;
+    const PixelAuxInfo* auxPtr = useBilinear_ ? buildSourceAuxInfo(auxInfo) : nullptr;
+    constexpr int_fixed halfPixel = 1 << (INT_FIXED_SHIFT - 1);
+
+    // ViewPortのx,yオフセット（最近傍DDA用、バイリニアは関数内部で加算）
+    int_fixed offsetX = static_cast<int32_t>(source_.x) << INT_FIXED_SHIFT;
+    int_fixed offsetY = static_cast<int32_t>(source_.y) << INT_FIXED_SHIFT;
+
+    int_fixed curX = 0, curY = 0;
+    project(dxStart, curX, curY);
+    int32_t dx = dxStart;
+    while (dx <= dxEnd) {
+        const int32_t len = std::min<int32_t>(kPerspectiveSpan, dxEnd - dx + 1);
+
+        // スパン終端の正確な座標（次スパンの始点と共有、除算はスパンあたり1回）
+        // 最終スパンは範囲内の末尾ピクセルを終端とし、範囲外の座標を補間に使わない
+        int_fixed nextX = curX, nextY = curY;
+        int32_t steps = len;
+        if (dx + len <= dxEnd) {
+            project(dx + len, nextX, nextY);
+        } else {
+            steps = len - 1;
+            if (steps > 0) project(dxEnd, nextX, nextY);
+        }
+        const int_fixed incrX = steps ? (nextX - curX) / steps : 0;
+        const int_fixed incrY = steps ? (nextY - curY) / steps : 0;
+
+        if (useBilinear_) {
+            view_ops::copyRowDDABilinear(dstRow, source_, static_cast<int_fast16_t>(len),
+                curX - halfPixel, curY - halfPixel, incrX, incrY, edgeFadeFlags_, auxPtr);
+        } else if (source_.formatID && source_.formatID->copyRowDDA) {
+            DDAParam param = { source_.stride, source_.width, source_.height,
+                               curX + offsetX, curY + offsetY, incrX, incrY, nullptr, nullptr };
+            source_.formatID->copyRowDDA(dstRow, static_cast<const uint8_t*>(source_.data),
+                                         static_cast<int_fast16_t>(len), &param);
+        }
+
+        dstRow += static_cast<size_t>(len) * dstBytesPerPixel;
+        curX = nextX;
+        curY = nextY;
+        dx += len;
+    }
+
+    applyOutputAuxInfo(*output);
+    return resp;
+}
+
+// ============================================================================
+// SourceNode - ワープ（WarpNode伝播時）
+// ============================================================================
+
+// ワープ時のスキャンライン有効範囲
+// メッシュ外接矩形（ワールド座標へ射影したもの）とスキャンラインの交差区間
+bool SourceNode::calcWarpRange(const RenderRequest& request,
+                               int32_t& dxStart, int32_t& dxEnd) const {
+    if (!perspectiveValid_) {
+        return false;
+    }
+    const float x0 = fixed_to_float(request.origin.x) + 0.5f;
+    const float y = fixed_to_float(request.origin.y) + 0.5f;
+    return warp_->scanlineRange(x0, y, request.width, dxStart, dxEnd);
+}
+
+// ワープ付きプル処理（スキャンライン専用）
+// スパン（最大 kWarpSpan ピクセル、軸平行時はメッシュのセル境界でも分割）の
+// 両端でメッシュ写像を正確に評価し、スパン内は既存のDDAカーネルで線形補間する
+// スパン内でソース矩形外に出る部分は解析的に除外し、透明として扱う
+RenderResponse& SourceNode::pullProcessWithWarp(const RenderRequest& request) {
+    int32_t dxStart = 0, dxEnd = 0;
+    if (!calcWarpRange(request, dxStart, dxEnd)) {
+        return makeEmptyResponse(request.origin);
+    }
+
+    Point adjustedOrigin = {
+        request.origin.x + to_fixed(dxStart),
+        request.origin.y
+    };
+
+    int validWidth = dxEnd - dxStart + 1;
+    RenderResponse& resp = makeEmptyResponse(adjustedOrigin);
+    PixelFormatID outFormat = ddaOutputFormat();
+    ImageBuffer* output = resp.createBuffer(
+        validWidth, 1, outFormat, InitPolicy::Uninitialized);
+    if (!output) {
+        return resp;
+    }
+    output->setOrigin(adjustedOrigin);
+
+#ifdef FLEXIMG_DEBUG_PERF_METRICS
+    PerfMetrics::instance().nodes[NodeType::Source].recordAlloc(
+        output->totalBytes(), output->width(), output->height());
+#endif
+
+    const PerspectiveMatrix& m = invPerspective_;
+    const float x0 = fixed_to_float(request.origin.x) + 0.5f;
+    const float y = fixed_to_float(request.origin.y) + 0.5f;
+
+    // 出力ピクセル dx のソース座標（Q16.16）を求める
+    // 戻り値: false=写像が定義されない（メッシュ外、視点の背後など）
+    constexpr float coordLimit = 16383.0f;
+    auto sample = [&](int32_t dx, int_fixed& fx, int_fixed& fy) -> bool {
+        float qx = 0, qy = 0;
+        if (!warp_->map(x0 + static_cast<float>(dx), y, qx, qy)) {
+            return false;
+        }
+        const float w = m.g * qx + m.h * qy + m.i;
+        if (w <= 1e-6f) {
+            return false;
+        }
+        const float invW = 1.0f / w;
+        const float sx = (m.a * qx + m.b * qy + m.tx) * invW;
+        const float sy = (m.c * qx + m.d * qy + m.ty) * invW;
+        fx = float_to_fixed(std::min(std::max(sx, -coordLimit), coordLimit));
+        fy = float_to_fixed(std::min(std::max(sy, -coordLimit), coordLimit));
+        return true;
+    };
+
+    uint8_t* dstRow = static_cast<uint8_t*>(output->data());
+    const auto dstBytesPerPixel = static_cast<size_t>(outFormat->bytesPerPixel);
+    const int_fixed maxX = fpWidth_ - 1;
+    const int_fixed maxY = fpHeight_ - 1;
+
+    PixelAuxInfo auxInfo;
+    const PixelAuxInfo* auxPtr = useBilinear_ ? buildSourceAuxInfo(auxInfo) : nullptr;
+    constexpr int_fixed halfPixel = 1 << (INT_FIXED_SHIFT - 1);
+
+    // ViewPortのx,yオフセット（最近傍DDA用、バイリニアは関数内部で加算）
+    int_fixed offsetX = static_cast<int32_t>(source_.x) << INT_FIXED_SHIFT;
+    int_fixed offsetY = static_cast<int32_t>(source_.y) << INT_FIXED_SHIFT;
+
+    // DDA転写（count ピクセル、始点 fx/fy、増分 incrX/incrY）
+    auto copySpan = [&](uint8_t* dst, int32_t count, int_fixed fx, int_fixed fy,
+                        int_fixed incrX, int_fixed incrY) {
+        if (useBilinear_) {
+            view_ops::copyRowDDABilinear(dst, source_, static_cast<int_fast16_t>(count),
+                fx - halfPixel, fy - halfPixel, incrX, incrY, edgeFadeFlags_, auxPtr);
+        } else if (source_.formatID && source_.formatID->copyRowDDA) {
+            DDAParam param = { source_.stride, source_.width, source_.height,
+                               fx + offsetX, fy + offsetY, incrX, incrY, nullptr, nullptr };
+            source_.formatID->copyRowDDA(dst, static_cast<const uint8_t*>(source_.data),
+                                         static_cast<int_fast16_t>(count), &param);
+        }
+    };
+
+    // ソース外のピクセル: 透明を表現できる形式は0埋め、
+    // それ以外は最寄りのソース端ピクセルで埋める（両端の範囲外は後で切り詰める）
+    const bool zeroFill = outFormat->hasAlpha && !outFormat->isIndexed;
+    auto fillGap = [&](uint8_t* dst, int32_t count, bool mapped, int_fixed fx, int_fixed fy) {
+        if (count <= 0) return;
+        if (zeroFill || !mapped) {
+            std::memset(dst, 0, static_cast<size_t>(count) * dstBytesPerPixel);
+            return;
+        }
+        copySpan(dst, count, std::min(std::max(fx, 0), maxX),
+                 std::min(std::max(fy, 0), maxY), 0, 0);
+    };
+
+    // 実際にソースを参照した範囲（バッファ内位置）
+    int32_t first = validWidth;
+    int32_t last = -1;
+
+    for (int32_t pos = 0; pos < validWidth; ) {
+        const int32_t dx = dxStart + pos;
+        const int32_t len = warp_->cellRun(x0 + static_cast<float>(dx),
+            std::min<int32_t>(kWarpSpan, validWidth - pos));
+
+        // スパン両端（同一セル内）の正確な座標から増分を求める
+        int_fixed sx0 = 0, sy0 = 0, sx1 = 0, sy1 = 0;
+        int_fixed incrX = 0, incrY = 0;
+        int32_t a = 1, b = 0;  // スパン内でソース矩形に収まる区間
+        const bool mapped = sample(dx, sx0, sy0)
+                         && (len == 1 || sample(dx + len - 1, sx1, sy1));
+        if (mapped) {
+            if (len > 1) {
+                incrX = (sx1 - sx0) / (len - 1);
+                incrY = (sy1 - sy0) / (len - 1);
+            }
+            a = 0;
+            b = len - 1;
+            transform::clipFixedRange(sx0, incrX, 0, maxX, a, b);
+            transform::clipFixedRange(sy0, incrY, 0, maxY, a, b);
+        }
+
+        uint8_t* spanDst = dstRow + static_cast<size_t>(pos) * dstBytesPerPixel;
+        if (a <= b) {
+            fillGap(spanDst, a, mapped, sx0, sy0);
+            copySpan(spanDst + static_cast<size_t>(a) * dstBytesPerPixel, b - a + 1,
+                     sx0 + incrX * a, sy0 + incrY * a, incrX, incrY);
+            fillGap(spanDst + static_cast<size_t>(b + 1) * dstBytesPerPixel, len - b - 1,
+                    mapped, sx0 + incrX * (b + 1), sy0 + incrY * (b + 1));
+            first = std::min(first, pos + a);
+            last = std::max(last, pos + b);
+        } else {
+            fillGap(spanDst, len, mapped, sx0, sy0);
+        }
+        pos += len;
+    }
+
+    if (last < first) {
+        resp.clear();  // ソースを参照するピクセルなし
+        return resp;
+    }
+
+    // 両端のソース外ピクセルを切り詰める
+    if (first > 0 || last < validWidth - 1) {
+        output->cropView(static_cast<int_fast16_t>(first), 0,
+                         static_cast<int_fast16_t>(last - first + 1), 1);
+        adjustedOrigin.x = request.origin.x + to_fixed(dxStart + first);
+        output->setOrigin(adjustedOrigin);
+        resp.origin = adjustedOrigin;
     }
 
+    applyOutputAuxInfo(*output);
     return resp;
 }
 
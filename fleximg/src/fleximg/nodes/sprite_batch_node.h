@@ -0,0 +1,511 @@
+#ifndef FLEXIMG_SPRITE_BATCH_NODE_H
+#define FLEXIMG_SPRITE_BATCH_NODE_H
+
+#include <vector>
+#include "../core/node.h"
+#include "../core/affine_capability.h"
+#include "../core/perf_metrics.h"
+#include "../image/viewport.h"
+#include "../image/image_buffer.h"
+#include "../image/pixel_format.h"
+
+namespace FLEXIMG_NAMESPACE {
+
+// ========================================================================
+// SpriteBatchNode - スプライト一括描画ノード（終端）
+// ========================================================================
+//
+// 複数のスプライト（画像 + 行列 + α）を1ノードでunder合成して出力します。
+// N個のSourceNodeをCompositeNodeに接続する構成と同じ結果を、
+// ノード呼び出し・Response確保・行バッファ確保なしで生成します。
+// - 入力ポート: 0
+// - 出力ポート: 1
+//
+// 合成順序（CompositeNodeと同じunder合成）:
+// - スプライト0が最前面、以降が順に背面
+//
+// 特徴:
+// - Prepare時に各スプライトのY範囲を16行（kBucketShift）単位のバケットに登録し、
+//   スキャンラインごとに該当バケットのスプライトのみを走査する
+// - 有効なスプライトとX範囲（アクティブリスト）はgetDataRangeで構築し、
+//   同一スキャンラインのProcessで再利用する
+// - 離れたスプライト群はセグメントリスト（getDataSegments）として扱い、
+//   出力バッファのゼロ初期化もセグメント内のみ行う
+// - 各スプライトは最近傍DDAで小さなチャンクに転写し、
+//   RGBA8_Straightの出力行へ直接under合成する（SourceNodeの最近傍と同一の座標計算）
+//
+// 座標系:
+// - スプライト行列は「画像左上を原点とするローカル座標 → ノード出力座標」
+// - ノード自身の行列（AffineCapability）と下流のアフィン行列は全スプライトに適用
+//
+// 注意:
+// - 補間は最近傍のみ（バイリニア等が必要な場合はSourceNodeを使用）
+// - 射影変換・ワープの伝播には未対応
+//
+// 使用例:
+//   SpriteBatchNode batch;
+//   batch.addSprite(ball.view(), AffineMatrix(1, 0, 0, 1, 10, 20));
+//   batch.addSprite(bg.view(), AffineMatrix(), 128);  // 半透明の背面
+//   batch >> renderer >> sink;
+//
+
+class SpriteBatchNode : public Node, public AffineCapability {
+public:
+    // スプライト定義
+    struct Sprite {
+        ViewPort image;
+        PaletteData palette;      // インデックス形式の場合のパレット
+        AffineMatrix matrix;      // ローカル座標（画像左上原点）→ ノード出力座標
+        uint8_t alpha = 255;      // 不透明度（0で描画しない）
+        bool visible = true;
+    };
+
+    SpriteBatchNode() {
+        initPorts(0, 1);  // 入力0、出力1
+    }
+
+    // ========================================
+    // スプライト管理
+    // ========================================
+
+    // スプライトを追加（戻り値: スプライト番号、最大 65535 個）
+    int_fast16_t addSprite(const ViewPort& image, const AffineMatrix& matrix = AffineMatrix(),
+                           uint8_t alpha = 255) {
+        Sprite sprite;
+        sprite.image = image;
+        sprite.matrix = matrix;
+        sprite.alpha = alpha;
+        sprites_.push_back(sprite);
+        markModified();
+        return static_cast<int_fast16_t>(sprites_.size() - 1);
+    }
+
+    void clearSprites() { sprites_.clear(); markModified(); }
+    int_fast16_t spriteCount() const { return static_cast<int_fast16_t>(sprites_.size()); }
+
+    Sprite& sprite(int_fast16_t index) { return sprites_[static_cast<size_t>(index)]; }
+    const Sprite& sprite(int_fast16_t index) const { return sprites_[static_cast<size_t>(index)]; }
+
+    void setSpriteMatrix(int_fast16_t index, const AffineMatrix& m) { sprite(index).matrix = m; markModified(); }
+    void setSpritePosition(int_fast16_t index, float x, float y) {
+        sprite(index).matrix.tx = x;
+        sprite(index).matrix.ty = y;
+        markModified();
+    }
+    void setSpriteAlpha(int_fast16_t index, uint8_t alpha) { sprite(index).alpha = alpha; markModified(); }
+    void setSpriteVisible(int_fast16_t index, bool visible) { sprite(index).visible = visible; markModified(); }
+    void setSpritePalette(int_fast16_t index, const PaletteData& palette) { sprite(index).palette = palette; markModified(); }
+
+    // ========================================
+    // Node インターフェース
+    // ========================================
+
+    const char* name() const override { return "SpriteBatchNode"; }
+    uint32_t generation() const override { return Node::generation() + matrixGeneration(); }
+
+    // ========================================
+    // Template Method フック
+    // ========================================
+
+    // onPullPrepare: 各スプライトの逆行列・Y範囲を事前計算しバケットを構築
+    PrepareResponse onPullPrepare(const PrepareRequest& request) override;
+
+    // onPullProcess: アクティブなスプライトを1行バッファにunder合成
+    RenderResponse& onPullProcess(const RenderRequest& request) override;
+
+    // getDataRange: アクティブなスプライトのX範囲の和集合を返す
+    DataRange getDataRange(const RenderRequest& request) const override;
+
+    // getDataSegments: アクティブなスプライトのX範囲をセグメントリストで返す
+    int_fast16_t getDataSegments(const RenderRequest& request,
+                                 DataRange* segments, int_fast16_t maxCount) const override;
+
+protected:
+    int nodeTypeForMetrics() const override { return NodeType::SpriteBatch; }
+
+private:
+    static constexpr int_fast16_t kBucketShift = 4;           // バケット高さ 16行
+    static constexpr int_fast16_t kChunkPixels = 64;          // DDA転写のチャンクサイズ
+    static constexpr int_fast16_t kMinSegmentGap = 16;        // これ以下の隙間のセグメントは結合
+
+    // Prepare時に計算するスプライトごとの状態（SourceNodeの最近傍パスと同一の値）
+    struct SpriteState {
+        AffinePrecomputed affine;
+        int32_t baseTx = 0;          // prepareOrigin に対応するDDA基準座標（Q16.16）
+        int32_t baseTy = 0;
+        int32_t xs1 = 0, xs2 = 0;    // 有効範囲判定用の境界値
+        int32_t ys1 = 0, ys2 = 0;
+        int32_t rowTop = 0;          // 描画され得る行範囲 [rowTop, rowBottom)
+        int32_t rowBottom = 0;
+        FormatConverter converter;   // DDA出力 → RGBA8_Straight（RGBA8_Straightなら無効）
+    };
+
+    // スキャンライン上のアクティブなスプライト
+    struct ActiveSprite {
+        uint16_t index;
+        int16_t dxStart;             // 有効範囲 [dxStart, dxEnd)（request座標系）
+        int16_t dxEnd;
+        int_fixed srcX;              // dxStart でのソース座標（Q16.16）
+        int_fixed srcY;
+    };
+
+    std::vector<Sprite> sprites_;
+    std::vector<SpriteState> states_;
+
+    // Y区間バケット（CSR形式: bucketStart_[b]..bucketStart_[b+1] が bucketSprites_ の範囲）
+    std::vector<uint32_t> bucketStart_;
+    std::vector<uint16_t> bucketSprites_;
+    int32_t bucketTop_ = 0;
+
+    int_fixed prepareOriginX_ = 0;
+    int_fixed prepareOriginY_ = 0;
+
+    // アクティブリスト（getDataRange/pullProcess 間で共有）
+    mutable std::vector<ActiveSprite> active_;
+    mutable struct {
+        Point origin = {0, 0};
+        int16_t width = 0;
+        DataRange range = {0, 0};
+        bool valid = false;
+    } activeCache_;
+
+    void buildBuckets();
+    void blendSpriteRow(uint8_t* dstRow, const ActiveSprite& a) const;
+};
+
+} // namespace FLEXIMG_NAMESPACE
+
+// =============================================================================
+// 実装部
+// =============================================================================
+#ifdef FLEXIMG_IMPLEMENTATION
+
+namespace FLEXIMG_NAMESPACE {
+
+// ============================================================================
+// SpriteBatchNode - Template Method フック実装
+// ============================================================================
+
+PrepareResponse SpriteBatchNode::onPullPrepare(const PrepareRequest& request) {
+    prepareOriginX_ = request.origin.x;
+    prepareOriginY_ = request.origin.y;
+    activeCache_.valid = false;
+
+    AffineMatrix nodeMatrix = request.hasAffine ? request.affineMatrix * localMatrix_
+                                                : localMatrix_;
+
+    states_.assign(sprites_.size(), SpriteState());
+    float minX = 0, minY = 0, maxX = 0, maxY = 0;
+    bool hasAny = false;
+
+    for (size_t i = 0; i < sprites_.size(); ++i) {
+        const Sprite& sp = sprites_[i];
+        SpriteState& st = states_[i];
+        st.rowTop = st.rowBottom = 0;  // 無効（バケットに登録しない）
+        if (!sp.visible || sp.alpha == 0 || !sp.image.isValid()
+            || !sp.image.formatID->copyRowDDA) continue;
+
+        const AffineMatrix combined = nodeMatrix * sp.matrix;
+        st.affine = precomputeInverseAffine(combined);
+        if (!st.affine.isValid()) continue;
+
+        // DDA出力フォーマット（bit-packed形式はIndex8で出力される）
+        PixelFormatID ddaFormat = sp.image.formatID->pixelsPerUnit > 1
+                                ? PixelFormatIDs::Index8 : sp.image.formatID;
+        if (ddaFormat != PixelFormatIDs::RGBA8_Straight) {
+            PixelAuxInfo aux;
+            if (sp.palette) {
+                aux.palette = sp.palette.data;
+                aux.paletteFormat = sp.palette.format;
+                aux.paletteColorCount = sp.palette.colorCount;
+            }
+            st.converter = resolveConverter(ddaFormat, PixelFormatIDs::RGBA8_Straight, &aux);
+            if (!st.converter) continue;
+        }
+
+        // 逆行列・境界値・基準座標（SourceNodeの最近傍パス、pivot=0 と同一）
+        const int32_t invA = st.affine.invMatrix.a;
+        const int32_t invB = st.affine.invMatrix.b;
+        const int32_t invC = st.affine.invMatrix.c;
+        const int32_t invD = st.affine.invMatrix.d;
+        const int32_t fpWidth = sp.image.width << INT_FIXED_SHIFT;
+        const int32_t fpHeight = sp.image.height << INT_FIXED_SHIFT;
+        st.xs1 = invA + (invA < 0 ? fpWidth : -1);
+        st.xs2 = invA + (invA < 0 ? 0 : (fpWidth - 1));
+        st.ys1 = invC + (invC < 0 ? fpHeight : -1);
+        st.ys2 = invC + (invC < 0 ? 0 : (fpHeight - 1));
+
+        const int32_t prepareOffsetX = static_cast<int32_t>(
+            (static_cast<int64_t>(prepareOriginX_) * invA
+           + static_cast<int64_t>(prepareOriginY_) * invB) >> INT_FIXED_SHIFT);
+        const int32_t prepareOffsetY = static_cast<int32_t>(
+            (static_cast<int64_t>(prepareOriginX_) * invC
+           + static_cast<int64_t>(prepareOriginY_) * invD) >> INT_FIXED_SHIFT);
+        st.baseTx = st.affine.invTxFixed + st.affine.rowOffsetX + st.affine.dxOffsetX + prepareOffsetX;
+        st.baseTy = st.affine.invTyFixed + st.affine.rowOffsetY + st.affine.dxOffsetY + prepareOffsetY;
+
+        // ワールド座標のAABB → 描画され得る行範囲
+        int16_t aabbW = 0, aabbH = 0;
+        Point aabbOrigin;
+        calcAffineAABB(static_cast<float>(sp.image.width), static_cast<float>(sp.image.height),
+                       {0, 0}, combined, aabbW, aabbH, aabbOrigin);
+        if (aabbW <= 0 || aabbH <= 0) continue;
+        st.rowTop = from_fixed_floor(aabbOrigin.y);
+        st.rowBottom = from_fixed_ceil(aabbOrigin.y + to_fixed(aabbH));
+
+        const float left = fixed_to_float(aabbOrigin.x);
+        const float top = fixed_to_float(aabbOrigin.y);
+        const float right = left + static_cast<float>(aabbW);
+        const float bottom = top + static_cast<float>(aabbH);
+        if (!hasAny) {
+            minX = left; minY = top; maxX = right; maxY = bottom;
+            hasAny = true;
+        } else {
+            minX = std::min(minX, left);
+            minY = std::min(minY, top);
+            maxX = std::max(maxX, right);
+            maxY = std::max(maxY, bottom);
+        }
+    }
+
+    buildBuckets();
+
+    PrepareResponse result;
+    result.status = PrepareStatus::Prepared;
+    result.preferredFormat = PixelFormatIDs::RGBA8_Straight;
+    if (hasAny) {
+        result.width = static_cast<int16_t>(std::ceil(maxX - minX));
+        result.height = static_cast<int16_t>(std::ceil(maxY - minY));
+        result.origin.x = float_to_fixed(minX);
+        result.origin.y = float_to_fixed(minY);
+    }
+    return result;
+}
+
+// 各スプライトの行範囲を kBucketShift 単位のバケットに登録（CSR形式）
+// バケット内はスプライト番号順（= 前面から順）に並ぶ
+void SpriteBatchNode::buildBuckets() {
+    bucketStart_.clear();
+    bucketSprites_.clear();
+
+    int32_t top = INT32_MAX, bottom = INT32_MIN;
+    for (const auto& st : states_) {
+        if (st.rowTop >= st.rowBottom) continue;
+        top = std::min(top, st.rowTop);
+        bottom = std::max(bottom, st.rowBottom);
+    }
+    if (top >= bottom) return;
+
+    bucketTop_ = top;
+    const auto bucketOf = [this](int32_t row) {
+        return static_cast<size_t>((row - bucketTop_) >> kBucketShift);
+    };
+    const size_t bucketCount = bucketOf(bottom - 1) + 1;
+
+    // 1パス目: バケットごとの件数、2パス目: 登録
+    bucketStart_.assign(bucketCount + 1, 0);
+    for (const auto& st : states_) {
+        if (st.rowTop >= st.rowBottom) continue;
+        for (size_t b = bucketOf(st.rowTop); b <= bucketOf(st.rowBottom - 1); ++b) {
+            ++bucketStart_[b + 1];
+        }
+    }
+    for (size_t b = 0; b < bucketCount; ++b) {
+        bucketStart_[b + 1] += bucketStart_[b];
+    }
+    bucketSprites_.resize(bucketStart_[bucketCount]);
+    std::vector<uint32_t> cursor(bucketStart_.begin(), bucketStart_.end() - 1);
+    for (size_t i = 0; i < states_.size(); ++i) {
+        const SpriteState& st = states_[i];
+        if (st.rowTop >= st.rowBottom) continue;
+        for (size_t b = bucketOf(st.rowTop); b <= bucketOf(st.rowBottom - 1); ++b) {
+            bucketSprites_[cursor[b]++] = static_cast<uint16_t>(i);
+        }
+    }
+}
+
+// getDataRange: アクティブリストを構築し、X範囲の和集合を返す
+// 同一スキャンラインの重複呼び出し（Process含む）はキャッシュを再利用
+DataRange SpriteBatchNode::getDataRange(const RenderRequest& request) const {
+    if (activeCache_.valid
+        && activeCache_.origin.x == request.origin.x
+        && activeCache_.origin.y == request.origin.y
+        && activeCache_.width == request.width) {
+        return activeCache_.range;
+    }
+
+    active_.clear();
+    int32_t startX = request.width;
+    int32_t endX = 0;
+
+    const int32_t row = from_fixed_floor(request.origin.y);
+    const size_t bucket = (row >= bucketTop_)
+        ? static_cast<size_t>((row - bucketTop_) >> kBucketShift) : bucketStart_.size();
+    if (bucket + 1 < bucketStart_.size()) {
+        // Prepare時のoriginからの差分（ピクセル単位の整数、SourceNodeと同一）
+        const int32_t deltaX = from_fixed(request.origin.x - prepareOriginX_);
+        const int32_t deltaY = from_fixed(request.origin.y - prepareOriginY_);
+
+        for (uint32_t k = bucketStart_[bucket]; k < bucketStart_[bucket + 1]; ++k) {
+            const uint16_t index = bucketSprites_[k];
+            const SpriteState& st = states_[index];
+            if (row < st.rowTop || row >= st.rowBottom) continue;
+
+            const int32_t invA = st.affine.invMatrix.a;
+            const int32_t invC = st.affine.invMatrix.c;
+            const int32_t baseX = st.baseTx + deltaX * invA + deltaY * st.affine.invMatrix.b;
+            const int32_t baseY = st.baseTy + deltaX * invC + deltaY * st.affine.invMatrix.d;
+
+            // SourceNode::calcScanlineRange と同一の範囲計算
+            const int32_t fpWidth = sprites_[index].image.width << INT_FIXED_SHIFT;
+            const int32_t fpHeight = sprites_[index].image.height << INT_FIXED_SHIFT;
+            int32_t left = 0;
+            int32_t right = request.width;
+            if (invA) {
+                left  = std::max(left, (st.xs1 - baseX) / invA);
+                right = std::min(right, (st.xs2 - baseX) / invA);
+            } else if (static_cast<uint32_t>(baseX) >= static_cast<uint32_t>(fpWidth)) {
+                continue;
+            }
+            if (invC) {
+                left  = std::max(left, (st.ys1 - baseY) / invC);
+                right = std::min(right, (st.ys2 - baseY) / invC);
+            } else if (static_cast<uint32_t>(baseY) >= static_cast<uint32_t>(fpHeight)) {
+                continue;
+            }
+            if (left >= right) continue;
+
+            active_.push_back(ActiveSprite{
+                index, static_cast<int16_t>(left), static_cast<int16_t>(right),
+                invA * left + baseX, invC * left + baseY});
+            startX = std::min(startX, left);
+            endX = std::max(endX, right);
+        }
+    }
+
+    DataRange result = (startX < endX)
+        ? DataRange{static_cast<int16_t>(startX), static_cast<int16_t>(endX)}
+        : DataRange{0, 0};
+
+    activeCache_.origin = request.origin;
+    activeCache_.width = request.width;
+    activeCache_.range = result;
+    activeCache_.valid = true;
+    return result;
+}
+
+// getDataSegments: アクティブリストのX範囲を結合・整列して返す
+int_fast16_t SpriteBatchNode::getDataSegments(const RenderRequest& request,
+                                              DataRange* segments, int_fast16_t maxCount) const {
+    if (maxCount <= 0 || !getDataRange(request).hasData()) return 0;
+
+    // 作業配列が溢れる前に正規化（結合）しながら追加
+    DataRange merged[MAX_DATA_SEGMENTS * 2];
+    int_fast16_t count = 0;
+    for (const auto& a : active_) {
+        if (count == MAX_DATA_SEGMENTS * 2) {
+            count = normalizeDataSegments(merged, count, MAX_DATA_SEGMENTS, kMinSegmentGap);
+        }
+        merged[count++] = DataRange{a.dxStart, a.dxEnd};
+    }
+    const int_fast16_t limit = std::min<int_fast16_t>(maxCount, MAX_DATA_SEGMENTS);
+    count = normalizeDataSegments(merged, count, limit, kMinSegmentGap);
+    for (int_fast16_t k = 0; k < count; ++k) {
+        segments[k] = merged[k];
+    }
+    return count;
+}
+
+// onPullProcess: アクティブなスプライトを前面から順に1行バッファへunder合成
+RenderResponse& SpriteBatchNode::onPullProcess(const RenderRequest& request) {
+    DataRange segments[MAX_DATA_SEGMENTS];
+    const int_fast16_t segmentCount = getDataSegments(request, segments, MAX_DATA_SEGMENTS);
+    if (segmentCount == 0) return makeEmptyResponse(request.origin);
+    const DataRange range{segments[0].startX, segments[segmentCount - 1].endX};
+
+    FLEXIMG_METRICS_SCOPE(NodeType::SpriteBatch);
+
+    // 複数セグメント: セグメント内のみゼロ初期化（プール枯渇時は全体をゼロ初期化）
+    DataRange* bufSegments = (segmentCount > 1)
+        ? context_->acquireSegments(static_cast<int>(segmentCount)) : nullptr;
+
+    Point origin = request.origin;
+    origin.x += to_fixed(range.startX);
+    RenderResponse& resp = makeEmptyResponse(origin);
+    ImageBuffer* output = resp.createBuffer(
+        range.width(), 1, PixelFormatIDs::RGBA8_Straight,
+        bufSegments ? InitPolicy::Uninitialized : InitPolicy::Zero);
+    if (!output) {
+        return resp;  // バッファ作成失敗時は空のResponseを返す
+    }
+    output->setOrigin(origin);
+    if (bufSegments) {
+        // バッファ左端基準のセグメント（全スプライトの範囲はいずれかのセグメントに含まれる）
+        auto* row = static_cast<uint8_t*>(output->data());
+        for (int_fast16_t k = 0; k < segmentCount; ++k) {
+            bufSegments[k] = DataRange{
+                static_cast<int16_t>(segments[k].startX - range.startX),
+                static_cast<int16_t>(segments[k].endX - range.startX)};
+            std::memset(row + bufSegments[k].startX * 4, 0,
+                        static_cast<size_t>(bufSegments[k].width()) * 4);
+        }
+        resp.setSegments(bufSegments, segmentCount);
+    }
+
+#ifdef FLEXIMG_DEBUG_PERF_METRICS
+    PerfMetrics::instance().nodes[NodeType::SpriteBatch].recordAlloc(
+        output->totalBytes(), output->width(), output->height());
+#endif
+
+    uint8_t* dstRow = static_cast<uint8_t*>(output->data());
+    for (const auto& a : active_) {
+        blendSpriteRow(dstRow + (a.dxStart - range.startX) * 4, a);
+    }
+    return resp;
+}
+
+// 1スプライト分の有効範囲をチャンク単位でDDA転写し、under合成
+// DDA出力 → (RGBA8_Straightへ変換) → α乗算 → blendUnderStraight
+void SpriteBatchNode::blendSpriteRow(uint8_t* dstRow, const ActiveSprite& a) const {
+    const Sprite& sp = sprites_[a.index];
+    const SpriteState& st = states_[a.index];
+    const ViewPort& img = sp.image;
+    auto blendUnder = PixelFormatIDs::RGBA8_Straight->blendUnderStraight;
+
+    // ViewPortのx,yオフセットを加算
+    DDAParam param = { img.stride, img.width, img.height,
+                       a.srcX + (static_cast<int32_t>(img.x) << INT_FIXED_SHIFT),
+                       a.srcY + (static_cast<int32_t>(img.y) << INT_FIXED_SHIFT),
+                       st.affine.invMatrix.a, st.affine.invMatrix.c, nullptr, nullptr };
+
+    uint8_t ddaBuf[kChunkPixels * 4];
+    uint8_t rgbaBuf[kChunkPixels * 4];
+    const uint32_t alphaScale = static_cast<uint32_t>(sp.alpha) + (sp.alpha >> 7);  // 255→256
+
+    int_fast16_t remaining = a.dxEnd - a.dxStart;
+    while (remaining > 0) {
+        const int_fast16_t chunk = std::min(remaining, kChunkPixels);
+        uint8_t* ddaDst = st.converter ? ddaBuf : rgbaBuf;
+        img.formatID->copyRowDDA(ddaDst, static_cast<const uint8_t*>(img.data), chunk, &param);
+        if (st.converter) {
+            st.converter(rgbaBuf, ddaBuf, static_cast<size_t>(chunk));
+        }
+        if (sp.alpha != 255) {
+            for (int_fast16_t x = 0; x < chunk; ++x) {
+                rgbaBuf[x * 4 + 3] = static_cast<uint8_t>((rgbaBuf[x * 4 + 3] * alphaScale) >> 8);
+            }
+        }
+        blendUnder(dstRow, rgbaBuf, static_cast<size_t>(chunk), nullptr);
+
+        param.srcX += param.incrX * static_cast<int32_t>(chunk);
+        param.srcY += param.incrY * static_cast<int32_t>(chunk);
+        dstRow += chunk * 4;
+        remaining -= chunk;
+    }
+}
+
+} // namespace FLEXIMG_NAMESPACE
+
+#endif // FLEXIMG_IMPLEMENTATION
+
+#endif // FLEXIMG_SPRITE_BATCH_NODE_H
@@ -25,10 +25,23 @@ namespace FLEXIMG_NAMESPACE {
 // - 「3パス×1ノード」と「1パス×3ノード直列」が同等の結果を得る
 //
 // メモリ消費量（概算）:
-// - 各ステージ: (radius * 2 + 1) * width * 4 bytes + width * 16 bytes（列合計）
+// - 各ステージ: (radius * 2 + 1) * width * 4 bytes（行リング）+ width * 16 bytes（列合計）
+// - 行リングはステージごとに1枚の連続バッファをパイプラインのアロケータから確保し、
+//   各行はデータ範囲（DataRange）の内側のみ書き込み・列合計へ加減算する
 // - 例: radius=50, passes=3, width=640 → 約500KB
 // - 例: radius=127, passes=3, width=2048 → 約4MB
 //
+// 単一チャンネルパス（pull型）:
+// - 上流の preferredFormat が Alpha8 / Grayscale8 の場合、行キャッシュを同じ
+//   1バイトフォーマットで確保し、列合計もピクセルあたり1要素のみ使用する
+//   （メモリ消費は約1/4、出力も同じフォーマット、範囲外は0として扱う）
+//
+// 列合計と出力:
+// - 列合計はピクセルごとに [R×A, G×A, B×A, A] をインターリーブした uint32 配列
+//   （行の加算・減算は SSE2/AVX2 で 2〜4ピクセル同時に処理）
+// - 出力は RGB = Σ(C×A) / ΣA、A = ΣA / kernelSize の切り捨て除算と完全に一致する
+//   （SIMD は float 除算、スカラーは逆数乗算＋補正。整数除算命令を使わない）
+//
 // スキャンライン処理:
 // - prepare()でキャッシュを確保
 // - pullProcess()で行キャッシュと列合計を使用したスライディングウィンドウ処理
@@ -60,10 +73,12 @@ public:
 
     void setRadius(int_fast16_t radius) {
         radius_ = static_cast<int16_t>((radius < 0) ? 0 : (radius > kMaxRadius) ? kMaxRadius : radius);
+        markModified();
     }
 
     void setPasses(int_fast16_t passes) {
         passes_ = static_cast<int16_t>((passes < 1) ? 1 : (passes > kMaxPasses) ? kMaxPasses : passes);
+        markModified();
     }
 
     int16_t radius() const { return radius_; }
@@ -109,13 +124,11 @@ private:
     // 各ステージが独立したキャッシュと列合計を持つ
     // passes=3の場合、3つのステージがパイプライン接続される
     struct BlurStage {
-        std::vector<ImageBuffer> rowCache;   // radius*2+1 行のキャッシュ
+        ImageBuffer rows;                    // 行リング（radius*2+1 行 × キャッシュ幅の連続バッファ）
         std::vector<int_fixed> rowOriginX;   // 各キャッシュ行のorigin.x（push型用）
-        std::vector<DataRange> rowDataRange; // 各キャッシュ行の有効範囲
-        std::vector<uint32_t> colSumR;       // 列合計（R×A）
-        std::vector<uint32_t> colSumG;       // 列合計（G×A）
-        std::vector<uint32_t> colSumB;       // 列合計（B×A）
-        std::vector<uint32_t> colSumA;       // 列合計（A）
+        std::vector<DataRange> rowDataRange; // 各キャッシュ行の格納範囲（範囲外の内容は不定、0として扱う）
+        std::vector<uint32_t> colSum;        // 列合計（RGBA8: [R×A, G×A, B×A, A] をピクセルごとに
+                                             //   インターリーブ、単一チャンネルパス: 値の合計）
         int32_t currentY = 0;                // 現在のY座標（pull型用）
         bool cacheReady = false;             // キャッシュ初期化済みフラグ
 
@@ -124,22 +137,38 @@ private:
         int32_t pushOutputY = 0;             // 出力行カウント
 
         void clear() {
-            rowCache.clear();
+            rows = ImageBuffer();
             rowOriginX.clear();
             rowDataRange.clear();
-            colSumR.clear();
-            colSumG.clear();
-            colSumB.clear();
-            colSumA.clear();
+            colSum.clear();
             currentY = 0;
             cacheReady = false;
             pushInputY = 0;
             pushOutputY = 0;
         }
+
+        uint8_t* row(int_fast16_t slot) {
+            return static_cast<uint8_t*>(rows.view().pixelAt(0, static_cast<int>(slot)));
+        }
+        const uint8_t* row(int_fast16_t slot) const {
+            return static_cast<const uint8_t*>(rows.view().pixelAt(0, static_cast<int>(slot)));
+        }
+
+        // キャッシュ中の全行の格納範囲の和集合（列合計が非0になり得る範囲）
+        DataRange storedExtent() const {
+            DataRange extent{INT16_MAX, 0};
+            for (const DataRange& r : rowDataRange) {
+                if (!r.hasData()) continue;
+                extent.startX = std::min(extent.startX, r.startX);
+                extent.endX = std::max(extent.endX, r.endX);
+            }
+            return extent.hasData() ? extent : DataRange{};
+        }
     };
 
     // パイプラインステージ（passes個、passes=1でもstages_[0]を使用）
     std::vector<BlurStage> stages_;
+    PixelFormatID channelFormat_ = nullptr;  // 単一チャンネルパスのフォーマット（nullptr = RGBA8）
     int16_t cacheWidth_ = 0;
     int_fixed cacheOriginX_ = 0;  // キャッシュの基準X座標（pull型用）
     int_fixed upstreamOriginX_ = 0;  // 上流pullProcessのorigin.x（radius=0と同じ出力用）
@@ -167,18 +196,60 @@ private:
     };
     mutable DataRangeCache rangeCache_;
 
+    // getDataRange のスライディングウィンドウ
+    // 上下 radius*passes 行の上流 DataRange を行リングに保持し、startX の最小・
+    // endX の最大を単調デックで管理する（1行ずつ下に進む要求では上流クエリ1回/行）
+    struct RowQueue {
+        std::vector<int32_t> rows;  // 行番号のリング
+        size_t head = 0;
+        size_t count = 0;
+
+        void reset(size_t capacity) { rows.assign(capacity, 0); head = 0; count = 0; }
+        bool empty() const { return count == 0; }
+        int32_t front() const { return rows[head]; }
+        int32_t back() const { return rows[(head + count - 1) % rows.size()]; }
+        void popFront() { head = (head + 1) % rows.size(); --count; }
+        void popBack() { --count; }
+        void pushBack(int32_t row) { rows[(head + count) % rows.size()] = row; ++count; }
+    };
+    struct RangeWindow {
+        std::vector<DataRange> history;  // 行ごとの上流 DataRange（2*expansion+1 行のリング）
+        RowQueue minStart;               // startX が単調増加する行番号列（先頭が最小）
+        RowQueue maxEnd;                 // endX が単調減少する行番号列（先頭が最大）
+        Point origin = {INT32_MIN, INT32_MIN};  // 現在のウィンドウ中心行のリクエスト origin
+        int16_t width = 0;
+        bool valid = false;
+
+        // 行番号 → history のリング位置
+        size_t slot(int32_t row) const {
+            const auto n = static_cast<int32_t>(history.size());
+            const int32_t m = row % n;
+            return static_cast<size_t>(m < 0 ? m + n : m);
+        }
+    };
+    mutable RangeWindow rangeWindow_;
+
+    // ウィンドウ中心行から dy 行の上流 DataRange を取得してウィンドウに追加
+    void pushRangeRow(Node* upstream, const RenderRequest& request, int_fast16_t dy) const;
+
     // 内部実装（宣言のみ）
     RenderResponse& pullProcessPipeline(Node* upstream, const RenderRequest& request);
     void updateStageCache(int_fast16_t stageIndex, Node* upstream, const RenderRequest& request, int_fast16_t newY);
     void fetchRowToStageCache(BlurStage& stage, Node* upstream, const RenderRequest& request, int_fast16_t srcY, int_fast16_t cacheIndex);
     void fetchRowFromPrevStage(int_fast16_t stageIndex, Node* upstream, const RenderRequest& request, int_fast16_t srcY, int_fast16_t cacheIndex);
     void updateStageColSum(BlurStage& stage, int_fast16_t cacheIndex, bool add);
-    void computeStageOutputRow(BlurStage& stage, ImageBuffer& output, int_fast16_t width);
+    void computeStageOutputRow(const BlurStage& stage, uint8_t* dst,
+                               int_fast16_t startX, int_fast16_t endX) const;
     void initializeStage(BlurStage& stage, int_fast16_t width);
     void initializeStages(int_fast16_t width);
     void propagatePipelineStages();
     void emitBlurredLinePipeline();
-    void storeInputRowToStageCache(BlurStage& stage, const ImageBuffer& input, int_fast16_t cacheIndex, int_fast16_t xOffset = 0);
+    void storeInputRowToStageCache(BlurStage& stage, const ViewPort& input, int_fast16_t cacheIndex, int_fast16_t xOffset = 0);
+    void storeStageOutputRow(const BlurStage& prevStage, BlurStage& stage, int_fast16_t cacheIndex);
+
+    // 行キャッシュのフォーマットとピクセルあたりバイト数
+    PixelFormatID cacheFormat() const { return channelFormat_ ? channelFormat_ : PixelFormatIDs::RGBA8_Straight; }
+    size_t cacheBytesPerPixel() const { return channelFormat_ ? 1 : 4; }
 };
 
 } // namespace FLEXIMG_NAMESPACE
@@ -188,8 +259,190 @@ private:
 // =============================================================================
 #ifdef FLEXIMG_IMPLEMENTATION
 
+#if defined(FLEXIMG_HAS_AVX2)
+#include <immintrin.h>
+#elif defined(FLEXIMG_HAS_SSE2)
+#include <emmintrin.h>
+#endif
+
 namespace FLEXIMG_NAMESPACE {
 
+// ========================================
+// 列合計カーネル
+// ========================================
+//
+// 列合計はピクセルごとに [R×A, G×A, B×A, A] をインターリーブした uint32 配列。
+// 行の加算・減算は乗数 [A, A, A, 1] との16bit乗算（C×A ≤ 65025）を32bitに
+// 拡張して加減算する。
+
+namespace vertical_blur_detail {
+
+// ks の固定小数点逆数: (n * kernelReciprocal(ks)) >> 32 == n / ks
+// （n ≤ 255×ks の範囲では n×ks < 2^32 のため誤差が切り捨てに影響しない）
+static inline uint64_t kernelReciprocal(uint32_t ks) {
+    return (uint64_t(1) << 32) / ks + 1;
+}
+
+template<bool Add>
+static inline void accumulateRowScalar(uint32_t* sums, const uint8_t* row, size_t begin, size_t end) {
+    for (size_t x = begin; x < end; x++) {
+        const uint8_t* p = row + x * 4;
+        uint32_t* s = sums + x * 4;
+        const uint32_t a = p[3];
+        if (Add) {
+            s[0] += p[0] * a; s[1] += p[1] * a; s[2] += p[2] * a; s[3] += a;
+        } else {
+            s[0] -= p[0] * a; s[1] -= p[1] * a; s[2] -= p[2] * a; s[3] -= a;
+        }
+    }
+}
+
+// 列合計から1ピクセルを出力（ΣA に対する逆数乗算の結果を ±1 補正して正確な切り捨てにする）
+static inline void resolvePixelScalar(uint8_t* dst, const uint32_t* s, uint64_t kernelRecip) {
+    const uint32_t sumA = s[3];
+    if (sumA == 0) {
+        dst[0] = dst[1] = dst[2] = dst[3] = 0;
+        return;
+    }
+    const float inv = 1.0f / static_cast<float>(sumA);
+    for (int c = 0; c < 3; c++) {
+        auto q = static_cast<uint32_t>(static_cast<float>(s[c]) * inv);
+        if (q * sumA > s[c]) {
+            --q;
+        } else if ((q + 1) * sumA <= s[c]) {
+            ++q;
+        }
+        dst[c] = static_cast<uint8_t>(q);
+    }
+    dst[3] = static_cast<uint8_t>((sumA * kernelRecip) >> 32);
+}
+
+#ifdef FLEXIMG_HAS_SSE2
+// 2ピクセル/反復
+template<bool Add>
+static inline size_t accumulateRowSSE2(uint32_t* sums, const uint8_t* row, size_t width) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i maskRGB = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+    const __m128i oneA = _mm_set_epi16(1, 0, 0, 0, 1, 0, 0, 0);
+    size_t x = 0;
+    for (; x + 2 <= width; x += 2) {
+        const __m128i px = _mm_unpacklo_epi8(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(row + x * 4)), zero);
+        // 各ピクセルの A を4レーンへ複製し、A レーンは乗数1にする
+        __m128i a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(px, 0xFF), 0xFF);
+        a = _mm_or_si128(_mm_and_si128(a, maskRGB), oneA);
+        const __m128i prod = _mm_mullo_epi16(px, a);
+        __m128i* s = reinterpret_cast<__m128i*>(sums + x * 4);
+        const __m128i lo = _mm_unpacklo_epi16(prod, zero);
+        const __m128i hi = _mm_unpackhi_epi16(prod, zero);
+        if (Add) {
+            _mm_storeu_si128(s, _mm_add_epi32(_mm_loadu_si128(s), lo));
+            _mm_storeu_si128(s + 1, _mm_add_epi32(_mm_loadu_si128(s + 1), hi));
+        } else {
+            _mm_storeu_si128(s, _mm_sub_epi32(_mm_loadu_si128(s), lo));
+            _mm_storeu_si128(s + 1, _mm_sub_epi32(_mm_loadu_si128(s + 1), hi));
+        }
+    }
+    return x;
+}
+
+// 1ピクセル/反復: 除数 [ΣA, ΣA, ΣA, ks] で4チャンネルを同時に float 除算
+// （被除数 < 2^24、商 ≤ 255、除数 ≤ 65025 の範囲では丸め後の商が次の整数に
+//   届かないため、切り捨てで整数除算と一致する）
+static inline size_t resolveRowSSE2(uint8_t* dst, const uint32_t* sums, size_t count, uint32_t ks) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i maskRGB = _mm_set_epi32(0, -1, -1, -1);
+    const __m128i ksA = _mm_set_epi32(static_cast<int>(ks), 0, 0, 0);
+    size_t i = 0;
+    for (; i < count; i++) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sums + i * 4));
+        const __m128i a = _mm_shuffle_epi32(v, 0xFF);
+        const __m128i den = _mm_or_si128(_mm_and_si128(a, maskRGB), ksA);
+        __m128i q = _mm_cvttps_epi32(_mm_div_ps(_mm_cvtepi32_ps(v), _mm_cvtepi32_ps(den)));
+        q = _mm_andnot_si128(_mm_cmpeq_epi32(a, zero), q);  // ΣA=0 → 全チャンネル0
+        const __m128i packed = _mm_packus_epi16(_mm_packs_epi32(q, q), zero);
+        const auto bits = static_cast<uint32_t>(_mm_cvtsi128_si32(packed));
+        std::memcpy(dst + i * 4, &bits, 4);
+    }
+    return i;
+}
+#endif // FLEXIMG_HAS_SSE2
+
+#ifdef FLEXIMG_HAS_AVX2
+// 4ピクセル/反復
+template<bool Add>
+static inline size_t accumulateRowAVX2(uint32_t* sums, const uint8_t* row, size_t width) {
+    const __m256i oneA = _mm256_set1_epi64x(static_cast<long long>(uint64_t(1) << 48));
+    size_t x = 0;
+    for (; x + 4 <= width; x += 4) {
+        const __m256i px = _mm256_cvtepu8_epi16(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x * 4)));
+        // 各ピクセルの A を4レーンへ複製し、A レーンは乗数1にする
+        __m256i a = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(px, 0xFF), 0xFF);
+        a = _mm256_blend_epi16(a, oneA, 0x88);
+        const __m256i prod = _mm256_mullo_epi16(px, a);
+        __m256i* s = reinterpret_cast<__m256i*>(sums + x * 4);
+        const __m256i lo = _mm256_cvtepu16_epi32(_mm256_castsi256_si128(prod));
+        const __m256i hi = _mm256_cvtepu16_epi32(_mm256_extracti128_si256(prod, 1));
+        if (Add) {
+            _mm256_storeu_si256(s, _mm256_add_epi32(_mm256_loadu_si256(s), lo));
+            _mm256_storeu_si256(s + 1, _mm256_add_epi32(_mm256_loadu_si256(s + 1), hi));
+        } else {
+            _mm256_storeu_si256(s, _mm256_sub_epi32(_mm256_loadu_si256(s), lo));
+            _mm256_storeu_si256(s + 1, _mm256_sub_epi32(_mm256_loadu_si256(s + 1), hi));
+        }
+    }
+    return x;
+}
+
+// 2ピクセル/反復（除算の正確性は resolveRowSSE2 と同じ）
+static inline size_t resolveRowAVX2(uint8_t* dst, const uint32_t* sums, size_t count, uint32_t ks) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ksVec = _mm256_set1_epi32(static_cast<int>(ks));
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sums + i * 4));
+        const __m256i a = _mm256_shuffle_epi32(v, 0xFF);
+        const __m256i den = _mm256_blend_epi32(a, ksVec, 0x88);
+        __m256i q = _mm256_cvttps_epi32(_mm256_div_ps(_mm256_cvtepi32_ps(v), _mm256_cvtepi32_ps(den)));
+        q = _mm256_andnot_si256(_mm256_cmpeq_epi32(a, zero), q);  // ΣA=0 → 全チャンネル0
+        const __m128i w = _mm_packs_epi32(_mm256_castsi256_si128(q), _mm256_extracti128_si256(q, 1));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i * 4), _mm_packus_epi16(w, w));
+    }
+    return i;
+}
+#endif // FLEXIMG_HAS_AVX2
+
+// 行を列合計に加算（Add=true）または減算（Add=false）
+template<bool Add>
+static inline void accumulateRow(uint32_t* sums, const uint8_t* row, size_t width) {
+#if defined(FLEXIMG_HAS_AVX2)
+    const size_t done = accumulateRowAVX2<Add>(sums, row, width);
+#elif defined(FLEXIMG_HAS_SSE2)
+    const size_t done = accumulateRowSSE2<Add>(sums, row, width);
+#else
+    const size_t done = 0;
+#endif
+    accumulateRowScalar<Add>(sums, row, done, width);
+}
+
+// 列合計 count ピクセル分から RGBA8 出力行を計算
+static inline void resolveRow(uint8_t* dst, const uint32_t* sums, size_t count, uint32_t ks) {
+#if defined(FLEXIMG_HAS_AVX2)
+    size_t i = resolveRowAVX2(dst, sums, count, ks);
+#elif defined(FLEXIMG_HAS_SSE2)
+    size_t i = resolveRowSSE2(dst, sums, count, ks);
+#else
+    size_t i = 0;
+#endif
+    const uint64_t recip = kernelReciprocal(ks);
+    for (; i < count; i++) {
+        resolvePixelScalar(dst + i * 4, sums + i * 4, recip);
+    }
+}
+
+} // namespace vertical_blur_detail
+
 // ========================================
 // 準備・終了処理
 // ========================================
@@ -220,6 +473,8 @@ void VerticalBlurNode::finalize() {
     }
     stages_.clear();
 
+    channelFormat_ = nullptr;
+
     // 上流origin情報をリセット
     upstreamOriginXSet_ = false;
     sourceOriginY_ = 0;
@@ -229,6 +484,7 @@ void VerticalBlurNode::finalize() {
     rangeCache_.origin = {INT32_MIN, INT32_MIN};
     rangeCache_.startX = 0;
     rangeCache_.endX = 0;
+    rangeWindow_ = RangeWindow();
 }
 
 // ========================================
@@ -259,19 +515,36 @@ DataRange VerticalBlurNode::getDataRange(const RenderRequest& request) const {
     // X範囲の和集合が必要（expansion = radius * passes）
     // 特にアフィン変換された画像では、各行のX範囲が異なる可能性がある
     int_fast16_t expansion = radius_ * passes_;
+    RangeWindow& window = rangeWindow_;
+    const bool sameColumn = window.valid && window.origin.x == request.origin.x
+                         && window.width == request.width;
+
+    if (sameColumn && request.origin.y == window.origin.y + to_fixed(1)) {
+        // 1行下へスライド: 下端の1行だけ上流に問い合わせ、上端の行をデックから除外
+        window.origin.y = request.origin.y;
+        pushRangeRow(upstream, request, expansion);
+        const int32_t firstRow = from_fixed_floor(request.origin.y) - static_cast<int32_t>(expansion);
+        while (!window.minStart.empty() && window.minStart.front() < firstRow) window.minStart.popFront();
+        while (!window.maxEnd.empty() && window.maxEnd.front() < firstRow) window.maxEnd.popFront();
+    } else if (!sameColumn || request.origin.y != window.origin.y) {
+        // ウィンドウを再構築（初回・列の変更・上方向や飛び越しの移動）
+        const auto windowRows = static_cast<size_t>(expansion * 2 + 1);
+        window.history.assign(windowRows, DataRange{0, 0});
+        window.minStart.reset(windowRows);
+        window.maxEnd.reset(windowRows);
+        window.origin = request.origin;
+        window.width = request.width;
+        window.valid = true;
+        for (auto dy = static_cast<int_fast16_t>(-expansion); dy <= expansion; ++dy) {
+            pushRangeRow(upstream, request, dy);
+        }
+    }
+
     int16_t startX = INT16_MAX;
     int16_t endX = INT16_MIN;
-
-    // ブラーカーネル範囲内の全行のX範囲の和集合を計算
-    RenderRequest rowRequest = request;
-    int_fixed baseY = request.origin.y;
-    for (auto dy = static_cast<int_fast16_t>(-expansion); dy <= expansion; ++dy) {
-        rowRequest.origin.y = baseY + to_fixed(dy);
-        DataRange rowRange = upstream->getDataRange(rowRequest);
-        if (rowRange.hasData()) {
-            if (rowRange.startX < startX) startX = rowRange.startX;
-            if (rowRange.endX > endX) endX = rowRange.endX;
-        }
+    if (!window.minStart.empty()) {
+        startX = window.history[window.slot(window.minStart.front())].startX;
+        endX = window.history[window.slot(window.maxEnd.front())].endX;
     }
 
     // キャッシュに保存
@@ -285,6 +558,29 @@ DataRange VerticalBlurNode::getDataRange(const RenderRequest& request) const {
     return DataRange{startX, endX};
 }
 
+void VerticalBlurNode::pushRangeRow(Node* upstream, const RenderRequest& request, int_fast16_t dy) const {
+    RangeWindow& window = rangeWindow_;
+    RenderRequest rowRequest = request;
+    rowRequest.origin.y = request.origin.y + to_fixed(dy);
+    const DataRange rowRange = upstream->getDataRange(rowRequest);
+
+    const int32_t row = from_fixed_floor(rowRequest.origin.y);
+    window.history[window.slot(row)] = rowRange;
+    if (!rowRange.hasData()) return;
+
+    // 単調デックの末尾から、新しい行に支配される行を取り除いて追加
+    while (!window.minStart.empty()
+           && window.history[window.slot(window.minStart.back())].startX >= rowRange.startX) {
+        window.minStart.popBack();
+    }
+    window.minStart.pushBack(row);
+    while (!window.maxEnd.empty()
+           && window.history[window.slot(window.maxEnd.back())].endX <= rowRange.endX) {
+        window.maxEnd.popBack();
+    }
+    window.maxEnd.pushBack(row);
+}
+
 // ========================================
 // Template Method フック
 // ========================================
@@ -313,19 +609,24 @@ PrepareResponse VerticalBlurNode::onPullPrepare(const PrepareRequest& request) {
     // radius=0でも保存しておく（getDataRangeで使用）
     sourceOriginY_ = upstreamResult.origin.y;
     sourceHeight_ = upstreamResult.height;
+    rangeWindow_.valid = false;
 
     // radius=0の場合はパススルー（キャッシュ不要）
     if (radius_ == 0 || passes_ == 0) {
         return upstreamResult;
     }
 
+    // 1バイト1チャンネルの上流は単一チャンネルパスで処理（出力も同じフォーマット）
+    channelFormat_ = isSingleChannel8(upstreamResult.preferredFormat)
+                   ? upstreamResult.preferredFormat : nullptr;
+
     // 上流AABBに基づいてキャッシュを初期化
     cacheOriginX_ = upstreamResult.origin.x;
     initializeStages(upstreamResult.width);
 
 #ifdef FLEXIMG_DEBUG_PERF_METRICS
-    // パイプライン方式: 各ステージ (radius*2+1)*width*4 + width*16
-    size_t cacheBytes = static_cast<size_t>(passes_) * (static_cast<size_t>(kernelSize()) * static_cast<size_t>(cacheWidth_) * 4 + static_cast<size_t>(cacheWidth_) * 4 * sizeof(uint32_t));
+    // パイプライン方式: 各ステージ (radius*2+1)*width*bpp + width*4*列合計数
+    size_t cacheBytes = static_cast<size_t>(passes_) * (static_cast<size_t>(kernelSize()) * static_cast<size_t>(cacheWidth_) * cacheBytesPerPixel() + static_cast<size_t>(cacheWidth_) * cacheBytesPerPixel() * sizeof(uint32_t));
     PerfMetrics::instance().nodes[NodeType::VerticalBlur].recordAlloc(
         cacheBytes, cacheWidth_, kernelSize() * passes_);
 #endif
@@ -360,6 +661,9 @@ PrepareResponse VerticalBlurNode::onPushPrepare(const PrepareRequest& request) {
         return downstreamResult;
     }
 
+    // push型は RGBA8 パスのみ
+    channelFormat_ = nullptr;
+
     // push用状態を初期化（下流から取得したサイズを使用）
     pushInputY_ = 0;
     pushOutputY_ = 0;
@@ -406,15 +710,13 @@ void VerticalBlurNode::onPushProcess(RenderResponse& input, const RenderRequest&
     }
 
     if (!input.isValid()) {
-        std::memset(stage0.rowCache[static_cast<size_t>(slot0)].view().data, 0, static_cast<size_t>(cacheWidth_) * 4);
+        stage0.rowDataRange[static_cast<size_t>(slot0)] = DataRange{};
     } else {
-        // バッファ準備
+        // バッファ準備（RGBA8以外は変換、RGBA8はそのまま行リングへコピー）
         consolidateIfNeeded(input);
         inputOrigin = input.origin;  // consolidate後のoriginを反映
-        ImageBuffer converted = convertFormat(ImageBuffer(input.buffer()),
-                                               PixelFormatIDs::RGBA8_Straight);
         int_fast16_t xOffset = static_cast<int_fast16_t>(from_fixed(inputOrigin.x - baseOriginX_));
-        storeInputRowToStageCache(stage0, converted, slot0, xOffset);
+        storeInputRowToStageCache(stage0, input.view(), slot0, xOffset);
     }
     stage0.rowOriginX[static_cast<size_t>(slot0)] = inputOrigin.x;
 
@@ -453,7 +755,7 @@ void VerticalBlurNode::onPushFinalize() {
         if (stage0.pushInputY >= ks) {
             updateStageColSum(stage0, slot0, false);
         }
-        std::memset(stage0.rowCache[static_cast<size_t>(slot0)].view().data, 0, static_cast<size_t>(cacheWidth_) * 4);
+        stage0.rowDataRange[static_cast<size_t>(slot0)] = DataRange{};
 
         // パディング行は画像の下端より下なのでorigin.yは増加する（新座標系）
         lastInputOriginY_ += to_fixed(1);
@@ -541,31 +843,15 @@ RenderResponse& VerticalBlurNode::pullProcessPipeline(Node* upstream, const Rend
     metrics.usedPixels += static_cast<uint64_t>(outputWidth) * 1;
 #endif
 
-    ImageBuffer output(outputWidth, 1, PixelFormatIDs::RGBA8_Straight,
-                      InitPolicy::Uninitialized);
+    ImageBuffer output(outputWidth, 1, cacheFormat(), InitPolicy::Uninitialized);
 
 #ifdef FLEXIMG_DEBUG_PERF_METRICS
     metrics.recordAlloc(output.totalBytes(), output.width(), output.height());
 #endif
 
     // 最終ステージの列合計から出力行を計算（有効範囲のみ）
-    BlurStage& lastStage = stages_[static_cast<size_t>(passes_ - 1)];
-    uint8_t* outRow = static_cast<uint8_t*>(output.view().data);
-    int_fast16_t ks = kernelSize();
-
-    for (int_fast16_t cacheX = srcStartX; cacheX < srcEndX; cacheX++) {
-        size_t outOff = static_cast<size_t>(cacheX - srcStartX) * 4;
-
-        if (lastStage.colSumA[static_cast<size_t>(cacheX)] > 0) {
-            size_t cx = static_cast<size_t>(cacheX);
-            outRow[outOff]     = static_cast<uint8_t>(lastStage.colSumR[cx] / lastStage.colSumA[cx]);
-            outRow[outOff + 1] = static_cast<uint8_t>(lastStage.colSumG[cx] / lastStage.colSumA[cx]);
-            outRow[outOff + 2] = static_cast<uint8_t>(lastStage.colSumB[cx] / lastStage.colSumA[cx]);
-            outRow[outOff + 3] = static_cast<uint8_t>(lastStage.colSumA[cx] / static_cast<uint32_t>(ks));
-        } else {
-            outRow[outOff] = outRow[outOff + 1] = outRow[outOff + 2] = outRow[outOff + 3] = 0;
-        }
-    }
+    computeStageOutputRow(stages_[static_cast<size_t>(passes_ - 1)],
+                          static_cast<uint8_t*>(output.view().data), srcStartX, srcEndX);
 
     // 出力の origin を計算（バッファ左上のワールド座標）
     Point outputOrigin;
@@ -623,14 +909,12 @@ void VerticalBlurNode::fetchRowToStageCache(BlurStage& stage, Node* upstream, co
     upstreamReq.origin.x = cacheOriginX_;
     upstreamReq.origin.y = to_fixed(srcY);
 
-    // 上流のデータ範囲を取得して記録
-    DataRange dataRange = upstream->getDataRange(upstreamReq);
-    stage.rowDataRange[static_cast<size_t>(cacheIndex)] = dataRange;
-
-    // キャッシュ行をゼロクリア
-    ViewPort dstView = stage.rowCache[static_cast<size_t>(cacheIndex)].view();
-    std::memset(dstView.data, 0, static_cast<size_t>(cacheWidth_) * 4);
+    // 格納範囲はコピーした範囲のみ（ゼロクリアは不要）
+    DataRange& stored = stage.rowDataRange[static_cast<size_t>(cacheIndex)];
+    stored = DataRange{};
 
+    // 上流のデータ範囲を取得
+    DataRange dataRange = upstream->getDataRange(upstreamReq);
     if (!dataRange.hasData()) {
         return;
     }
@@ -640,8 +924,8 @@ void VerticalBlurNode::fetchRowToStageCache(BlurStage& stage, Node* upstream, co
         return;
     }
 
-    // バッファ準備
-    consolidateIfNeeded(result);
+    // バッファ準備（キャッシュと同じフォーマットに変換）
+    consolidateIfNeeded(result, cacheFormat());
 
     // upstreamOriginX_はpullProcessPipelineで出力のorigin.x計算に使用
     // アフィン変換された場合、各行のorigin.xが異なる可能性があるため、
@@ -651,9 +935,8 @@ void VerticalBlurNode::fetchRowToStageCache(BlurStage& stage, Node* upstream, co
         upstreamOriginXSet_ = true;
     }
 
-    ImageBuffer converted = convertFormat(ImageBuffer(result.buffer()),
-                                           PixelFormatIDs::RGBA8_Straight);
-    ViewPort srcView = converted.view();
+    ViewPort srcView = result.view();
+    const size_t bpp = cacheBytesPerPixel();
 
     // 入力データをキャッシュにコピー（オフセット考慮）
     // cacheOriginX_（更新済み）を使用して正しい座標でコピーする
@@ -663,8 +946,11 @@ void VerticalBlurNode::fetchRowToStageCache(BlurStage& stage, Node* upstream, co
     int_fast16_t srcStartX = std::max<int_fast16_t>(0, -srcOffsetX);
     int_fast16_t copyWidth = std::min<int_fast16_t>(static_cast<int_fast16_t>(srcView.width) - srcStartX, cacheWidth_ - dstStartX);
     if (copyWidth > 0) {
-        const uint8_t* srcPtr = static_cast<const uint8_t*>(srcView.data) + srcStartX * 4;
-        std::memcpy(static_cast<uint8_t*>(dstView.data) + dstStartX * 4, srcPtr, static_cast<size_t>(copyWidth) * 4);
+        // 参照モードの上流バッファはビュー位置 (x, y) を持つため pixelAt で先頭を求める
+        const auto* srcPtr = static_cast<const uint8_t*>(srcView.pixelAt(static_cast<int>(srcStartX), 0));
+        std::memcpy(stage.row(cacheIndex) + static_cast<size_t>(dstStartX) * bpp, srcPtr,
+                    static_cast<size_t>(copyWidth) * bpp);
+        stored = DataRange{static_cast<int16_t>(dstStartX), static_cast<int16_t>(dstStartX + copyWidth)};
     }
 
     (void)request;  // 現在は未使用（将来の拡張用）
@@ -679,63 +965,59 @@ void VerticalBlurNode::fetchRowFromPrevStage(int_fast16_t stageIndex, Node* upst
     updateStageCache(stageIndex - 1, upstream, request, srcY);
 
     // 前段ステージの列合計から1行を計算してキャッシュに格納
-    ViewPort dstView = stage.rowCache[static_cast<size_t>(cacheIndex)].view();
-    uint8_t* dstRow = static_cast<uint8_t*>(dstView.data);
-
-    // 有効範囲を追跡
-    int16_t startX = static_cast<int16_t>(cacheWidth_);
-    int16_t endX = 0;
+    storeStageOutputRow(prevStage, stage, cacheIndex);
+}
 
-    int_fast16_t ks = kernelSize();
-    for (size_t x = 0; x < static_cast<size_t>(cacheWidth_); x++) {
-        size_t off = x * 4;
-        if (prevStage.colSumA[x] > 0) {
-            dstRow[off]     = static_cast<uint8_t>(prevStage.colSumR[x] / prevStage.colSumA[x]);
-            dstRow[off + 1] = static_cast<uint8_t>(prevStage.colSumG[x] / prevStage.colSumA[x]);
-            dstRow[off + 2] = static_cast<uint8_t>(prevStage.colSumB[x] / prevStage.colSumA[x]);
-            dstRow[off + 3] = static_cast<uint8_t>(prevStage.colSumA[x] / static_cast<uint32_t>(ks));
-            // 有効範囲を更新
-            if (static_cast<int16_t>(x) < startX) startX = static_cast<int16_t>(x);
-            endX = static_cast<int16_t>(x + 1);
-        } else {
-            dstRow[off] = dstRow[off + 1] = dstRow[off + 2] = dstRow[off + 3] = 0;
-        }
+void VerticalBlurNode::storeStageOutputRow(const BlurStage& prevStage, BlurStage& stage, int_fast16_t cacheIndex) {
+    // 前段の列合計が非0になり得るのは前段キャッシュ行の格納範囲の和集合のみ
+    const DataRange extent = prevStage.storedExtent();
+    stage.rowDataRange[static_cast<size_t>(cacheIndex)] = extent;
+    if (extent.hasData()) {
+        computeStageOutputRow(prevStage, stage.row(cacheIndex) + static_cast<size_t>(extent.startX) * cacheBytesPerPixel(),
+                              extent.startX, extent.endX);
     }
-
-    // DataRangeを記録
-    stage.rowDataRange[static_cast<size_t>(cacheIndex)] = DataRange{startX, endX};
 }
 
 void VerticalBlurNode::updateStageColSum(BlurStage& stage, int_fast16_t cacheIndex, bool add) {
-    const uint8_t* row = static_cast<const uint8_t*>(stage.rowCache[static_cast<size_t>(cacheIndex)].view().data);
-    int_fast16_t sign = add ? 1 : -1;
-    for (size_t x = 0; x < static_cast<size_t>(cacheWidth_); x++) {
-        size_t off = x * 4;
-        int32_t a = row[off + 3] * sign;
-        int32_t ra = row[off] * a;
-        int32_t ga = row[off + 1] * a;
-        int32_t ba = row[off + 2] * a;
-        stage.colSumR[x] += static_cast<uint32_t>(ra);
-        stage.colSumG[x] += static_cast<uint32_t>(ga);
-        stage.colSumB[x] += static_cast<uint32_t>(ba);
-        stage.colSumA[x] += static_cast<uint32_t>(a);
+    // 格納範囲の外は0なので加減算しない
+    const DataRange range = stage.rowDataRange[static_cast<size_t>(cacheIndex)];
+    if (!range.hasData()) return;
+    const auto begin = static_cast<size_t>(range.startX);
+    const auto count = static_cast<size_t>(range.endX - range.startX);
+    if (channelFormat_) {
+        const uint8_t* row = stage.row(cacheIndex) + begin;
+        uint32_t* sums = stage.colSum.data() + begin;
+        if (add) {
+            for (size_t x = 0; x < count; x++) sums[x] += row[x];
+        } else {
+            for (size_t x = 0; x < count; x++) sums[x] -= row[x];
+        }
+        return;
+    }
+    const uint8_t* row = stage.row(cacheIndex) + begin * 4;
+    uint32_t* sums = stage.colSum.data() + begin * 4;
+    if (add) {
+        vertical_blur_detail::accumulateRow<true>(sums, row, count);
+    } else {
+        vertical_blur_detail::accumulateRow<false>(sums, row, count);
     }
 }
 
-void VerticalBlurNode::computeStageOutputRow(BlurStage& stage, ImageBuffer& output, int_fast16_t width) {
-    uint8_t* outRow = static_cast<uint8_t*>(output.view().data);
-    int_fast16_t ks = kernelSize();
-    for (size_t x = 0; x < static_cast<size_t>(width); x++) {
-        size_t off = x * 4;
-        if (stage.colSumA[x] > 0) {
-            outRow[off]     = static_cast<uint8_t>(stage.colSumR[x] / stage.colSumA[x]);
-            outRow[off + 1] = static_cast<uint8_t>(stage.colSumG[x] / stage.colSumA[x]);
-            outRow[off + 2] = static_cast<uint8_t>(stage.colSumB[x] / stage.colSumA[x]);
-            outRow[off + 3] = static_cast<uint8_t>(stage.colSumA[x] / static_cast<uint32_t>(ks));
-        } else {
-            outRow[off] = outRow[off + 1] = outRow[off + 2] = outRow[off + 3] = 0;
+void VerticalBlurNode::computeStageOutputRow(const BlurStage& stage, uint8_t* dst,
+                                             int_fast16_t startX, int_fast16_t endX) const {
+    const auto ks = static_cast<uint32_t>(kernelSize());
+    const auto begin = static_cast<size_t>(startX);
+    const auto count = static_cast<size_t>(endX - startX);
+    if (channelFormat_) {
+        // 単一チャンネル: Σ / ks（Σ ≤ 255×ks のため固定小数点逆数で正確）
+        const uint64_t recip = vertical_blur_detail::kernelReciprocal(ks);
+        const uint32_t* sums = stage.colSum.data() + begin;
+        for (size_t i = 0; i < count; i++) {
+            dst[i] = static_cast<uint8_t>((sums[i] * recip) >> 32);
         }
+        return;
     }
+    vertical_blur_detail::resolveRow(dst, stage.colSum.data() + begin * 4, count, ks);
 }
 
 // ========================================
@@ -744,17 +1026,13 @@ void VerticalBlurNode::computeStageOutputRow(BlurStage& stage, ImageBuffer& outp
 
 void VerticalBlurNode::initializeStage(BlurStage& stage, int_fast16_t width) {
     size_t cacheRows = static_cast<size_t>(kernelSize());  // radius*2+1
-    stage.rowCache.resize(cacheRows);
+    // 全行を1回で確保（内容は格納範囲で管理するため初期化不要）
+    stage.rows = ImageBuffer(width, static_cast<int_fast16_t>(cacheRows), cacheFormat(),
+                             InitPolicy::Uninitialized, allocator());
     stage.rowOriginX.assign(cacheRows, 0);
     stage.rowDataRange.assign(cacheRows, DataRange{0, 0});  // 空範囲で初期化
-    for (size_t i = 0; i < cacheRows; i++) {
-        stage.rowCache[i] = ImageBuffer(width, 1, PixelFormatIDs::RGBA8_Straight,
-                                        InitPolicy::Zero, allocator());
-    }
-    stage.colSumR.assign(static_cast<size_t>(width), 0);
-    stage.colSumG.assign(static_cast<size_t>(width), 0);
-    stage.colSumB.assign(static_cast<size_t>(width), 0);
-    stage.colSumA.assign(static_cast<size_t>(width), 0);
+    // 単一チャンネルパスでは色の列合計は不要（ピクセルあたり1要素）
+    stage.colSum.assign(static_cast<size_t>(width) * (channelFormat_ ? 1 : 4), 0);
     stage.currentY = 0;
     stage.cacheReady = false;
 }
@@ -779,23 +1057,6 @@ void VerticalBlurNode::propagatePipelineStages() {
         BlurStage& prevStage = stages_[static_cast<size_t>(s - 1)];
         BlurStage& stage = stages_[static_cast<size_t>(s)];
 
-        // 前段ステージの列合計から1行を計算
-        ImageBuffer stageInput(cacheWidth_, 1, PixelFormatIDs::RGBA8_Straight,
-                               InitPolicy::Uninitialized);
-        uint8_t* stageRow = static_cast<uint8_t*>(stageInput.view().data);
-
-        for (size_t x = 0; x < static_cast<size_t>(cacheWidth_); x++) {
-            size_t off = x * 4;
-            if (prevStage.colSumA[x] > 0) {
-                stageRow[off]     = static_cast<uint8_t>(prevStage.colSumR[x] / prevStage.colSumA[x]);
-                stageRow[off + 1] = static_cast<uint8_t>(prevStage.colSumG[x] / prevStage.colSumA[x]);
-                stageRow[off + 2] = static_cast<uint8_t>(prevStage.colSumB[x] / prevStage.colSumA[x]);
-                stageRow[off + 3] = static_cast<uint8_t>(prevStage.colSumA[x] / static_cast<uint32_t>(ks));
-            } else {
-                stageRow[off] = stageRow[off + 1] = stageRow[off + 2] = stageRow[off + 3] = 0;
-            }
-        }
-
         // 前段の出力行カウントを更新
         prevStage.pushOutputY++;
 
@@ -807,10 +1068,8 @@ void VerticalBlurNode::propagatePipelineStages() {
             updateStageColSum(stage, slot, false);
         }
 
-        // 新しい行をキャッシュに格納
-        ViewPort srcView = stageInput.view();
-        ViewPort dstView = stage.rowCache[static_cast<size_t>(slot)].view();
-        std::memcpy(dstView.data, srcView.data, static_cast<size_t>(cacheWidth_) * 4);
+        // 前段ステージの列合計から1行を計算してキャッシュに格納
+        storeStageOutputRow(prevStage, stage, slot);
 
         // 新しい行を列合計に加算
         updateStageColSum(stage, slot, true);
@@ -829,22 +1088,14 @@ void VerticalBlurNode::propagatePipelineStages() {
 
 void VerticalBlurNode::emitBlurredLinePipeline() {
     BlurStage& lastStage = stages_[static_cast<size_t>(passes_ - 1)];
-    int_fast16_t ks = kernelSize();
 
+    // 列合計が非0になり得る範囲のみ計算（範囲外はゼロ初期化のまま）
     ImageBuffer output(cacheWidth_, 1, PixelFormatIDs::RGBA8_Straight,
-                      InitPolicy::Uninitialized);
-    uint8_t* outRow = static_cast<uint8_t*>(output.view().data);
-
-    for (size_t x = 0; x < static_cast<size_t>(cacheWidth_); x++) {
-        size_t off = x * 4;
-        if (lastStage.colSumA[x] > 0) {
-            outRow[off]     = static_cast<uint8_t>(lastStage.colSumR[x] / lastStage.colSumA[x]);
-            outRow[off + 1] = static_cast<uint8_t>(lastStage.colSumG[x] / lastStage.colSumA[x]);
-            outRow[off + 2] = static_cast<uint8_t>(lastStage.colSumB[x] / lastStage.colSumA[x]);
-            outRow[off + 3] = static_cast<uint8_t>(lastStage.colSumA[x] / static_cast<uint32_t>(ks));
-        } else {
-            outRow[off] = outRow[off + 1] = outRow[off + 2] = outRow[off + 3] = 0;
-        }
+                      InitPolicy::Zero);
+    const DataRange extent = lastStage.storedExtent();
+    if (extent.hasData()) {
+        computeStageOutputRow(lastStage, static_cast<uint8_t*>(output.view().data) + static_cast<size_t>(extent.startX) * 4,
+                              extent.startX, extent.endX);
     }
 
     lastStage.pushOutputY++;
@@ -871,15 +1122,8 @@ void VerticalBlurNode::emitBlurredLinePipeline() {
     }
 }
 
-void VerticalBlurNode::storeInputRowToStageCache(BlurStage& stage, const ImageBuffer& input, int_fast16_t cacheIndex, int_fast16_t xOffset) {
-    ViewPort srcView = input.view();
-    ViewPort dstView = stage.rowCache[static_cast<size_t>(cacheIndex)].view();
-    const uint8_t* srcData = static_cast<const uint8_t*>(srcView.data);
-    uint8_t* dstData = static_cast<uint8_t*>(dstView.data);
-    int_fast16_t srcWidth = static_cast<int_fast16_t>(srcView.width);
-
-    // キャッシュをゼロクリア
-    std::memset(dstData, 0, static_cast<size_t>(cacheWidth_) * 4);
+void VerticalBlurNode::storeInputRowToStageCache(BlurStage& stage, const ViewPort& input, int_fast16_t cacheIndex, int_fast16_t xOffset) {
+    auto srcWidth = static_cast<int_fast16_t>(input.width);
 
     // コピー範囲の計算（pull pathのfetchRowToStageCacheと同じロジック）
     // xOffset > 0: 入力がキャッシュより右にある → cache[xOffset]に書き込み
@@ -888,8 +1132,13 @@ void VerticalBlurNode::storeInputRowToStageCache(BlurStage& stage, const ImageBu
     int_fast16_t srcStart = std::max<int_fast16_t>(0, -xOffset);
     int_fast16_t copyWidth = std::min<int_fast16_t>(srcWidth - srcStart, cacheWidth_ - dstStart);
 
+    // 格納範囲はコピーした範囲のみ（ゼロクリアは不要）
+    DataRange& stored = stage.rowDataRange[static_cast<size_t>(cacheIndex)];
+    stored = DataRange{};
     if (copyWidth > 0) {
-        std::memcpy(dstData + dstStart * 4, srcData + srcStart * 4, static_cast<size_t>(copyWidth) * 4);
+        std::memcpy(stage.row(cacheIndex) + static_cast<size_t>(dstStart) * 4,
+                    input.pixelAt(static_cast<int>(srcStart), 0), static_cast<size_t>(copyWidth) * 4);
+        stored = DataRange{static_cast<int16_t>(dstStart), static_cast<int16_t>(dstStart + copyWidth)};
     }
 }
 
@@ -0,0 +1,194 @@
+#ifndef FLEXIMG_WARP_NODE_H
+#define FLEXIMG_WARP_NODE_H
+
+#include "../core/node.h"
+#include "../core/perf_metrics.h"
+#include "../core/warp_mesh.h"
+#include "../image/viewport.h"
+
+namespace FLEXIMG_NAMESPACE {
+
+// ========================================================================
+// WarpNode - メッシュワープノード
+// ========================================================================
+//
+// 制御点格子（WarpMesh）による任意変形を入力画像に適用します。
+// レンズ歪み、波形エフェクト、ページめくり等の非線形変形に使用します。
+// - 入力: 1ポート
+// - 出力: 1ポート
+//
+// 特徴:
+// - AffineNode/PerspectiveNodeと同様、写像を上流のSourceNodeへ伝播するのみ
+// - 実際のサンプリングはSourceNodeが行う（スパン単位の線形DDA）
+//   スパン両端で写像を正確に評価し、間は copyRowDDA / copyRowDDABilinear で補間
+// - 下流側の射影/アフィン行列は自身の写像に取り込み、
+//   上流側のAffineNode/PerspectiveNodeは従来通り累積する
+// - getDataRange はメッシュ外接矩形からスキャンライン単位で求める
+//
+// 制御点の意味:
+// - 格子点の位置で「上流側のどの座標をサンプリングするか」を指定する
+// - 初期値は格子点自身（恒等写像）、setDisplacement で変位として設定可能
+//
+// 注意:
+// - プル型のみ対応（プッシュ型パイプラインではパススルー）
+// - ディスプレイスメントマップは格子点ごとに1回サンプリングして制御点に変換する
+//   （ピクセル単位のマップ参照は行わない）
+//
+// 使用例:
+//   WarpNode warp;
+//   warp.setGrid(8, 8, -64, -64, 16, 16);   // 128x128 を 8x8 セルに分割
+//   warp.setDisplacement(4, 4, 6.0f, -3.0f);
+//   src >> warp >> renderer >> sink;
+//
+
+class WarpNode : public Node {
+public:
+    WarpNode() {
+        initPorts(1, 1);  // 入力1、出力1
+    }
+
+    // ========================================
+    // メッシュ設定
+    // ========================================
+
+    // 格子を設定（制御点は恒等写像で初期化）
+    void setGrid(int_fast16_t cols, int_fast16_t rows,
+                 float x, float y, float cellWidth, float cellHeight) {
+        mesh_.setGrid(cols, rows, x, y, cellWidth, cellHeight);
+        markModified();
+    }
+
+    void setControlPoint(int_fast16_t col, int_fast16_t row, float srcX, float srcY) {
+        mesh_.setPoint(col, row, srcX, srcY);
+        markModified();
+    }
+
+    void setDisplacement(int_fast16_t col, int_fast16_t row, float dx, float dy) {
+        mesh_.setDisplacement(col, row, dx, dy);
+        markModified();
+    }
+
+    // ディスプレイスメントマップから制御点を設定
+    // マップ全体を格子全体に対応させ、各格子点の位置の画素から変位を求める
+    // 変位 = (R - 128) / 127 * scaleX, (G - 128) / 127 * scaleY
+    // bit-packed形式のマップは未対応（何もしない）
+    void setDisplacementMap(const ViewPort& map, float scaleX, float scaleY);
+
+    WarpMesh& mesh() { return mesh_; }
+    const WarpMesh& mesh() const { return mesh_; }
+
+    // ========================================
+    // Node インターフェース
+    // ========================================
+
+    const char* name() const override { return "WarpNode"; }
+
+    // getDataSegments: 上流パススルー（範囲は上流のSourceNodeが変換込みで算出）
+    int_fast16_t getDataSegments(const RenderRequest& request,
+                                 DataRange* segments, int_fast16_t maxCount) const override {
+        Node* upstream = upstreamNode(0);
+        return upstream ? upstream->getDataSegments(request, segments, maxCount) : 0;
+    }
+
+protected:
+    // ========================================
+    // Template Method フック
+    // ========================================
+
+    // onPullPrepare: ワープ写像を上流に伝播し、SourceNodeで一括実行
+    PrepareResponse onPullPrepare(const PrepareRequest& request) override;
+
+    // onPullProcess: 写像を保持するのみ、パススルー
+    RenderResponse& onPullProcess(const RenderRequest& request) override;
+
+    int nodeTypeForMetrics() const override { return NodeType::Warp; }
+
+private:
+    WarpMesh mesh_;
+    WarpField field_;  // Prepare時に構築、上流のSourceNodeが参照
+};
+
+} // namespace FLEXIMG_NAMESPACE
+
+// =============================================================================
+// 実装部
+// =============================================================================
+#ifdef FLEXIMG_IMPLEMENTATION
+
+namespace FLEXIMG_NAMESPACE {
+
+// ============================================================================
+// WarpNode - メッシュ設定
+// ============================================================================
+
+void WarpNode::setDisplacementMap(const ViewPort& map, float scaleX, float scaleY) {
+    if (!map.isValid() || !mesh_.isValid() || map.formatID->pixelsPerUnit > 1) {
+        return;
+    }
+    const auto cols = mesh_.cols();
+    const auto rows = mesh_.rows();
+    constexpr float kInv127 = 1.0f / 127.0f;
+    for (int_fast16_t r = 0; r <= rows; ++r) {
+        const auto my = static_cast<int>((r * (map.height - 1) + rows / 2) / rows);
+        for (int_fast16_t c = 0; c <= cols; ++c) {
+            const auto mx = static_cast<int>((c * (map.width - 1) + cols / 2) / cols);
+            uint8_t rgba[4] = {128, 128, 0, 0};
+            FLEXIMG_NAMESPACE::convertFormat(map.pixelAt(mx, my), map.formatID,
+                                             rgba, PixelFormatIDs::RGBA8_Straight, 1);
+            mesh_.setDisplacement(c, r,
+                static_cast<float>(rgba[0] - 128) * kInv127 * scaleX,
+                static_cast<float>(rgba[1] - 128) * kInv127 * scaleY);
+        }
+    }
+    markModified();
+}
+
+// ============================================================================
+// WarpNode - Template Method フック実装
+// ============================================================================
+
+PrepareResponse WarpNode::onPullPrepare(const PrepareRequest& request) {
+    // 下流側の変換（射影 * アフィン）: WarpNode出力座標 → ワールド座標
+    PerspectiveMatrix downstream = request.hasPerspective
+                                 ? request.perspectiveMatrix : PerspectiveMatrix();
+    if (request.hasAffine) {
+        downstream = downstream * request.affineMatrix;
+    }
+    field_.mesh = &mesh_;
+    field_.forward = downstream;
+    field_.valid = mesh_.isValid() && downstream.inverse(field_.view);
+    field_.outer = request.warp;
+
+    // 上流に渡すためのコピーを作成
+    // 下流側の行列はWarpFieldに取り込み済みのため、上流側はここから新たに累積する
+    PrepareRequest upstreamRequest = request;
+    upstreamRequest.warp = &field_;
+    upstreamRequest.perspectiveMatrix = PerspectiveMatrix();
+    upstreamRequest.hasPerspective = false;
+    upstreamRequest.affineMatrix = AffineMatrix();
+    upstreamRequest.hasAffine = false;
+
+    // 上流へ伝播
+    Node* upstream = upstreamNode(0);
+    if (upstream) {
+        return upstream->pullPrepare(upstreamRequest);  // パススルー
+    }
+    // 上流なし: 有効なデータがないのでサイズ0を返す
+    PrepareResponse result;
+    result.status = PrepareStatus::Prepared;
+    return result;
+}
+
+RenderResponse& WarpNode::onPullProcess(const RenderRequest& request) {
+    Node* upstream = upstreamNode(0);
+    if (upstream) {
+        return upstream->pullProcess(request);
+    }
+    return makeEmptyResponse(request.origin);
+}
+
+} // namespace FLEXIMG_NAMESPACE
+
+#endif // FLEXIMG_IMPLEMENTATION
+
+#endif // FLEXIMG_WARP_NODE_H
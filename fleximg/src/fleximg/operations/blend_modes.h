@@ -0,0 +1,287 @@
+#ifndef FLEXIMG_OPERATIONS_BLEND_MODES_H
+#define FLEXIMG_OPERATIONS_BLEND_MODES_H
+
+#include <cstddef>
+#include <cstdint>
+#include "../core/common.h"
+
+namespace FLEXIMG_NAMESPACE {
+
+// ========================================================================
+// BlendMode - レイヤー合成モード
+// ========================================================================
+//
+// 前面レイヤー（src）を背面（backdrop）に重ねる際の色の合成方法です。
+// W3C Compositing and Blending の分離可能ブレンドモードに準拠し、
+// ストレートアルファで source-over 合成します:
+//
+//   αo = αs + αb * (1 - αs)
+//   Co = (αs(1-αb)Cs + αsαb B(Cb,Cs) + (1-αs)αb Cb) / αo
+//
+// B(Cb, Cs) はモードごとのブレンド関数（各チャンネル独立）。
+//
+
+enum class BlendMode : uint8_t {
+    Normal = 0,   // B = Cs（通常の重ね合わせ）
+    Multiply,     // B = Cb * Cs
+    Screen,       // B = Cb + Cs - Cb * Cs
+    Add,          // B = min(1, Cb + Cs)（リニアドッジ）
+    Overlay,      // Cb < 0.5 ? 2CbCs : Screen(2Cb-1, Cs)
+    Darken,       // B = min(Cb, Cs)
+    Lighten,      // B = max(Cb, Cs)
+    Difference,   // B = |Cb - Cs|
+    Count
+};
+
+namespace blend {
+
+// ========================================================================
+// BlendModeDescriptor - ブレンドモードの関数テーブル
+// ========================================================================
+//
+// PixelFormatDescriptor と同様、モードごとの処理を関数ポインタで保持します。
+// 利用側はPrepare時に関数ポインタを解決し、内側ループで分岐しません。
+//
+// blendOver の共通仕様（dst, src とも RGBA8_Straight、インプレース）:
+// - src が透明（α=0）のピクセルはスキップ（dst は変更しない）
+// - dst が透明（α=0）のピクセルは src をコピー
+// - 両方不透明のピクセルは B(Cb,Cs) のみ（除算なし）
+// - SIMD版は4ピクセル単位で上記の判定を行い、該当しないブロックはスカラー処理
+//   （結果はスカラー版とビット単位で一致）
+//
+
+/// 合成関数型（RGBA8_Straight の src を dst の前面に合成）
+using BlendOverFunc = void(*)(uint8_t* dst, const uint8_t* src, size_t pixelCount);
+
+struct BlendModeDescriptor {
+    const char* name;
+    BlendOverFunc blendOver;        // 利用可能な最速実装（SIMD対応時はSIMD版）
+    BlendOverFunc blendOverScalar;  // スカラー実装（フォールバック・検証用）
+};
+
+/// モードの関数テーブルを取得（範囲外は Normal）
+const BlendModeDescriptor& descriptor(BlendMode mode);
+
+} // namespace blend
+} // namespace FLEXIMG_NAMESPACE
+
+// =============================================================================
+// 実装部
+// =============================================================================
+#ifdef FLEXIMG_IMPLEMENTATION
+
+#include <cstring>
+#ifdef FLEXIMG_HAS_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace FLEXIMG_NAMESPACE {
+namespace blend {
+namespace detail {
+
+// a * b / 255（丸め付き、0〜255の入力で正確）
+static inline uint_fast32_t mul255(uint_fast32_t a, uint_fast32_t b) {
+    const uint_fast32_t t = a * b + 128;
+    return (t + (t >> 8)) >> 8;
+}
+
+// ========================================================================
+// チャンネル単位のブレンド関数 B(Cb, Cs)
+// ========================================================================
+//
+// apply  : スカラー版（0〜255）
+// apply16: SSE2版（16bitレーン、0〜255）
+//
+
+#ifdef FLEXIMG_HAS_SSE2
+static inline __m128i mul255_16(__m128i a, __m128i b) {
+    const __m128i t = _mm_add_epi16(_mm_mullo_epi16(a, b), _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+#endif
+
+struct NormalOp {
+    static uint_fast32_t apply(uint_fast32_t, uint_fast32_t s) { return s; }
+#ifdef FLEXIMG_HAS_SSE2
+    static __m128i apply16(__m128i, __m128i s) { return s; }
+#endif
+};
+
+struct MultiplyOp {
+    static uint_fast32_t apply(uint_fast32_t b, uint_fast32_t s) { return mul255(b, s); }
+#ifdef FLEXIMG_HAS_SSE2
+    static __m128i apply16(__m128i b, __m128i s) { return mul255_16(b, s); }
+#endif
+};
+
+struct ScreenOp {
+    static uint_fast32_t apply(uint_fast32_t b, uint_fast32_t s) { return b + s - mul255(b, s); }
+#ifdef FLEXIMG_HAS_SSE2
+    static __m128i apply16(__m128i b, __m128i s) {
+        return _mm_sub_epi16(_mm_add_epi16(b, s), mul255_16(b, s));
+    }
+#endif
+};
+
+struct AddOp {
+    static uint_fast32_t apply(uint_fast32_t b, uint_fast32_t s) { return (b + s > 255) ? 255 : b + s; }
+#ifdef FLEXIMG_HAS_SSE2
+    static __m128i apply16(__m128i b, __m128i s) {
+        return _mm_min_epi16(_mm_add_epi16(b, s), _mm_set1_epi16(255));
+    }
+#endif
+};
+
+struct OverlayOp {
+    static uint_fast32_t apply(uint_fast32_t b, uint_fast32_t s) {
+        return (b < 128) ? mul255(b * 2, s) : 255 - mul255((255 - b) * 2, 255 - s);
+    }
+#ifdef FLEXIMG_HAS_SSE2
+    static __m128i apply16(__m128i b, __m128i s) {
+        const __m128i v255 = _mm_set1_epi16(255);
+        const __m128i low = mul255_16(_mm_slli_epi16(b, 1), s);
+        const __m128i high = _mm_sub_epi16(v255, mul255_16(
+            _mm_slli_epi16(_mm_sub_epi16(v255, b), 1), _mm_sub_epi16(v255, s)));
+        const __m128i mask = _mm_cmplt_epi16(b, _mm_set1_epi16(128));
+        return _mm_or_si128(_mm_and_si128(mask, low), _mm_andnot_si128(mask, high));
+    }
+#endif
+};
+
+struct DarkenOp {
+    static uint_fast32_t apply(uint_fast32_t b, uint_fast32_t s) { return (b < s) ? b : s; }
+#ifdef FLEXIMG_HAS_SSE2
+    static __m128i apply16(__m128i b, __m128i s) { return _mm_min_epi16(b, s); }
+#endif
+};
+
+struct LightenOp {
+    static uint_fast32_t apply(uint_fast32_t b, uint_fast32_t s) { return (b > s) ? b : s; }
+#ifdef FLEXIMG_HAS_SSE2
+    static __m128i apply16(__m128i b, __m128i s) { return _mm_max_epi16(b, s); }
+#endif
+};
+
+struct DifferenceOp {
+    static uint_fast32_t apply(uint_fast32_t b, uint_fast32_t s) { return (b > s) ? b - s : s - b; }
+#ifdef FLEXIMG_HAS_SSE2
+    static __m128i apply16(__m128i b, __m128i s) {
+        return _mm_sub_epi16(_mm_max_epi16(b, s), _mm_min_epi16(b, s));
+    }
+#endif
+};
+
+// ========================================================================
+// ピクセル合成（スカラー）
+// ========================================================================
+
+template<class Op>
+static inline void blendPixel(uint8_t* d, const uint8_t* s) {
+    const uint_fast32_t as = s[3];
+    if (as == 0) return;
+    const uint_fast32_t ab = d[3];
+    if (ab == 0) {
+        std::memcpy(d, s, 4);
+        return;
+    }
+    if ((as & ab) == 255) {
+        // 両方不透明: B(Cb,Cs) のみ
+        d[0] = static_cast<uint8_t>(Op::apply(d[0], s[0]));
+        d[1] = static_cast<uint8_t>(Op::apply(d[1], s[1]));
+        d[2] = static_cast<uint8_t>(Op::apply(d[2], s[2]));
+        return;
+    }
+    // 重み（255^2 スケール、合計 = αo * 255）
+    const uint_fast32_t wS = as * (255 - ab);
+    const uint_fast32_t wB = as * ab;
+    const uint_fast32_t wD = (255 - as) * ab;
+    const uint_fast32_t total = wS + wB + wD;
+    const uint_fast32_t half = total >> 1;
+    for (int_fast8_t c = 0; c < 3; ++c) {
+        const uint_fast32_t cb = d[c];
+        const uint_fast32_t cs = s[c];
+        d[c] = static_cast<uint8_t>((wS * cs + wB * Op::apply(cb, cs) + wD * cb + half) / total);
+    }
+    d[3] = static_cast<uint8_t>((total + 127) / 255);
+}
+
+template<class Op>
+static void blendOverScalar(uint8_t* dst, const uint8_t* src, size_t pixelCount) {
+    for (size_t i = 0; i < pixelCount; ++i) {
+        blendPixel<Op>(dst + i * 4, src + i * 4);
+    }
+}
+
+// ========================================================================
+// ピクセル合成（SSE2、4ピクセル単位）
+// ========================================================================
+
+#ifdef FLEXIMG_HAS_SSE2
+template<class Op>
+static void blendOverSSE2(uint8_t* dst, const uint8_t* src, size_t pixelCount) {
+    const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= pixelCount; i += 4) {
+        uint8_t* d = dst + i * 4;
+        const uint8_t* s = src + i * 4;
+        const __m128i vs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+        const __m128i sa = _mm_and_si128(vs, alphaMask);
+        // src 全透明: スキップ
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(sa, zero)) == 0xFFFF) continue;
+
+        const __m128i vd = _mm_loadu_si128(reinterpret_cast<const __m128i*>(d));
+        const __m128i both = _mm_and_si128(_mm_and_si128(vs, vd), alphaMask);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(both, alphaMask)) == 0xFFFF) {
+            // 4ピクセルとも両方不透明: B(Cb,Cs) を16bitレーンで計算
+            const __m128i lo = Op::apply16(_mm_unpacklo_epi8(vd, zero), _mm_unpacklo_epi8(vs, zero));
+            const __m128i hi = Op::apply16(_mm_unpackhi_epi8(vd, zero), _mm_unpackhi_epi8(vs, zero));
+            const __m128i result = _mm_or_si128(_mm_packus_epi16(lo, hi), alphaMask);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(d), result);
+            continue;
+        }
+        for (size_t k = 0; k < 4; ++k) {
+            blendPixel<Op>(d + k * 4, s + k * 4);
+        }
+    }
+    for (; i < pixelCount; ++i) {
+        blendPixel<Op>(dst + i * 4, src + i * 4);
+    }
+}
+#define FLEXIMG_BLEND_OVER(Op) blendOverSSE2<Op>
+#else
+#define FLEXIMG_BLEND_OVER(Op) blendOverScalar<Op>
+#endif
+
+} // namespace detail
+
+// ========================================================================
+// ディスクリプタテーブル（BlendMode の順序と一致）
+// ========================================================================
+
+static const BlendModeDescriptor kBlendModes[] = {
+    {"Normal",     detail::FLEXIMG_BLEND_OVER(detail::NormalOp),     detail::blendOverScalar<detail::NormalOp>},
+    {"Multiply",   detail::FLEXIMG_BLEND_OVER(detail::MultiplyOp),   detail::blendOverScalar<detail::MultiplyOp>},
+    {"Screen",     detail::FLEXIMG_BLEND_OVER(detail::ScreenOp),     detail::blendOverScalar<detail::ScreenOp>},
+    {"Add",        detail::FLEXIMG_BLEND_OVER(detail::AddOp),        detail::blendOverScalar<detail::AddOp>},
+    {"Overlay",    detail::FLEXIMG_BLEND_OVER(detail::OverlayOp),    detail::blendOverScalar<detail::OverlayOp>},
+    {"Darken",     detail::FLEXIMG_BLEND_OVER(detail::DarkenOp),     detail::blendOverScalar<detail::DarkenOp>},
+    {"Lighten",    detail::FLEXIMG_BLEND_OVER(detail::LightenOp),    detail::blendOverScalar<detail::LightenOp>},
+    {"Difference", detail::FLEXIMG_BLEND_OVER(detail::DifferenceOp), detail::blendOverScalar<detail::DifferenceOp>},
+};
+static_assert(sizeof(kBlendModes) / sizeof(kBlendModes[0]) == static_cast<size_t>(BlendMode::Count),
+              "kBlendModes must match BlendMode");
+
+#undef FLEXIMG_BLEND_OVER
+
+const BlendModeDescriptor& descriptor(BlendMode mode) {
+    const auto index = static_cast<size_t>(mode);
+    return kBlendModes[index < static_cast<size_t>(BlendMode::Count) ? index : 0];
+}
+
+} // namespace blend
+} // namespace FLEXIMG_NAMESPACE
+
+#endif // FLEXIMG_IMPLEMENTATION
+
+#endif // FLEXIMG_OPERATIONS_BLEND_MODES_H
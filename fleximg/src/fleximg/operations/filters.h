@@ -19,6 +19,7 @@ namespace filters {
 struct LineFilterParams {
     float value1 = 0.0f;  ///< brightness amount, alpha scale 等
     float value2 = 0.0f;  ///< 将来の拡張用
+    const uint8_t* lut = nullptr;  ///< color_curve_line: チャンネル別LUT（R, G, B, A の順に各256エントリ）
 };
 
 /// ラインフィルタ関数型（RGBA8_Straight形式、インプレース処理）
@@ -44,6 +45,34 @@ void grayscale_line(uint8_t* pixels, int_fast16_t count, const LineFilterParams&
 /// params.value1: アルファスケール（0.0〜1.0）
 void alpha_line(uint8_t* pixels, int_fast16_t count, const LineFilterParams& params);
 
+/// チャンネル別LUT適用（ラインフィルタ版）
+/// params.lut: R, G, B, A の順に各256エントリ（nullptr の場合は何もしない）
+void color_curve_line(uint8_t* pixels, int_fast16_t count, const LineFilterParams& params);
+
+// ========================================================================
+// ラインフィルタの融合（連続したフィルタを1パスで適用）
+// ========================================================================
+//
+// FilterNodeBase が連続したフィルタノードを prepare 時にまとめ、
+// 1回のスキャンラインで全段を適用するために使用します。
+//
+
+/// ラインフィルタの段（関数 + パラメータ）
+struct LineFilterStage {
+    LineFilterFunc func = nullptr;
+    LineFilterParams params;
+};
+
+/// 融合できる段数の上限
+constexpr int_fast16_t kMaxLineFilterStages = 8;
+
+/// 複数のラインフィルタを stages[0] から順に適用（結果は各関数を順に呼んだ場合と一致）
+/// - 全段が brightness / grayscale / alpha: 1ピクセルを1回読み込み、全段をレジスタ上で適用して1回書き込む
+///   （SSE2 では4ピクセル同時）
+/// - それ以外の関数を含む: L1 に収まるブロック単位で各関数を順に適用
+void apply_line_chain(uint8_t* pixels, int_fast16_t count,
+                      const LineFilterStage* stages, int_fast16_t stageCount);
+
 } // namespace filters
 } // namespace FLEXIMG_NAMESPACE
 
@@ -55,6 +84,10 @@ void alpha_line(uint8_t* pixels, int_fast16_t count, const LineFilterParams& par
 #include <algorithm>
 #include <cstdint>
 
+#ifdef FLEXIMG_HAS_SSE2
+#include <emmintrin.h>
+#endif
+
 namespace FLEXIMG_NAMESPACE {
 namespace filters {
 
@@ -105,6 +138,190 @@ void alpha_line(uint8_t* pixels, int_fast16_t count, const LineFilterParams& par
     }
 }
 
+void color_curve_line(uint8_t* pixels, int_fast16_t count, const LineFilterParams& params) {
+    const uint8_t* lut = params.lut;
+    if (!lut) return;
+    const uint8_t* lutR = lut;
+    const uint8_t* lutG = lut + 256;
+    const uint8_t* lutB = lut + 512;
+    const uint8_t* lutA = lut + 768;
+
+    // lut8toN と同様、端数（奇数ピクセル）を先に処理してから
+    // 2ピクセル（8バイト）単位で「全読み→全LUT参照→全書き」
+    uint8_t* p = pixels;
+    if (count & 1) {
+        auto v0 = p[0];
+        auto v1 = p[1];
+        auto v2 = p[2];
+        auto v3 = p[3];
+        p[0] = lutR[v0]; p[1] = lutG[v1]; p[2] = lutB[v2]; p[3] = lutA[v3];
+        p += 4;
+    }
+    for (int_fast16_t n = count >> 1; n > 0; --n) {
+        auto v0 = p[0];
+        auto v1 = p[1];
+        auto v2 = p[2];
+        auto v3 = p[3];
+        auto v4 = p[4];
+        auto v5 = p[5];
+        auto v6 = p[6];
+        auto v7 = p[7];
+        auto l0 = lutR[v0];
+        auto l1 = lutG[v1];
+        auto l2 = lutB[v2];
+        auto l3 = lutA[v3];
+        auto l4 = lutR[v4];
+        auto l5 = lutG[v5];
+        auto l6 = lutB[v6];
+        auto l7 = lutA[v7];
+        p[0] = l0; p[1] = l1; p[2] = l2; p[3] = l3;
+        p[4] = l4; p[5] = l5; p[6] = l6; p[7] = l7;
+        p += 8;
+    }
+}
+
+// ========================================================================
+// ラインフィルタの融合
+// ========================================================================
+
+namespace {
+
+// 融合カーネルの演算（既知のラインフィルタ関数に対応）
+struct FusedOp {
+    enum Kind : uint8_t { Brightness, Grayscale, Alpha };
+    Kind kind;
+    int_fast16_t adjustment;  // Brightness: 加算量（-255〜255 に制限しても結果は同じ）
+    uint32_t alphaScale;      // Alpha: 256 = 1.0
+};
+
+// 段を融合カーネルの演算へ変換（未知の関数を含む場合は false）
+static bool compileFusedOps(const LineFilterStage* stages, int_fast16_t stageCount, FusedOp* ops) {
+    for (int_fast16_t i = 0; i < stageCount; i++) {
+        const LineFilterStage& stage = stages[i];
+        FusedOp& op = ops[i];
+        op.adjustment = 0;
+        op.alphaScale = 0;
+        if (stage.func == &brightness_line) {
+            op.kind = FusedOp::Brightness;
+            const auto adjustment = static_cast<int_fast16_t>(stage.params.value1 * 255.0f);
+            op.adjustment = std::max<int_fast16_t>(-255, std::min<int_fast16_t>(255, adjustment));
+        } else if (stage.func == &grayscale_line) {
+            op.kind = FusedOp::Grayscale;
+        } else if (stage.func == &alpha_line) {
+            op.kind = FusedOp::Alpha;
+            op.alphaScale = static_cast<uint32_t>(stage.params.value1 * 256.0f);
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 1ピクセルに全段を適用（各ラインフィルタ関数と同じ整数演算）
+static inline void applyFusedPixel(uint8_t* pixel, const FusedOp* ops, int_fast16_t opCount) {
+    int_fast16_t r = pixel[0];
+    int_fast16_t g = pixel[1];
+    int_fast16_t b = pixel[2];
+    uint32_t a = pixel[3];
+    for (int_fast16_t i = 0; i < opCount; i++) {
+        const FusedOp& op = ops[i];
+        switch (op.kind) {
+            case FusedOp::Brightness:
+                r = std::max<int_fast16_t>(0, std::min<int_fast16_t>(255, r + op.adjustment));
+                g = std::max<int_fast16_t>(0, std::min<int_fast16_t>(255, g + op.adjustment));
+                b = std::max<int_fast16_t>(0, std::min<int_fast16_t>(255, b + op.adjustment));
+                break;
+            case FusedOp::Grayscale:
+                r = g = b = (r + g + b) / 3;
+                break;
+            case FusedOp::Alpha:
+                a = static_cast<uint8_t>((a * op.alphaScale) >> 8);
+                break;
+        }
+    }
+    pixel[0] = static_cast<uint8_t>(r);
+    pixel[1] = static_cast<uint8_t>(g);
+    pixel[2] = static_cast<uint8_t>(b);
+    pixel[3] = static_cast<uint8_t>(a);
+}
+
+#ifdef FLEXIMG_HAS_SSE2
+// 4ピクセル/反復で全段を適用し、処理したピクセル数を返す
+static int_fast16_t applyFusedSSE2(uint8_t* pixels, int_fast16_t count, const FusedOp* ops, int_fast16_t opCount) {
+    // 段ごとの定数を事前に用意
+    __m128i addv[kMaxLineFilterStages];
+    __m128i subv[kMaxLineFilterStages];
+    __m128i scalev[kMaxLineFilterStages];
+    for (int_fast16_t i = 0; i < opCount; i++) {
+        const auto up = static_cast<uint32_t>(std::max<int_fast16_t>(0, ops[i].adjustment));
+        const auto down = static_cast<uint32_t>(std::max<int_fast16_t>(0, -ops[i].adjustment));
+        addv[i] = _mm_set1_epi32(static_cast<int>(up * 0x010101u));
+        subv[i] = _mm_set1_epi32(static_cast<int>(down * 0x010101u));
+        // 16bit乗算の下位16bitから >>8 の下位8bitを取り出す（スカラー版の uint8_t への切り捨てと一致）
+        scalev[i] = _mm_set1_epi32(static_cast<int>(ops[i].alphaScale & 0xFFFFu));
+    }
+    const __m128i lowByte = _mm_set1_epi32(0xFF);
+    const __m128i rgbMask = _mm_set1_epi32(0x00FFFFFF);
+    const __m128i third = _mm_set1_epi32(21846);  // floor(sum / 3) = (sum × 21846) >> 16（sum ≤ 765）
+
+    int_fast16_t x = 0;
+    for (; x + 4 <= count; x += 4) {
+        __m128i* p = reinterpret_cast<__m128i*>(pixels + x * 4);
+        __m128i v = _mm_loadu_si128(p);
+        for (int_fast16_t i = 0; i < opCount; i++) {
+            switch (ops[i].kind) {
+                case FusedOp::Brightness:
+                    v = _mm_subs_epu8(_mm_adds_epu8(v, addv[i]), subv[i]);
+                    break;
+                case FusedOp::Grayscale: {
+                    const __m128i sum = _mm_add_epi32(_mm_add_epi32(_mm_and_si128(v, lowByte),
+                                                                    _mm_and_si128(_mm_srli_epi32(v, 8), lowByte)),
+                                                      _mm_and_si128(_mm_srli_epi32(v, 16), lowByte));
+                    const __m128i gray = _mm_mulhi_epu16(sum, third);
+                    const __m128i rgb = _mm_or_si128(_mm_or_si128(gray, _mm_slli_epi32(gray, 8)), _mm_slli_epi32(gray, 16));
+                    v = _mm_or_si128(_mm_andnot_si128(rgbMask, v), rgb);
+                    break;
+                }
+                case FusedOp::Alpha: {
+                    const __m128i alpha = _mm_srli_epi16(_mm_mullo_epi16(_mm_srli_epi32(v, 24), scalev[i]), 8);
+                    v = _mm_or_si128(_mm_and_si128(v, rgbMask), _mm_slli_epi32(_mm_and_si128(alpha, lowByte), 24));
+                    break;
+                }
+            }
+        }
+        _mm_storeu_si128(p, v);
+    }
+    return x;
+}
+#endif
+
+} // namespace
+
+void apply_line_chain(uint8_t* pixels, int_fast16_t count,
+                      const LineFilterStage* stages, int_fast16_t stageCount) {
+    FusedOp ops[kMaxLineFilterStages];
+    if (stageCount <= kMaxLineFilterStages && compileFusedOps(stages, stageCount, ops)) {
+#ifdef FLEXIMG_HAS_SSE2
+        int_fast16_t x = applyFusedSSE2(pixels, count, ops, stageCount);
+#else
+        int_fast16_t x = 0;
+#endif
+        for (; x < count; x++) {
+            applyFusedPixel(pixels + x * 4, ops, stageCount);
+        }
+        return;
+    }
+
+    // 未知の関数を含む: ブロック（64ピクセル = 256バイト）ごとに全段を適用
+    constexpr int_fast16_t kBlock = 64;
+    for (int_fast16_t x = 0; x < count; x += kBlock) {
+        const int_fast16_t n = std::min<int_fast16_t>(kBlock, count - x);
+        for (int_fast16_t i = 0; i < stageCount; i++) {
+            stages[i].func(pixels + x * 4, n, stages[i].params);
+        }
+    }
+}
+
 } // namespace filters
 } // namespace FLEXIMG_NAMESPACE
 
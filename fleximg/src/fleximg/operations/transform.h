@@ -3,6 +3,8 @@
 
 #include "../core/common.h"
 #include "../core/types.h"
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
 #include <utility>
 
@@ -108,6 +110,71 @@ inline std::pair<int, int> calcValidRange(
     return {dxStart, dxEnd};
 }
 
+// ========================================================================
+// clipLinearRange - 1次不等式による整数区間の絞り込み
+// ========================================================================
+//
+// 整数 t の区間 [lo, hi] を、不等式 a * t + b >= 0（strict時は > 0）を
+// 満たす部分に絞り込みます（lo, hi は整数値を保持する float）。
+//
+// 射影変換やワープメッシュの範囲計算では、スキャンライン上の
+// 「w > 0」「0 <= u < W * w」等の条件がすべて t の1次不等式になるため、
+// 本関数を条件ごとに適用すると有効区間が解析的に求まります。
+//
+// 解なしの場合は lo > hi になります。
+//
+
+inline void clipLinearRange(float a, float b, bool strict, float& lo, float& hi) {
+    if (a > 0.0f) {
+        const float t = -b / a;
+        lo = std::max(lo, strict ? std::floor(t) + 1.0f : std::ceil(t));
+    } else if (a < 0.0f) {
+        const float t = -b / a;
+        hi = std::min(hi, strict ? std::ceil(t) - 1.0f : std::floor(t));
+    } else if (strict ? (b <= 0.0f) : (b < 0.0f)) {
+        lo = 1.0f;
+        hi = 0.0f;
+    }
+}
+
+// ========================================================================
+// clipFixedRange - 固定小数点DDAの値域による整数区間の絞り込み
+// ========================================================================
+//
+// DDA座標 base + incr * t（Q16.16）が [lo, hi] に収まる整数 t に
+// 区間 [tStart, tEnd] を絞り込みます。
+// 解なしの場合は tStart > tEnd になります。
+//
+
+inline void clipFixedRange(int_fixed base, int_fixed incr, int_fixed lo, int_fixed hi,
+                           int32_t& tStart, int32_t& tEnd) {
+    if (incr == 0) {
+        if (base < lo || base > hi) {
+            tStart = 1;
+            tEnd = 0;
+        }
+        return;
+    }
+    // 床除算（負の被除数・除数に対応）
+    auto floorDiv = [](int64_t n, int64_t d) {
+        const int64_t q = n / d;
+        return (n % d != 0 && ((n < 0) != (d < 0))) ? q - 1 : q;
+    };
+    // incr * t ∈ [lo - base, hi - base]
+    const int64_t minProd = static_cast<int64_t>(lo) - base;
+    const int64_t maxProd = static_cast<int64_t>(hi) - base;
+    int64_t tMin, tMax;
+    if (incr > 0) {
+        tMin = -floorDiv(-minProd, incr);
+        tMax = floorDiv(maxProd, incr);
+    } else {
+        tMin = -floorDiv(-maxProd, incr);
+        tMax = floorDiv(minProd, incr);
+    }
+    tStart = static_cast<int32_t>(std::max<int64_t>(tStart, tMin));
+    tEnd = static_cast<int32_t>(std::min<int64_t>(tEnd, tMax));
+}
+
 } // namespace transform
 } // namespace FLEXIMG_NAMESPACE
 
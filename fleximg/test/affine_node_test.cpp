@@ -14,6 +14,7 @@
 #include "fleximg/nodes/renderer_node.h"
 
 #include <cmath>
+#include <cstring>
 
 using namespace fleximg;
 
@@ -305,3 +306,125 @@ TEST_CASE("AffineNode translation smoothness") {
 
     CHECK(backwardJumps == 0);  // 逆方向へのジャンプがないことを確認
 }
+
+// =============================================================================
+// Edge Antialiasing (InterpolationMode::EdgeAA) Tests
+// =============================================================================
+
+// 不透明な単色画像でソースを描画（補間モード・エッジフェード指定）
+static void renderSolidSprite(ImageBuffer& dst, const AffineMatrix& m,
+                              InterpolationMode mode, uint8_t edgeFade = EdgeFade_All) {
+    ImageBuffer srcImg(16, 16, PixelFormatIDs::RGBA8_Straight);
+    for (int y = 0; y < 16; y++) {
+        for (int x = 0; x < 16; x++) {
+            uint8_t* p = static_cast<uint8_t*>(srcImg.view().pixelAt(x, y));
+            p[0] = static_cast<uint8_t>(x * 16); p[1] = static_cast<uint8_t>(y * 16);
+            p[2] = 200; p[3] = 255;
+        }
+    }
+    SourceNode src(srcImg.view());
+    AffineNode affine;
+    RendererNode renderer;
+    SinkNode sink(dst.view());
+    src >> affine >> renderer >> sink;
+    src.setInterpolationMode(mode);
+    src.setEdgeFade(edgeFade);
+    affine.setMatrix(m);
+    renderer.setVirtualScreen(dst.width(), dst.height());
+    CHECK(renderer.exec() == PrepareStatus::Prepared);
+}
+
+TEST_CASE("SourceNode EdgeAA coverage on fractional translation") {
+    const int canvasW = 40, canvasH = 30;
+    ImageBuffer dst(canvasW, canvasH, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    renderSolidSprite(dst, AffineMatrix(1, 0, 0, 1, 10.5f, 4.0f), InterpolationMode::EdgeAA);
+
+    // 左右の辺がピクセル中心を通る → 境界列のカバレッジは0.5、内部は不透明
+    for (int y = 4; y < 20; y++) {
+        auto alphaAt = [&](int x) {
+            return static_cast<const uint8_t*>(dst.view().pixelAt(x, y))[3];
+        };
+        CHECK(alphaAt(9) == 0);
+        CHECK(alphaAt(10) >= 126);
+        CHECK(alphaAt(10) <= 128);
+        CHECK(alphaAt(11) == 255);
+        CHECK(alphaAt(25) == 255);
+        CHECK(alphaAt(26) >= 126);
+        CHECK(alphaAt(26) <= 128);
+        CHECK(alphaAt(27) == 0);
+    }
+    // 上下の辺はピクセル境界に一致 → 半透明行なし
+    CHECK(static_cast<const uint8_t*>(dst.view().pixelAt(15, 3))[3] == 0);
+    CHECK(static_cast<const uint8_t*>(dst.view().pixelAt(15, 19))[3] == 255);
+    CHECK(static_cast<const uint8_t*>(dst.view().pixelAt(15, 20))[3] == 0);
+}
+
+TEST_CASE("SourceNode EdgeAA keeps nearest interior on rotation") {
+    const int canvasW = 48, canvasH = 48;
+    const float angle = 0.5f;
+    const float c = std::cos(angle), s = std::sin(angle);
+    AffineMatrix m(c, -s, s, c, 24.3f, 8.7f);
+
+    ImageBuffer dstN(canvasW, canvasH, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    ImageBuffer dstAA(canvasW, canvasH, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    renderSolidSprite(dstN, m, InterpolationMode::Nearest);
+    renderSolidSprite(dstAA, m, InterpolationMode::EdgeAA);
+
+    int partial = 0, opaque = 0, colorMismatch = 0;
+    for (int y = 0; y < canvasH; y++) {
+        for (int x = 0; x < canvasW; x++) {
+            auto pn = static_cast<const uint8_t*>(dstN.view().pixelAt(x, y));
+            auto pa = static_cast<const uint8_t*>(dstAA.view().pixelAt(x, y));
+            if (pa[3] == 255) {
+                ++opaque;
+                // カバレッジ1の内部は最近傍と完全一致
+                if (std::memcmp(pn, pa, 4) != 0) ++colorMismatch;
+            } else if (pa[3] > 0) {
+                ++partial;
+            }
+        }
+    }
+    CHECK(opaque > 150);
+    CHECK(partial > 20);
+    CHECK(partial < opaque);
+    CHECK(colorMismatch == 0);
+}
+
+TEST_CASE("SourceNode EdgeAA without edge flags matches nearest") {
+    const int canvasW = 48, canvasH = 48;
+    AffineMatrix m(0.8f, -0.6f, 0.6f, 0.8f, 20.2f, 6.6f);
+    ImageBuffer dstN(canvasW, canvasH, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    ImageBuffer dstAA(canvasW, canvasH, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    renderSolidSprite(dstN, m, InterpolationMode::Nearest, EdgeFade_None);
+    renderSolidSprite(dstAA, m, InterpolationMode::EdgeAA, EdgeFade_None);
+    CHECK(std::memcmp(dstN.view().data, dstAA.view().data,
+                      static_cast<size_t>(canvasW * canvasH * 4)) == 0);
+}
+
+TEST_CASE("SourceNode EdgeAA converts opaque formats to RGBA8 on edge rows") {
+    // アルファなし形式（RGB565）でも境界ピクセルは半透明になる
+    ImageBuffer srcImg(16, 16, PixelFormatIDs::RGB565_LE, InitPolicy::Zero);
+    for (int y = 0; y < 16; y++) {
+        for (int x = 0; x < 16; x++) {
+            auto p = static_cast<uint8_t*>(srcImg.view().pixelAt(x, y));
+            p[0] = 0xFF; p[1] = 0xFF;  // 白
+        }
+    }
+    ImageBuffer dst(40, 30, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    SourceNode src(srcImg.view());
+    AffineNode affine;
+    RendererNode renderer;
+    SinkNode sink(dst.view());
+    src >> affine >> renderer >> sink;
+    src.setInterpolationMode(InterpolationMode::EdgeAA);
+    affine.setMatrix(AffineMatrix(1, 0, 0, 1, 10.5f, 4.0f));
+    renderer.setVirtualScreen(40, 30);
+    CHECK(renderer.exec() == PrepareStatus::Prepared);
+
+    auto p10 = static_cast<const uint8_t*>(dst.view().pixelAt(10, 8));
+    auto p15 = static_cast<const uint8_t*>(dst.view().pixelAt(15, 8));
+    CHECK(p10[3] >= 126);
+    CHECK(p10[3] <= 128);
+    CHECK(p15[0] == 255);
+    CHECK(p15[3] == 255);
+}
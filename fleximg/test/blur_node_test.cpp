@@ -0,0 +1,198 @@
+// fleximg BlurNode Unit Tests
+// 2次元ボックスブラーノードのテスト
+
+#include "doctest.h"
+
+#define FLEXIMG_NAMESPACE fleximg
+#include "fleximg/core/common.h"
+#include "fleximg/core/types.h"
+#include "fleximg/image/render_types.h"
+#include "fleximg/image/image_buffer.h"
+#include "fleximg/nodes/blur_node.h"
+#include "fleximg/nodes/horizontal_blur_node.h"
+#include "fleximg/nodes/vertical_blur_node.h"
+#include "fleximg/nodes/source_node.h"
+#include "fleximg/nodes/sink_node.h"
+#include "fleximg/nodes/renderer_node.h"
+#include <cstring>
+#include <string>
+
+using namespace fleximg;
+
+// =============================================================================
+// Helper Functions
+// =============================================================================
+
+// 色・アルファが位置で変化する画像
+static ImageBuffer createPatternImage(int width, int height) {
+    ImageBuffer img(width, height, PixelFormatIDs::RGBA8_Straight);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            uint8_t* p = static_cast<uint8_t*>(img.view().pixelAt(x, y));
+            p[0] = static_cast<uint8_t>(x * 13);
+            p[1] = static_cast<uint8_t>(y * 17);
+            p[2] = static_cast<uint8_t>((x * y) & 0xFF);
+            p[3] = static_cast<uint8_t>((x % 5 == 0) ? 0 : 80 + x * 7);
+        }
+    }
+    return img;
+}
+
+// 回転した上流（行ごとに格納範囲が異なる）で描画
+// fused=true: src >> BlurNode、false: src >> HorizontalBlurNode >> VerticalBlurNode
+static void renderBlur(const ImageBuffer& image, bool fused, int rx, int ry, int passes,
+                       ImageBuffer& dst) {
+    SourceNode src(image.view());
+    src.setRotation(0.4f);
+    src.setTranslation(static_cast<float>(dst.width() / 2), static_cast<float>(dst.height() / 2));
+    BlurNode blur;
+    blur.setRadius(rx, ry);
+    blur.setPasses(passes);
+    HorizontalBlurNode hblur;
+    hblur.setRadius(rx);
+    hblur.setPasses(passes);
+    VerticalBlurNode vblur;
+    vblur.setRadius(ry);
+    vblur.setPasses(passes);
+    RendererNode renderer;
+    SinkNode sink(dst.view());
+    if (fused) {
+        src >> blur >> renderer >> sink;
+    } else {
+        src >> hblur >> vblur >> renderer >> sink;
+    }
+    renderer.setVirtualScreen(dst.width(), dst.height());
+    CHECK(renderer.exec() == PrepareStatus::Prepared);
+}
+
+static int countMismatches(const ImageBuffer& a, const ImageBuffer& b) {
+    int mismatches = 0;
+    for (int y = 0; y < a.height(); y++) {
+        for (int x = 0; x < a.width(); x++) {
+            if (std::memcmp(a.view().pixelAt(x, y), b.view().pixelAt(x, y), 4) != 0) ++mismatches;
+        }
+    }
+    return mismatches;
+}
+
+// =============================================================================
+// BlurNode Tests
+// =============================================================================
+
+TEST_CASE("BlurNode basic construction") {
+    BlurNode node;
+    CHECK(std::string(node.name()) == "BlurNode");
+    CHECK(node.inputPortCount() == 1);
+    CHECK(node.outputPortCount() == 1);
+
+    node.setRadius(7);
+    CHECK(node.radiusX() == 7);
+    CHECK(node.radiusY() == 7);
+    node.setRadius(200, -3);
+    CHECK(node.radiusX() == BlurNode::kMaxRadius);
+    CHECK(node.radiusY() == 0);
+    node.setRadiusY(4);
+    CHECK(node.radiusY() == 4);
+    CHECK(node.kernelSizeY() == 9);
+    node.setPasses(5);
+    CHECK(node.passes() == BlurNode::kMaxPasses);
+}
+
+TEST_CASE("BlurNode matches HorizontalBlurNode >> VerticalBlurNode exactly") {
+    ImageBuffer image = createPatternImage(20, 16);
+    struct Params { int rx, ry, passes; };
+    for (const Params& p : {Params{3, 3, 1}, Params{2, 5, 2}, Params{6, 1, 3},
+                            Params{4, 0, 2}, Params{0, 4, 2}}) {
+        CAPTURE(p.rx);
+        CAPTURE(p.ry);
+        CAPTURE(p.passes);
+        ImageBuffer fused(64, 56, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+        ImageBuffer pair(64, 56, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+        renderBlur(image, true, p.rx, p.ry, p.passes, fused);
+        renderBlur(image, false, p.rx, p.ry, p.passes, pair);
+        CHECK(countMismatches(fused, pair) == 0);
+    }
+}
+
+TEST_CASE("BlurNode processes Alpha8 input in a single channel") {
+    ImageBuffer alphaImg(12, 10, PixelFormatIDs::Alpha8);
+    for (int y = 0; y < 10; y++) {
+        for (int x = 0; x < 12; x++) {
+            *static_cast<uint8_t*>(alphaImg.view().pixelAt(x, y)) =
+                static_cast<uint8_t>((x % 4 == 0) ? 0 : (x * 20 + y * 7));
+        }
+    }
+
+    ImageBuffer fused(32, 28, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    ImageBuffer pair(32, 28, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    renderBlur(alphaImg, true, 3, 2, 2, fused);
+    renderBlur(alphaImg, false, 3, 2, 2, pair);
+    CHECK(countMismatches(fused, pair) == 0);
+
+    // 出力は上流と同じ1チャンネルフォーマット
+    SourceNode src(alphaImg.view());
+    BlurNode blur;
+    blur.setRadius(2, 2);
+    RendererNode renderer;
+    ImageBuffer dst(16, 16, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    SinkNode sink(dst.view());
+    src >> blur >> renderer >> sink;
+    renderer.setVirtualScreen(16, 16);
+    REQUIRE(renderer.execPrepare() == PrepareStatus::Prepared);
+    RenderRequest req;
+    req.width = 16;
+    req.height = 1;
+    req.origin = {0, to_fixed(4)};
+    RenderResponse& resp = blur.pullProcess(req);
+    REQUIRE(resp.isValid());
+    CHECK(resp.buffer().formatID() == PixelFormatIDs::Alpha8);
+    renderer.execFinalize();
+}
+
+TEST_CASE("BlurNode getDataRange matches the node pair") {
+    ImageBuffer image = createPatternImage(14, 10);
+    SourceNode src1(image.view()), src2(image.view());
+    for (SourceNode* src : {&src1, &src2}) {
+        src->setRotation(0.5f);
+        src->setTranslation(24, 20);
+    }
+    HorizontalBlurNode hblur;
+    hblur.setRadius(3);
+    VerticalBlurNode vblur;
+    vblur.setRadius(2);
+    BlurNode blur;
+    blur.setRadius(3, 2);
+    src1 >> hblur >> vblur;
+    src2 >> blur;
+
+    PrepareRequest prep;
+    prep.width = 48;
+    prep.height = 40;
+    const PrepareResponse expectedPrep = vblur.pullPrepare(prep);
+    const PrepareResponse actualPrep = blur.pullPrepare(prep);
+    REQUIRE(actualPrep.ok());
+    CHECK(actualPrep.origin.x == expectedPrep.origin.x);
+    CHECK(actualPrep.origin.y == expectedPrep.origin.y);
+    CHECK(actualPrep.width == expectedPrep.width);
+    CHECK(actualPrep.height == expectedPrep.height);
+
+    RenderRequest req;
+    req.width = 48;
+    req.height = 1;
+    int rowsWithData = 0;
+    for (int y = 0; y < 40; y++) {
+        CAPTURE(y);
+        req.origin = {0, to_fixed(y)};
+        const DataRange expected = vblur.getDataRange(req);
+        const DataRange actual = blur.getDataRange(req);
+        CHECK(actual.hasData() == expected.hasData());
+        if (expected.hasData()) {
+            ++rowsWithData;
+            CHECK(actual.startX == expected.startX);
+            CHECK(actual.endX == expected.endX);
+        }
+    }
+    CHECK(rowsWithData > 10);
+    vblur.pullFinalize();
+    blur.pullFinalize();
+}
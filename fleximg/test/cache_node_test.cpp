@@ -0,0 +1,237 @@
+// fleximg CacheNode Unit Tests
+// サブツリー描画結果キャッシュノードのテスト
+
+#include "doctest.h"
+
+#define FLEXIMG_NAMESPACE fleximg
+#include "fleximg/core/common.h"
+#include "fleximg/core/types.h"
+#include "fleximg/image/render_types.h"
+#include "fleximg/image/image_buffer.h"
+#include "fleximg/nodes/cache_node.h"
+#include "fleximg/nodes/affine_node.h"
+#include "fleximg/nodes/alpha_node.h"
+#include "fleximg/nodes/source_node.h"
+#include "fleximg/nodes/sink_node.h"
+#include "fleximg/nodes/renderer_node.h"
+#include <cstring>
+#include <string>
+
+using namespace fleximg;
+
+// =============================================================================
+// Helper Functions
+// =============================================================================
+
+static ImageBuffer createPatternImage(int width, int height) {
+    ImageBuffer img(width, height, PixelFormatIDs::RGBA8_Straight);
+    ViewPort view = img.view();
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            uint8_t* p = static_cast<uint8_t*>(view.pixelAt(x, y));
+            p[0] = static_cast<uint8_t>(x * 9);
+            p[1] = static_cast<uint8_t>(y * 13);
+            p[2] = static_cast<uint8_t>(x ^ y);
+            p[3] = 255;
+        }
+    }
+    return img;
+}
+
+static int countMismatches(const ImageBuffer& a, const ImageBuffer& b) {
+    int mismatches = 0;
+    for (int y = 0; y < a.height(); ++y) {
+        for (int x = 0; x < a.width(); ++x) {
+            auto pa = static_cast<const uint8_t*>(a.view().pixelAt(x, y));
+            auto pb = static_cast<const uint8_t*>(b.view().pixelAt(x, y));
+            if (std::memcmp(pa, pb, 4) != 0) ++mismatches;
+        }
+    }
+    return mismatches;
+}
+
+// 上流へのリクエスト回数を記録するパススルーノード
+class PullCounterNode : public Node {
+public:
+    PullCounterNode() { initPorts(1, 1); }
+    const char* name() const override { return "PullCounterNode"; }
+
+    int calls = 0;
+
+protected:
+    RenderResponse& onPullProcess(const RenderRequest& request) override {
+        ++calls;
+        return upstreamNode(0)->pullProcess(request);
+    }
+};
+
+// source >> alpha >> counter >> [cache] >> renderer >> sink を構築して描画
+struct CachedScene {
+    ImageBuffer image = createPatternImage(20, 12);
+    SourceNode source{image.view()};
+    AlphaNode alpha;
+    PullCounterNode counter;
+    CacheNode cache;
+    RendererNode renderer;
+    SinkNode sink;
+
+    explicit CachedScene(bool useCache) {
+        source.setRotation(0.3f);
+        source.setTranslation(14, 6);
+        source >> alpha >> counter;
+        if (useCache) {
+            counter >> cache >> renderer;
+        } else {
+            counter >> renderer;
+        }
+        renderer >> sink;
+    }
+
+    void render(ImageBuffer& dst) {
+        sink.setTarget(dst.view());
+        renderer.setVirtualScreen(dst.width(), dst.height());
+        CHECK(renderer.exec() == PrepareStatus::Prepared);
+    }
+};
+
+// =============================================================================
+// CacheNode Tests
+// =============================================================================
+
+TEST_CASE("CacheNode basic construction") {
+    CacheNode node;
+    CHECK(std::string(node.name()) == "CacheNode");
+    CHECK(node.inputPortCount() == 1);
+    CHECK(node.outputPortCount() == 1);
+    CHECK_FALSE(node.isCached());
+    CHECK(node.cachedBytes() == 0);
+}
+
+TEST_CASE("CacheNode serves later frames from the cache") {
+    ImageBuffer ref(40, 30, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    CachedScene plain(false);
+    plain.render(ref);
+
+    CachedScene scene(true);
+    ImageBuffer dst1(40, 30, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    scene.render(dst1);
+    CHECK(countMismatches(ref, dst1) == 0);
+    CHECK(scene.cache.isCached());
+    CHECK(scene.cache.renderCount() == 1);
+    const int firstCalls = scene.counter.calls;
+    CHECK(firstCalls > 0);
+
+    // 2回目: 上流は呼ばれず、同一の結果
+    ImageBuffer dst2(40, 30, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    scene.render(dst2);
+    CHECK(scene.counter.calls == firstCalls);
+    CHECK(scene.cache.renderCount() == 1);
+    CHECK(countMismatches(ref, dst2) == 0);
+}
+
+TEST_CASE("CacheNode invalidates on upstream generation change") {
+    CachedScene scene(true);
+    ImageBuffer dst(40, 30, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    scene.render(dst);
+    REQUIRE(scene.cache.renderCount() == 1);
+
+    SUBCASE("parameter setter") {
+        scene.alpha.setScale(0.5f);
+        ImageBuffer dst2(40, 30, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+        scene.render(dst2);
+        CHECK(scene.cache.renderCount() == 2);
+
+        CachedScene plain(false);
+        plain.alpha.setScale(0.5f);
+        ImageBuffer ref(40, 30, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+        plain.render(ref);
+        CHECK(countMismatches(ref, dst2) == 0);
+    }
+
+    SUBCASE("matrix setter") {
+        scene.source.setTranslation(4, 2);
+        scene.render(dst);
+        CHECK(scene.cache.renderCount() == 2);
+    }
+
+    SUBCASE("markModified after editing source pixels") {
+        static_cast<uint8_t*>(scene.image.view().pixelAt(5, 5))[0] ^= 0xFF;
+        scene.source.markModified();
+        scene.render(dst);
+        CHECK(scene.cache.renderCount() == 2);
+    }
+
+    SUBCASE("explicit invalidate") {
+        scene.cache.invalidate();
+        CHECK_FALSE(scene.cache.isCached());
+        scene.render(dst);
+        CHECK(scene.cache.renderCount() == 2);
+    }
+
+    SUBCASE("downstream transform") {
+        AffineNode affine;
+        affine.setTranslation(3, 1);
+        scene.cache.disconnectAll();
+        scene.counter >> scene.cache >> affine >> scene.renderer;
+        ImageBuffer dst2(40, 30, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+        scene.render(dst2);
+        CHECK(scene.cache.renderCount() == 2);
+        // 平行移動した結果と一致
+        CHECK(std::memcmp(dst.view().pixelAt(14, 12), dst2.view().pixelAt(17, 13), 4) == 0);
+    }
+}
+
+TEST_CASE("CacheNode getDataRange trims transparent pixels") {
+    // 中央 [4,8) のみ不透明
+    ImageBuffer image(12, 2, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    for (int x = 4; x < 8; ++x) {
+        static_cast<uint8_t*>(image.view().pixelAt(x, 1))[3] = 255;
+    }
+    SourceNode source(image.view());
+    CacheNode cache;
+    RendererNode renderer;
+    ImageBuffer dst(16, 2, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    SinkNode sink(dst.view());
+    source >> cache >> renderer >> sink;
+    renderer.setVirtualScreen(16, 2);
+    REQUIRE(renderer.execPrepare() == PrepareStatus::Prepared);
+
+    RenderRequest req;
+    req.width = 16;
+    req.height = 1;
+    req.origin = {0, 0};
+    CHECK_FALSE(cache.getDataRange(req).hasData());
+    req.origin = {0, to_fixed(1)};
+    DataRange r = cache.getDataRange(req);
+    CHECK(r.startX == 4);
+    CHECK(r.endX == 8);
+    renderer.execFinalize();
+}
+
+TEST_CASE("CacheNode evicts least recently used caches over budget") {
+    const size_t previousBudget = CacheNode::globalBudget();
+    CachedScene a(true);
+    CachedScene b(true);
+    ImageBuffer dst(40, 30, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    a.render(dst);
+    const size_t bytesA = a.cache.cachedBytes();
+    REQUIRE(bytesA > 0);
+
+    // 1つ分の予算: b のキャッシュ作成で a が解放される
+    CacheNode::setGlobalBudget(bytesA);
+    b.render(dst);
+    CHECK(b.cache.isCached());
+    CHECK_FALSE(a.cache.isCached());
+    CHECK(CacheNode::globalUsage() == b.cache.cachedBytes());
+
+    // 予算に収まらない場合はパススルー（結果は変わらない）
+    CacheNode::setGlobalBudget(bytesA / 2);
+    ImageBuffer ref(40, 30, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    b.render(ref);
+    ImageBuffer dst2(40, 30, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    a.render(dst2);
+    CHECK_FALSE(a.cache.isCached());
+    CHECK(countMismatches(ref, dst2) == 0);
+
+    CacheNode::setGlobalBudget(previousBudget);
+}
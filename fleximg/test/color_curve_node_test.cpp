@@ -0,0 +1,284 @@
+// fleximg ColorCurveNode Unit Tests
+// トーンカーブノードのテスト
+
+#include "doctest.h"
+
+#define FLEXIMG_NAMESPACE fleximg
+#include "fleximg/core/common.h"
+#include "fleximg/core/types.h"
+#include "fleximg/image/render_types.h"
+#include "fleximg/image/image_buffer.h"
+#include "fleximg/nodes/color_curve_node.h"
+#include "fleximg/nodes/brightness_node.h"
+#include "fleximg/nodes/source_node.h"
+#include "fleximg/nodes/sink_node.h"
+#include "fleximg/nodes/renderer_node.h"
+#include <cmath>
+#include <cstring>
+#include <string>
+
+using namespace fleximg;
+
+// =============================================================================
+// Helper Functions
+// =============================================================================
+
+// 位置で値が変化する画像
+static ImageBuffer createPatternImage(int width, int height) {
+    ImageBuffer img(width, height, PixelFormatIDs::RGBA8_Straight);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            uint8_t* p = static_cast<uint8_t*>(img.view().pixelAt(x, y));
+            p[0] = static_cast<uint8_t>(x * 37 + y * 11);
+            p[1] = static_cast<uint8_t>(255 - x * 19 + y);
+            p[2] = static_cast<uint8_t>(x * y * 7);
+            p[3] = static_cast<uint8_t>(x * 13 + y * 29);
+        }
+    }
+    return img;
+}
+
+// ノード単体で prepare し、コンパイル済みLUTを得る
+static void compileCurve(ColorCurveNode& curve) {
+    RenderRequest screen;
+    curve.prepare(screen);
+}
+
+// ノードを通して描画（出力は RGBA8、キャンバスは入力と同サイズ）
+static ImageBuffer renderThrough(const ViewPort& srcView, const PaletteData& palette, Node& filter) {
+    ImageBuffer dst(srcView.width, srcView.height, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    SourceNode src;
+    src.setSource(srcView, palette);
+    RendererNode renderer;
+    SinkNode sink(dst.view());
+    src >> filter >> renderer >> sink;
+    renderer.setVirtualScreen(srcView.width, srcView.height);
+    CHECK(renderer.exec() == PrepareStatus::Prepared);
+    return dst;
+}
+
+// =============================================================================
+// ColorCurveNode Tests
+// =============================================================================
+
+TEST_CASE("ColorCurveNode basic construction") {
+    ColorCurveNode node;
+    CHECK(std::string(node.name()) == "ColorCurveNode");
+    CHECK(node.inputPortCount() == 1);
+    CHECK(node.outputPortCount() == 1);
+    CHECK(node.brightness() == doctest::Approx(0.0f));
+    CHECK(node.contrast() == doctest::Approx(0.0f));
+    CHECK(node.gamma() == doctest::Approx(1.0f));
+    CHECK(node.inputBlack() == 0);
+    CHECK(node.inputWhite() == 255);
+    CHECK_FALSE(node.hasCurve(ColorCurveNode::Channel::RGB));
+
+    // 既定値は恒等変換
+    compileCurve(node);
+    int changed = 0;
+    for (int c = 0; c < 4; c++) {
+        for (int v = 0; v < 256; v++) {
+            if (node.lut()[c * 256 + v] != v) ++changed;
+        }
+    }
+    CHECK(changed == 0);
+}
+
+TEST_CASE("ColorCurveNode brightness matches BrightnessNode") {
+    const ImageBuffer image = createPatternImage(23, 7);
+    for (const float amount : {0.3f, -0.45f, 1.0f}) {
+        CAPTURE(amount);
+        ColorCurveNode curve;
+        curve.setBrightness(amount);
+        BrightnessNode brightness;
+        brightness.setAmount(amount);
+        const ImageBuffer actual = renderThrough(image.view(), PaletteData(), curve);
+        const ImageBuffer expected = renderThrough(image.view(), PaletteData(), brightness);
+        CHECK(std::memcmp(actual.view().pixelAt(0, 0), expected.view().pixelAt(0, 0), 23 * 7 * 4) == 0);
+    }
+}
+
+TEST_CASE("ColorCurveNode levels, gamma and contrast") {
+    SUBCASE("levels map black and white points") {
+        ColorCurveNode curve;
+        curve.setLevels(16, 235, 10, 200);
+        compileCurve(curve);
+        const uint8_t* lut = curve.lut();
+        CHECK(lut[0] == 10);
+        CHECK(lut[16] == 10);
+        CHECK(lut[235] == 200);
+        CHECK(lut[255] == 200);
+        bool monotonic = true;
+        for (int v = 1; v < 256; v++) monotonic = monotonic && lut[v] >= lut[v - 1];
+        CHECK(monotonic);
+        CHECK(lut[768 + 100] == 100);  // アルファは変化なし
+    }
+
+    SUBCASE("gamma") {
+        ColorCurveNode curve;
+        curve.setGamma(2.2f);
+        compileCurve(curve);
+        for (int v = 0; v < 256; v += 17) {
+            CAPTURE(v);
+            const double expected = 255.0 * std::pow(v / 255.0, 1.0 / 2.2);
+            CHECK(std::abs(curve.lut()[v] - expected) <= 1.0);
+        }
+    }
+
+    SUBCASE("contrast extremes") {
+        ColorCurveNode flat, binary;
+        flat.setContrast(-1.0f);
+        binary.setContrast(1.0f);
+        compileCurve(flat);
+        compileCurve(binary);
+        for (int v = 0; v < 256; v++) {
+            CAPTURE(v);
+            CHECK(flat.lut()[v] == 128);
+            CHECK(binary.lut()[v] == (v < 128 ? 0 : 255));
+        }
+    }
+}
+
+TEST_CASE("ColorCurveNode custom curves") {
+    uint8_t invert[256], half[256];
+    for (int v = 0; v < 256; v++) {
+        invert[v] = static_cast<uint8_t>(255 - v);
+        half[v] = static_cast<uint8_t>(v / 2);
+    }
+    ColorCurveNode curve;
+    curve.setCurve(ColorCurveNode::Channel::RGB, invert);
+    curve.setCurve(ColorCurveNode::Channel::Green, half);
+    curve.setCurve(ColorCurveNode::Channel::Alpha, half);
+    CHECK(curve.hasCurve(ColorCurveNode::Channel::Green));
+
+    const ImageBuffer image = createPatternImage(17, 5);
+    const ImageBuffer actual = renderThrough(image.view(), PaletteData(), curve);
+    int mismatches = 0;
+    for (int y = 0; y < 5; y++) {
+        for (int x = 0; x < 17; x++) {
+            const auto* s = static_cast<const uint8_t*>(image.view().pixelAt(x, y));
+            const auto* d = static_cast<const uint8_t*>(actual.view().pixelAt(x, y));
+            const uint8_t expected[4] = {invert[s[0]], half[invert[s[1]]], invert[s[2]], half[s[3]]};
+            if (std::memcmp(d, expected, 4) != 0) ++mismatches;
+        }
+    }
+    CHECK(mismatches == 0);
+
+    // 解除すると恒等変換に戻る
+    curve.reset();
+    CHECK_FALSE(curve.hasCurve(ColorCurveNode::Channel::Green));
+    compileCurve(curve);
+    CHECK(curve.lut()[256 + 77] == 77);
+}
+
+TEST_CASE("ColorCurveNode applies the curve to the palette of indexed sources") {
+    const int width = 19, height = 6;
+    ImageBuffer indexed(width, height, PixelFormatIDs::Index8);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            *static_cast<uint8_t*>(indexed.view().pixelAt(x, y)) = static_cast<uint8_t>((x * 5 + y * 3) % 16);
+        }
+    }
+    uint8_t palette[16 * 4];
+    for (int i = 0; i < 16; i++) {
+        palette[i * 4 + 0] = static_cast<uint8_t>(i * 16);
+        palette[i * 4 + 1] = static_cast<uint8_t>(255 - i * 9);
+        palette[i * 4 + 2] = static_cast<uint8_t>(i * i);
+        palette[i * 4 + 3] = static_cast<uint8_t>(i == 0 ? 0 : 255);
+    }
+    uint8_t paletteCopy[sizeof(palette)];
+    std::memcpy(paletteCopy, palette, sizeof(palette));
+    const PaletteData paletteData(palette, PixelFormatIDs::RGBA8_Straight, 16);
+
+    ColorCurveNode curve;
+    curve.setContrast(0.4f);
+    curve.setGamma(0.8f);
+
+    // 期待値: ピクセルを RGBA8 に展開してから LUT を適用
+    compileCurve(curve);
+    ImageBuffer expected(width, height, PixelFormatIDs::RGBA8_Straight);
+    PixelAuxInfo aux;
+    aux.palette = palette;
+    aux.paletteFormat = PixelFormatIDs::RGBA8_Straight;
+    aux.paletteColorCount = 16;
+    FormatConverter expand = resolveConverter(PixelFormatIDs::Index8, PixelFormatIDs::RGBA8_Straight, &aux);
+    filters::LineFilterParams params;
+    params.lut = curve.lut();
+    for (int y = 0; y < height; y++) {
+        auto* row = static_cast<uint8_t*>(expected.view().pixelAt(0, y));
+        expand(row, indexed.view().pixelAt(0, y), width);
+        filters::color_curve_line(row, width, params);
+    }
+
+    const ImageBuffer actual = renderThrough(indexed.view(), paletteData, curve);
+    CHECK(std::memcmp(actual.view().pixelAt(0, 0), expected.view().pixelAt(0, 0),
+                      static_cast<size_t>(width * height) * 4) == 0);
+
+    // ノードの出力はインデックス形式のまま（パレットのみ差し替え）、元のパレットは変更されない
+    ColorCurveNode inspected;
+    inspected.setContrast(0.4f);
+    inspected.setGamma(0.8f);
+    SourceNode src;
+    src.setSource(indexed.view(), paletteData);
+    RendererNode renderer;
+    ImageBuffer dst(width, height, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    SinkNode sink(dst.view());
+    src >> inspected >> renderer >> sink;
+    renderer.setVirtualScreen(width, height);
+    REQUIRE(renderer.execPrepare() == PrepareStatus::Prepared);
+    RenderRequest req;
+    req.width = width;
+    req.height = 1;
+    req.origin = {0, to_fixed(2)};
+    RenderResponse& resp = inspected.pullProcess(req);
+    REQUIRE(resp.isValid());
+    CHECK(resp.buffer().formatID() == PixelFormatIDs::Index8);
+    CHECK(resp.buffer().auxInfo().palette != palette);
+    CHECK(resp.buffer().auxInfo().paletteColorCount == 16);
+    renderer.execFinalize();
+    CHECK(std::memcmp(palette, paletteCopy, sizeof(palette)) == 0);
+}
+
+TEST_CASE("ColorCurveNode palette path writes to an RGB565 sink") {
+    const int width = 13, height = 3;
+    ImageBuffer indexed(width, height, PixelFormatIDs::Index8);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            *static_cast<uint8_t*>(indexed.view().pixelAt(x, y)) = static_cast<uint8_t>((x + y) % 4);
+        }
+    }
+    const uint8_t palette[4 * 4] = {
+        0, 0, 0, 255,  200, 40, 40, 255,  40, 200, 40, 255,  250, 250, 250, 255,
+    };
+    ColorCurveNode curve;
+    curve.setBrightness(-0.2f);
+    curve.setLevels(0, 255, 0, 128);
+
+    ImageBuffer dst(width, height, PixelFormatIDs::RGB565_LE, InitPolicy::Zero);
+    SourceNode src;
+    src.setSource(indexed.view(), PaletteData(palette, PixelFormatIDs::RGBA8_Straight, 4));
+    RendererNode renderer;
+    SinkNode sink(dst.view());
+    src >> curve >> renderer >> sink;
+    renderer.setVirtualScreen(width, height);
+    CHECK(renderer.exec() == PrepareStatus::Prepared);
+
+    // 期待値: パレットに LUT を適用して RGB565 へ変換
+    uint8_t curved[4 * 4];
+    std::memcpy(curved, palette, sizeof(curved));
+    filters::LineFilterParams params;
+    params.lut = curve.lut();
+    filters::color_curve_line(curved, 4, params);
+    uint16_t curved565[4];
+    FormatConverter toRGB565 = resolveConverter(PixelFormatIDs::RGBA8_Straight, PixelFormatIDs::RGB565_LE);
+    toRGB565(curved565, curved, 4);
+
+    int mismatches = 0;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            const uint16_t actual = *static_cast<const uint16_t*>(dst.view().pixelAt(x, y));
+            if (actual != curved565[(x + y) % 4]) ++mismatches;
+        }
+    }
+    CHECK(mismatches == 0);
+}
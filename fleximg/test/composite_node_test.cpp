@@ -12,6 +12,12 @@
 #include "fleximg/nodes/source_node.h"
 #include "fleximg/nodes/sink_node.h"
 #include "fleximg/nodes/renderer_node.h"
+#include "fleximg/nodes/brightness_node.h"
+#include "fleximg/operations/blend_modes.h"
+
+#include <cstring>
+#include <memory>
+#include <vector>
 
 using namespace fleximg;
 
@@ -473,6 +479,494 @@ TEST_CASE("CompositeNode non-overlapping regions use convertFormat") {
     }
 }
 
+// =============================================================================
+// CompositeNode Occlusion Culling Tests
+// =============================================================================
+
+// 上流へのリクエストを記録するパススルーノード
+class RequestRecorderNode : public Node {
+public:
+    RequestRecorderNode() { initPorts(1, 1); }
+    const char* name() const override { return "RequestRecorderNode"; }
+
+    int calls = 0;
+    int requestedPixels = 0;
+
+protected:
+    RenderResponse& onPullProcess(const RenderRequest& request) override {
+        ++calls;
+        requestedPixels += request.width;
+        return upstreamNode(0)->pullProcess(request);
+    }
+};
+
+TEST_CASE("CompositeNode occlusion culling narrows back layer requests") {
+    // 前面: 不透明パネル [10,40)、背面: 全幅の不透明背景（記録ノード経由）
+    const int canvasW = 64, canvasH = 4;
+    ImageBuffer panel = createSolidImage(30, canvasH, 255, 0, 0, 255);
+    ImageBuffer bg = createSolidImage(canvasW, canvasH, 0, 0, 255, 255);
+    ImageBuffer dstImg(canvasW, canvasH, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+
+    SourceNode front(panel.view(), 0, 0);
+    front.setTranslation(10, 0);
+    SourceNode back(bg.view(), 0, 0);
+    RequestRecorderNode recorder;
+    CompositeNode composite(2);
+    RendererNode renderer;
+    SinkNode sink(dstImg.view(), 0, 0);
+
+    front >> composite;
+    back >> recorder;
+    recorder.connectTo(composite, 1);
+    composite >> renderer >> sink;
+    renderer.setVirtualScreen(canvasW, canvasH);
+    renderer.exec();
+
+    // 背面は透明区間 [0,10) と [40,64) のみリクエストされる
+    CHECK(recorder.calls == canvasH * 2);
+    CHECK(recorder.requestedPixels == canvasH * (10 + 24));
+
+    for (int y = 0; y < canvasH; ++y) {
+        for (int x = 0; x < canvasW; ++x) {
+            uint8_t r, g, b, a;
+            getPixelRGBA8(dstImg.view(), x, y, r, g, b, a);
+            const bool inPanel = (x >= 10 && x < 40);
+            CHECK(r == (inPanel ? 255 : 0));
+            CHECK(b == (inPanel ? 0 : 255));
+            CHECK(a == 255);
+        }
+    }
+}
+
+TEST_CASE("CompositeNode occlusion culling skips fully covered layers") {
+    const int canvasW = 48, canvasH = 3;
+    ImageBuffer fg = createSolidImage(canvasW, canvasH, 0, 255, 0, 255);
+    ImageBuffer bg = createSolidImage(canvasW, canvasH, 255, 0, 0, 255);
+    ImageBuffer dstImg(canvasW, canvasH, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+
+    SourceNode front(fg.view(), 0, 0);
+    SourceNode back(bg.view(), 0, 0);
+    RequestRecorderNode recorder;
+    CompositeNode composite(2);
+    RendererNode renderer;
+    SinkNode sink(dstImg.view(), 0, 0);
+
+    front >> composite;
+    back >> recorder;
+    recorder.connectTo(composite, 1);
+    composite >> renderer >> sink;
+    renderer.setVirtualScreen(canvasW, canvasH);
+    renderer.exec();
+
+    CHECK(recorder.calls == 0);
+    uint8_t r, g, b, a;
+    getPixelRGBA8(dstImg.view(), 5, 1, r, g, b, a);
+    CHECK(g == 255);
+    CHECK(a == 255);
+}
+
+TEST_CASE("CompositeNode occlusion culling merges short opaque runs") {
+    // 前面: 半透明の隙間を挟む不透明区間 → 短い不透明区間は結合して1リクエスト
+    const int canvasW = 40;
+    ImageBuffer fg = createSolidImage(canvasW, 1, 0, 255, 0, 255);
+    for (int x = 12; x < 20; ++x) {
+        static_cast<uint8_t*>(fg.view().pixelAt(x, 0))[3] = 128;
+    }
+    for (int x = 24; x < 30; ++x) {
+        static_cast<uint8_t*>(fg.view().pixelAt(x, 0))[3] = 0;
+    }
+    ImageBuffer bg = createSolidImage(canvasW, 1, 255, 0, 0, 255);
+    ImageBuffer dstImg(canvasW, 1, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+
+    SourceNode front(fg.view(), 0, 0);
+    SourceNode back(bg.view(), 0, 0);
+    RequestRecorderNode recorder;
+    CompositeNode composite(2);
+    RendererNode renderer;
+    SinkNode sink(dstImg.view(), 0, 0);
+
+    front >> composite;
+    back >> recorder;
+    recorder.connectTo(composite, 1);
+    composite >> renderer >> sink;
+    renderer.setVirtualScreen(canvasW, 1);
+    renderer.exec();
+
+    // [12,20) と [24,30) の間の不透明区間は4ピクセル → [12,30) の1リクエスト
+    CHECK(recorder.calls == 1);
+    CHECK(recorder.requestedPixels == 18);
+
+    uint8_t r, g, b, a;
+    getPixelRGBA8(dstImg.view(), 26, 0, r, g, b, a);
+    CHECK(r == 255);
+    CHECK(a == 255);
+    getPixelRGBA8(dstImg.view(), 22, 0, r, g, b, a);
+    CHECK(r == 0);
+    CHECK(g == 255);
+}
+
+// =============================================================================
+// CompositeNode Segment Tests
+// =============================================================================
+
+TEST_CASE("normalizeDataSegments sorts and merges") {
+    DataRange segs[6] = {{50, 60}, {0, 10}, {12, 20}, {30, 30}, {90, 100}, {70, 80}};
+    // 空区間を除去、隙間2以下は結合 → [0,20) [50,60) [70,80) [90,100)
+    int_fast16_t n = normalizeDataSegments(segs, 6, 8, 2);
+    REQUIRE(n == 4);
+    CHECK(segs[0].startX == 0);
+    CHECK(segs[0].endX == 20);
+    CHECK(segs[1].startX == 50);
+    CHECK(segs[3].endX == 100);
+
+    // 上限3: 隙間の最も小さい箇所（[50,60)-[70,80)）から結合
+    n = normalizeDataSegments(segs, n, 3, 2);
+    REQUIRE(n == 3);
+    CHECK(segs[1].startX == 50);
+    CHECK(segs[1].endX == 80);
+    CHECK(segs[2].startX == 90);
+}
+
+TEST_CASE("CompositeNode keeps distant inputs as separate segments") {
+    // 画面両端の2枚 → 2セグメント、間の領域はシンクに書き込まれない
+    const int canvasW = 100, canvasH = 2;
+    ImageBuffer left = createSolidImage(10, canvasH, 255, 0, 0, 255);
+    ImageBuffer right = createSolidImage(10, canvasH, 0, 0, 255, 128);
+    ImageBuffer dstImg(canvasW, canvasH, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    for (int y = 0; y < canvasH; ++y) {
+        for (int x = 0; x < canvasW; ++x) {
+            static_cast<uint8_t*>(dstImg.view().pixelAt(x, y))[1] = 77;  // 目印
+        }
+    }
+
+    SourceNode srcL(left.view(), 0, 0);
+    SourceNode srcR(right.view(), 0, 0);
+    srcL.setTranslation(5, 0);
+    srcR.setTranslation(80, 0);
+    CompositeNode composite(2);
+    RendererNode renderer;
+    SinkNode sink(dstImg.view(), 0, 0);
+    srcL >> composite;
+    srcR.connectTo(composite, 1);
+    composite >> renderer >> sink;
+    renderer.setVirtualScreen(canvasW, canvasH);
+
+    REQUIRE(renderer.execPrepare() == PrepareStatus::Prepared);
+    RenderRequest req;
+    req.width = canvasW;
+    req.height = 1;
+    req.origin = {0, 0};
+    DataRange segs[MAX_DATA_SEGMENTS];
+    const int_fast16_t n = composite.getDataSegments(req, segs, MAX_DATA_SEGMENTS);
+    REQUIRE(n == 2);
+    CHECK(segs[0].startX == 5);
+    CHECK(segs[0].endX == 15);
+    CHECK(segs[1].startX == 80);
+    CHECK(segs[1].endX == 90);
+    // 上限1: 全体を1区間にまとめる
+    CHECK(composite.getDataSegments(req, segs, 1) == 1);
+    CHECK(segs[0].startX == 5);
+    CHECK(segs[0].endX == 90);
+    CHECK(composite.getDataRange(req).endX == 90);
+    renderer.execFinalize();
+
+    renderer.exec();
+    for (int y = 0; y < canvasH; ++y) {
+        for (int x = 0; x < canvasW; ++x) {
+            uint8_t r, g, b, a;
+            getPixelRGBA8(dstImg.view(), x, y, r, g, b, a);
+            if (x >= 5 && x < 15) {
+                CHECK(r == 255);
+                CHECK(a == 255);
+            } else if (x >= 80 && x < 90) {
+                CHECK(b == 255);
+                CHECK(a == 128);
+            } else {
+                CHECK(g == 77);  // セグメント外は変更されない
+            }
+        }
+    }
+}
+
+TEST_CASE("CompositeNode segmented output is zero-filled for other consumers") {
+    // 疎バッファを合成・フィルタの入力にした場合、セグメント外は透明として扱われる
+    const int canvasW = 80;
+    ImageBuffer left = createSolidImage(8, 1, 255, 0, 0, 255);
+    ImageBuffer right = createSolidImage(8, 1, 0, 255, 0, 255);
+    ImageBuffer bg = createSolidImage(canvasW, 1, 0, 0, 255, 255);
+
+    SUBCASE("nested composite") {
+        ImageBuffer dstImg(canvasW, 1, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+        SourceNode srcL(left.view(), 0, 0);
+        SourceNode srcR(right.view(), 0, 0);
+        SourceNode srcBg(bg.view(), 0, 0);
+        srcR.setTranslation(60, 0);
+        CompositeNode inner(2);
+        CompositeNode outer(2);
+        RendererNode renderer;
+        SinkNode sink(dstImg.view(), 0, 0);
+        srcL >> inner;
+        srcR.connectTo(inner, 1);
+        inner >> outer;
+        srcBg.connectTo(outer, 1);
+        outer >> renderer >> sink;
+        renderer.setVirtualScreen(canvasW, 1);
+        renderer.exec();
+
+        for (int x = 0; x < canvasW; ++x) {
+            uint8_t r, g, b, a;
+            getPixelRGBA8(dstImg.view(), x, 0, r, g, b, a);
+            CHECK(r == (x < 8 ? 255 : 0));
+            CHECK(g == ((x >= 60 && x < 68) ? 255 : 0));
+            CHECK(b == ((x < 8 || (x >= 60 && x < 68)) ? 0 : 255));
+            CHECK(a == 255);
+        }
+    }
+
+    SUBCASE("filter consumer") {
+        ImageBuffer dstImg(canvasW, 1, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+        SourceNode srcL(left.view(), 0, 0);
+        SourceNode srcR(right.view(), 0, 0);
+        srcR.setTranslation(60, 0);
+        CompositeNode composite(2);
+        BrightnessNode brightness;
+        RendererNode renderer;
+        SinkNode sink(dstImg.view(), 0, 0);
+        srcL >> composite;
+        srcR.connectTo(composite, 1);
+        composite >> brightness >> renderer >> sink;
+        renderer.setVirtualScreen(canvasW, 1);
+        renderer.exec();
+
+        for (int x = 8; x < 60; ++x) {
+            uint8_t r, g, b, a;
+            getPixelRGBA8(dstImg.view(), x, 0, r, g, b, a);
+            CHECK(a == 0);
+        }
+        uint8_t r, g, b, a;
+        getPixelRGBA8(dstImg.view(), 62, 0, r, g, b, a);
+        CHECK(g == 255);
+        CHECK(a == 255);
+    }
+}
+
+// =============================================================================
+// CompositeNode Y-Interval Index Tests
+// =============================================================================
+
+// getDataRange の呼び出し回数を記録するパススルーノード
+class RangeCounterNode : public Node {
+public:
+    RangeCounterNode() { initPorts(1, 1); }
+    const char* name() const override { return "RangeCounterNode"; }
+
+    mutable int rangeCalls = 0;
+
+    DataRange getDataRange(const RenderRequest& request) const override {
+        ++rangeCalls;
+        return upstreamNode(0)->getDataRange(request);
+    }
+};
+
+TEST_CASE("CompositeNode evaluates only inputs active on the scanline") {
+    // 縦に並んだ24本の帯（高さ4行、5行間隔）→ 各行で有効な入力は高々1つ
+    const int count = 24, canvasW = 16, canvasH = count * 5;
+    ImageBuffer band = createSolidImage(canvasW, 4, 0, 200, 0, 255);
+    ImageBuffer dstImg(canvasW, canvasH, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+
+    std::vector<std::unique_ptr<SourceNode>> sources;
+    std::vector<std::unique_ptr<RangeCounterNode>> counters;
+    CompositeNode composite(count);
+    for (int i = 0; i < count; ++i) {
+        sources.emplace_back(new SourceNode(band.view(), 0, 0));
+        sources.back()->setTranslation(0, static_cast<float>(i * 5));
+        counters.emplace_back(new RangeCounterNode());
+        *sources.back() >> *counters.back();
+        counters.back()->connectTo(composite, i);
+    }
+    RendererNode renderer;
+    SinkNode sink(dstImg.view(), 0, 0);
+    composite >> renderer >> sink;
+    renderer.setVirtualScreen(canvasW, canvasH);
+    renderer.exec();
+
+    // 各入力は自身の行範囲（余裕を含め数行）でのみ評価される
+    int totalCalls = 0;
+    for (const auto& c : counters) {
+        CHECK(c->rangeCalls <= 8);
+        totalCalls += c->rangeCalls;
+    }
+    CHECK(totalCalls < count * canvasH / 8);
+
+    for (int y = 0; y < canvasH; ++y) {
+        uint8_t r, g, b, a;
+        getPixelRGBA8(dstImg.view(), 3, y, r, g, b, a);
+        CHECK(a == ((y % 5) < 4 ? 255 : 0));
+    }
+}
+
+// =============================================================================
+// CompositeNode Blend Mode Tests
+// =============================================================================
+
+TEST_CASE("Blend mode kernels match scalar reference") {
+    // 不透明・半透明・透明を混在させた行で、SIMD版とスカラー版が一致すること
+    const int count = 67;
+    uint8_t src[count * 4], dst[count * 4];
+    uint32_t seed = 12345;
+    auto next = [&seed]() {
+        seed = seed * 1103515245u + 12345u;
+        return static_cast<uint8_t>(seed >> 16);
+    };
+    for (int i = 0; i < count * 4; ++i) {
+        src[i] = next();
+        dst[i] = next();
+    }
+    for (int i = 0; i < count; ++i) {
+        // 先頭側は両方不透明のブロックを多めにする
+        if (i < 32 || (i % 3) == 0) { src[i * 4 + 3] = 255; dst[i * 4 + 3] = 255; }
+        if (i % 11 == 5) src[i * 4 + 3] = 0;
+        if (i % 13 == 7) dst[i * 4 + 3] = 0;
+    }
+
+    for (int m = 0; m < static_cast<int>(BlendMode::Count); ++m) {
+        const auto& desc = blend::descriptor(static_cast<BlendMode>(m));
+        CAPTURE(desc.name);
+        uint8_t a[count * 4], b[count * 4];
+        std::memcpy(a, dst, sizeof(a));
+        std::memcpy(b, dst, sizeof(b));
+        desc.blendOver(a, src, count);
+        desc.blendOverScalar(b, src, count);
+        CHECK(std::memcmp(a, b, sizeof(a)) == 0);
+    }
+}
+
+TEST_CASE("Blend mode formulas on opaque pixels") {
+    const uint8_t s[4] = {200, 100, 30, 255};
+    auto blendOne = [&s](BlendMode mode, const uint8_t (&d0)[4], uint8_t (&out)[4]) {
+        std::memcpy(out, d0, 4);
+        blend::descriptor(mode).blendOverScalar(out, s, 1);
+    };
+    const uint8_t d[4] = {100, 200, 60, 255};
+    uint8_t o[4];
+
+    blendOne(BlendMode::Normal, d, o);
+    CHECK(std::memcmp(o, s, 4) == 0);
+    blendOne(BlendMode::Multiply, d, o);
+    CHECK(o[0] == 78);   // 200*100/255
+    CHECK(o[2] == 7);    // 30*60/255
+    blendOne(BlendMode::Screen, d, o);
+    CHECK(o[0] == 222);  // 100+200-78
+    blendOne(BlendMode::Add, d, o);
+    CHECK(o[0] == 255);
+    CHECK(o[2] == 90);
+    blendOne(BlendMode::Darken, d, o);
+    CHECK(o[0] == 100);
+    CHECK(o[1] == 100);
+    blendOne(BlendMode::Lighten, d, o);
+    CHECK(o[0] == 200);
+    CHECK(o[1] == 200);
+    blendOne(BlendMode::Difference, d, o);
+    CHECK(o[0] == 100);
+    CHECK(o[2] == 30);
+    blendOne(BlendMode::Overlay, d, o);
+    CHECK(o[0] == 157);  // Cb<128: 2*100*200/255
+    CHECK(o[1] == 188);  // Cb>=128: 255 - 2*55*155/255
+    CHECK(o[3] == 255);
+
+    // 透明な背景にはsrcをそのまま、透明なsrcは何もしない
+    const uint8_t clear[4] = {1, 2, 3, 0};
+    blendOne(BlendMode::Multiply, clear, o);
+    CHECK(std::memcmp(o, s, 4) == 0);
+    const uint8_t t[4] = {9, 9, 9, 0};
+    std::memcpy(o, d, 4);
+    blend::descriptor(BlendMode::Screen).blendOverScalar(o, t, 1);
+    CHECK(std::memcmp(o, d, 4) == 0);
+}
+
+TEST_CASE("CompositeNode blend mode over backdrop") {
+    // 入力0: 不透明パネル [0,8)（Normal、前面）
+    // 入力1: 乗算レイヤー（全幅）
+    // 入力2: 背景（全幅、記録ノード経由）
+    const int canvasW = 32;
+    ImageBuffer panel = createSolidImage(8, 1, 10, 20, 30, 255);
+    ImageBuffer layer = createSolidImage(canvasW, 1, 128, 255, 64, 255);
+    ImageBuffer bg = createSolidImage(canvasW, 1, 200, 100, 255, 255);
+    ImageBuffer dstImg(canvasW, 1, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+
+    SourceNode front(panel.view(), 0, 0);
+    SourceNode mid(layer.view(), 0, 0);
+    SourceNode back(bg.view(), 0, 0);
+    RequestRecorderNode recorder;
+    CompositeNode composite(3);
+    RendererNode renderer;
+    SinkNode sink(dstImg.view(), 0, 0);
+    front >> composite;
+    mid.connectTo(composite, 1);
+    back >> recorder;
+    recorder.connectTo(composite, 2);
+    composite >> renderer >> sink;
+    composite.setBlendMode(1, BlendMode::Multiply);
+    CHECK(composite.blendMode(1) == BlendMode::Multiply);
+    CHECK(composite.blendMode(0) == BlendMode::Normal);
+    renderer.setVirtualScreen(canvasW, 1);
+    renderer.exec();
+
+    // 前面の不透明パネルに隠れた区間は背景をリクエストしない
+    CHECK(recorder.requestedPixels == canvasW - 8);
+
+    for (int x = 0; x < canvasW; ++x) {
+        uint8_t r, g, b, a;
+        getPixelRGBA8(dstImg.view(), x, 0, r, g, b, a);
+        if (x < 8) {
+            CHECK(r == 10);
+            CHECK(b == 30);
+        } else {
+            CHECK(r == 100);  // 128*200/255
+            CHECK(g == 100);  // 255*100/255
+            CHECK(b == 64);   // 64*255/255
+        }
+        CHECK(a == 255);
+    }
+}
+
+TEST_CASE("CompositeNode blend modes with translucent layers") {
+    // 半透明の前面(Normal) + Screen + 半透明の背景: 合成関数を順に適用した結果と一致
+    const int canvasW = 20;
+    ImageBuffer top = createSolidImage(canvasW, 1, 255, 0, 0, 100);
+    ImageBuffer scr = createSolidImage(canvasW, 1, 40, 200, 90, 180);
+    ImageBuffer bg = createSolidImage(canvasW, 1, 90, 60, 200, 150);
+    ImageBuffer dstImg(canvasW, 1, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+
+    SourceNode s0(top.view(), 0, 0);
+    SourceNode s1(scr.view(), 0, 0);
+    SourceNode s2(bg.view(), 0, 0);
+    CompositeNode composite(3);
+    RendererNode renderer;
+    SinkNode sink(dstImg.view(), 0, 0);
+    s0 >> composite;
+    s1.connectTo(composite, 1);
+    s2.connectTo(composite, 2);
+    composite >> renderer >> sink;
+    composite.setBlendMode(1, BlendMode::Screen);
+    renderer.setVirtualScreen(canvasW, 1);
+    renderer.exec();
+
+    // 参照: 背景 ← Screen(入力1) ← 前面をunder合成
+    uint8_t expected[4] = {90, 60, 200, 150};
+    blend::descriptor(BlendMode::Screen).blendOverScalar(
+        expected, static_cast<const uint8_t*>(scr.view().pixelAt(0, 0)), 1);
+    uint8_t front[4] = {255, 0, 0, 100};
+    PixelFormatIDs::RGBA8_Straight->blendUnderStraight(front, expected, 1, nullptr);
+
+    uint8_t r, g, b, a;
+    getPixelRGBA8(dstImg.view(), 10, 0, r, g, b, a);
+    CHECK(r == front[0]);
+    CHECK(g == front[1]);
+    CHECK(b == front[2]);
+    CHECK(a == front[3]);
+}
+
 // =============================================================================
 // CompositeNode Port Management Tests
 // =============================================================================
@@ -0,0 +1,325 @@
+// fleximg ConvolutionNode Unit Tests
+// 汎用畳み込みフィルタノードのテスト
+
+#include "doctest.h"
+
+#define FLEXIMG_NAMESPACE fleximg
+#include "fleximg/core/common.h"
+#include "fleximg/core/types.h"
+#include "fleximg/image/render_types.h"
+#include "fleximg/image/image_buffer.h"
+#include "fleximg/nodes/convolution_node.h"
+#include "fleximg/nodes/blur_node.h"
+#include "fleximg/nodes/source_node.h"
+#include "fleximg/nodes/sink_node.h"
+#include "fleximg/nodes/renderer_node.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+using namespace fleximg;
+
+// =============================================================================
+// Helper Functions
+// =============================================================================
+
+// 色・アルファが位置で変化する画像（透明ピクセルを含む）
+static ImageBuffer createPatternImage(int width, int height) {
+    ImageBuffer img(width, height, PixelFormatIDs::RGBA8_Straight);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            uint8_t* p = static_cast<uint8_t*>(img.view().pixelAt(x, y));
+            p[0] = static_cast<uint8_t>(x * 37 + y * 11);
+            p[1] = static_cast<uint8_t>(255 - x * 19);
+            p[2] = static_cast<uint8_t>(x * y * 7);
+            p[3] = static_cast<uint8_t>(((x + y) % 5 == 0) ? 0 : 255 - (x * 13 + y * 29) % 200);
+        }
+    }
+    return img;
+}
+
+static int clampInt(int v, int lo, int hi) {
+    return (v < lo) ? lo : (v > hi) ? hi : v;
+}
+
+// 参照実装: プリマルチプライド値に相関を適用してストレートへ戻す
+// （dst 上で画像は (tx, ty) に配置、範囲外は透明）
+static void referenceConvolve(const ImageBuffer& src, int tx, int ty, int kw, int kh,
+                              const int16_t* k, int divisor, int bias, bool preserveAlpha,
+                              uint8_t* expected, int x, int y) {
+    const int ax = (kw - 1) / 2, ay = (kh - 1) / 2;
+    auto premul = [&](int sx, int sy, int c) -> long {
+        if (sx < 0 || sy < 0 || sx >= src.width() || sy >= src.height()) return 0;
+        const uint8_t* p = static_cast<const uint8_t*>(src.view().pixelAt(sx, sy));
+        if (c == 3) return p[3];
+        return (p[c] * p[3] + 127) / 255;
+    };
+    long sum[4] = {0, 0, 0, 0};
+    for (int i = 0; i < kh; i++) {
+        for (int j = 0; j < kw; j++) {
+            for (int c = 0; c < 4; c++) {
+                sum[c] += k[i * kw + j] * premul(x - tx - ax + j, y - ty - ay + i, c);
+            }
+        }
+    }
+    // 出力変換は float（A = trunc(ΣA×scale + 0.5)、P = trunc(ΣP×scale + bias×A/255 + 0.5)、
+    // C = trunc(P × 255/A + 0.5)）
+    const auto scale = static_cast<float>(1.0 / divisor);
+    const auto trunc = [](float v, float hi) {
+        return static_cast<int>(std::min(std::max(v, 0.0f), hi));
+    };
+    const int a = preserveAlpha ? static_cast<int>(premul(x - tx, y - ty, 3))
+                                : trunc(static_cast<float>(sum[3]) * scale + 0.5f, 255.0f);
+    expected[0] = expected[1] = expected[2] = expected[3] = 0;
+    if (a == 0) return;
+    const auto af = static_cast<float>(a);
+    for (int c = 0; c < 3; c++) {
+        const int p = trunc(static_cast<float>(sum[c]) * scale + static_cast<float>(bias) / 255.0f * af + 0.5f, af);
+        expected[c] = static_cast<uint8_t>(static_cast<float>(p) * (255.0f / af) + 0.5f);
+    }
+    expected[3] = static_cast<uint8_t>(a);
+}
+
+// 畳み込み結果を参照実装と比較し、許容差を超えて異なるピクセル数を返す
+static int countReferenceMismatches(ConvolutionNode& conv, const ImageBuffer& image,
+                                    int kw, int kh, const int16_t* k, int divisor, int bias,
+                                    bool preserveAlpha, int tolerance = 0) {
+    const int tx = 4, ty = 5;
+    const int canvasW = image.width() + tx * 2, canvasH = image.height() + ty * 2;
+    ImageBuffer dst(canvasW, canvasH, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    SourceNode src(image.view());
+    src.setTranslation(static_cast<float>(tx), static_cast<float>(ty));
+    RendererNode renderer;
+    SinkNode sink(dst.view());
+    src >> conv >> renderer >> sink;
+    renderer.setVirtualScreen(canvasW, canvasH);
+    CHECK(renderer.exec() == PrepareStatus::Prepared);
+
+    int mismatches = 0;
+    for (int y = 0; y < canvasH; y++) {
+        for (int x = 0; x < canvasW; x++) {
+            uint8_t expected[4];
+            referenceConvolve(image, tx, ty, kw, kh, k, divisor, bias, preserveAlpha, expected, x, y);
+            const auto* actual = static_cast<const uint8_t*>(dst.view().pixelAt(x, y));
+            for (int c = 0; c < 4; c++) {
+                // tolerance はプリマルチプライド値の差（ストレートでは 255/A 倍に拡大）
+                const int allowed = (c == 3 || tolerance == 0)
+                    ? tolerance : tolerance * 255 / std::max<int>(1, expected[3]) + 1;
+                if (std::abs(actual[c] - expected[c]) > allowed) {
+                    ++mismatches;
+                    break;
+                }
+            }
+        }
+    }
+    return mismatches;
+}
+
+// =============================================================================
+// ConvolutionNode Tests
+// =============================================================================
+
+TEST_CASE("ConvolutionNode basic construction") {
+    ConvolutionNode node;
+    CHECK(std::string(node.name()) == "ConvolutionNode");
+    CHECK(node.inputPortCount() == 1);
+    CHECK(node.outputPortCount() == 1);
+    CHECK(node.kernelWidth() == 1);
+    CHECK(node.kernelHeight() == 1);
+    CHECK(node.weight(0, 0) == 1);
+
+    const int16_t k[] = {1, 2, 3, 4, 5, 6};
+    node.setKernel(3, 2, k);
+    CHECK(node.kernelWidth() == 3);
+    CHECK(node.kernelHeight() == 2);
+    CHECK(node.weight(2, 1) == 6);
+    CHECK(node.divisor() == 21);  // 0 指定 → 重みの合計
+
+    const int16_t big[7] = {5000, -5000};
+    node.setKernel(9, 0, big, 0, 0);
+    CHECK(node.kernelWidth() == ConvolutionNode::kMaxKernelSize);
+    CHECK(node.kernelHeight() == 1);
+    CHECK(node.weight(0, 0) == ConvolutionNode::kMaxWeight);
+    CHECK(node.weight(1, 0) == -ConvolutionNode::kMaxWeight);
+    CHECK(node.divisor() == 1);  // 合計0 → 1
+
+    node.setEdgeDetect();
+    CHECK(node.preserveAlpha());
+    CHECK(node.weight(1, 1) == 8);
+}
+
+TEST_CASE("ConvolutionNode non-separable kernels match a brute-force reference") {
+    ImageBuffer image = createPatternImage(13, 9);
+
+    SUBCASE("sharpen") {
+        ConvolutionNode conv;
+        conv.setSharpen(2);
+        const int16_t k[] = {0, -2, 0, -2, 9, -2, 0, -2, 0};
+        CHECK(countReferenceMismatches(conv, image, 3, 3, k, 1, 0, false) == 0);
+        CHECK_FALSE(conv.isSeparable());
+    }
+    SUBCASE("emboss with bias and preserved alpha") {
+        ConvolutionNode conv;
+        conv.setEmboss();
+        const int16_t k[] = {-1, -1, 0, -1, 0, 1, 0, 1, 1};
+        CHECK(countReferenceMismatches(conv, image, 3, 3, k, 1, 128, true) == 0);
+    }
+    SUBCASE("asymmetric 4x2 kernel with divisor") {
+        const int16_t k[] = {1, -3, 5, 2, 4, 0, -1, 7};
+        ConvolutionNode conv;
+        conv.setKernel(4, 2, k, 9, 3);
+        CHECK(countReferenceMismatches(conv, image, 4, 2, k, 9, 3, false) == 0);
+    }
+}
+
+TEST_CASE("ConvolutionNode detects and applies separable kernels") {
+    ImageBuffer image = createPatternImage(15, 11);
+
+    SUBCASE("5x5 binomial") {
+        // [1 4 6 4 1]^T × [1 4 6 4 1]
+        const int16_t v[] = {1, 4, 6, 4, 1};
+        int16_t k[25];
+        for (int i = 0; i < 5; i++) {
+            for (int j = 0; j < 5; j++) k[i * 5 + j] = static_cast<int16_t>(v[i] * v[j]);
+        }
+        ConvolutionNode conv;
+        conv.setKernel(5, 5, k);
+        CHECK(countReferenceMismatches(conv, image, 5, 5, k, 256, 0, false) == 0);
+        CHECK(conv.isSeparable());
+    }
+    SUBCASE("Sobel with preserved alpha") {
+        const int16_t k[] = {-1, 0, 1, -2, 0, 2, -1, 0, 1};
+        ConvolutionNode conv;
+        conv.setKernel(3, 3, k, 1, 128);
+        conv.setPreserveAlpha(true);
+        CHECK(countReferenceMismatches(conv, image, 3, 3, k, 1, 128, true) == 0);
+        CHECK(conv.isSeparable());
+    }
+    SUBCASE("large weights need a horizontal shift") {
+        // 水平の絶対値合計 255×(1000+999) は int16 を超えるため右シフトして格納
+        // （シフトで落ちた下位ビットにより ±1 の丸め差を許容）
+        const int16_t k[] = {1000, 999, 1000, 999};
+        ConvolutionNode conv;
+        conv.setKernel(2, 2, k);
+        CHECK(countReferenceMismatches(conv, image, 2, 2, k, 3998, 0, false, 1) == 0);
+        CHECK(conv.isSeparable());
+    }
+}
+
+TEST_CASE("ConvolutionNode 1x1 identity is a pass-through") {
+    ImageBuffer image = createPatternImage(8, 6);
+    ConvolutionNode conv;
+    const int16_t k[] = {3};
+    conv.setKernel(1, 1, k, 3, 0);
+    const int tx = 4, ty = 5;
+    ImageBuffer dst(image.width() + tx * 2, image.height() + ty * 2, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    SourceNode src(image.view());
+    src.setTranslation(static_cast<float>(tx), static_cast<float>(ty));
+    RendererNode renderer;
+    SinkNode sink(dst.view());
+    src >> conv >> renderer >> sink;
+    renderer.setVirtualScreen(dst.width(), dst.height());
+    CHECK(renderer.exec() == PrepareStatus::Prepared);
+    int mismatches = 0;
+    for (int y = 0; y < image.height(); y++) {
+        for (int x = 0; x < image.width(); x++) {
+            const auto* s = static_cast<const uint8_t*>(image.view().pixelAt(x, y));
+            const auto* d = static_cast<const uint8_t*>(dst.view().pixelAt(x + tx, y + ty));
+            if (s[3] != d[3] || (s[3] != 0 && std::memcmp(s, d, 3) != 0)) ++mismatches;
+        }
+    }
+    CHECK(mismatches == 0);
+}
+
+TEST_CASE("ConvolutionNode processes Alpha8 input in a single channel") {
+    ImageBuffer alphaImg(12, 10, PixelFormatIDs::Alpha8);
+    for (int y = 0; y < 10; y++) {
+        for (int x = 0; x < 12; x++) {
+            *static_cast<uint8_t*>(alphaImg.view().pixelAt(x, y)) =
+                static_cast<uint8_t>((x % 4 == 0) ? 0 : (x * 20 + y * 7));
+        }
+    }
+    SourceNode src(alphaImg.view());
+    ConvolutionNode conv;
+    conv.setSharpen(1);
+    RendererNode renderer;
+    ImageBuffer dst(16, 16, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    SinkNode sink(dst.view());
+    src >> conv >> renderer >> sink;
+    renderer.setVirtualScreen(16, 16);
+    REQUIRE(renderer.execPrepare() == PrepareStatus::Prepared);
+
+    RenderRequest req;
+    req.width = 16;
+    req.height = 1;
+    req.origin = {0, to_fixed(4)};
+    RenderResponse& resp = conv.pullProcess(req);
+    REQUIRE(resp.isValid());
+    CHECK(resp.buffer().formatID() == PixelFormatIDs::Alpha8);
+
+    // 値を直接畳み込む: 5*v(x,y) - 上下左右
+    auto at = [&](int x, int y) -> int {
+        if (x < 0 || y < 0 || x >= 12 || y >= 10) return 0;
+        return *static_cast<const uint8_t*>(alphaImg.view().pixelAt(x, y));
+    };
+    const int outX0 = static_cast<int>(from_fixed(resp.origin.x));
+    const ViewPort out = resp.view();
+    int mismatches = 0;
+    for (int i = 0; i < out.width; i++) {
+        const int x = outX0 + i;
+        const int expected = clampInt(5 * at(x, 4) - at(x - 1, 4) - at(x + 1, 4) - at(x, 3) - at(x, 5), 0, 255);
+        if (*static_cast<const uint8_t*>(out.pixelAt(i, 0)) != expected) ++mismatches;
+    }
+    CHECK(mismatches == 0);
+    renderer.execFinalize();
+}
+
+TEST_CASE("ConvolutionNode getDataRange matches BlurNode of the same extent") {
+    ImageBuffer image = createPatternImage(14, 10);
+    SourceNode src1(image.view()), src2(image.view());
+    for (SourceNode* src : {&src1, &src2}) {
+        src->setRotation(0.5f);
+        src->setTranslation(24, 20);
+    }
+    // 5x3 カーネル ↔ BlurNode(radiusX=2, radiusY=1)
+    BlurNode blur;
+    blur.setRadius(2, 1);
+    ConvolutionNode conv;
+    const int16_t k[15] = {1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 1};
+    conv.setKernel(5, 3, k);
+    src1 >> blur;
+    src2 >> conv;
+
+    PrepareRequest prep;
+    prep.width = 48;
+    prep.height = 40;
+    const PrepareResponse expectedPrep = blur.pullPrepare(prep);
+    const PrepareResponse actualPrep = conv.pullPrepare(prep);
+    REQUIRE(actualPrep.ok());
+    CHECK(actualPrep.origin.x == expectedPrep.origin.x);
+    CHECK(actualPrep.origin.y == expectedPrep.origin.y);
+    CHECK(actualPrep.width == expectedPrep.width);
+    CHECK(actualPrep.height == expectedPrep.height);
+
+    RenderRequest req;
+    req.width = 48;
+    req.height = 1;
+    int rowsWithData = 0;
+    for (int y = 0; y < 40; y++) {
+        CAPTURE(y);
+        req.origin = {0, to_fixed(y)};
+        const DataRange expected = blur.getDataRange(req);
+        const DataRange actual = conv.getDataRange(req);
+        CHECK(actual.hasData() == expected.hasData());
+        if (expected.hasData()) {
+            ++rowsWithData;
+            CHECK(actual.startX == expected.startX);
+            CHECK(actual.endX == expected.endX);
+        }
+    }
+    CHECK(rowsWithData > 10);
+    blur.pullFinalize();
+    conv.pullFinalize();
+}
@@ -0,0 +1,206 @@
+// fleximg DropShadowNode Unit Tests
+// ドロップシャドウノードのテスト
+
+#include "doctest.h"
+
+#define FLEXIMG_NAMESPACE fleximg
+#include "fleximg/core/common.h"
+#include "fleximg/core/types.h"
+#include "fleximg/image/render_types.h"
+#include "fleximg/image/image_buffer.h"
+#include "fleximg/nodes/drop_shadow_node.h"
+#include "fleximg/nodes/source_node.h"
+#include "fleximg/nodes/sink_node.h"
+#include "fleximg/nodes/renderer_node.h"
+#include <cstdlib>
+#include <string>
+
+using namespace fleximg;
+
+// =============================================================================
+// Helper Functions
+// =============================================================================
+
+// 単色の矩形画像
+static ImageBuffer createSolidImage(int width, int height, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    ImageBuffer img(width, height, PixelFormatIDs::RGBA8_Straight);
+    ViewPort view = img.view();
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            uint8_t* p = static_cast<uint8_t*>(view.pixelAt(x, y));
+            p[0] = r;
+            p[1] = g;
+            p[2] = b;
+            p[3] = a;
+        }
+    }
+    return img;
+}
+
+static const uint8_t* pixel(const ImageBuffer& img, int x, int y) {
+    return static_cast<const uint8_t*>(img.view().pixelAt(x, y));
+}
+
+// source(translate) >> shadow >> renderer >> sink で描画
+static void renderShadow(const ImageBuffer& image, DropShadowNode& shadow,
+                         int tx, int ty, ImageBuffer& dst) {
+    SourceNode source(image.view());
+    source.setTranslation(static_cast<float>(tx), static_cast<float>(ty));
+    RendererNode renderer;
+    SinkNode sink(dst.view());
+    source >> shadow >> renderer >> sink;
+    renderer.setVirtualScreen(dst.width(), dst.height());
+    CHECK(renderer.exec() == PrepareStatus::Prepared);
+}
+
+// =============================================================================
+// DropShadowNode Tests
+// =============================================================================
+
+TEST_CASE("DropShadowNode basic construction") {
+    DropShadowNode node;
+    CHECK(std::string(node.name()) == "DropShadowNode");
+    CHECK(node.inputPortCount() == 1);
+    CHECK(node.outputPortCount() == 1);
+
+    node.setRadius(500);
+    CHECK(node.radius() == DropShadowNode::kMaxRadius);
+    node.setPasses(0);
+    CHECK(node.passes() == 1);
+    node.setDownsample(3);
+    CHECK(node.downsample() == 2);
+
+    SUBCASE("automatic downsample follows the spread") {
+        node.setDownsample(0);
+        node.setPasses(1);
+        node.setRadius(3);
+        CHECK(node.effectiveDownsample() == 1);
+        node.setRadius(12);
+        CHECK(node.effectiveDownsample() == 2);
+        node.setPasses(3);
+        CHECK(node.effectiveDownsample() == 4);
+    }
+}
+
+TEST_CASE("DropShadowNode hard shadow is offset and tinted") {
+    ImageBuffer image = createSolidImage(6, 4, 200, 100, 50, 255);
+    DropShadowNode shadow;
+    shadow.setRadius(0);
+    shadow.setOffset(3, 2);
+    shadow.setColor(10, 20, 30, 128);
+    shadow.setDownsample(1);
+
+    ImageBuffer dst(16, 12, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    renderShadow(image, shadow, 2, 2, dst);
+
+    // 入力（不透明）は影より手前
+    CHECK(pixel(dst, 2, 2)[0] == 200);
+    CHECK(pixel(dst, 7, 5)[3] == 255);
+    // 入力の外側で影が見える範囲: 影色 + 影アルファ
+    const uint8_t* s = pixel(dst, 9, 7);
+    CHECK(s[0] == 10);
+    CHECK(s[1] == 20);
+    CHECK(s[2] == 30);
+    CHECK(s[3] == 128);
+    CHECK(pixel(dst, 10, 7)[3] == 128);
+    // 影の外側は透明
+    CHECK(pixel(dst, 11, 7)[3] == 0);
+    CHECK(pixel(dst, 9, 8)[3] == 0);
+    CHECK(pixel(dst, 1, 2)[3] == 0);
+}
+
+TEST_CASE("DropShadowNode composites translucent input over the shadow") {
+    ImageBuffer image = createSolidImage(4, 4, 255, 0, 0, 128);
+    DropShadowNode shadow;
+    shadow.setRadius(0);
+    shadow.setOffset(1, 0);
+    shadow.setColor(0, 0, 255, 255);
+    shadow.setDownsample(1);
+
+    ImageBuffer dst(8, 6, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    renderShadow(image, shadow, 1, 1, dst);
+
+    // 影アルファ = 128（入力アルファ × 影色アルファ）
+    // 合成: a = 128 + 128 * (255 - 128) / 255 ≒ 192
+    const uint8_t* p = pixel(dst, 3, 2);
+    CHECK(p[3] >= 191);
+    CHECK(p[3] <= 193);
+    // 入力の寄与 128*255 : 影の寄与 128*127 → 赤が優勢
+    CHECK(p[0] > p[2]);
+    CHECK(p[1] == 0);
+    CHECK(std::abs(static_cast<int>(p[0]) - 170) <= 1);
+    CHECK(std::abs(static_cast<int>(p[2]) - 85) <= 1);
+    // 入力の左端は影なし（入力そのまま）
+    CHECK(pixel(dst, 1, 2)[3] == 128);
+    CHECK(pixel(dst, 1, 2)[0] == 255);
+}
+
+TEST_CASE("DropShadowNode downsampled blur approximates full resolution") {
+    ImageBuffer image = createSolidImage(16, 16, 255, 255, 255, 255);
+
+    auto renderWith = [&](int downsample, ImageBuffer& dst) {
+        DropShadowNode shadow;
+        shadow.setRadius(8);
+        shadow.setPasses(2);
+        shadow.setOffset(6, 6);
+        shadow.setColor(0, 0, 0, 255);
+        shadow.setDownsample(downsample);
+        renderShadow(image, shadow, 12, 12, dst);
+    };
+
+    ImageBuffer full(56, 56, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    ImageBuffer half(56, 56, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    ImageBuffer quarter(56, 56, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    renderWith(1, full);
+    renderWith(2, half);
+    renderWith(4, quarter);
+
+    int maxDiffHalf = 0, maxDiffQuarter = 0;
+    for (int y = 0; y < 56; ++y) {
+        for (int x = 0; x < 56; ++x) {
+            const int a = pixel(full, x, y)[3];
+            maxDiffHalf = std::max(maxDiffHalf, std::abs(a - pixel(half, x, y)[3]));
+            maxDiffQuarter = std::max(maxDiffQuarter, std::abs(a - pixel(quarter, x, y)[3]));
+        }
+    }
+    CHECK(maxDiffHalf <= 16);
+    CHECK(maxDiffQuarter <= 32);
+
+    // 影は入力から離れるほど薄くなり、広がり (radius*passes) の外で消える
+    CHECK(pixel(full, 30, 34)[3] > pixel(full, 30, 40)[3]);
+    CHECK(pixel(full, 30, 40)[3] > pixel(full, 30, 46)[3]);
+    CHECK(pixel(full, 30, 52)[3] == 0);
+    CHECK(pixel(half, 30, 52)[3] == 0);
+    // 入力部分は不透明の白のまま
+    CHECK(pixel(quarter, 20, 20)[0] == 255);
+    CHECK(pixel(quarter, 20, 20)[3] == 255);
+}
+
+TEST_CASE("DropShadowNode getDataRange includes the shadow") {
+    ImageBuffer image = createSolidImage(4, 4, 255, 255, 255, 255);
+    SourceNode source(image.view());
+    DropShadowNode shadow;
+    shadow.setRadius(0);
+    shadow.setOffset(5, 1);
+    shadow.setDownsample(1);
+    RendererNode renderer;
+    ImageBuffer dst(16, 8, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    SinkNode sink(dst.view());
+    source >> shadow >> renderer >> sink;
+    renderer.setVirtualScreen(16, 8);
+    REQUIRE(renderer.execPrepare() == PrepareStatus::Prepared);
+
+    RenderRequest req;
+    req.width = 16;
+    req.height = 1;
+    req.origin = {0, to_fixed(2)};
+    DataRange r = shadow.getDataRange(req);
+    CHECK(r.startX == 0);
+    CHECK(r.endX == 9);
+    // 入力より下の行は影のみ
+    req.origin = {0, to_fixed(4)};
+    r = shadow.getDataRange(req);
+    CHECK(r.startX == 5);
+    CHECK(r.endX == 9);
+    renderer.execFinalize();
+}
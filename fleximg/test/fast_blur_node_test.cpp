@@ -0,0 +1,230 @@
+// fleximg FastBlurNode Unit Tests
+// 縮小ぼかしノードのテスト
+
+#include "doctest.h"
+
+#define FLEXIMG_NAMESPACE fleximg
+#include "fleximg/core/common.h"
+#include "fleximg/core/types.h"
+#include "fleximg/image/render_types.h"
+#include "fleximg/image/image_buffer.h"
+#include "fleximg/nodes/fast_blur_node.h"
+#include "fleximg/nodes/horizontal_blur_node.h"
+#include "fleximg/nodes/vertical_blur_node.h"
+#include "fleximg/nodes/source_node.h"
+#include "fleximg/nodes/sink_node.h"
+#include "fleximg/nodes/renderer_node.h"
+#include <cstdlib>
+#include <string>
+
+using namespace fleximg;
+
+// =============================================================================
+// Helper Functions
+// =============================================================================
+
+// 単色の矩形画像
+static ImageBuffer createSolidImage(int width, int height, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    ImageBuffer img(width, height, PixelFormatIDs::RGBA8_Straight);
+    ViewPort view = img.view();
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            uint8_t* p = static_cast<uint8_t*>(view.pixelAt(x, y));
+            p[0] = r;
+            p[1] = g;
+            p[2] = b;
+            p[3] = a;
+        }
+    }
+    return img;
+}
+
+static const uint8_t* pixel(const ImageBuffer& img, int x, int y) {
+    return static_cast<const uint8_t*>(img.view().pixelAt(x, y));
+}
+
+// source(translate) >> blur >> renderer >> sink で描画
+static void renderBlur(const ImageBuffer& image, FastBlurNode& blur,
+                       int tx, int ty, ImageBuffer& dst) {
+    SourceNode source(image.view());
+    source.setTranslation(static_cast<float>(tx), static_cast<float>(ty));
+    RendererNode renderer;
+    SinkNode sink(dst.view());
+    source >> blur >> renderer >> sink;
+    renderer.setVirtualScreen(dst.width(), dst.height());
+    CHECK(renderer.exec() == PrepareStatus::Prepared);
+}
+
+// 等倍の HorizontalBlur >> VerticalBlur（比較用）
+static void renderReference(const ImageBuffer& image, int radius, int passes,
+                            int tx, int ty, ImageBuffer& dst) {
+    SourceNode source(image.view());
+    source.setTranslation(static_cast<float>(tx), static_cast<float>(ty));
+    HorizontalBlurNode hblur;
+    hblur.setRadius(radius);
+    hblur.setPasses(passes);
+    VerticalBlurNode vblur;
+    vblur.setRadius(radius);
+    vblur.setPasses(passes);
+    RendererNode renderer;
+    SinkNode sink(dst.view());
+    source >> hblur >> vblur >> renderer >> sink;
+    renderer.setVirtualScreen(dst.width(), dst.height());
+    CHECK(renderer.exec() == PrepareStatus::Prepared);
+}
+
+// =============================================================================
+// FastBlurNode Tests
+// =============================================================================
+
+TEST_CASE("FastBlurNode basic construction") {
+    FastBlurNode node;
+    CHECK(std::string(node.name()) == "FastBlurNode");
+    CHECK(node.inputPortCount() == 1);
+    CHECK(node.outputPortCount() == 1);
+
+    node.setRadius(5000);
+    CHECK(node.radius() == FastBlurNode::kMaxRadius);
+    node.setPasses(0);
+    CHECK(node.passes() == 1);
+    node.setDownsample(3);
+    CHECK(node.downsample() == 2);
+    node.setDownsample(100);
+    CHECK(node.downsample() == 8);
+
+    SUBCASE("automatic downsample follows the thresholds") {
+        node.setDownsample(0);
+        node.setPasses(1);
+        node.setRadius(4);
+        CHECK(node.effectiveDownsample() == 1);
+        node.setRadius(8);
+        CHECK(node.effectiveDownsample() == 2);
+        node.setRadius(30);
+        CHECK(node.effectiveDownsample() == 4);
+        node.setPasses(3);
+        CHECK(node.effectiveDownsample() == 8);
+        CHECK(node.lowResRadius() == 4);
+
+        node.setAutoThresholds(100, 200, 400);
+        CHECK(node.effectiveDownsample() == 1);
+        CHECK(node.lowResRadius() == 30);
+        // 閾値は単調になるよう揃えられる
+        node.setAutoThresholds(50, 10, 0);
+        CHECK(node.autoThreshold4() == 50);
+        CHECK(node.autoThreshold8() == 50);
+        CHECK(node.effectiveDownsample() == 8);
+    }
+}
+
+TEST_CASE("FastBlurNode without downsampling matches HorizontalBlur >> VerticalBlur") {
+    ImageBuffer image = createSolidImage(10, 8, 200, 80, 40, 255);
+    FastBlurNode blur;
+    blur.setRadius(3);
+    blur.setPasses(2);
+    blur.setDownsample(1);
+
+    ImageBuffer dst(32, 28, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    ImageBuffer ref(32, 28, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    renderBlur(image, blur, 11, 10, dst);
+    renderReference(image, 3, 2, 11, 10, ref);
+
+    for (int y = 0; y < 28; ++y) {
+        for (int x = 0; x < 32; ++x) {
+            const uint8_t* a = pixel(dst, x, y);
+            const uint8_t* b = pixel(ref, x, y);
+            CHECK(std::abs(a[3] - b[3]) <= 1);
+            if (b[3] >= 32) {
+                CHECK(std::abs(a[0] - b[0]) <= 1);
+            }
+        }
+    }
+}
+
+TEST_CASE("FastBlurNode downsampled blur approximates full resolution") {
+    ImageBuffer image = createSolidImage(48, 48, 255, 255, 255, 255);
+    ImageBuffer ref(112, 112, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    renderReference(image, 8, 2, 32, 32, ref);
+
+    for (int factor : {2, 4, 8}) {
+        CAPTURE(factor);
+        FastBlurNode blur;
+        blur.setRadius(8);
+        blur.setPasses(2);
+        blur.setDownsample(factor);
+        ImageBuffer dst(112, 112, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+        renderBlur(image, blur, 32, 32, dst);
+
+        int maxDiff = 0;
+        for (int y = 0; y < 112; ++y) {
+            for (int x = 0; x < 112; ++x) {
+                maxDiff = std::max(maxDiff, std::abs(pixel(dst, x, y)[3] - pixel(ref, x, y)[3]));
+            }
+        }
+        CHECK(maxDiff <= factor * 8);
+        // 入力中心は不透明の白のまま、広がりの十分外側は透明
+        CHECK(pixel(dst, 56, 56)[0] == 255);
+        CHECK(pixel(dst, 56, 56)[3] == 255);
+        CHECK(pixel(dst, 2, 56)[3] == 0);
+        CHECK(pixel(dst, 56, 109)[3] == 0);
+    }
+}
+
+TEST_CASE("FastBlurNode large radius keeps flat regions and symmetry") {
+    ImageBuffer image = createSolidImage(200, 200, 40, 160, 220, 255);
+    FastBlurNode blur;
+    blur.setRadius(24);
+    blur.setPasses(3);
+    REQUIRE(blur.effectiveDownsample() == 8);
+
+    ImageBuffer dst(480, 480, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    renderBlur(image, blur, 140, 140, dst);
+
+    // 平坦部はそのまま
+    const uint8_t* c = pixel(dst, 240, 240);
+    CHECK(c[0] == 40);
+    CHECK(c[1] == 160);
+    CHECK(c[2] == 220);
+    CHECK(c[3] == 255);
+    // 縁は半透明、色は保たれる
+    const uint8_t* e = pixel(dst, 140, 240);
+    CHECK(e[3] > 64);
+    CHECK(e[3] < 192);
+    CHECK(std::abs(e[1] - 160) <= 2);
+    // 左右・上下対称（縮小グリッドの位相差を許容）
+    for (int d = 0; d < 120; d += 8) {
+        CHECK(std::abs(pixel(dst, 140 - d, 240)[3] - pixel(dst, 339 + d, 240)[3]) <= 8);
+        CHECK(std::abs(pixel(dst, 240, 140 - d)[3] - pixel(dst, 240, 339 + d)[3]) <= 8);
+    }
+}
+
+TEST_CASE("FastBlurNode getDataRange covers the expanded bounds") {
+    ImageBuffer image = createSolidImage(16, 16, 255, 255, 255, 255);
+    SourceNode source(image.view());
+    source.setTranslation(40.0f, 40.0f);
+    FastBlurNode blur;
+    blur.setRadius(8);
+    blur.setPasses(1);
+    blur.setDownsample(4);
+    RendererNode renderer;
+    ImageBuffer dst(96, 96, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    SinkNode sink(dst.view());
+    source >> blur >> renderer >> sink;
+    renderer.setVirtualScreen(96, 96);
+    REQUIRE(renderer.execPrepare() == PrepareStatus::Prepared);
+
+    // 縮小半径 2 → 縮小画素 2 個（等倍 8px）ずつ拡張
+    RenderRequest req;
+    req.width = 96;
+    req.height = 1;
+    req.origin = {0, to_fixed(48)};
+    DataRange r = blur.getDataRange(req);
+    CHECK(r.startX == 32);
+    CHECK(r.endX == 64);
+    req.origin = {0, to_fixed(31)};
+    CHECK_FALSE(blur.getDataRange(req).hasData());
+    req.origin = {0, to_fixed(63)};
+    CHECK(blur.getDataRange(req).hasData());
+    req.origin = {0, to_fixed(64)};
+    CHECK_FALSE(blur.getDataRange(req).hasData());
+    renderer.execFinalize();
+}
@@ -16,6 +16,7 @@
 #include "fleximg/nodes/source_node.h"
 #include "fleximg/nodes/sink_node.h"
 #include "fleximg/nodes/renderer_node.h"
+#include <cstring>
 
 using namespace fleximg;
 
@@ -94,7 +95,7 @@ TEST_CASE("BrightnessNode positive brightness") {
     ImageBuffer srcImg = createSolidImage(imgSize, imgSize, 100, 100, 100, 255);
     ViewPort srcView = srcImg.view();
 
-    ImageBuffer dstImg(canvasSize, canvasSize, PixelFormatIDs::RGBA8_Straight);
+    ImageBuffer dstImg(canvasSize, canvasSize, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
     ViewPort dstView = dstImg.view();
 
     SourceNode src(srcView, float_to_fixed(imgSize / 2.0f), float_to_fixed(imgSize / 2.0f));
@@ -118,6 +119,24 @@ TEST_CASE("BrightnessNode positive brightness") {
     CHECK(b > 100);
 }
 
+TEST_CASE("BrightnessNode does not modify reference-mode source") {
+    // 参照モード（ソース画像のサブビュー）は編集せずコピーして加工する
+    ImageBuffer srcImg = createSolidImage(8, 2, 100, 100, 100, 255);
+    ImageBuffer dstImg(8, 2, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+
+    SourceNode src(srcImg.view());
+    BrightnessNode brightness;
+    brightness.setAmount(0.2f);
+    RendererNode renderer;
+    SinkNode sink(dstImg.view());
+    src >> brightness >> renderer >> sink;
+    renderer.setVirtualScreen(8, 2);
+    renderer.exec();
+
+    CHECK(static_cast<const uint8_t*>(dstImg.view().pixelAt(3, 1))[0] > 100);
+    CHECK(static_cast<const uint8_t*>(srcImg.view().pixelAt(3, 1))[0] == 100);
+}
+
 // =============================================================================
 // GrayscaleNode Tests
 // =============================================================================
@@ -135,7 +154,7 @@ TEST_CASE("GrayscaleNode converts to grayscale") {
     ImageBuffer srcImg = createSolidImage(imgSize, imgSize, 255, 0, 0, 255);
     ViewPort srcView = srcImg.view();
 
-    ImageBuffer dstImg(canvasSize, canvasSize, PixelFormatIDs::RGBA8_Straight);
+    ImageBuffer dstImg(canvasSize, canvasSize, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
     ViewPort dstView = dstImg.view();
 
     SourceNode src(srcView, float_to_fixed(imgSize / 2.0f), float_to_fixed(imgSize / 2.0f));
@@ -186,7 +205,7 @@ TEST_CASE("AlphaNode reduces alpha") {
     ImageBuffer srcImg = createSolidImage(imgSize, imgSize, 255, 0, 0, 255);
     ViewPort srcView = srcImg.view();
 
-    ImageBuffer dstImg(canvasSize, canvasSize, PixelFormatIDs::RGBA8_Straight);
+    ImageBuffer dstImg(canvasSize, canvasSize, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
     ViewPort dstView = dstImg.view();
 
     SourceNode src(srcView, float_to_fixed(imgSize / 2.0f), float_to_fixed(imgSize / 2.0f));
@@ -236,7 +255,7 @@ TEST_CASE("HorizontalBlurNode blurs image horizontally") {
     uint8_t* centerPixel = static_cast<uint8_t*>(srcView.pixelAt(imgSize / 2, imgSize / 2));
     centerPixel[0] = 255; centerPixel[1] = 255; centerPixel[2] = 255; centerPixel[3] = 255;
 
-    ImageBuffer dstImg(canvasSize, canvasSize, PixelFormatIDs::RGBA8_Straight);
+    ImageBuffer dstImg(canvasSize, canvasSize, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
     ViewPort dstView = dstImg.view();
 
     SourceNode src(srcView, float_to_fixed(imgSize / 2.0f), float_to_fixed(imgSize / 2.0f));
@@ -285,7 +304,7 @@ TEST_CASE("VerticalBlurNode blurs image vertically") {
     uint8_t* centerPixel = static_cast<uint8_t*>(srcView.pixelAt(imgSize / 2, imgSize / 2));
     centerPixel[0] = 255; centerPixel[1] = 255; centerPixel[2] = 255; centerPixel[3] = 255;
 
-    ImageBuffer dstImg(canvasSize, canvasSize, PixelFormatIDs::RGBA8_Straight);
+    ImageBuffer dstImg(canvasSize, canvasSize, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
     ViewPort dstView = dstImg.view();
 
     SourceNode src(srcView, float_to_fixed(imgSize / 2.0f), float_to_fixed(imgSize / 2.0f));
@@ -304,6 +323,105 @@ TEST_CASE("VerticalBlurNode blurs image vertically") {
     CHECK(true);
 }
 
+TEST_CASE("VerticalBlurNode matches a brute-force box blur") {
+    // 透明ピクセルと奇数幅（SIMD の端数処理）を含む画像
+    // （参照モードの上流から各行を正しく取得し、除算が整数除算と一致すること）
+    const int imgW = 13, imgH = 9, radius = 3, ty = 4;
+    const int canvasW = imgW, canvasH = imgH + ty * 2;
+    ImageBuffer srcImg(imgW, imgH, PixelFormatIDs::RGBA8_Straight);
+    for (int y = 0; y < imgH; y++) {
+        for (int x = 0; x < imgW; x++) {
+            uint8_t* p = static_cast<uint8_t*>(srcImg.view().pixelAt(x, y));
+            p[0] = static_cast<uint8_t>(x * 37 + y * 11);
+            p[1] = static_cast<uint8_t>(255 - x * 19);
+            p[2] = static_cast<uint8_t>(x * y * 7);
+            p[3] = static_cast<uint8_t>(((x + y) % 5 == 0) ? 0 : 255 - (x * 13 + y * 29) % 200);
+        }
+    }
+
+    ImageBuffer dstImg(canvasW, canvasH, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    SourceNode src(srcImg.view());
+    src.setTranslation(0, static_cast<float>(ty));
+    VerticalBlurNode vblur;
+    vblur.setRadius(radius);
+    RendererNode renderer;
+    SinkNode sink(dstImg.view());
+    src >> vblur >> renderer >> sink;
+    renderer.setVirtualScreen(canvasW, canvasH);
+    CHECK(renderer.exec() == PrepareStatus::Prepared);
+
+    // 参照: RGB = Σ(C×A) / ΣA、A = ΣA / (2r+1)（範囲外は透明）
+    int mismatches = 0;
+    for (int y = 0; y < canvasH; y++) {
+        for (int x = 0; x < canvasW; x++) {
+            uint32_t sum[4] = {0, 0, 0, 0};
+            for (int sy = y - ty - radius; sy <= y - ty + radius; sy++) {
+                if (sy < 0 || sy >= imgH) continue;
+                const uint8_t* p = static_cast<const uint8_t*>(srcImg.view().pixelAt(x, sy));
+                for (int c = 0; c < 3; c++) sum[c] += static_cast<uint32_t>(p[c] * p[3]);
+                sum[3] += p[3];
+            }
+            uint8_t expected[4] = {0, 0, 0, 0};
+            if (sum[3] > 0) {
+                for (int c = 0; c < 3; c++) expected[c] = static_cast<uint8_t>(sum[c] / sum[3]);
+                expected[3] = static_cast<uint8_t>(sum[3] / (radius * 2 + 1));
+            }
+            if (std::memcmp(dstImg.view().pixelAt(x, y), expected, 4) != 0) ++mismatches;
+        }
+    }
+    CHECK(mismatches == 0);
+}
+
+TEST_CASE("VerticalBlurNode multi-pass stages match chained single-pass nodes") {
+    // 回転した上流（行ごとに格納範囲が異なる）
+    const int canvasW = 40, canvasH = 40;
+    ImageBuffer srcImg(18, 14, PixelFormatIDs::RGBA8_Straight);
+    for (int y = 0; y < 14; y++) {
+        for (int x = 0; x < 18; x++) {
+            uint8_t* p = static_cast<uint8_t*>(srcImg.view().pixelAt(x, y));
+            p[0] = static_cast<uint8_t>(x * 14);
+            p[1] = static_cast<uint8_t>(y * 18);
+            p[2] = static_cast<uint8_t>((x * y) & 0xFF);
+            p[3] = static_cast<uint8_t>(96 + x * 9);
+        }
+    }
+
+    auto render = [&](bool chained, ImageBuffer& dst) {
+        SourceNode src(srcImg.view());
+        src.setRotation(0.6f);
+        src.setTranslation(20, 20);
+        VerticalBlurNode vblur1, vblur2;
+        vblur1.setRadius(3);
+        vblur2.setRadius(3);
+        vblur1.setPasses(chained ? 1 : 2);
+        RendererNode renderer;
+        SinkNode sink(dst.view());
+        if (chained) {
+            src >> vblur1 >> vblur2 >> renderer >> sink;
+        } else {
+            src >> vblur1 >> renderer >> sink;
+        }
+        renderer.setVirtualScreen(canvasW, canvasH);
+        CHECK(renderer.exec() == PrepareStatus::Prepared);
+    };
+
+    ImageBuffer piped(canvasW, canvasH, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    ImageBuffer chained(canvasW, canvasH, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    render(false, piped);
+    render(true, chained);
+
+    int mismatches = 0, nonZero = 0;
+    for (int y = 0; y < canvasH; y++) {
+        for (int x = 0; x < canvasW; x++) {
+            const void* p = piped.view().pixelAt(x, y);
+            if (std::memcmp(p, chained.view().pixelAt(x, y), 4) != 0) ++mismatches;
+            if (static_cast<const uint8_t*>(p)[3] != 0) ++nonZero;
+        }
+    }
+    CHECK(mismatches == 0);
+    CHECK(nonZero > 18 * 14);
+}
+
 // =============================================================================
 // Horizontal + Vertical Blur Combination Tests
 // =============================================================================
@@ -318,7 +436,7 @@ TEST_CASE("HorizontalBlur + VerticalBlur combination") {
     uint8_t* centerPixel = static_cast<uint8_t*>(srcView.pixelAt(imgSize / 2, imgSize / 2));
     centerPixel[0] = 255; centerPixel[1] = 255; centerPixel[2] = 255; centerPixel[3] = 255;
 
-    ImageBuffer dstImg(canvasSize, canvasSize, PixelFormatIDs::RGBA8_Straight);
+    ImageBuffer dstImg(canvasSize, canvasSize, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
     ViewPort dstView = dstImg.view();
 
     SourceNode src(srcView, float_to_fixed(imgSize / 2.0f), float_to_fixed(imgSize / 2.0f));
@@ -340,6 +458,68 @@ TEST_CASE("HorizontalBlur + VerticalBlur combination") {
     CHECK(true);
 }
 
+TEST_CASE("Blur nodes process Alpha8 input in a single channel") {
+    const int imgW = 12, imgH = 10, canvasW = 24, canvasH = 20;
+
+    // 同じアルファを持つ Alpha8 画像と RGBA8 画像
+    ImageBuffer alphaImg(imgW, imgH, PixelFormatIDs::Alpha8);
+    ImageBuffer rgbaImg = createSolidImage(imgW, imgH, 255, 255, 255, 0);
+    for (int y = 0; y < imgH; y++) {
+        for (int x = 0; x < imgW; x++) {
+            auto a = static_cast<uint8_t>((x % 4 == 0) ? 0 : (x * 20 + y * 7));
+            *static_cast<uint8_t*>(alphaImg.view().pixelAt(x, y)) = a;
+            static_cast<uint8_t*>(rgbaImg.view().pixelAt(x, y))[3] = a;
+        }
+    }
+
+    auto render = [&](const ImageBuffer& img, ImageBuffer& dst) {
+        SourceNode src(img.view());
+        src.setTranslation(6, 5);
+        HorizontalBlurNode hblur;
+        hblur.setRadius(2);
+        hblur.setPasses(2);
+        VerticalBlurNode vblur;
+        vblur.setRadius(2);
+        vblur.setPasses(2);
+        RendererNode renderer;
+        SinkNode sink(dst.view());
+        src >> hblur >> vblur >> renderer >> sink;
+        renderer.setVirtualScreen(canvasW, canvasH);
+        REQUIRE(renderer.execPrepare() == PrepareStatus::Prepared);
+
+        // 単一チャンネルパスの出力は上流と同じフォーマット
+        RenderRequest req;
+        req.width = static_cast<int16_t>(canvasW);
+        req.height = 1;
+        req.origin = {0, to_fixed(9)};
+        RenderResponse& resp = vblur.pullProcess(req);
+        REQUIRE(resp.isValid());
+        CHECK(resp.buffer().formatID() == img.formatID());
+        renderer.execFinalize();
+
+        CHECK(renderer.exec() == PrepareStatus::Prepared);
+    };
+
+    ImageBuffer dstAlpha(canvasW, canvasH, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    ImageBuffer dstRgba(canvasW, canvasH, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    render(alphaImg, dstAlpha);
+    render(rgbaImg, dstRgba);
+
+    // アルファは RGBA8 パスと一致
+    int mismatches = 0;
+    int nonZero = 0;
+    for (int y = 0; y < canvasH; y++) {
+        for (int x = 0; x < canvasW; x++) {
+            const uint8_t a1 = static_cast<const uint8_t*>(dstAlpha.view().pixelAt(x, y))[3];
+            const uint8_t a2 = static_cast<const uint8_t*>(dstRgba.view().pixelAt(x, y))[3];
+            if (a1 != a2) ++mismatches;
+            if (a1 != 0) ++nonZero;
+        }
+    }
+    CHECK(mismatches == 0);
+    CHECK(nonZero > imgW * imgH);
+}
+
 // =============================================================================
 // Filter Chain Tests
 // =============================================================================
@@ -351,7 +531,7 @@ TEST_CASE("Filter chain: brightness -> grayscale") {
     ImageBuffer srcImg = createSolidImage(imgSize, imgSize, 100, 50, 150, 255);
     ViewPort srcView = srcImg.view();
 
-    ImageBuffer dstImg(canvasSize, canvasSize, PixelFormatIDs::RGBA8_Straight);
+    ImageBuffer dstImg(canvasSize, canvasSize, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
     ViewPort dstView = dstImg.view();
 
     SourceNode src(srcView, float_to_fixed(imgSize / 2.0f), float_to_fixed(imgSize / 2.0f));
@@ -375,6 +555,193 @@ TEST_CASE("Filter chain: brightness -> grayscale") {
     CHECK(std::abs(g - b) <= 5);
 }
 
+// 位置で値が変化する画像（融合テスト用）
+static ImageBuffer createPatternImage(int width, int height) {
+    ImageBuffer img(width, height, PixelFormatIDs::RGBA8_Straight);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            uint8_t* p = static_cast<uint8_t*>(img.view().pixelAt(x, y));
+            p[0] = static_cast<uint8_t>(x * 37 + y * 11);
+            p[1] = static_cast<uint8_t>(255 - x * 19 + y);
+            p[2] = static_cast<uint8_t>(x * y * 7);
+            p[3] = static_cast<uint8_t>(x * 13 + y * 29);
+        }
+    }
+    return img;
+}
+
+TEST_CASE("Fused filter chain matches per-node application") {
+    const int width = 37, height = 5;  // SIMD 4ピクセル単位の端数を含む
+    ImageBuffer srcImg = createPatternImage(width, height);
+
+    BrightnessNode brightness1, brightness2;
+    GrayscaleNode grayscale;
+    AlphaNode alpha1, alpha2;
+    brightness1.setAmount(0.3f);
+    alpha1.setScale(0.6f);
+    brightness2.setAmount(-0.45f);
+    alpha2.setScale(1.5f);
+
+    ImageBuffer dstImg(width, height, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    SourceNode src(srcImg.view());
+    RendererNode renderer;
+    SinkNode sink(dstImg.view());
+    src >> brightness1 >> grayscale >> alpha1 >> brightness2 >> alpha2 >> renderer >> sink;
+    renderer.setVirtualScreen(width, height);
+
+    REQUIRE(renderer.execPrepare() == PrepareStatus::Prepared);
+    CHECK(alpha2.fusedStageCount() == 5);
+    renderer.execFinalize();
+    CHECK(alpha2.fusedStageCount() == 1);
+
+    CHECK(renderer.exec() == PrepareStatus::Prepared);
+
+    // 期待値: 各ラインフィルタ関数を順に適用
+    ImageBuffer expected = createPatternImage(width, height);
+    const filters::LineFilterParams p1{0.3f, 0.0f}, p2{0.6f, 0.0f}, p3{-0.45f, 0.0f}, p4{1.5f, 0.0f}, none{};
+    int mismatches = 0;
+    for (int y = 0; y < height; y++) {
+        auto* row = static_cast<uint8_t*>(expected.view().pixelAt(0, y));
+        filters::brightness_line(row, width, p1);
+        filters::grayscale_line(row, width, none);
+        filters::alpha_line(row, width, p2);
+        filters::brightness_line(row, width, p3);
+        filters::alpha_line(row, width, p4);
+        if (std::memcmp(row, dstImg.view().pixelAt(0, y), static_cast<size_t>(width) * 4) != 0) ++mismatches;
+    }
+    CHECK(mismatches == 0);
+
+    // ソース画像は変更されない（参照モードはコピーしてから加工）
+    ImageBuffer original = createPatternImage(width, height);
+    CHECK(std::memcmp(srcImg.view().pixelAt(0, 0), original.view().pixelAt(0, 0),
+                      static_cast<size_t>(width * height) * 4) == 0);
+}
+
+TEST_CASE("Fused filter chain stops at non-filter nodes") {
+    ImageBuffer srcImg = createPatternImage(8, 4);
+    SourceNode src(srcImg.view());
+    BrightnessNode brightness;
+    HorizontalBlurNode blur;
+    blur.setRadius(0);
+    GrayscaleNode grayscale;
+    AlphaNode alpha;
+    ImageBuffer dstImg(8, 4, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    RendererNode renderer;
+    SinkNode sink(dstImg.view());
+    src >> brightness >> blur >> grayscale >> alpha >> renderer >> sink;
+    renderer.setVirtualScreen(8, 4);
+
+    REQUIRE(renderer.execPrepare() == PrepareStatus::Prepared);
+    CHECK(brightness.fusedStageCount() == 1);
+    CHECK(alpha.fusedStageCount() == 2);
+    renderer.execFinalize();
+}
+
+// 融合カーネルに対応しないラインフィルタ（ブロック単位の適用になる）
+static void invert_line(uint8_t* pixels, int_fast16_t count, const filters::LineFilterParams&) {
+    for (int_fast16_t i = 0; i < count * 4; i++) {
+        if (i % 4 != 3) pixels[i] = static_cast<uint8_t>(255 - pixels[i]);
+    }
+}
+
+TEST_CASE("filters::apply_line_chain with an unknown filter matches sequential application") {
+    const int width = 150;  // 複数ブロック
+    ImageBuffer actual = createPatternImage(width, 1);
+    ImageBuffer expected = createPatternImage(width, 1);
+    filters::LineFilterStage stages[3];
+    stages[0].func = &filters::brightness_line;
+    stages[0].params.value1 = 0.2f;
+    stages[1].func = &invert_line;
+    stages[2].func = &filters::alpha_line;
+    stages[2].params.value1 = 0.5f;
+
+    filters::apply_line_chain(static_cast<uint8_t*>(actual.view().pixelAt(0, 0)), width, stages, 3);
+    auto* row = static_cast<uint8_t*>(expected.view().pixelAt(0, 0));
+    for (const auto& stage : stages) {
+        stage.func(row, width, stage.params);
+    }
+    CHECK(std::memcmp(actual.view().pixelAt(0, 0), row, static_cast<size_t>(width) * 4) == 0);
+}
+
+TEST_CASE("Point filters transform the palette of indexed sources") {
+    const int width = 21, height = 4;
+    ImageBuffer indexed(width, height, PixelFormatIDs::Index8);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            *static_cast<uint8_t*>(indexed.view().pixelAt(x, y)) = static_cast<uint8_t>((x * 3 + y) % 8);
+        }
+    }
+    // RGB565 パレット + カラーキー（ピクセル経路では展開時にカラーキーを適用）
+    uint16_t palette[8];
+    for (int i = 0; i < 8; i++) {
+        palette[i] = static_cast<uint16_t>(i * 0x2345 + 0x0841);
+    }
+    PixelAuxInfo aux;
+    aux.palette = palette;
+    aux.paletteFormat = PixelFormatIDs::RGB565_LE;
+    aux.paletteColorCount = 8;
+    uint8_t keyColor[4];
+    resolveConverter(PixelFormatIDs::RGB565_LE, PixelFormatIDs::RGBA8_Straight)(keyColor, &palette[5], 1);
+    std::memcpy(&aux.colorKeyRGBA8, keyColor, 4);
+
+    BrightnessNode brightness;
+    GrayscaleNode grayscale;
+    AlphaNode alpha;
+    brightness.setAmount(0.25f);
+    alpha.setScale(0.5f);
+    SourceNode src;
+    src.setSource(indexed.view(), PaletteData(palette, PixelFormatIDs::RGB565_LE, 8));
+    src.setColorKey(aux.colorKeyRGBA8, 0);
+    ImageBuffer dst(width, height, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    RendererNode renderer;
+    SinkNode sink(dst.view());
+    src >> brightness >> grayscale >> alpha >> renderer >> sink;
+    renderer.setVirtualScreen(width, height);
+    CHECK(renderer.exec() == PrepareStatus::Prepared);
+
+    // 期待値: ピクセルを RGBA8 に展開してから各ラインフィルタを順に適用
+    FormatConverter expand = resolveConverter(PixelFormatIDs::Index8, PixelFormatIDs::RGBA8_Straight, &aux);
+    const filters::LineFilterParams pb{0.25f, 0.0f}, pa{0.5f, 0.0f}, none{};
+    int mismatches = 0;
+    for (int y = 0; y < height; y++) {
+        uint8_t row[width * 4];
+        expand(row, indexed.view().pixelAt(0, y), width);
+        filters::brightness_line(row, width, pb);
+        filters::grayscale_line(row, width, none);
+        filters::alpha_line(row, width, pa);
+        if (std::memcmp(row, dst.view().pixelAt(0, y), sizeof(row)) != 0) ++mismatches;
+    }
+    CHECK(mismatches == 0);
+
+    // 出力はインデックス形式のまま（preferredFormat もインデックス形式を伝える）
+    REQUIRE(renderer.execPrepare() == PrepareStatus::Prepared);
+    PrepareRequest prep;
+    prep.width = width;
+    prep.height = height;
+    CHECK(alpha.pullPrepare(prep).preferredFormat == PixelFormatIDs::Index8);
+    RenderRequest req;
+    req.width = width;
+    req.height = 1;
+    req.origin = {0, to_fixed(1)};
+    RenderResponse& resp = alpha.pullProcess(req);
+    REQUIRE(resp.isValid());
+    CHECK(resp.buffer().formatID() == PixelFormatIDs::Index8);
+    CHECK(resp.buffer().auxInfo().paletteFormat == PixelFormatIDs::RGBA8_Straight);
+    renderer.execFinalize();
+}
+
+TEST_CASE("Point filters report RGBA8 output for non-indexed sources") {
+    ImageBuffer rgb565(4, 2, PixelFormatIDs::RGB565_LE, InitPolicy::Zero);
+    SourceNode src(rgb565.view());
+    BrightnessNode brightness;
+    src >> brightness;
+    PrepareRequest prep;
+    prep.width = 4;
+    prep.height = 2;
+    CHECK(brightness.pullPrepare(prep).preferredFormat == PixelFormatIDs::RGBA8_Straight);
+    brightness.pullFinalize();
+}
+
 // =============================================================================
 // getDataRange() Tests
 // =============================================================================
@@ -612,6 +979,84 @@ TEST_CASE("VerticalBlurNode getDataRange passes through X range") {
     CHECK(vblurRange.endX == srcRange.endX);
 }
 
+// getDataRange の呼び出し回数を記録するパススルーノード
+class RangeQueryCounterNode : public Node {
+public:
+    RangeQueryCounterNode() { initPorts(1, 1); }
+    const char* name() const override { return "RangeQueryCounterNode"; }
+
+    DataRange getDataRange(const RenderRequest& request) const override {
+        ++queries;
+        return upstreamNode(0)->getDataRange(request);
+    }
+
+    mutable int queries = 0;
+};
+
+TEST_CASE("VerticalBlurNode getDataRange slides over rotated source") {
+    const int imgSize = 24;
+    const int canvasSize = 80;
+    const int expansion = 4 * 2;
+
+    ImageBuffer srcImg = createSolidImage(imgSize, imgSize, 255, 0, 0, 255);
+    SourceNode src(srcImg.view(), float_to_fixed(imgSize / 2.0f), float_to_fixed(imgSize / 2.0f));
+    src.setRotation(0.5f);
+    RangeQueryCounterNode counter;
+    VerticalBlurNode vblur;
+    vblur.setRadius(4);
+    vblur.setPasses(2);
+    src >> counter >> vblur;
+
+    PrepareRequest prepReq;
+    prepReq.width = static_cast<int16_t>(canvasSize);
+    prepReq.height = static_cast<int16_t>(canvasSize);
+    prepReq.origin.x = to_fixed(-canvasSize / 2);
+    prepReq.origin.y = to_fixed(-canvasSize / 2);
+    REQUIRE(vblur.pullPrepare(prepReq).ok());
+
+    // 上下 expansion 行の上流 DataRange 和集合（総当たり）
+    auto bruteForce = [&](const RenderRequest& req) {
+        int16_t startX = INT16_MAX, endX = INT16_MIN;
+        RenderRequest rowReq = req;
+        for (int dy = -expansion; dy <= expansion; ++dy) {
+            rowReq.origin.y = req.origin.y + to_fixed(dy);
+            DataRange r = src.getDataRange(rowReq);
+            if (r.hasData()) {
+                startX = std::min(startX, r.startX);
+                endX = std::max(endX, r.endX);
+            }
+        }
+        return (startX < endX) ? DataRange{startX, endX} : DataRange{0, 0};
+    };
+
+    RenderRequest req;
+    req.width = static_cast<int16_t>(canvasSize);
+    req.height = 1;
+    req.origin.x = prepReq.origin.x;
+
+    int mismatches = 0;
+    for (int y = -30; y <= 30; ++y) {
+        req.origin.y = to_fixed(y);
+        DataRange expected = bruteForce(req);
+        DataRange actual = vblur.getDataRange(req);
+        if (expected.hasData() != actual.hasData()
+            || (expected.hasData() && (expected.startX != actual.startX || expected.endX != actual.endX))) {
+            ++mismatches;
+        }
+    }
+    CHECK(mismatches == 0);
+    // 初回のみウィンドウ全体、以降は1行につき上流クエリ1回
+    CHECK(counter.queries == (expansion * 2 + 1) + 60);
+
+    // 上方向への移動ではウィンドウを再構築
+    req.origin.y = to_fixed(-5);
+    DataRange expected = bruteForce(req);
+    DataRange actual = vblur.getDataRange(req);
+    CHECK(actual.startX == expected.startX);
+    CHECK(actual.endX == expected.endX);
+    vblur.pullFinalize();
+}
+
 TEST_CASE("HorizontalBlurNode + VerticalBlurNode getDataRange chain") {
     const int imgSize = 32;
     const int canvasSize = 100;
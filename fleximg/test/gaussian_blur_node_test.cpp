@@ -0,0 +1,281 @@
+// fleximg GaussianBlurNode Unit Tests
+// ガウシアンブラーノード（再帰フィルタ）のテスト
+
+#include "doctest.h"
+
+#define FLEXIMG_NAMESPACE fleximg
+#include "fleximg/core/common.h"
+#include "fleximg/core/types.h"
+#include "fleximg/image/render_types.h"
+#include "fleximg/image/image_buffer.h"
+#include "fleximg/nodes/gaussian_blur_node.h"
+#include "fleximg/nodes/source_node.h"
+#include "fleximg/nodes/sink_node.h"
+#include "fleximg/nodes/renderer_node.h"
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace fleximg;
+
+// =============================================================================
+// Helper Functions
+// =============================================================================
+
+static ImageBuffer createSolidImage(int width, int height, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    ImageBuffer img(width, height, PixelFormatIDs::RGBA8_Straight);
+    ViewPort view = img.view();
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            uint8_t* p = static_cast<uint8_t*>(view.pixelAt(x, y));
+            p[0] = r;
+            p[1] = g;
+            p[2] = b;
+            p[3] = a;
+        }
+    }
+    return img;
+}
+
+// 不透明のパターン画像（縞 + グラデーション）
+static ImageBuffer createPatternImage(int width, int height) {
+    ImageBuffer img(width, height, PixelFormatIDs::RGBA8_Straight);
+    ViewPort view = img.view();
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            uint8_t* p = static_cast<uint8_t*>(view.pixelAt(x, y));
+            p[0] = static_cast<uint8_t>(((x / 4 + y / 3) % 2) ? 230 : 20);
+            p[1] = static_cast<uint8_t>(x * 255 / (width - 1));
+            p[2] = static_cast<uint8_t>(y * 255 / (height - 1));
+            p[3] = 255;
+        }
+    }
+    return img;
+}
+
+static const uint8_t* pixel(const ImageBuffer& img, int x, int y) {
+    return static_cast<const uint8_t*>(img.view().pixelAt(x, y));
+}
+
+static void renderBlur(const ImageBuffer& image, GaussianBlurNode& blur,
+                       int tx, int ty, ImageBuffer& dst) {
+    SourceNode source(image.view());
+    source.setTranslation(static_cast<float>(tx), static_cast<float>(ty));
+    RendererNode renderer;
+    SinkNode sink(dst.view());
+    source >> blur >> renderer >> sink;
+    renderer.setVirtualScreen(dst.width(), dst.height());
+    CHECK(renderer.exec() == PrepareStatus::Prepared);
+}
+
+// =============================================================================
+// GaussianBlurNode Tests
+// =============================================================================
+
+TEST_CASE("GaussianBlurNode basic construction") {
+    GaussianBlurNode node;
+    CHECK(std::string(node.name()) == "GaussianBlurNode");
+    CHECK(node.inputPortCount() == 1);
+    CHECK(node.outputPortCount() == 1);
+
+    node.setSigma(500.0f);
+    CHECK(node.sigma() == GaussianBlurNode::kMaxSigma);
+    node.setSigma(-1.0f);
+    CHECK(node.sigma() == 0.0f);
+    node.setSigma(2.0f);
+    CHECK(node.lookahead() == 7);
+}
+
+TEST_CASE("GaussianBlurNode approximates a true Gaussian") {
+    const int w = 40, h = 32;
+    const double sigma = 3.0;
+    ImageBuffer image = createPatternImage(w, h);
+    GaussianBlurNode blur;
+    blur.setSigma(static_cast<float>(sigma));
+    const int pad = static_cast<int>(blur.lookahead());
+    const int cw = w + pad * 2, ch = h + pad * 2;
+    ImageBuffer dst(cw, ch, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    renderBlur(image, blur, pad, pad, dst);
+
+    // 参照: 分離可能な2次元ガウシアン（double、プリマルチプライド、範囲外は透明）
+    const int kr = static_cast<int>(std::ceil(sigma * 4));
+    std::vector<double> kernel(static_cast<size_t>(kr * 2 + 1));
+    double ksum = 0;
+    for (int i = -kr; i <= kr; ++i) {
+        kernel[static_cast<size_t>(i + kr)] = std::exp(-0.5 * i * i / (sigma * sigma));
+        ksum += kernel[static_cast<size_t>(i + kr)];
+    }
+    for (double& k : kernel) k /= ksum;
+
+    auto premul = [&](int x, int y, int c) -> double {
+        if (x < 0 || y < 0 || x >= w || y >= h) return 0;
+        const uint8_t* p = pixel(image, x, y);
+        return (c == 3) ? p[3] : p[c] * p[3] / 255.0;
+    };
+    std::vector<double> tmp(static_cast<size_t>(cw * ch * 4), 0.0);
+    for (int y = 0; y < ch; ++y) {
+        for (int x = 0; x < cw; ++x) {
+            for (int c = 0; c < 4; ++c) {
+                double s = 0;
+                for (int k = -kr; k <= kr; ++k) {
+                    s += kernel[static_cast<size_t>(k + kr)] * premul(x + k - pad, y - pad, c);
+                }
+                tmp[static_cast<size_t>((y * cw + x) * 4 + c)] = s;
+            }
+        }
+    }
+
+    int maxDiff = 0;
+    long long sumAlphaDiff = 0;
+    for (int y = 0; y < ch; ++y) {
+        for (int x = 0; x < cw; ++x) {
+            double v[4];
+            for (int c = 0; c < 4; ++c) {
+                v[c] = 0;
+                for (int k = -kr; k <= kr; ++k) {
+                    const int yy = y + k;
+                    if (yy < 0 || yy >= ch) continue;
+                    v[c] += kernel[static_cast<size_t>(k + kr)] * tmp[static_cast<size_t>((yy * cw + x) * 4 + c)];
+                }
+            }
+            const uint8_t* p = pixel(dst, x, y);
+            const int refA = static_cast<int>(std::lround(v[3]));
+            int diff = std::abs(p[3] - refA);
+            sumAlphaDiff += diff;
+            // 色はアルファが十分ある画素で比較（ほぼ透明な画素の色は不定）
+            if (refA >= 32) {
+                for (int c = 0; c < 3; ++c) {
+                    const int refC = static_cast<int>(std::lround(v[c] * 255.0 / v[3]));
+                    diff = std::max(diff, std::abs(p[c] - refC));
+                }
+            }
+            maxDiff = std::max(maxDiff, diff);
+        }
+    }
+    // 3次再帰フィルタの近似誤差（縞のエッジで数レベル）
+    CHECK(maxDiff <= 6);
+    CHECK(sumAlphaDiff <= static_cast<long long>(cw * ch) * 2);
+}
+
+TEST_CASE("GaussianBlurNode preserves flat regions and fades outside") {
+    ImageBuffer image = createSolidImage(64, 48, 200, 100, 50, 255);
+    GaussianBlurNode blur;
+    blur.setSigma(4.0f);
+    const int pad = static_cast<int>(blur.lookahead());
+    ImageBuffer dst(64 + pad * 2, 48 + pad * 2, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    renderBlur(image, blur, pad, pad, dst);
+
+    // 内部（端から 3σ 以上）は入力のまま
+    const uint8_t* c = pixel(dst, pad + 32, pad + 24);
+    CHECK(c[0] == 200);
+    CHECK(c[1] == 100);
+    CHECK(c[2] == 50);
+    CHECK(c[3] == 255);
+    // 端はおよそ半分、外側へ向かって単調に減衰
+    const int edgeA = pixel(dst, pad, pad + 24)[3];
+    CHECK(std::abs(edgeA - 140) <= 12);
+    CHECK(pixel(dst, pad - 4, pad + 24)[3] < edgeA);
+    CHECK(pixel(dst, pad - 8, pad + 24)[3] < pixel(dst, pad - 4, pad + 24)[3]);
+    CHECK(pixel(dst, 0, pad + 24)[3] <= 1);
+    // 色は半透明部分でも保たれる（ストレートアルファ）
+    const uint8_t* e = pixel(dst, pad - 4, pad + 24);
+    CHECK(std::abs(e[0] - 200) <= 2);
+    CHECK(std::abs(e[1] - 100) <= 2);
+}
+
+TEST_CASE("GaussianBlurNode large sigma keeps a constant cost per pixel") {
+    // σ=50: lookahead 151 行のリングでブロック処理しても平坦部は保存される
+    ImageBuffer image = createSolidImage(400, 400, 30, 60, 90, 255);
+    GaussianBlurNode blur;
+    blur.setSigma(50.0f);
+    CHECK(blur.lookahead() == 151);
+    ImageBuffer dst(400, 400, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    renderBlur(image, blur, 0, 0, dst);
+
+    const uint8_t* c = pixel(dst, 200, 200);
+    CHECK(std::abs(c[0] - 30) <= 1);
+    CHECK(std::abs(c[2] - 90) <= 1);
+    CHECK(c[3] == 255);
+    // 上下対称（ブロック境界で段差がない）
+    for (int y = 150; y < 250; ++y) {
+        CHECK(std::abs(pixel(dst, 0, y)[3] - pixel(dst, 0, 399 - y)[3]) <= 1);
+    }
+}
+
+TEST_CASE("GaussianBlurNode random row access matches sequential rendering") {
+    ImageBuffer image = createPatternImage(30, 24);
+    GaussianBlurNode refBlur;
+    refBlur.setSigma(2.5f);
+    const int pad = static_cast<int>(refBlur.lookahead());
+    const int cw = 30 + pad * 2, ch = 24 + pad * 2;
+    ImageBuffer ref(cw, ch, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    renderBlur(image, refBlur, pad, pad, ref);
+
+    GaussianBlurNode blur;
+    blur.setSigma(2.5f);
+
+    SourceNode source(image.view());
+    source.setTranslation(static_cast<float>(pad), static_cast<float>(pad));
+    RendererNode renderer;
+    ImageBuffer dst(cw, ch, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    SinkNode sink(dst.view());
+    source >> blur >> renderer >> sink;
+    renderer.setVirtualScreen(cw, ch);
+    REQUIRE(renderer.execPrepare() == PrepareStatus::Prepared);
+
+    // 下から上へ要求（毎回前進をやり直す）
+    int maxDiff = 0;
+    for (int y = ch - 1; y >= 0; --y) {
+        RenderRequest req;
+        req.width = static_cast<int16_t>(cw);
+        req.height = 1;
+        req.origin = {0, to_fixed(y)};
+        RenderResponse& resp = blur.pullProcess(req);
+        if (!resp.isValid()) continue;
+        const ViewPort v = resp.view();
+        const int offset = from_fixed(resp.origin.x);
+        for (int x = 0; x < v.width; ++x) {
+            const auto* p = static_cast<const uint8_t*>(v.pixelAt(x, 0));
+            const uint8_t* q = pixel(ref, x + offset, y);
+            maxDiff = std::max(maxDiff, std::abs(p[3] - q[3]));
+            // ほぼ透明な画素の色は不定なので比較しない
+            if (q[3] < 32) continue;
+            for (int c = 0; c < 3; ++c) {
+                maxDiff = std::max(maxDiff, std::abs(p[c] - q[c]));
+            }
+        }
+    }
+    renderer.execFinalize();
+    // 途中からの開始は lookahead 行手前の定常値初期化（打ち切り誤差のみ）
+    CHECK(maxDiff <= 2);
+}
+
+TEST_CASE("GaussianBlurNode getDataRange covers the expanded bounds") {
+    ImageBuffer image = createSolidImage(10, 6, 255, 255, 255, 255);
+    SourceNode source(image.view());
+    source.setTranslation(20, 20);
+    GaussianBlurNode blur;
+    blur.setSigma(2.0f);  // lookahead 7
+    RendererNode renderer;
+    ImageBuffer dst(64, 48, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    SinkNode sink(dst.view());
+    source >> blur >> renderer >> sink;
+    renderer.setVirtualScreen(64, 48);
+    REQUIRE(renderer.execPrepare() == PrepareStatus::Prepared);
+
+    RenderRequest req;
+    req.width = 64;
+    req.height = 1;
+    req.origin = {0, to_fixed(22)};
+    DataRange r = blur.getDataRange(req);
+    CHECK(r.startX == 13);
+    CHECK(r.endX == 37);
+    req.origin = {0, to_fixed(13)};
+    CHECK(blur.getDataRange(req).hasData());
+    req.origin = {0, to_fixed(12)};
+    CHECK_FALSE(blur.getDataRange(req).hasData());
+    req.origin = {0, to_fixed(33)};
+    CHECK_FALSE(blur.getDataRange(req).hasData());
+    renderer.execFinalize();
+}
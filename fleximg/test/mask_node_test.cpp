@@ -0,0 +1,252 @@
+// fleximg MaskNode Unit Tests
+// マスク適用ノードのテスト
+
+#include "doctest.h"
+
+#define FLEXIMG_NAMESPACE fleximg
+#include "fleximg/core/common.h"
+#include "fleximg/core/types.h"
+#include "fleximg/image/render_types.h"
+#include "fleximg/image/image_buffer.h"
+#include "fleximg/nodes/mask_node.h"
+#include "fleximg/nodes/source_node.h"
+#include "fleximg/nodes/sink_node.h"
+#include "fleximg/nodes/renderer_node.h"
+#include <cstring>
+#include <string>
+
+using namespace fleximg;
+
+// =============================================================================
+// Helper Functions
+// =============================================================================
+
+// 単色RGBA画像を作成
+static ImageBuffer createSolidImage(int width, int height, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    ImageBuffer img(width, height, PixelFormatIDs::RGBA8_Straight);
+    ViewPort view = img.view();
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            uint8_t* p = static_cast<uint8_t*>(view.pixelAt(x, y));
+            p[0] = r; p[1] = g; p[2] = b; p[3] = a;
+        }
+    }
+    return img;
+}
+
+static const uint8_t* pixelAt(const ImageBuffer& img, int x, int y) {
+    return static_cast<const uint8_t*>(img.view().pixelAt(x, y));
+}
+
+// 画像 + マスクを MaskNode で描画（マスクは maskX だけ右にずらす）
+static void renderMasked(const ImageBuffer& image, const ImageBuffer& mask, int maskX,
+                         MaskNode& node, ImageBuffer& dst) {
+    SourceNode imageSrc(image.view());
+    SourceNode maskSrc(mask.view());
+    maskSrc.setPosition(static_cast<float>(maskX), 0);
+    RendererNode renderer;
+    SinkNode sink(dst.view());
+    imageSrc >> node;
+    maskSrc.connectTo(node, 1);
+    node >> renderer >> sink;
+    renderer.setVirtualScreen(dst.width(), dst.height());
+    CHECK(renderer.exec() == PrepareStatus::Prepared);
+}
+
+// =============================================================================
+// MaskNode Construction Tests
+// =============================================================================
+
+TEST_CASE("MaskNode basic construction") {
+    MaskNode node;
+    CHECK(std::string(node.name()) == "MaskNode");
+    CHECK(node.inputPortCount() == 2);
+    CHECK(node.outputPortCount() == 1);
+    CHECK(node.mode() == MaskNode::MaskMode::Alpha);
+    CHECK_FALSE(node.inverted());
+}
+
+// =============================================================================
+// MaskNode Format Tests
+// =============================================================================
+
+TEST_CASE("MaskNode Alpha8 mask scales input alpha") {
+    ImageBuffer image = createSolidImage(16, 2, 200, 100, 50, 255);
+    ImageBuffer mask(8, 2, PixelFormatIDs::Alpha8, InitPolicy::Zero);
+    for (int y = 0; y < 2; ++y) {
+        for (int x = 0; x < 8; ++x) {
+            static_cast<uint8_t*>(mask.view().pixelAt(x, y))[0] = static_cast<uint8_t>(x * 36);
+        }
+    }
+
+    MaskNode node;
+    ImageBuffer dst(16, 2, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    renderMasked(image, mask, 4, node, dst);
+
+    // マスク範囲外は透明
+    CHECK(pixelAt(dst, 2, 1)[3] == 0);
+    CHECK(pixelAt(dst, 12, 1)[3] == 0);
+    // マスク値 0 は透明、それ以外は色を保持してアルファを変調
+    CHECK(pixelAt(dst, 4, 0)[3] == 0);
+    for (int x = 5; x < 12; ++x) {
+        const int m = (x - 4) * 36;
+        const uint8_t* p = pixelAt(dst, x, 0);
+        CHECK(p[0] == 200);
+        CHECK(p[3] == ((255 * (m + (m >> 7))) >> 8));
+    }
+}
+
+TEST_CASE("MaskNode reads bit-packed Grayscale1 mask at odd offsets") {
+    // 20px幅の1bitマスク（MSBFirst）: 3バイト目は端数
+    ImageBuffer image = createSolidImage(40, 1, 10, 20, 30, 255);
+    ImageBuffer mask(20, 1, PixelFormatIDs::Grayscale1_MSB, InitPolicy::Zero);
+    auto* bits = static_cast<uint8_t*>(mask.view().data);
+    bits[0] = 0b10110011;
+    bits[1] = 0b00001111;
+    bits[2] = 0b10100000;
+
+    MaskNode node;
+    ImageBuffer dst(40, 1, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    renderMasked(image, mask, 7, node, dst);
+
+    for (int x = 0; x < 40; ++x) {
+        const int mx = x - 7;
+        const bool on = mx >= 0 && mx < 20 && ((bits[mx >> 3] >> (7 - (mx & 7))) & 1);
+        const uint8_t* p = pixelAt(dst, x, 0);
+        CAPTURE(x);
+        CHECK(p[3] == (on ? 255 : 0));
+        CHECK(p[0] == (on ? 10 : 0));
+    }
+}
+
+TEST_CASE("MaskNode scales Grayscale4 mask and supports inversion") {
+    ImageBuffer image = createSolidImage(8, 1, 255, 255, 255, 255);
+    ImageBuffer mask(4, 1, PixelFormatIDs::Grayscale4_LSB, InitPolicy::Zero);
+    auto* bits = static_cast<uint8_t*>(mask.view().data);
+    bits[0] = 0xF0;  // pixel0=0, pixel1=15
+    bits[1] = 0x85;  // pixel2=5, pixel3=8
+
+    SUBCASE("normal") {
+        MaskNode node;
+        ImageBuffer dst(8, 1, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+        renderMasked(image, mask, 2, node, dst);
+        CHECK(pixelAt(dst, 1, 0)[3] == 0);
+        CHECK(pixelAt(dst, 2, 0)[3] == 0);
+        CHECK(pixelAt(dst, 3, 0)[3] == 255);
+        CHECK(pixelAt(dst, 4, 0)[3] == ((255 * (85 + (85 >> 7))) >> 8));
+        CHECK(pixelAt(dst, 5, 0)[3] == ((255 * (136 + (136 >> 7))) >> 8));
+        CHECK(pixelAt(dst, 7, 0)[3] == 0);
+    }
+
+    SUBCASE("inverted") {
+        MaskNode node;
+        node.setInverted(true);
+        ImageBuffer dst(8, 1, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+        renderMasked(image, mask, 2, node, dst);
+        // マスク範囲外は反転により全面表示
+        CHECK(pixelAt(dst, 0, 0)[3] == 255);
+        CHECK(pixelAt(dst, 7, 0)[3] == 255);
+        CHECK(pixelAt(dst, 2, 0)[3] == 255);
+        CHECK(pixelAt(dst, 3, 0)[3] == 0);
+        CHECK(pixelAt(dst, 4, 0)[3] == ((255 * (170 + (170 >> 7))) >> 8));
+    }
+}
+
+TEST_CASE("MaskNode luminance mode on RGBA mask") {
+    ImageBuffer image = createSolidImage(4, 1, 0, 128, 255, 255);
+    ImageBuffer mask(4, 1, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    const uint8_t colors[4][4] = {
+        {255, 255, 255, 255},  // 白 → 255
+        {255, 0, 0, 255},      // 赤 → Y=77
+        {255, 255, 255, 128},  // 半透明白 → 128
+        {0, 0, 0, 255},        // 黒 → 0
+    };
+    for (int x = 0; x < 4; ++x) {
+        std::memcpy(mask.view().pixelAt(x, 0), colors[x], 4);
+    }
+
+    SUBCASE("luminance") {
+        MaskNode node;
+        node.setMode(MaskNode::MaskMode::Luminance);
+        ImageBuffer dst(4, 1, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+        renderMasked(image, mask, 0, node, dst);
+        CHECK(pixelAt(dst, 0, 0)[3] == 255);
+        CHECK(pixelAt(dst, 1, 0)[3] == ((255 * (77 + (77 >> 7))) >> 8));
+        CHECK(pixelAt(dst, 2, 0)[3] == ((255 * (128 + (128 >> 7))) >> 8));
+        CHECK(pixelAt(dst, 3, 0)[3] == 0);
+    }
+
+    SUBCASE("alpha") {
+        MaskNode node;
+        ImageBuffer dst(4, 1, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+        renderMasked(image, mask, 0, node, dst);
+        CHECK(pixelAt(dst, 1, 0)[3] == 255);
+        CHECK(pixelAt(dst, 3, 0)[3] == 255);
+        CHECK(pixelAt(dst, 3, 0)[1] == 128);
+    }
+}
+
+// =============================================================================
+// MaskNode Range Tests
+// =============================================================================
+
+TEST_CASE("MaskNode getDataRange intersects with mask unless inverted") {
+    ImageBuffer image = createSolidImage(30, 4, 1, 2, 3, 255);
+    ImageBuffer mask(10, 4, PixelFormatIDs::Alpha8, InitPolicy::Zero);
+    SourceNode imageSrc(image.view());
+    SourceNode maskSrc(mask.view());
+    maskSrc.setPosition(12, 0);
+    MaskNode node;
+    RendererNode renderer;
+    ImageBuffer dst(40, 4, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    SinkNode sink(dst.view());
+    imageSrc >> node;
+    maskSrc.connectTo(node, 1);
+    node >> renderer >> sink;
+    renderer.setVirtualScreen(40, 4);
+    REQUIRE(renderer.execPrepare() == PrepareStatus::Prepared);
+
+    RenderRequest req;
+    req.width = 40;
+    req.height = 1;
+    req.origin = {0, to_fixed(1)};
+    DataRange r = node.getDataRange(req);
+    CHECK(r.startX == 12);
+    CHECK(r.endX == 22);
+
+    node.setInverted(true);
+    r = node.getDataRange(req);
+    CHECK(r.startX == 0);
+    CHECK(r.endX == 30);
+    renderer.execFinalize();
+}
+
+TEST_CASE("MaskNode without mask") {
+    ImageBuffer image = createSolidImage(4, 1, 9, 9, 9, 255);
+
+    SUBCASE("normal: transparent") {
+        SourceNode imageSrc(image.view());
+        MaskNode node;
+        RendererNode renderer;
+        ImageBuffer dst(4, 1, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+        SinkNode sink(dst.view());
+        imageSrc >> node >> renderer >> sink;
+        renderer.setVirtualScreen(4, 1);
+        CHECK(renderer.exec() == PrepareStatus::Prepared);
+        CHECK(pixelAt(dst, 1, 0)[3] == 0);
+    }
+
+    SUBCASE("inverted: pass-through") {
+        SourceNode imageSrc(image.view());
+        MaskNode node;
+        node.setInverted(true);
+        RendererNode renderer;
+        ImageBuffer dst(4, 1, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+        SinkNode sink(dst.view());
+        imageSrc >> node >> renderer >> sink;
+        renderer.setVirtualScreen(4, 1);
+        CHECK(renderer.exec() == PrepareStatus::Prepared);
+        CHECK(pixelAt(dst, 1, 0)[0] == 9);
+        CHECK(pixelAt(dst, 1, 0)[3] == 255);
+    }
+}
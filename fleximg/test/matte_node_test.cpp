@@ -350,3 +350,77 @@ TEST_CASE("MatteNode all inputs empty") {
     // エラーなく完了すればOK
     CHECK(true);
 }
+
+// =============================================================================
+// MatteNode Row Kernel Tests
+// =============================================================================
+
+TEST_CASE("MatteNode row kernels match 256-scale formula across runs") {
+    // SIMD版（16/32px単位）とスカラー端数処理の境界を跨ぐよう、
+    // 0/255ラン・中間alpha・混在ブロックを含むマスクで検証する
+    const int canvasW = 101, canvasH = 3;
+    const int fgX = 23, fgW = 61;
+    const int maskX = 5, maskW = 90;
+
+    ImageBuffer bgImg(canvasW, canvasH, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    ImageBuffer fgImg(fgW, canvasH, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    ImageBuffer maskImg(maskW, canvasH, PixelFormatIDs::Alpha8, InitPolicy::Zero);
+    uint32_t seed = 12345;
+    auto rnd = [&seed]() {
+        seed = seed * 1103515245u + 12345u;
+        return static_cast<uint8_t>(seed >> 16);
+    };
+    for (int y = 0; y < canvasH; ++y) {
+        for (int x = 0; x < canvasW; ++x) {
+            auto p = static_cast<uint8_t*>(bgImg.view().pixelAt(x, y));
+            for (int c = 0; c < 4; ++c) p[c] = rnd();
+        }
+        for (int x = 0; x < fgW; ++x) {
+            auto p = static_cast<uint8_t*>(fgImg.view().pixelAt(x, y));
+            for (int c = 0; c < 4; ++c) p[c] = rnd();
+        }
+        for (int x = 0; x < maskW; ++x) {
+            uint8_t a = rnd();
+            const int block = (x + y * 7) / 12;
+            if (block % 4 == 0) a = 0;
+            else if (block % 4 == 2) a = 255;
+            static_cast<uint8_t*>(maskImg.view().pixelAt(x, y))[0] = a;
+        }
+    }
+
+    ImageBuffer dstImg(canvasW, canvasH, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    SourceNode fgSrc(fgImg.view());
+    SourceNode bgSrc(bgImg.view());
+    SourceNode maskSrc(maskImg.view());
+    fgSrc.setPosition(static_cast<float>(fgX), 0);
+    maskSrc.setPosition(static_cast<float>(maskX), 0);
+    MatteNode matte;
+    RendererNode renderer;
+    SinkNode sink(dstImg.view());
+    fgSrc >> matte;
+    bgSrc.connectTo(matte, 1);
+    maskSrc.connectTo(matte, 2);
+    matte >> renderer >> sink;
+    renderer.setVirtualScreen(canvasW, canvasH);
+    CHECK(renderer.exec() == PrepareStatus::Prepared);
+
+    int mismatches = 0;
+    for (int y = 0; y < canvasH; ++y) {
+        for (int x = 0; x < canvasW; ++x) {
+            auto bg = static_cast<const uint8_t*>(bgImg.view().pixelAt(x, y));
+            auto out = static_cast<const uint8_t*>(dstImg.view().pixelAt(x, y));
+            const bool inMask = x >= maskX && x < maskX + maskW;
+            const bool inFg = x >= fgX && x < fgX + fgW;
+            const int a = inMask
+                ? static_cast<const uint8_t*>(maskImg.view().pixelAt(x - maskX, y))[0] : 0;
+            const int a256 = a + (a >> 7);
+            for (int c = 0; c < 4; ++c) {
+                const int fg = inFg
+                    ? static_cast<const uint8_t*>(fgImg.view().pixelAt(x - fgX, y))[c] : 0;
+                const int expected = (bg[c] * (256 - a256) + fg * a256) >> 8;
+                if (out[c] != expected) ++mismatches;
+            }
+        }
+    }
+    CHECK(mismatches == 0);
+}
@@ -0,0 +1,256 @@
+// fleximg MedianNode Unit Tests
+// メディアンフィルタノードのテスト
+
+#include "doctest.h"
+
+#define FLEXIMG_NAMESPACE fleximg
+#include "fleximg/core/common.h"
+#include "fleximg/core/types.h"
+#include "fleximg/image/render_types.h"
+#include "fleximg/image/image_buffer.h"
+#include "fleximg/nodes/median_node.h"
+#include "fleximg/nodes/blur_node.h"
+#include "fleximg/nodes/source_node.h"
+#include "fleximg/nodes/sink_node.h"
+#include "fleximg/nodes/renderer_node.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace fleximg;
+
+// =============================================================================
+// Helper Functions
+// =============================================================================
+
+// 色・アルファが位置で変化する画像（透明ピクセル・ノイズ状の値を含む）
+static ImageBuffer createPatternImage(int width, int height) {
+    ImageBuffer img(width, height, PixelFormatIDs::RGBA8_Straight);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            uint8_t* p = static_cast<uint8_t*>(img.view().pixelAt(x, y));
+            p[0] = static_cast<uint8_t>(x * 37 + y * 11);
+            p[1] = static_cast<uint8_t>((x * 7919 + y * 104729) % 256);
+            p[2] = static_cast<uint8_t>(x * y * 7);
+            p[3] = static_cast<uint8_t>(((x * 3 + y) % 7 == 0) ? 0 : 255 - (x * 13 + y * 29) % 200);
+        }
+    }
+    return img;
+}
+
+// 参照実装: プリマルチプライド値の各チャンネルの中央値（範囲外は0）をストレートへ戻す
+// （dst 上で画像は (tx, ty) に配置）
+static void referenceMedian(const ImageBuffer& src, int tx, int ty, int radius,
+                            uint8_t* expected, int x, int y) {
+    auto premul = [&](int sx, int sy, int c) -> int {
+        if (sx < 0 || sy < 0 || sx >= src.width() || sy >= src.height()) return 0;
+        const uint8_t* p = static_cast<const uint8_t*>(src.view().pixelAt(sx, sy));
+        if (c == 3) return p[3];
+        return (p[c] * p[3] + 127) / 255;
+    };
+    int median[4];
+    std::vector<int> values;
+    for (int c = 0; c < 4; c++) {
+        values.clear();
+        for (int dy = -radius; dy <= radius; dy++) {
+            for (int dx = -radius; dx <= radius; dx++) {
+                values.push_back(premul(x - tx + dx, y - ty + dy, c));
+            }
+        }
+        std::nth_element(values.begin(), values.begin() + static_cast<long>(values.size() / 2), values.end());
+        median[c] = values[values.size() / 2];
+    }
+    const int a = median[3];
+    expected[0] = expected[1] = expected[2] = 0;
+    expected[3] = static_cast<uint8_t>(a);
+    for (int c = 0; c < 3 && a > 0; c++) {
+        expected[c] = static_cast<uint8_t>(static_cast<float>(median[c]) * (255.0f / static_cast<float>(a)) + 0.5f);
+    }
+}
+
+// メディアン結果を参照実装と比較し、異なるピクセル数を返す
+static int countReferenceMismatches(MedianNode& median, const ImageBuffer& image) {
+    const int margin = median.radius() + 2;
+    const int canvasW = image.width() + margin * 2, canvasH = image.height() + margin * 2;
+    ImageBuffer dst(canvasW, canvasH, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    SourceNode src(image.view());
+    src.setTranslation(static_cast<float>(margin), static_cast<float>(margin));
+    RendererNode renderer;
+    SinkNode sink(dst.view());
+    src >> median >> renderer >> sink;
+    renderer.setVirtualScreen(canvasW, canvasH);
+    CHECK(renderer.exec() == PrepareStatus::Prepared);
+
+    int mismatches = 0;
+    for (int y = 0; y < canvasH; y++) {
+        for (int x = 0; x < canvasW; x++) {
+            uint8_t expected[4];
+            referenceMedian(image, margin, margin, median.radius(), expected, x, y);
+            const auto* actual = static_cast<const uint8_t*>(dst.view().pixelAt(x, y));
+            if (std::memcmp(actual, expected, 4) != 0) ++mismatches;
+        }
+    }
+    return mismatches;
+}
+
+// =============================================================================
+// MedianNode Tests
+// =============================================================================
+
+TEST_CASE("MedianNode basic construction") {
+    MedianNode node;
+    CHECK(std::string(node.name()) == "MedianNode");
+    CHECK(node.inputPortCount() == 1);
+    CHECK(node.outputPortCount() == 1);
+    CHECK(node.radius() == 1);
+
+    node.setRadius(5);
+    CHECK(node.radius() == 5);
+    node.setRadius(-1);
+    CHECK(node.radius() == 0);
+    node.setRadius(100);
+    CHECK(node.radius() == MedianNode::kMaxRadius);
+}
+
+TEST_CASE("MedianNode matches a brute-force reference") {
+    const ImageBuffer image = createPatternImage(29, 21);
+    for (const int radius : {1, 2, 3, 6}) {
+        CAPTURE(radius);
+        MedianNode median;
+        median.setRadius(radius);
+        CHECK(countReferenceMismatches(median, image) == 0);
+    }
+}
+
+TEST_CASE("MedianNode maximum radius") {
+    const ImageBuffer image = createPatternImage(70, 12);
+    MedianNode median;
+    median.setRadius(MedianNode::kMaxRadius);
+    CHECK(countReferenceMismatches(median, image) == 0);
+}
+
+TEST_CASE("MedianNode removes salt-and-pepper noise from Grayscale8") {
+    ImageBuffer gray(16, 12, PixelFormatIDs::Grayscale8);
+    for (int y = 0; y < 12; y++) {
+        for (int x = 0; x < 16; x++) {
+            // 一様な128に孤立した 0 / 255 のノイズ
+            const int n = (x * 5 + y * 3) % 11;
+            *static_cast<uint8_t*>(gray.view().pixelAt(x, y)) =
+                static_cast<uint8_t>((n == 0) ? 255 : (n == 6) ? 0 : 128);
+        }
+    }
+    SourceNode src(gray.view());
+    MedianNode median;
+    median.setRadius(1);
+    RendererNode renderer;
+    ImageBuffer dst(16, 12, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    SinkNode sink(dst.view());
+    src >> median >> renderer >> sink;
+    renderer.setVirtualScreen(16, 12);
+    REQUIRE(renderer.execPrepare() == PrepareStatus::Prepared);
+
+    int noisy = 0;
+    for (int y = 1; y < 11; y++) {
+        RenderRequest req;
+        req.width = 16;
+        req.height = 1;
+        req.origin = {0, to_fixed(y)};
+        RenderResponse& resp = median.pullProcess(req);
+        REQUIRE(resp.isValid());
+        CHECK(resp.buffer().formatID() == PixelFormatIDs::Grayscale8);
+        const int outX0 = static_cast<int>(from_fixed(resp.origin.x));
+        for (int x = 1; x < 15; x++) {
+            if (*static_cast<const uint8_t*>(resp.view().pixelAt(x - outX0, 0)) != 128) ++noisy;
+        }
+    }
+    CHECK(noisy == 0);
+    renderer.execFinalize();
+}
+
+TEST_CASE("MedianNode out-of-order row requests match sequential rendering") {
+    const ImageBuffer image = createPatternImage(20, 16);
+    SourceNode src(image.view());
+    src.setTranslation(5, 4);
+    MedianNode median;
+    median.setRadius(3);
+    ImageBuffer dst(30, 24, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    RendererNode renderer;
+    SinkNode sink(dst.view());
+    src >> median >> renderer >> sink;
+    renderer.setVirtualScreen(30, 24);
+    CHECK(renderer.exec() == PrepareStatus::Prepared);
+
+    REQUIRE(renderer.execPrepare() == PrepareStatus::Prepared);
+    int mismatches = 0;
+    // 上方向・重複・少し先・離れた行へのリクエスト
+    const int rows[] = {12, 11, 11, 3, 5, 20, 21, 0, 23, 10, 14, 18};
+    for (const int y : rows) {
+        RenderRequest req;
+        req.width = 30;
+        req.height = 1;
+        req.origin = {0, to_fixed(y)};
+        RenderResponse& resp = median.pullProcess(req);
+        const int outX0 = resp.isValid() ? static_cast<int>(from_fixed(resp.origin.x)) : 0;
+        const int outW = resp.isValid() ? resp.view().width : 0;
+        for (int x = 0; x < 30; x++) {
+            const int i = x - outX0;
+            const auto* expected = static_cast<const uint8_t*>(dst.view().pixelAt(x, y));
+            for (int c = 0; c < 4; c++) {
+                const int actual = (i >= 0 && i < outW)
+                    ? static_cast<const uint8_t*>(resp.view().pixelAt(i, 0))[c] : 0;
+                if (actual != expected[c]) {
+                    ++mismatches;
+                    break;
+                }
+            }
+        }
+    }
+    CHECK(mismatches == 0);
+    renderer.execFinalize();
+}
+
+TEST_CASE("MedianNode getDataRange matches BlurNode of the same radius") {
+    const ImageBuffer image = createPatternImage(14, 10);
+    SourceNode src1(image.view()), src2(image.view());
+    for (SourceNode* src : {&src1, &src2}) {
+        src->setRotation(0.5f);
+        src->setTranslation(24, 20);
+    }
+    BlurNode blur;
+    blur.setRadius(2);
+    MedianNode median;
+    median.setRadius(2);
+    src1 >> blur;
+    src2 >> median;
+
+    PrepareRequest prep;
+    prep.width = 48;
+    prep.height = 40;
+    const PrepareResponse expectedPrep = blur.pullPrepare(prep);
+    const PrepareResponse actualPrep = median.pullPrepare(prep);
+    REQUIRE(actualPrep.ok());
+    CHECK(actualPrep.origin.x == expectedPrep.origin.x);
+    CHECK(actualPrep.origin.y == expectedPrep.origin.y);
+    CHECK(actualPrep.width == expectedPrep.width);
+    CHECK(actualPrep.height == expectedPrep.height);
+
+    RenderRequest req;
+    req.width = 48;
+    req.height = 1;
+    int rowsWithData = 0;
+    for (int y = 0; y < 40; y++) {
+        CAPTURE(y);
+        req.origin = {0, to_fixed(y)};
+        const DataRange expected = blur.getDataRange(req);
+        const DataRange actual = median.getDataRange(req);
+        CHECK(actual.hasData() == expected.hasData());
+        if (expected.hasData()) {
+            ++rowsWithData;
+            CHECK(actual.startX == expected.startX);
+            CHECK(actual.endX == expected.endX);
+        }
+    }
+    CHECK(rowsWithData > 10);
+    blur.pullFinalize();
+    median.pullFinalize();
+}
@@ -0,0 +1,371 @@
+// fleximg MorphologyNode Unit Tests
+// モルフォロジーフィルタノードのテスト
+
+#include "doctest.h"
+
+#define FLEXIMG_NAMESPACE fleximg
+#include "fleximg/core/common.h"
+#include "fleximg/core/types.h"
+#include "fleximg/image/render_types.h"
+#include "fleximg/image/image_buffer.h"
+#include "fleximg/nodes/morphology_node.h"
+#include "fleximg/nodes/blur_node.h"
+#include "fleximg/nodes/source_node.h"
+#include "fleximg/nodes/sink_node.h"
+#include "fleximg/nodes/renderer_node.h"
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace fleximg;
+
+// =============================================================================
+// Helper Functions
+// =============================================================================
+
+// 色・アルファが位置で変化する画像（透明ピクセル・孤立点を含む）
+static ImageBuffer createPatternImage(int width, int height) {
+    ImageBuffer img(width, height, PixelFormatIDs::RGBA8_Straight);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            uint8_t* p = static_cast<uint8_t*>(img.view().pixelAt(x, y));
+            p[0] = static_cast<uint8_t>(x * 37 + y * 11);
+            p[1] = static_cast<uint8_t>(255 - x * 19);
+            p[2] = static_cast<uint8_t>(x * y * 7);
+            p[3] = static_cast<uint8_t>(((x * 3 + y) % 7 == 0) ? 0 : 255 - (x * 13 + y * 29) % 200);
+        }
+    }
+    return img;
+}
+
+// 参照実装用の平面（プリマルチプライド、範囲外は0）
+struct Plane {
+    int width, height, channels;
+    std::vector<int> v;
+    Plane(int w, int h, int c) : width(w), height(h), channels(c), v(static_cast<size_t>(w * h * c), 0) {}
+    int& at(int x, int y, int c) { return v[static_cast<size_t>((y * width + x) * channels + c)]; }
+    int get(int x, int y, int c) const {
+        if (x < 0 || y < 0 || x >= width || y >= height) return 0;
+        return v[static_cast<size_t>((y * width + x) * channels + c)];
+    }
+};
+
+// 矩形構造要素の最小値 / 最大値（ブルートフォース）
+static Plane referenceMorph(const Plane& in, int rx, int ry, bool dilate) {
+    Plane out(in.width, in.height, in.channels);
+    for (int y = 0; y < in.height; y++) {
+        for (int x = 0; x < in.width; x++) {
+            for (int c = 0; c < in.channels; c++) {
+                int m = dilate ? 0 : 255;
+                for (int dy = -ry; dy <= ry; dy++) {
+                    for (int dx = -rx; dx <= rx; dx++) {
+                        const int s = in.get(x + dx, y + dy, c);
+                        m = dilate ? std::max(m, s) : std::min(m, s);
+                    }
+                }
+                out.at(x, y, c) = m;
+            }
+        }
+    }
+    return out;
+}
+
+static Plane referenceOperation(const Plane& in, int rx, int ry, MorphologyNode::Operation op) {
+    switch (op) {
+        case MorphologyNode::Operation::Erode: return referenceMorph(in, rx, ry, false);
+        case MorphologyNode::Operation::Dilate: return referenceMorph(in, rx, ry, true);
+        case MorphologyNode::Operation::Open:
+            return referenceMorph(referenceMorph(in, rx, ry, false), rx, ry, true);
+        case MorphologyNode::Operation::Close:
+            return referenceMorph(referenceMorph(in, rx, ry, true), rx, ry, false);
+    }
+    return in;
+}
+
+// 画像をキャンバス (canvasW × canvasH) の (tx, ty) に配置したプリマルチプライド平面
+static Plane premultipliedCanvas(const ImageBuffer& image, int tx, int ty, int canvasW, int canvasH) {
+    Plane plane(canvasW, canvasH, 4);
+    for (int y = 0; y < image.height(); y++) {
+        for (int x = 0; x < image.width(); x++) {
+            const auto* p = static_cast<const uint8_t*>(image.view().pixelAt(x, y));
+            for (int c = 0; c < 3; c++) plane.at(x + tx, y + ty, c) = (p[c] * p[3] + 127) / 255;
+            plane.at(x + tx, y + ty, 3) = p[3];
+        }
+    }
+    return plane;
+}
+
+// モルフォロジー結果を参照実装と比較し、異なるピクセル数を返す
+static int countReferenceMismatches(MorphologyNode& morph, const ImageBuffer& image) {
+    const int margin = std::max<int>(morph.radiusX(), morph.radiusY()) * 2 + 2;
+    const int canvasW = image.width() + margin * 2, canvasH = image.height() + margin * 2;
+    ImageBuffer dst(canvasW, canvasH, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    SourceNode src(image.view());
+    src.setTranslation(static_cast<float>(margin), static_cast<float>(margin));
+    RendererNode renderer;
+    SinkNode sink(dst.view());
+    src >> morph >> renderer >> sink;
+    renderer.setVirtualScreen(canvasW, canvasH);
+    CHECK(renderer.exec() == PrepareStatus::Prepared);
+
+    const Plane expected = referenceOperation(premultipliedCanvas(image, margin, margin, canvasW, canvasH),
+                                              morph.radiusX(), morph.radiusY(), morph.operation());
+    int mismatches = 0;
+    for (int y = 0; y < canvasH; y++) {
+        for (int x = 0; x < canvasW; x++) {
+            const int a = expected.get(x, y, 3);
+            uint8_t e[4] = {0, 0, 0, static_cast<uint8_t>(a)};
+            for (int c = 0; c < 3 && a > 0; c++) {
+                e[c] = static_cast<uint8_t>(static_cast<float>(expected.get(x, y, c)) * (255.0f / static_cast<float>(a)) + 0.5f);
+            }
+            const auto* actual = static_cast<const uint8_t*>(dst.view().pixelAt(x, y));
+            if (std::abs(actual[0] - e[0]) > 0 || std::abs(actual[1] - e[1]) > 0 ||
+                std::abs(actual[2] - e[2]) > 0 || actual[3] != e[3]) {
+                ++mismatches;
+            }
+        }
+    }
+    return mismatches;
+}
+
+// =============================================================================
+// MorphologyNode Tests
+// =============================================================================
+
+TEST_CASE("MorphologyNode basic construction") {
+    MorphologyNode node;
+    CHECK(std::string(node.name()) == "MorphologyNode");
+    CHECK(node.inputPortCount() == 1);
+    CHECK(node.outputPortCount() == 1);
+    CHECK(node.operation() == MorphologyNode::Operation::Dilate);
+    CHECK(node.radiusX() == 1);
+    CHECK(node.radiusY() == 1);
+
+    node.setRadius(3, 5);
+    CHECK(node.radiusX() == 3);
+    CHECK(node.radiusY() == 5);
+    node.setRadius(-2);
+    CHECK(node.radiusX() == 0);
+    CHECK(node.radiusY() == 0);
+    node.setRadiusX(1000);
+    CHECK(node.radiusX() == MorphologyNode::kMaxRadius);
+    node.setOperation(MorphologyNode::Operation::Close);
+    CHECK(node.operation() == MorphologyNode::Operation::Close);
+}
+
+TEST_CASE("MorphologyNode operations match a brute-force reference") {
+    const ImageBuffer image = createPatternImage(23, 17);
+    const MorphologyNode::Operation ops[] = {
+        MorphologyNode::Operation::Erode, MorphologyNode::Operation::Dilate,
+        MorphologyNode::Operation::Open, MorphologyNode::Operation::Close};
+    const int radii[][2] = {{1, 1}, {2, 1}, {0, 3}, {4, 0}, {3, 2}};
+    for (const auto op : ops) {
+        for (const auto& r : radii) {
+            CAPTURE(static_cast<int>(op));
+            CAPTURE(r[0]);
+            CAPTURE(r[1]);
+            MorphologyNode morph;
+            morph.setOperation(op);
+            morph.setRadius(r[0], r[1]);
+            CHECK(countReferenceMismatches(morph, image) == 0);
+        }
+    }
+}
+
+TEST_CASE("MorphologyNode radius larger than the image") {
+    const ImageBuffer image = createPatternImage(9, 7);
+    MorphologyNode dilate;
+    dilate.setRadius(12, 9);
+    CHECK(countReferenceMismatches(dilate, image) == 0);
+
+    MorphologyNode close;
+    close.setOperation(MorphologyNode::Operation::Close);
+    close.setRadius(6, 11);
+    CHECK(countReferenceMismatches(close, image) == 0);
+}
+
+TEST_CASE("MorphologyNode processes Alpha8 input in a single channel") {
+    ImageBuffer alphaImg(12, 10, PixelFormatIDs::Alpha8);
+    Plane plane(12, 10, 1);
+    for (int y = 0; y < 10; y++) {
+        for (int x = 0; x < 12; x++) {
+            const auto v = static_cast<uint8_t>((x % 5 == 0) ? 0 : (x * 20 + y * 7));
+            *static_cast<uint8_t*>(alphaImg.view().pixelAt(x, y)) = v;
+            plane.at(x, y, 0) = v;
+        }
+    }
+    const Plane expected = referenceMorph(plane, 1, 2, false);
+
+    SourceNode src(alphaImg.view());
+    MorphologyNode morph;
+    morph.setOperation(MorphologyNode::Operation::Erode);
+    morph.setRadius(1, 2);
+    RendererNode renderer;
+    ImageBuffer dst(12, 10, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    SinkNode sink(dst.view());
+    src >> morph >> renderer >> sink;
+    renderer.setVirtualScreen(12, 10);
+    REQUIRE(renderer.execPrepare() == PrepareStatus::Prepared);
+
+    int mismatches = 0;
+    int rowsWithData = 0;
+    for (int y = 0; y < 10; y++) {
+        RenderRequest req;
+        req.width = 12;
+        req.height = 1;
+        req.origin = {0, to_fixed(y)};
+        RenderResponse& resp = morph.pullProcess(req);
+        if (!resp.isValid()) {
+            for (int x = 0; x < 12; x++) {
+                if (expected.get(x, y, 0) != 0) ++mismatches;
+            }
+            continue;
+        }
+        ++rowsWithData;
+        CHECK(resp.buffer().formatID() == PixelFormatIDs::Alpha8);
+        const int outX0 = static_cast<int>(from_fixed(resp.origin.x));
+        const ViewPort out = resp.view();
+        for (int x = 0; x < 12; x++) {
+            const int i = x - outX0;
+            const int actual = (i >= 0 && i < out.width) ? *static_cast<const uint8_t*>(out.pixelAt(i, 0)) : 0;
+            if (actual != expected.get(x, y, 0)) ++mismatches;
+        }
+    }
+    CHECK(rowsWithData > 0);
+    CHECK(mismatches == 0);
+    renderer.execFinalize();
+}
+
+TEST_CASE("MorphologyNode out-of-order row requests match sequential rendering") {
+    const ImageBuffer image = createPatternImage(20, 16);
+    SourceNode src(image.view());
+    src.setTranslation(5, 4);
+    MorphologyNode morph;
+    morph.setOperation(MorphologyNode::Operation::Open);
+    morph.setRadius(2, 3);
+    ImageBuffer dst(30, 24, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    RendererNode renderer;
+    SinkNode sink(dst.view());
+    src >> morph >> renderer >> sink;
+    renderer.setVirtualScreen(30, 24);
+    CHECK(renderer.exec() == PrepareStatus::Prepared);
+
+    REQUIRE(renderer.execPrepare() == PrepareStatus::Prepared);
+    int mismatches = 0;
+    // 上方向・重複・離れた行へのリクエスト
+    const int rows[] = {12, 11, 11, 3, 20, 21, 0, 23, 10, 14, 18};
+    for (const int y : rows) {
+        RenderRequest req;
+        req.width = 30;
+        req.height = 1;
+        req.origin = {0, to_fixed(y)};
+        RenderResponse& resp = morph.pullProcess(req);
+        const int outX0 = resp.isValid() ? static_cast<int>(from_fixed(resp.origin.x)) : 0;
+        const int outW = resp.isValid() ? resp.view().width : 0;
+        for (int x = 0; x < 30; x++) {
+            const int i = x - outX0;
+            const auto* expected = static_cast<const uint8_t*>(dst.view().pixelAt(x, y));
+            for (int c = 0; c < 4; c++) {
+                const int actual = (i >= 0 && i < outW)
+                    ? static_cast<const uint8_t*>(resp.view().pixelAt(i, 0))[c] : 0;
+                if (actual != expected[c]) {
+                    ++mismatches;
+                    break;
+                }
+            }
+        }
+    }
+    CHECK(mismatches == 0);
+    renderer.execFinalize();
+}
+
+TEST_CASE("MorphologyNode getDataRange covers every non-transparent output pixel") {
+    const ImageBuffer image = createPatternImage(14, 10);
+    const MorphologyNode::Operation ops[] = {
+        MorphologyNode::Operation::Erode, MorphologyNode::Operation::Dilate,
+        MorphologyNode::Operation::Open, MorphologyNode::Operation::Close};
+    for (const auto op : ops) {
+        CAPTURE(static_cast<int>(op));
+        SourceNode src(image.view());
+        src.setTranslation(17, 15);
+        MorphologyNode morph;
+        morph.setOperation(op);
+        morph.setRadius(2, 1);
+        ImageBuffer dst(48, 40, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+        RendererNode renderer;
+        SinkNode sink(dst.view());
+        src >> morph >> renderer >> sink;
+        renderer.setVirtualScreen(48, 40);
+        REQUIRE(renderer.execPrepare() == PrepareStatus::Prepared);
+
+        RenderRequest req;
+        req.width = 48;
+        req.height = 1;
+        int rowsWithData = 0;
+        int outside = 0;
+        for (int y = 0; y < 40; y++) {
+            req.origin = {0, to_fixed(y)};
+            const DataRange range = morph.getDataRange(req);
+            RenderResponse& resp = morph.pullProcess(req);
+            if (!resp.isValid()) continue;
+            ++rowsWithData;
+            const int outX0 = static_cast<int>(from_fixed(resp.origin.x));
+            const ViewPort out = resp.view();
+            for (int i = 0; i < out.width; i++) {
+                const int x = outX0 + i;
+                const auto* p = static_cast<const uint8_t*>(out.pixelAt(i, 0));
+                if (p[3] != 0 && (!range.hasData() || x < range.startX || x >= range.endX)) ++outside;
+            }
+        }
+        CHECK(rowsWithData > 5);
+        CHECK(outside == 0);
+        renderer.execFinalize();
+    }
+}
+
+TEST_CASE("MorphologyNode dilate getDataRange matches BlurNode of the same extent") {
+    const ImageBuffer image = createPatternImage(14, 10);
+    SourceNode src1(image.view()), src2(image.view());
+    for (SourceNode* src : {&src1, &src2}) {
+        src->setRotation(0.5f);
+        src->setTranslation(24, 20);
+    }
+    BlurNode blur;
+    blur.setRadius(2, 1);
+    MorphologyNode dilate;
+    dilate.setRadius(2, 1);
+    src1 >> blur;
+    src2 >> dilate;
+
+    PrepareRequest prep;
+    prep.width = 48;
+    prep.height = 40;
+    const PrepareResponse expectedPrep = blur.pullPrepare(prep);
+    const PrepareResponse actualPrep = dilate.pullPrepare(prep);
+    REQUIRE(actualPrep.ok());
+    CHECK(actualPrep.origin.x == expectedPrep.origin.x);
+    CHECK(actualPrep.origin.y == expectedPrep.origin.y);
+    CHECK(actualPrep.width == expectedPrep.width);
+    CHECK(actualPrep.height == expectedPrep.height);
+
+    RenderRequest req;
+    req.width = 48;
+    req.height = 1;
+    int rowsWithData = 0;
+    for (int y = 0; y < 40; y++) {
+        CAPTURE(y);
+        req.origin = {0, to_fixed(y)};
+        const DataRange expected = blur.getDataRange(req);
+        const DataRange actual = dilate.getDataRange(req);
+        CHECK(actual.hasData() == expected.hasData());
+        if (expected.hasData()) {
+            ++rowsWithData;
+            CHECK(actual.startX == expected.startX);
+            CHECK(actual.endX == expected.endX);
+        }
+    }
+    CHECK(rowsWithData > 10);
+    blur.pullFinalize();
+    dilate.pullFinalize();
+}
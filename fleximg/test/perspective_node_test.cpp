@@ -0,0 +1,279 @@
+// fleximg PerspectiveNode Unit Tests
+// 射影変換ノードのテスト
+
+#include "doctest.h"
+
+#define FLEXIMG_NAMESPACE fleximg
+#include "fleximg/core/common.h"
+#include "fleximg/core/types.h"
+#include "fleximg/image/render_types.h"
+#include "fleximg/image/image_buffer.h"
+#include "fleximg/nodes/affine_node.h"
+#include "fleximg/nodes/perspective_node.h"
+#include "fleximg/nodes/source_node.h"
+#include "fleximg/nodes/sink_node.h"
+#include "fleximg/nodes/renderer_node.h"
+
+#include <cmath>
+
+using namespace fleximg;
+
+// =============================================================================
+// Helper Functions
+// =============================================================================
+
+// 8x8ブロックのチェッカー画像（全ピクセル不透明）
+static ImageBuffer createCheckerImage(int width, int height) {
+    ImageBuffer img(width, height, PixelFormatIDs::RGBA8_Straight);
+    ViewPort view = img.view();
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            uint8_t* p = static_cast<uint8_t*>(view.pixelAt(x, y));
+            bool on = ((x >> 3) + (y >> 3)) & 1;
+            p[0] = on ? 255 : 0;
+            p[1] = static_cast<uint8_t>(x * 4);
+            p[2] = static_cast<uint8_t>(y * 4);
+            p[3] = 255;
+        }
+    }
+    return img;
+}
+
+// 倍精度の逆射影でピクセル中心のソース座標を求める（参照実装）
+static bool referenceProject(const PerspectiveMatrix& forward, double px, double py,
+                             int srcW, int srcH, int& sx, int& sy) {
+    const double a = forward.a, b = forward.b, c = forward.tx;
+    const double d = forward.c, e = forward.d, f = forward.ty;
+    const double g = forward.g, h = forward.h, i = forward.i;
+    const double det = a * (e * i - f * h) - b * (d * i - f * g) + c * (d * h - e * g);
+    const double u = ((e * i - f * h) * px + (c * h - b * i) * py + (b * f - c * e)) / det;
+    const double v = ((f * g - d * i) * px + (a * i - c * g) * py + (c * d - a * f)) / det;
+    const double w = ((d * h - e * g) * px + (b * g - a * h) * py + (a * e - b * d)) / det;
+    if (w <= 0) return false;
+    const double fx = u / w, fy = v / w;
+    if (fx < 0 || fy < 0 || fx >= srcW || fy >= srcH) return false;
+    sx = static_cast<int>(std::floor(fx));
+    sy = static_cast<int>(std::floor(fy));
+    return true;
+}
+
+// =============================================================================
+// PerspectiveMatrix Tests
+// =============================================================================
+
+TEST_CASE("PerspectiveMatrix squareToQuad maps corners") {
+    auto m = PerspectiveMatrix::squareToQuad(10, 5, 90, 20, 70, 80, 20, 60);
+    const float ux[4] = {0, 1, 1, 0};
+    const float uy[4] = {0, 0, 1, 1};
+    const float qx[4] = {10, 90, 70, 20};
+    const float qy[4] = {5, 20, 80, 60};
+    for (int k = 0; k < 4; ++k) {
+        float w = m.g * ux[k] + m.h * uy[k] + m.i;
+        CHECK((m.a * ux[k] + m.b * uy[k] + m.tx) / w == doctest::Approx(qx[k]).epsilon(0.001));
+        CHECK((m.c * ux[k] + m.d * uy[k] + m.ty) / w == doctest::Approx(qy[k]).epsilon(0.001));
+    }
+}
+
+TEST_CASE("PerspectiveMatrix inverse") {
+    auto m = PerspectiveMatrix::squareToQuad(0, 0, 100, 10, 90, 90, 5, 80);
+    PerspectiveMatrix inv;
+    REQUIRE(m.inverse(inv));
+    auto id = m * inv;
+    float s = id.i;
+    CHECK(id.a / s == doctest::Approx(1.0f).epsilon(0.001));
+    CHECK(id.d / s == doctest::Approx(1.0f).epsilon(0.001));
+    CHECK(id.b / s == doctest::Approx(0.0f).epsilon(0.001));
+    CHECK(id.g / s == doctest::Approx(0.0f).epsilon(0.001));
+
+    PerspectiveMatrix singular(1, 2, 0, 2, 4, 0, 0, 0, 1);
+    CHECK_FALSE(singular.inverse(inv));
+}
+
+// =============================================================================
+// PerspectiveNode Pipeline Tests
+// =============================================================================
+
+TEST_CASE("PerspectiveNode with affine-equivalent matrix matches AffineNode") {
+    const int imgW = 32, imgH = 32;
+    const int canvasW = 100, canvasH = 80;
+
+    ImageBuffer srcImg = createCheckerImage(imgW, imgH);
+    ImageBuffer dstA(canvasW, canvasH, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    ImageBuffer dstP(canvasW, canvasH, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+
+    AffineMatrix am(2.0f, 0.0f, 0.0f, 2.0f, 12.0f, 8.0f);
+    {
+        SourceNode src(srcImg.view());
+        AffineNode affine;
+        RendererNode renderer;
+        SinkNode sink(dstA.view());
+        src >> affine >> renderer >> sink;
+        affine.setMatrix(am);
+        renderer.setVirtualScreen(canvasW, canvasH);
+        CHECK(renderer.exec() == PrepareStatus::Prepared);
+    }
+    {
+        SourceNode src(srcImg.view());
+        PerspectiveNode persp;
+        RendererNode renderer;
+        SinkNode sink(dstP.view());
+        src >> persp >> renderer >> sink;
+        persp.setMatrix(PerspectiveMatrix(am));
+        renderer.setVirtualScreen(canvasW, canvasH);
+        CHECK(renderer.exec() == PrepareStatus::Prepared);
+    }
+
+    int mismatches = 0;
+    for (int y = 0; y < canvasH; ++y) {
+        for (int x = 0; x < canvasW; ++x) {
+            auto pa = static_cast<const uint8_t*>(dstA.view().pixelAt(x, y));
+            auto pp = static_cast<const uint8_t*>(dstP.view().pixelAt(x, y));
+            if (std::memcmp(pa, pp, 4) != 0) ++mismatches;
+        }
+    }
+    CHECK(mismatches == 0);
+}
+
+TEST_CASE("PerspectiveNode trapezoid rendering matches reference projection") {
+    const int imgW = 64, imgH = 64;
+    const int canvasW = 160, canvasH = 120;
+
+    ImageBuffer srcImg = createCheckerImage(imgW, imgH);
+    ImageBuffer dstImg(canvasW, canvasH, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+
+    SourceNode src(srcImg.view());
+    PerspectiveNode persp;
+    RendererNode renderer;
+    SinkNode sink(dstImg.view());
+    src >> persp >> renderer >> sink;
+
+    // 床面風の台形（上辺が短い）
+    persp.setRectToQuad(static_cast<float>(imgW), static_cast<float>(imgH),
+                        60.3f, 10.2f, 100.7f, 10.2f, 150.1f, 110.6f, 9.4f, 110.6f);
+    renderer.setVirtualScreen(canvasW, canvasH);
+    REQUIRE(renderer.exec() == PrepareStatus::Prepared);
+
+    const PerspectiveMatrix& forward = persp.matrix();
+    int coverageMismatch = 0;
+    int colorMismatch = 0;
+    int covered = 0;
+    const ViewPort srcView = srcImg.view();
+    for (int y = 0; y < canvasH; ++y) {
+        for (int x = 0; x < canvasW; ++x) {
+            auto p = static_cast<const uint8_t*>(dstImg.view().pixelAt(x, y));
+            int sx = 0, sy = 0;
+            bool inside = referenceProject(forward, x + 0.5, y + 0.5, imgW, imgH, sx, sy);
+            if (inside != (p[3] != 0)) {
+                ++coverageMismatch;
+                continue;
+            }
+            if (!inside) continue;
+            ++covered;
+            auto s = static_cast<const uint8_t*>(srcView.pixelAt(sx, sy));
+            if (std::memcmp(s, p, 4) != 0) ++colorMismatch;
+        }
+    }
+    CHECK(covered > 3000);
+    CHECK(coverageMismatch == 0);
+    // スパン内の線形補間による誤差は少数のテクセル境界ピクセルに限られる
+    CHECK(colorMismatch * 50 < covered);
+}
+
+TEST_CASE("PerspectiveNode getDataRange clips each scanline exactly") {
+    const int imgW = 40, imgH = 30;
+    const int canvasW = 120, canvasH = 90;
+
+    ImageBuffer srcImg = createCheckerImage(imgW, imgH);
+    ImageBuffer dstImg(canvasW, canvasH, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+
+    SourceNode src(srcImg.view());
+    PerspectiveNode persp;
+    RendererNode renderer;
+    SinkNode sink(dstImg.view());
+    src >> persp >> renderer >> sink;
+
+    persp.setRectToQuad(static_cast<float>(imgW), static_cast<float>(imgH),
+                        30.3f, 5.7f, 100.2f, 20.6f, 90.4f, 80.3f, 10.1f, 70.8f);
+    renderer.setVirtualScreen(canvasW, canvasH);
+    REQUIRE(renderer.execPrepare() == PrepareStatus::Prepared);
+
+    const PerspectiveMatrix& forward = persp.matrix();
+    int rowsWithData = 0;
+    for (int y = 0; y < canvasH; ++y) {
+        RenderRequest req;
+        req.width = static_cast<int16_t>(canvasW);
+        req.height = 1;
+        req.origin = {0, to_fixed(y)};
+        DataRange range = src.getDataRange(req);
+
+        int16_t expStart = 0, expEnd = 0;
+        bool found = false;
+        for (int x = 0; x < canvasW; ++x) {
+            int sx = 0, sy = 0;
+            if (referenceProject(forward, x + 0.5, y + 0.5, imgW, imgH, sx, sy)) {
+                if (!found) expStart = static_cast<int16_t>(x);
+                expEnd = static_cast<int16_t>(x + 1);
+                found = true;
+            }
+        }
+        if (found) {
+            ++rowsWithData;
+            CHECK(range.startX == expStart);
+            CHECK(range.endX == expEnd);
+        } else {
+            CHECK_FALSE(range.hasData());
+        }
+    }
+    CHECK(rowsWithData > 50);
+    renderer.execFinalize();
+}
+
+TEST_CASE("PerspectiveNode composes with downstream and upstream AffineNode") {
+    const int imgW = 32, imgH = 32;
+    const int canvasW = 100, canvasH = 100;
+
+    ImageBuffer srcImg = createCheckerImage(imgW, imgH);
+    ImageBuffer dstImg(canvasW, canvasH, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    ImageBuffer refImg(canvasW, canvasH, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+
+    auto quad = PerspectiveMatrix::squareToQuad(0, 0, 40, 4, 36, 30, 2, 26)
+              * AffineMatrix::scale(1.0f / imgW, 1.0f / imgH);
+    AffineMatrix down = AffineMatrix::translate(20, 10);
+    AffineMatrix up = AffineMatrix::scale(0.5f, 0.5f);
+
+    {
+        // src >> up >> persp >> down >> renderer
+        SourceNode src(srcImg.view());
+        AffineNode upNode, downNode;
+        PerspectiveNode persp;
+        RendererNode renderer;
+        SinkNode sink(dstImg.view());
+        src >> upNode >> persp >> downNode >> renderer >> sink;
+        upNode.setMatrix(up);
+        downNode.setMatrix(down);
+        persp.setMatrix(quad);
+        renderer.setVirtualScreen(canvasW, canvasH);
+        CHECK(renderer.exec() == PrepareStatus::Prepared);
+    }
+    {
+        // 合成済み行列を単一のPerspectiveNodeで適用
+        SourceNode src(srcImg.view());
+        PerspectiveNode persp;
+        RendererNode renderer;
+        SinkNode sink(refImg.view());
+        src >> persp >> renderer >> sink;
+        persp.setMatrix(PerspectiveMatrix(down) * quad * up);
+        renderer.setVirtualScreen(canvasW, canvasH);
+        CHECK(renderer.exec() == PrepareStatus::Prepared);
+    }
+
+    int mismatches = 0;
+    for (int y = 0; y < canvasH; ++y) {
+        for (int x = 0; x < canvasW; ++x) {
+            auto pa = static_cast<const uint8_t*>(dstImg.view().pixelAt(x, y));
+            auto pb = static_cast<const uint8_t*>(refImg.view().pixelAt(x, y));
+            if (std::memcmp(pa, pb, 4) != 0) ++mismatches;
+        }
+    }
+    CHECK(mismatches == 0);
+}
@@ -0,0 +1,181 @@
+// fleximg SharedNode Unit Tests
+// 共有出力ノード（DAG、スキャンラインメモ化）のテスト
+
+#include "doctest.h"
+
+#define FLEXIMG_NAMESPACE fleximg
+#include "fleximg/core/common.h"
+#include "fleximg/core/types.h"
+#include "fleximg/image/render_types.h"
+#include "fleximg/image/image_buffer.h"
+#include "fleximg/nodes/shared_node.h"
+#include "fleximg/nodes/alpha_node.h"
+#include "fleximg/nodes/brightness_node.h"
+#include "fleximg/nodes/composite_node.h"
+#include "fleximg/nodes/horizontal_blur_node.h"
+#include "fleximg/nodes/source_node.h"
+#include "fleximg/nodes/sink_node.h"
+#include "fleximg/nodes/renderer_node.h"
+#include <cstring>
+#include <string>
+
+using namespace fleximg;
+
+// =============================================================================
+// Helper Functions
+// =============================================================================
+
+static ImageBuffer createPatternImage(int width, int height) {
+    ImageBuffer img(width, height, PixelFormatIDs::RGBA8_Straight);
+    ViewPort view = img.view();
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            uint8_t* p = static_cast<uint8_t*>(view.pixelAt(x, y));
+            p[0] = static_cast<uint8_t>(x * 11);
+            p[1] = static_cast<uint8_t>(y * 7);
+            p[2] = static_cast<uint8_t>(x + y);
+            p[3] = 255;
+        }
+    }
+    return img;
+}
+
+static int countMismatches(const ImageBuffer& a, const ImageBuffer& b) {
+    int mismatches = 0;
+    for (int y = 0; y < a.height(); ++y) {
+        for (int x = 0; x < a.width(); ++x) {
+            auto pa = static_cast<const uint8_t*>(a.view().pixelAt(x, y));
+            auto pb = static_cast<const uint8_t*>(b.view().pixelAt(x, y));
+            if (std::memcmp(pa, pb, 4) != 0) ++mismatches;
+        }
+    }
+    return mismatches;
+}
+
+// 上流へのリクエスト回数を記録するパススルーノード
+class PullCounterNode : public Node {
+public:
+    PullCounterNode() { initPorts(1, 1); }
+    const char* name() const override { return "PullCounterNode"; }
+
+    int calls = 0;
+
+protected:
+    RenderResponse& onPullProcess(const RenderRequest& request) override {
+        ++calls;
+        return upstreamNode(0)->pullProcess(request);
+    }
+};
+
+// =============================================================================
+// SharedNode Tests
+// =============================================================================
+
+TEST_CASE("SharedNode basic construction") {
+    SharedNode node;
+    CHECK(std::string(node.name()) == "SharedNode");
+    CHECK(node.inputPortCount() == 1);
+    CHECK(node.outputCount() == 2);
+    node.setOutputCount(3);
+    CHECK(node.outputCount() == 3);
+}
+
+TEST_CASE("SharedNode evaluates a shared subtree once per scanline") {
+    const int canvasW = 32, canvasH = 12;
+    ImageBuffer image = createPatternImage(24, 10);
+
+    // 参照: 共有サブツリーを複製した木構造
+    ImageBuffer ref(canvasW, canvasH, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    {
+        SourceNode src1(image.view()), src2(image.view());
+        src1.setTranslation(3, 1);
+        src2.setTranslation(3, 1);
+        HorizontalBlurNode blur1, blur2;
+        blur1.setRadius(2);
+        blur2.setRadius(2);
+        BrightnessNode bright;
+        bright.setAmount(0.2f);
+        AlphaNode alpha;
+        alpha.setScale(0.5f);
+        CompositeNode composite(2);
+        RendererNode renderer;
+        SinkNode sink(ref.view());
+        src1 >> blur1 >> alpha;
+        src2 >> blur2 >> bright;
+        alpha.connectTo(composite, 0);
+        bright.connectTo(composite, 1);
+        composite >> renderer >> sink;
+        renderer.setVirtualScreen(canvasW, canvasH);
+        CHECK(renderer.exec() == PrepareStatus::Prepared);
+    }
+
+    // DAG: blur を SharedNode で共有
+    ImageBuffer dst(canvasW, canvasH, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    SourceNode src(image.view());
+    src.setTranslation(3, 1);
+    HorizontalBlurNode blur;
+    blur.setRadius(2);
+    PullCounterNode counter;
+    SharedNode shared(2);
+    BrightnessNode bright;
+    bright.setAmount(0.2f);
+    AlphaNode alpha;
+    alpha.setScale(0.5f);
+    CompositeNode composite(2);
+    RendererNode renderer;
+    SinkNode sink(dst.view());
+    src >> blur >> counter >> shared;
+    shared.connectTo(alpha, 0, 0);
+    shared.connectTo(bright, 0, 1);
+    alpha.connectTo(composite, 0);
+    bright.connectTo(composite, 1);
+    composite >> renderer >> sink;
+    renderer.setVirtualScreen(canvasW, canvasH);
+    CHECK(renderer.exec() == PrepareStatus::Prepared);
+
+    CHECK(countMismatches(ref, dst) == 0);
+    // 各行で上流は1回だけ評価され、2本目はメモから供給
+    CHECK(shared.missCount() == static_cast<uint32_t>(counter.calls));
+    CHECK(shared.hitCount() == shared.missCount());
+    CHECK(counter.calls <= canvasH);
+}
+
+TEST_CASE("SharedNode re-evaluates on differing requests") {
+    ImageBuffer image = createPatternImage(8, 4);
+    SourceNode src(image.view());
+    PullCounterNode counter;
+    SharedNode shared(2);
+    src >> counter >> shared;
+
+    // 2つの下流を模擬: 同一 RenderContext 上で直接プル
+    ImageBuffer dst(8, 4, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    RendererNode renderer;
+    SinkNode sink(dst.view());
+    AlphaNode a, b;
+    shared.connectTo(a, 0, 0);
+    shared.connectTo(b, 0, 1);
+    CompositeNode composite(2);
+    a.connectTo(composite, 0);
+    b.connectTo(composite, 1);
+    composite >> renderer >> sink;
+    renderer.setVirtualScreen(8, 4);
+    REQUIRE(renderer.execPrepare() == PrepareStatus::Prepared);
+
+    RenderRequest req;
+    req.width = 8;
+    req.height = 1;
+    req.origin = {0, to_fixed(1)};
+    RenderResponse& r1 = shared.pullProcess(req);
+    RenderRequest other = req;
+    other.origin.y = to_fixed(2);
+    RenderResponse& r2 = shared.pullProcess(other);
+    CHECK(counter.calls == 2);
+
+    // 差し替え後も旧メモの参照は読み出せる
+    REQUIRE(r1.isValid());
+    REQUIRE(r2.isValid());
+    CHECK_FALSE(r1.buffer().ownsMemory());
+    CHECK(static_cast<const uint8_t*>(r1.buffer().view().pixelAt(2, 0))[1] == 7);
+    CHECK(static_cast<const uint8_t*>(r2.buffer().view().pixelAt(2, 0))[1] == 14);
+    renderer.execFinalize();
+}
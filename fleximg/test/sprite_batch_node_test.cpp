@@ -0,0 +1,247 @@
+// fleximg SpriteBatchNode Unit Tests
+// スプライト一括描画ノードのテスト
+
+#include "doctest.h"
+
+#define FLEXIMG_NAMESPACE fleximg
+#include "fleximg/core/common.h"
+#include "fleximg/core/types.h"
+#include "fleximg/image/render_types.h"
+#include "fleximg/image/image_buffer.h"
+#include "fleximg/nodes/composite_node.h"
+#include "fleximg/nodes/sprite_batch_node.h"
+#include "fleximg/nodes/source_node.h"
+#include "fleximg/nodes/sink_node.h"
+#include "fleximg/nodes/renderer_node.h"
+
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+using namespace fleximg;
+
+// =============================================================================
+// Helper Functions
+// =============================================================================
+
+// グラデーション画像（αは指定値）
+static ImageBuffer createPatternImage(int width, int height, uint8_t seed, uint8_t alpha) {
+    ImageBuffer img(width, height, PixelFormatIDs::RGBA8_Straight);
+    ViewPort view = img.view();
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            uint8_t* p = static_cast<uint8_t*>(view.pixelAt(x, y));
+            p[0] = static_cast<uint8_t>(seed + x * 7);
+            p[1] = static_cast<uint8_t>(seed * 3 + y * 5);
+            p[2] = static_cast<uint8_t>(x ^ y);
+            p[3] = alpha;
+        }
+    }
+    return img;
+}
+
+static int countMismatches(const ImageBuffer& a, const ImageBuffer& b) {
+    int mismatches = 0;
+    for (int y = 0; y < a.height(); ++y) {
+        for (int x = 0; x < a.width(); ++x) {
+            auto pa = static_cast<const uint8_t*>(a.view().pixelAt(x, y));
+            auto pb = static_cast<const uint8_t*>(b.view().pixelAt(x, y));
+            if (std::memcmp(pa, pb, 4) != 0) ++mismatches;
+        }
+    }
+    return mismatches;
+}
+
+// SourceNode群 + CompositeNode で同じシーンを描画（参照結果）
+static void renderWithComposite(const std::vector<const ImageBuffer*>& images,
+                                const std::vector<AffineMatrix>& matrices,
+                                ImageBuffer& dst) {
+    const auto count = static_cast<int_fast16_t>(images.size());
+    std::vector<std::unique_ptr<SourceNode>> sources;
+    CompositeNode composite(count);
+    for (int_fast16_t i = 0; i < count; ++i) {
+        sources.emplace_back(new SourceNode(images[static_cast<size_t>(i)]->view()));
+        sources.back()->setMatrix(matrices[static_cast<size_t>(i)]);
+        sources.back()->connectTo(composite, static_cast<int>(i));
+    }
+    RendererNode renderer;
+    SinkNode sink(dst.view());
+    composite >> renderer >> sink;
+    renderer.setVirtualScreen(dst.width(), dst.height());
+    CHECK(renderer.exec() == PrepareStatus::Prepared);
+}
+
+static void renderWithBatch(SpriteBatchNode& batch, ImageBuffer& dst) {
+    RendererNode renderer;
+    SinkNode sink(dst.view());
+    batch >> renderer >> sink;
+    renderer.setVirtualScreen(dst.width(), dst.height());
+    CHECK(renderer.exec() == PrepareStatus::Prepared);
+}
+
+// =============================================================================
+// SpriteBatchNode Tests
+// =============================================================================
+
+TEST_CASE("SpriteBatchNode basic construction") {
+    SpriteBatchNode batch;
+    CHECK(batch.inputPortCount() == 0);
+    CHECK(batch.outputPortCount() == 1);
+    CHECK(batch.spriteCount() == 0);
+
+    ImageBuffer img = createPatternImage(4, 4, 0, 255);
+    CHECK(batch.addSprite(img.view()) == 0);
+    CHECK(batch.addSprite(img.view(), AffineMatrix(1, 0, 0, 1, 5, 6), 100) == 1);
+    CHECK(batch.spriteCount() == 2);
+    CHECK(batch.sprite(1).alpha == 100);
+    CHECK(batch.sprite(1).matrix.tx == doctest::Approx(5.0f));
+    batch.clearSprites();
+    CHECK(batch.spriteCount() == 0);
+}
+
+TEST_CASE("SpriteBatchNode matches SourceNodes + CompositeNode") {
+    const int canvasW = 96, canvasH = 80;
+
+    // 不透明・半透明のスプライトを重ねて配置（回転・拡大を含む）
+    ImageBuffer img0 = createPatternImage(20, 16, 10, 200);
+    ImageBuffer img1 = createPatternImage(32, 24, 60, 255);
+    ImageBuffer img2 = createPatternImage(12, 40, 90, 128);
+    ImageBuffer img3 = createPatternImage(64, 64, 20, 255);
+    std::vector<const ImageBuffer*> images = {&img0, &img1, &img2, &img3};
+
+    const float c = std::cos(0.4f), s = std::sin(0.4f);
+    std::vector<AffineMatrix> matrices = {
+        AffineMatrix(1, 0, 0, 1, 10, 8),
+        AffineMatrix(c, -s, s, c, 30, 20),
+        AffineMatrix(2, 0, 0, 1.5f, 50, 5),
+        AffineMatrix(1, 0, 0, 1, 16, 12),
+    };
+
+    ImageBuffer dstRef(canvasW, canvasH, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    renderWithComposite(images, matrices, dstRef);
+
+    SpriteBatchNode batch;
+    for (size_t i = 0; i < images.size(); ++i) {
+        batch.addSprite(images[i]->view(), matrices[i]);
+    }
+    ImageBuffer dstBatch(canvasW, canvasH, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    renderWithBatch(batch, dstBatch);
+
+    CHECK(countMismatches(dstRef, dstBatch) == 0);
+}
+
+TEST_CASE("SpriteBatchNode many sprites across buckets") {
+    // バケット境界（16行）を跨ぐ小スプライトを多数配置
+    const int canvasW = 128, canvasH = 100;
+    ImageBuffer tile = createPatternImage(9, 7, 33, 255);
+    std::vector<const ImageBuffer*> images;
+    std::vector<AffineMatrix> matrices;
+    SpriteBatchNode batch;
+    for (int i = 0; i < 40; ++i) {
+        const AffineMatrix m(1, 0, 0, 1,
+                             static_cast<float>((i * 37) % 120) - 4.0f,
+                             static_cast<float>((i * 23) % 96) - 3.0f);
+        images.push_back(&tile);
+        matrices.push_back(m);
+        batch.addSprite(tile.view(), m);
+    }
+
+    ImageBuffer dstRef(canvasW, canvasH, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    renderWithComposite(images, matrices, dstRef);
+    ImageBuffer dstBatch(canvasW, canvasH, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    renderWithBatch(batch, dstBatch);
+    CHECK(countMismatches(dstRef, dstBatch) == 0);
+}
+
+TEST_CASE("SpriteBatchNode alpha and visibility") {
+    const int canvasW = 16, canvasH = 4;
+    ImageBuffer red(8, 4, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    for (int y = 0; y < 4; ++y) {
+        for (int x = 0; x < 8; ++x) {
+            auto p = static_cast<uint8_t*>(red.view().pixelAt(x, y));
+            p[0] = 255; p[3] = 255;
+        }
+    }
+
+    SpriteBatchNode batch;
+    batch.addSprite(red.view(), AffineMatrix(), 128);
+    batch.addSprite(red.view(), AffineMatrix(1, 0, 0, 1, 8, 0));
+    batch.setSpriteVisible(1, false);
+
+    ImageBuffer dst(canvasW, canvasH, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    renderWithBatch(batch, dst);
+
+    auto p = static_cast<const uint8_t*>(dst.view().pixelAt(3, 2));
+    CHECK(p[0] == 255);
+    CHECK(p[3] == 128);
+    auto q = static_cast<const uint8_t*>(dst.view().pixelAt(12, 2));
+    CHECK(q[3] == 0);
+}
+
+TEST_CASE("SpriteBatchNode getDataRange and segments of active sprites") {
+    ImageBuffer img = createPatternImage(10, 10, 0, 255);
+    ImageBuffer dstImg(100, 60, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+
+    SpriteBatchNode batch;
+    batch.addSprite(img.view(), AffineMatrix(1, 0, 0, 1, 5, 0));
+    batch.addSprite(img.view(), AffineMatrix(1, 0, 0, 1, 60, 5));
+    RendererNode renderer;
+    SinkNode sink(dstImg.view());
+    batch >> renderer >> sink;
+    renderer.setVirtualScreen(100, 60);
+    REQUIRE(renderer.execPrepare() == PrepareStatus::Prepared);
+
+    auto rangeAt = [&](int y) {
+        RenderRequest req;
+        req.width = 100;
+        req.height = 1;
+        req.origin = {0, to_fixed(y)};
+        return batch.getDataRange(req);
+    };
+    DataRange r0 = rangeAt(2);
+    CHECK(r0.startX == 5);
+    CHECK(r0.endX == 15);
+    DataRange r1 = rangeAt(7);
+    CHECK(r1.startX == 5);
+    CHECK(r1.endX == 70);
+    DataRange r2 = rangeAt(12);
+    CHECK(r2.startX == 60);
+    CHECK(r2.endX == 70);
+    CHECK_FALSE(rangeAt(40).hasData());
+
+    // 離れた2スプライトはセグメントリストでは別区間
+    RenderRequest req;
+    req.width = 100;
+    req.height = 1;
+    req.origin = {0, to_fixed(7)};
+    DataRange segs[MAX_DATA_SEGMENTS];
+    REQUIRE(batch.getDataSegments(req, segs, MAX_DATA_SEGMENTS) == 2);
+    CHECK(segs[0].startX == 5);
+    CHECK(segs[0].endX == 15);
+    CHECK(segs[1].startX == 60);
+    CHECK(segs[1].endX == 70);
+    renderer.execFinalize();
+}
+
+TEST_CASE("SpriteBatchNode converts non-RGBA8 sprites") {
+    // RGB565 スプライト → RGBA8_Straight に変換して合成
+    ImageBuffer src565(4, 2, PixelFormatIDs::RGB565_LE, InitPolicy::Zero);
+    for (int y = 0; y < 2; ++y) {
+        for (int x = 0; x < 4; ++x) {
+            auto p = static_cast<uint16_t*>(src565.view().pixelAt(x, y));
+            *p = 0xF800;  // 赤
+        }
+    }
+    SpriteBatchNode batch;
+    batch.addSprite(src565.view(), AffineMatrix(1, 0, 0, 1, 2, 1));
+    ImageBuffer dst(8, 4, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    renderWithBatch(batch, dst);
+
+    auto p = static_cast<const uint8_t*>(dst.view().pixelAt(3, 2));
+    CHECK(p[0] == 255);
+    CHECK(p[1] == 0);
+    CHECK(p[3] == 255);
+    auto q = static_cast<const uint8_t*>(dst.view().pixelAt(0, 0));
+    CHECK(q[3] == 0);
+}
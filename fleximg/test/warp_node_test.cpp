@@ -0,0 +1,250 @@
+// fleximg WarpNode Unit Tests
+// メッシュワープノードのテスト
+
+#include "doctest.h"
+
+#define FLEXIMG_NAMESPACE fleximg
+#include "fleximg/core/common.h"
+#include "fleximg/core/types.h"
+#include "fleximg/core/warp_mesh.h"
+#include "fleximg/image/render_types.h"
+#include "fleximg/image/image_buffer.h"
+#include "fleximg/nodes/affine_node.h"
+#include "fleximg/nodes/warp_node.h"
+#include "fleximg/nodes/source_node.h"
+#include "fleximg/nodes/sink_node.h"
+#include "fleximg/nodes/renderer_node.h"
+
+#include <cmath>
+#include <cstring>
+
+using namespace fleximg;
+
+// =============================================================================
+// Helper Functions
+// =============================================================================
+
+// 8x8ブロックのチェッカー画像（全ピクセル不透明）
+static ImageBuffer createCheckerImage(int width, int height) {
+    ImageBuffer img(width, height, PixelFormatIDs::RGBA8_Straight);
+    ViewPort view = img.view();
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            uint8_t* p = static_cast<uint8_t*>(view.pixelAt(x, y));
+            bool on = ((x >> 3) + (y >> 3)) & 1;
+            p[0] = on ? 255 : 0;
+            p[1] = static_cast<uint8_t>(x * 4);
+            p[2] = static_cast<uint8_t>(y * 4);
+            p[3] = 255;
+        }
+    }
+    return img;
+}
+
+// ソース → (warp) → (affine) → renderer → sink を実行
+static void renderWarp(const ImageBuffer& srcImg, WarpNode* warp, AffineNode* affine,
+                       ImageBuffer& dst) {
+    SourceNode src(srcImg.view());
+    RendererNode renderer;
+    SinkNode sink(dst.view());
+    Node* last = &src;
+    if (warp) { *last >> *warp; last = warp; }
+    if (affine) { *last >> *affine; last = affine; }
+    *last >> renderer >> sink;
+    renderer.setVirtualScreen(dst.width(), dst.height());
+    CHECK(renderer.exec() == PrepareStatus::Prepared);
+}
+
+static int countMismatches(const ImageBuffer& a, const ImageBuffer& b) {
+    int mismatches = 0;
+    for (int y = 0; y < a.height(); ++y) {
+        for (int x = 0; x < a.width(); ++x) {
+            auto pa = static_cast<const uint8_t*>(a.view().pixelAt(x, y));
+            auto pb = static_cast<const uint8_t*>(b.view().pixelAt(x, y));
+            if (std::memcmp(pa, pb, 4) != 0) ++mismatches;
+        }
+    }
+    return mismatches;
+}
+
+// =============================================================================
+// WarpMesh Tests
+// =============================================================================
+
+TEST_CASE("WarpMesh identity and bilinear interpolation") {
+    WarpMesh mesh;
+    mesh.setGrid(2, 2, 10, 20, 8, 4);
+    REQUIRE(mesh.isValid());
+    CHECK(mesh.right() == doctest::Approx(26.0f));
+    CHECK(mesh.bottom() == doctest::Approx(28.0f));
+
+    float ox = 0, oy = 0;
+    REQUIRE(mesh.map(13.0f, 21.0f, ox, oy));
+    CHECK(ox == doctest::Approx(13.0f));
+    CHECK(oy == doctest::Approx(21.0f));
+    CHECK_FALSE(mesh.map(9.0f, 21.0f, ox, oy));
+    CHECK_FALSE(mesh.map(13.0f, 29.0f, ox, oy));
+
+    // 中央の格子点だけを変位 → セル中心では変位の1/4
+    mesh.setDisplacement(1, 1, 4.0f, -2.0f);
+    REQUIRE(mesh.map(14.0f, 22.0f, ox, oy));
+    CHECK(ox == doctest::Approx(15.0f));
+    CHECK(oy == doctest::Approx(21.5f));
+
+    mesh.setGrid(0, 2, 0, 0, 8, 8);
+    CHECK_FALSE(mesh.isValid());
+}
+
+// =============================================================================
+// WarpNode Pipeline Tests
+// =============================================================================
+
+TEST_CASE("WarpNode with uniform displacement matches translation") {
+    const int imgW = 32, imgH = 32;
+    const int canvasW = 64, canvasH = 48;
+    ImageBuffer srcImg = createCheckerImage(imgW, imgH);
+
+    // 格子をキャンバス全体に張り、全制御点を (-5, -3) だけ変位
+    // → 出力 (x, y) はソース (x - 5, y - 3) をサンプリング = (5, 3) 平行移動
+    WarpNode warp;
+    warp.setGrid(4, 3, 0, 0, 16, 16);
+    for (int r = 0; r <= 3; ++r) {
+        for (int c = 0; c <= 4; ++c) {
+            warp.setDisplacement(c, r, -5.0f, -3.0f);
+        }
+    }
+    AffineNode translate;
+    translate.setMatrix(AffineMatrix(1, 0, 0, 1, 5, 3));
+
+    ImageBuffer dstW(canvasW, canvasH, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    ImageBuffer dstA(canvasW, canvasH, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    renderWarp(srcImg, &warp, nullptr, dstW);
+    renderWarp(srcImg, nullptr, &translate, dstA);
+    CHECK(countMismatches(dstW, dstA) == 0);
+}
+
+TEST_CASE("WarpNode wave mesh matches reference mapping") {
+    const int imgW = 64, imgH = 64;
+    const int canvasW = 96, canvasH = 96;
+    ImageBuffer srcImg = createCheckerImage(imgW, imgH);
+
+    // 波形変位のメッシュ（格子は画像より広く、一部はソース外を参照）
+    WarpNode warp;
+    const int cols = 6, rows = 6;
+    warp.setGrid(cols, rows, 4, 4, 14, 14);
+    for (int r = 0; r <= rows; ++r) {
+        for (int c = 0; c <= cols; ++c) {
+            warp.setDisplacement(c, r,
+                6.0f * std::sin(static_cast<float>(r) * 0.9f),
+                4.0f * std::cos(static_cast<float>(c) * 1.3f) - 4.0f);
+        }
+    }
+
+    ImageBuffer dst(canvasW, canvasH, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    renderWarp(srcImg, &warp, nullptr, dst);
+
+    // 倍精度の参照写像と比較（境界付近の丸め差のみ許容）
+    const WarpMesh& mesh = warp.mesh();
+    int coverageMismatch = 0, colorMismatch = 0, covered = 0;
+    for (int y = 0; y < canvasH; ++y) {
+        for (int x = 0; x < canvasW; ++x) {
+            float sx = 0, sy = 0;
+            const bool inMesh = mesh.map(static_cast<float>(x) + 0.5f,
+                                         static_cast<float>(y) + 0.5f, sx, sy)
+                             && static_cast<float>(x) + 0.5f < mesh.right()
+                             && static_cast<float>(y) + 0.5f < mesh.bottom();
+            const bool inSrc = inMesh && sx >= 0 && sy >= 0 && sx < imgW && sy < imgH;
+            auto p = static_cast<const uint8_t*>(dst.view().pixelAt(x, y));
+            const bool drawn = p[3] != 0;
+            if (inSrc) ++covered;
+            if (drawn != inSrc) {
+                // 境界ピクセルは丸め差で判定が変わり得る
+                if (inSrc && (sx < 0.05f || sy < 0.05f || sx > imgW - 0.05f || sy > imgH - 0.05f)) continue;
+                ++coverageMismatch;
+                continue;
+            }
+            if (!inSrc) continue;
+            auto q = static_cast<const uint8_t*>(srcImg.view().pixelAt(
+                static_cast<int>(sx), static_cast<int>(sy)));
+            if (std::memcmp(p, q, 4) != 0) ++colorMismatch;
+        }
+    }
+    CHECK(covered > 2000);
+    CHECK(coverageMismatch == 0);
+    CHECK(colorMismatch < covered / 50);
+}
+
+TEST_CASE("WarpNode getDataRange follows mesh bounds") {
+    const int imgW = 64, imgH = 64;
+    const int canvasW = 100, canvasH = 60;
+    ImageBuffer srcImg = createCheckerImage(imgW, imgH);
+    ImageBuffer dstImg(canvasW, canvasH, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+
+    SourceNode src(srcImg.view());
+    WarpNode warp;
+    RendererNode renderer;
+    SinkNode sink(dstImg.view());
+    src >> warp >> renderer >> sink;
+
+    warp.setGrid(2, 2, 10, 5, 20, 20);   // x: [10, 50), y: [5, 45)
+    renderer.setVirtualScreen(canvasW, canvasH);
+    REQUIRE(renderer.execPrepare() == PrepareStatus::Prepared);
+
+    for (int y = 0; y < canvasH; ++y) {
+        RenderRequest req;
+        req.width = static_cast<int16_t>(canvasW);
+        req.height = 1;
+        req.origin = {0, to_fixed(y)};
+        DataRange range = src.getDataRange(req);
+        if (y >= 5 && y < 45) {
+            CHECK(range.startX == 10);
+            CHECK(range.endX == 50);
+        } else {
+            CHECK_FALSE(range.hasData());
+        }
+    }
+    renderer.execFinalize();
+}
+
+TEST_CASE("WarpNode composes with downstream AffineNode") {
+    const int imgW = 32, imgH = 32;
+    const int canvasW = 80, canvasH = 64;
+    ImageBuffer srcImg = createCheckerImage(imgW, imgH);
+
+    // ワープ（恒等メッシュ）の下流で平行移動 → 平行移動のみと一致
+    WarpNode warp;
+    warp.setGrid(2, 2, 0, 0, 16, 16);
+    AffineNode translate;
+    translate.setMatrix(AffineMatrix(1, 0, 0, 1, 20, 12));
+    ImageBuffer dstW(canvasW, canvasH, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    renderWarp(srcImg, &warp, &translate, dstW);
+
+    AffineNode translate2;
+    translate2.setMatrix(AffineMatrix(1, 0, 0, 1, 20, 12));
+    ImageBuffer dstA(canvasW, canvasH, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    renderWarp(srcImg, nullptr, &translate2, dstA);
+    CHECK(countMismatches(dstW, dstA) == 0);
+}
+
+TEST_CASE("WarpNode displacement map sets control points") {
+    WarpNode warp;
+    warp.setGrid(2, 1, 0, 0, 10, 10);
+
+    // 3x2 のマップ: 格子点と1対1に対応
+    ImageBuffer map(3, 2, PixelFormatIDs::RGBA8_Straight, InitPolicy::Zero);
+    for (int y = 0; y < 2; ++y) {
+        for (int x = 0; x < 3; ++x) {
+            auto p = static_cast<uint8_t*>(map.view().pixelAt(x, y));
+            p[0] = static_cast<uint8_t>(x == 1 ? 255 : 128);
+            p[1] = static_cast<uint8_t>(y == 1 ? 1 : 128);
+            p[3] = 255;
+        }
+    }
+    warp.setDisplacementMap(map.view(), 8.0f, 4.0f);
+
+    const WarpMesh& mesh = warp.mesh();
+    CHECK(mesh.pointX(0, 0) == doctest::Approx(0.0f));
+    CHECK(mesh.pointX(1, 0) == doctest::Approx(18.0f));
+    CHECK(mesh.pointY(1, 0) == doctest::Approx(0.0f));
+    CHECK(mesh.pointY(2, 1) == doctest::Approx(6.0f));
+}